@@ -20,6 +20,8 @@ create_library(
         probfd/cost_function
         probfd/caching_task_state_space
         probfd/task_state_space
+        probfd/concurrent_state_registry
+        probfd/concurrent_task_state_space
         probfd/progress_report
         probfd/quotient_system
 
@@ -37,11 +39,15 @@ create_library(
 
         # Task Utils
         probfd/task_utils/causal_graph
+        probfd/task_utils/outcome_deltas
         probfd/task_utils/sampling
 
         # Utility
         probfd/utils/guards
+        probfd/utils/mapped_file
+        probfd/utils/mapped_memory_resource
         probfd/utils/not_implemented
+        probfd/utils/thread_pool
 
         probfd/solver_interface
 
@@ -53,15 +59,18 @@ create_library(
         core_tasks
         utils
         probabilistic_successor_generator
-        mas_heuristic
 )
 
+find_package(Threads REQUIRED)
+target_link_libraries(probfd_core_obj PUBLIC Threads::Threads)
+
 create_library(
     NAME probabilistic_successor_generator
     SOURCES
         probfd/task_utils/probabilistic_successor_generator
         probfd/task_utils/probabilistic_successor_generator_factory
         probfd/task_utils/probabilistic_successor_generator_internals
+        probfd/task_utils/flat_successor_generator
     DEPENDS
         task_properties
 )
@@ -175,6 +184,8 @@ create_library(
         probfd/pdbs/assignment_enumerator
         probfd/pdbs/evaluators
         probfd/pdbs/match_tree
+        probfd/pdbs/multi_pattern_ranking
+        probfd/pdbs/pdb_cache
         probfd/pdbs/probability_aware_pattern_database
         probfd/pdbs/projection_operator
         probfd/pdbs/projection_state_space
@@ -305,6 +316,7 @@ create_library(
     SOURCES
         probfd/cartesian_abstractions/abstract_state
         probfd/cartesian_abstractions/adaptive_flaw_generator
+        probfd/cartesian_abstractions/adjacency_lists
         probfd/cartesian_abstractions/astar_trace_generator
         probfd/cartesian_abstractions/cartesian_abstraction
         probfd/cartesian_abstractions/cartesian_heuristic_function
@@ -312,6 +324,7 @@ create_library(
         probfd/cartesian_abstractions/cost_saturation
         probfd/cartesian_abstractions/complete_policy_flaw_finder
         probfd/cartesian_abstractions/evaluators
+        probfd/cartesian_abstractions/flat_refinement_hierarchy
         probfd/cartesian_abstractions/flaw
         probfd/cartesian_abstractions/ilao_policy_generator
         probfd/cartesian_abstractions/policy_based_flaw_generator
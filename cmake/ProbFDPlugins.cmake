@@ -194,6 +194,20 @@ create_library(
         probfd
 )
 
+create_library(
+    NAME parallel_lrtdp_solver_plugin
+    HELP "Enables the parallel LRTDP solver plugin"
+    SOURCES
+        probfd/cli/solvers/parallel_lrtdp
+    DEPENDS
+        mdp_solver_options
+        lrtdp_solver_plugin
+        parser
+        plugins
+    TARGET
+        probfd
+)
+
 create_library(
     NAME trap_aware_dfhs_solver_plugin
     HELP "Enables the trap-Aware DFHS solver plugin"
@@ -446,6 +460,15 @@ create_library(
         probfd
 )
 
+create_library(
+    NAME pdb_cache_options
+    SOURCES
+        probfd/cli/pdbs/pdb_cache_options
+    DEPENDS
+        parser
+        plugins
+)
+
 create_library(
     NAME gzocp_heuristic_plugin
     HELP "Enables the PDB Greedy Zero-One Cost-Partitioning heuristic plugin"
@@ -454,6 +477,7 @@ create_library(
     DEPENDS
         evaluator_category
         gzocp_pdb_heuristic
+        pdb_cache_options
         parser
         plugins
     TARGET
@@ -468,6 +492,7 @@ create_library(
     DEPENDS
         evaluator_category
         probability_aware_pdb_heuristic
+        pdb_cache_options
         parser
         plugins
     TARGET
@@ -482,6 +507,7 @@ create_library(
     DEPENDS
         evaluator_category
         scp_pdb_heuristic
+        pdb_cache_options
         parser
         plugins
     TARGET
@@ -496,6 +522,7 @@ create_library(
     DEPENDS
         evaluator_category
         ucp_pdb_heuristic
+        pdb_cache_options
         parser
         plugins
     TARGET
@@ -77,4 +77,15 @@ create_library(
         probability_aware_pdbs
         probfd_core
     TARGET probfd_tests
-)
\ No newline at end of file
+)
+
+create_library(
+    NAME hash_set_tests
+    HELP "Enables hash set tests"
+    SOURCES
+        tests/hash_set_tests
+    DEPENDS
+        GTest::gtest
+        utils
+    TARGET probfd_tests
+)
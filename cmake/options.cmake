@@ -27,6 +27,21 @@ option USE_LP to false."
             "not supported when an LP solver is used. See issue982 for details.")
     endif()
 
+    option(
+        USE_MIXED_PRECISION
+        "Store the lookup tables of pattern database and Cartesian heuristics \
+and the state values of heuristic search algorithms in single precision. \
+Bellman backups are still computed in double precision. Stored lower bounds \
+are rounded down and stored upper bounds are rounded up."
+        FALSE)
+
+    if(USE_MIXED_PRECISION)
+        target_compile_definitions(
+            common_cxx_flags
+            INTERFACE
+            PROBFD_MIXED_PRECISION)
+    endif()
+
     option(
         DISABLE_LIBRARIES_BY_DEFAULT
         "If set to YES only libraries that are specifically enabled will be compiled"
@@ -0,0 +1,314 @@
+#ifndef ALGORITHMS_COMPACT_INT_HASH_SET_H
+#define ALGORITHMS_COMPACT_INT_HASH_SET_H
+
+#include "downward/utils/logging.h"
+#include "downward/utils/system.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+namespace compact_int_hash_set {
+/*
+  Hash set for storing non-negative integer keys, with the same interface
+  as int_hash_set::IntHashSet but less memory per entry.
+
+  IntHashSet stores the key and its full 32-bit hash in each bucket, i.e.
+  8 bytes per bucket, and doubles its capacity when it grows. This set uses
+  6 bytes per bucket: the key, an 8-bit fingerprint of its hash and its
+  probe distance. It grows by a factor of 1.5 and keeps the load factor
+  between 7/12 and 7/8, so it needs roughly 7-10 bytes per entry instead of
+  the 9-18 bytes of IntHashSet.
+
+  Implementation:
+
+  We use linear probing with Robin Hood displacement: a key that is further
+  away from its ideal bucket takes the bucket of a key that is closer to its
+  own. Probe distances therefore stay short even at high load factors, and a
+  lookup can stop as soon as it reaches a bucket whose key is closer to its
+  ideal bucket than the looked up key would be.
+
+  The ideal bucket of a key is computed from the upper bits of its hash by
+  multiplying with the number of buckets, so the number of buckets does not
+  have to be a power of two. The fingerprint is taken from the lowest bits
+  of the hash. Keys are only compared with the equality tester if they have
+  the same ideal bucket and the same fingerprint.
+
+  Since the full hash is not stored, growing the set recomputes the hashes
+  of all keys with the hasher. This adds at most three hash computations
+  per key over the lifetime of the set.
+
+  Limitations:
+
+  Like IntHashSet, keys must be in [0, 2^31 - 1]. The probe distance of a
+  key is stored in 8 bits. If a key would be more than 254 buckets away
+  from its ideal bucket, the set grows, which requires a very bad hash
+  function.
+*/
+
+using KeyType = int;
+using HashType = unsigned int;
+
+template <typename Hasher, typename Equal>
+class CompactIntHashSet {
+    static constexpr int MAX_DISTANCE = 255;
+    static constexpr std::size_t MIN_CAPACITY = 16;
+
+    // Maximum load factor MAX_LOAD_NUMERATOR / MAX_LOAD_DENOMINATOR.
+    static constexpr std::size_t MAX_LOAD_NUMERATOR = 7;
+    static constexpr std::size_t MAX_LOAD_DENOMINATOR = 8;
+
+    /*
+      The key is split into two halves so that the bucket is 2-aligned and
+      has no padding.
+    */
+    struct Bucket {
+        // Distance to the ideal bucket plus one, zero for empty buckets.
+        std::uint8_t distance = 0;
+        std::uint8_t fingerprint = 0;
+        std::uint16_t key_low = 0;
+        std::uint16_t key_high = 0;
+
+        bool full() const { return distance != 0; }
+
+        KeyType get_key() const
+        {
+            return static_cast<KeyType>(
+                key_low | (static_cast<std::uint32_t>(key_high) << 16));
+        }
+
+        void set_key(KeyType key)
+        {
+            key_low = static_cast<std::uint16_t>(key);
+            key_high = static_cast<std::uint16_t>(
+                static_cast<std::uint32_t>(key) >> 16);
+        }
+    };
+
+    static_assert(sizeof(Bucket) == 6, "Bucket does not use 6 bytes");
+
+    Hasher hasher;
+    Equal equal;
+    std::vector<Bucket> buckets;
+    int num_entries;
+    int num_resizes;
+
+    std::size_t capacity() const { return buckets.size(); }
+
+    std::size_t get_bucket(HashType hash) const
+    {
+        return (static_cast<std::uint64_t>(hash) * capacity()) >> 32;
+    }
+
+    std::size_t get_next(std::size_t index) const
+    {
+        return ++index == capacity() ? 0 : index;
+    }
+
+    static std::uint8_t get_fingerprint(HashType hash)
+    {
+        return static_cast<std::uint8_t>(hash);
+    }
+
+    /*
+      Returns the index of the bucket containing a key equal to the given
+      key, or -1 if there is none.
+    */
+    long find_equal_key(KeyType key, HashType hash) const
+    {
+        const std::uint8_t fingerprint = get_fingerprint(hash);
+        std::size_t index = get_bucket(hash);
+        for (int distance = 1;; ++distance) {
+            const Bucket& bucket = buckets[index];
+            // The key would have displaced a bucket closer to its ideal one.
+            if (bucket.distance < distance) return -1;
+            if (bucket.distance == distance &&
+                bucket.fingerprint == fingerprint &&
+                equal(bucket.get_key(), key)) {
+                return static_cast<long>(index);
+            }
+            index = get_next(index);
+        }
+    }
+
+    /*
+      Inserts a key which is not contained in the set. Returns false if the
+      key, or a key displaced by it, would end up too far from its ideal
+      bucket. In that case, the set contains all keys except for one
+      displaced key, which is returned in the output parameters.
+    */
+    bool insert_new(KeyType& key, HashType& hash)
+    {
+        Bucket carried;
+        carried.distance = 1;
+        carried.fingerprint = get_fingerprint(hash);
+        carried.set_key(key);
+
+        std::size_t index = get_bucket(hash);
+
+        for (;;) {
+            Bucket& bucket = buckets[index];
+            if (!bucket.full()) {
+                bucket = carried;
+                ++num_entries;
+                return true;
+            }
+
+            if (bucket.distance < carried.distance) {
+                std::swap(bucket, carried);
+            }
+
+            if (carried.distance == MAX_DISTANCE - 1) {
+                key = carried.get_key();
+                hash = hasher(key);
+                return false;
+            }
+
+            ++carried.distance;
+            index = get_next(index);
+        }
+    }
+
+    void rehash(std::size_t new_capacity)
+    {
+        std::vector<Bucket> old_buckets = std::move(buckets);
+        buckets.assign(new_capacity, Bucket());
+        num_entries = 0;
+        ++num_resizes;
+
+        for (const Bucket& bucket : old_buckets) {
+            if (bucket.full()) {
+                KeyType key = bucket.get_key();
+                HashType hash = hasher(key);
+                insert_new_or_enlarge(key, hash);
+            }
+        }
+    }
+
+    void enlarge()
+    {
+        const std::size_t new_capacity = capacity() + capacity() / 2;
+        if (new_capacity > static_cast<std::size_t>(1) << 32) {
+            std::cerr << "CompactIntHashSet surpassed maximum capacity. This "
+                         "means there is an unexpectedly high number of hash "
+                         "collisions that should be investigated. Aborting."
+                      << std::endl;
+            utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+        }
+        rehash(new_capacity);
+    }
+
+    void insert_new_or_enlarge(KeyType key, HashType hash)
+    {
+        while (!insert_new(key, hash)) {
+            enlarge();
+        }
+    }
+
+    std::pair<KeyType, bool> insert(KeyType key, HashType hash)
+    {
+        assert(hasher(key) == hash);
+
+        /* If the hash set already contains the key, return the key and a
+           Boolean indicating that no new key has been inserted. */
+        const long index = find_equal_key(key, hash);
+        if (index != -1) {
+            return std::make_pair(buckets[index].get_key(), false);
+        }
+
+        if ((num_entries + 1) * MAX_LOAD_DENOMINATOR >
+            capacity() * MAX_LOAD_NUMERATOR) {
+            enlarge();
+        }
+
+        insert_new_or_enlarge(key, hash);
+        return std::make_pair(key, true);
+    }
+
+public:
+    CompactIntHashSet(const Hasher& hasher, const Equal& equal)
+        : hasher(hasher)
+        , equal(equal)
+        , buckets(MIN_CAPACITY)
+        , num_entries(0)
+        , num_resizes(0)
+    {
+    }
+
+    int size() const { return num_entries; }
+
+    /*
+      Insert a key into the hash set.
+
+      Return a pair whose first item is the given key, or an equivalent key
+      already contained in the hash set. The second item in the pair is a bool
+      indicating whether a new key was inserted into the hash set.
+    */
+    std::pair<KeyType, bool> insert(KeyType key)
+    {
+        assert(key >= 0);
+        return insert(key, hasher(key));
+    }
+
+    /*
+      Like insert(key), but uses a hash of the key computed by the caller,
+      e.g. to hash a batch of keys before prefetching their buckets.
+    */
+    std::pair<KeyType, bool> insert_with_hash(KeyType key, HashType hash)
+    {
+        assert(key >= 0);
+        return insert(key, hash);
+    }
+
+    /*
+      Hint that a key with the given hash will be looked up soon. Loads the
+      ideal bucket of the hash into the cache without waiting for it.
+    */
+    void prefetch(HashType hash) const
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(&buckets[get_bucket(hash)]);
+#else
+        (void)hash;
+#endif
+    }
+
+    std::size_t get_size_in_bytes() const
+    {
+        return buckets.capacity() * sizeof(Bucket);
+    }
+
+    void print_statistics(utils::LogProxy& log) const
+    {
+        std::size_t total_distance = 0;
+        int max_distance = 0;
+        for (const Bucket& bucket : buckets) {
+            if (bucket.full()) {
+                total_distance += bucket.distance;
+                max_distance = std::max<int>(max_distance, bucket.distance);
+            }
+        }
+
+        log << "Compact int hash set load factor: " << num_entries << "/"
+            << capacity() << " = "
+            << static_cast<double>(num_entries) / capacity() << std::endl;
+        log << "Compact int hash set resizes: " << num_resizes << std::endl;
+        log << "Compact int hash set bytes per entry: "
+            << (num_entries ? static_cast<double>(get_size_in_bytes()) /
+                                  num_entries
+                            : 0.0)
+            << std::endl;
+        log << "Compact int hash set average probe length: "
+            << (num_entries ? static_cast<double>(total_distance) / num_entries
+                            : 0.0)
+            << std::endl;
+        log << "Compact int hash set maximum probe length: " << max_distance
+            << std::endl;
+    }
+};
+} // namespace compact_int_hash_set
+
+#endif
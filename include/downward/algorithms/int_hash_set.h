@@ -299,6 +299,11 @@ public:
         return insert(key, hasher(key));
     }
 
+    std::size_t get_size_in_bytes() const
+    {
+        return buckets.capacity() * sizeof(Bucket);
+    }
+
     void dump(utils::LogProxy& log) const
     {
         int num_buckets = capacity();
@@ -30,6 +30,28 @@ class IntPacker {
 public:
     typedef unsigned int Bin;
 
+    // The value of a variable is (buffer[bin_index] & read_mask) >> shift.
+    struct BitPosition {
+        int bin_index;
+        int shift;
+        Bin read_mask;
+    };
+
+    /*
+      An update of one bin that sets several variables stored in it at once:
+      buffer[bin_index] = (buffer[bin_index] & keep_mask) | value.
+    */
+    struct BinDelta {
+        int bin_index;
+        Bin keep_mask;
+        Bin value;
+
+        void apply(Bin *buffer) const
+        {
+            buffer[bin_index] = (buffer[bin_index] & keep_mask) | value;
+        }
+    };
+
     /*
       The constructor takes the range for each variable. The domain of
       variable i is {0, ..., ranges[i] - 1}. Because we are using signed
@@ -42,6 +64,19 @@ public:
     int get(const Bin *buffer, int var) const;
     void set(Bin *buffer, int var, int value) const;
 
+    /*
+      For code that reads the same variables from many buffers and wants to
+      avoid the indirection of get().
+    */
+    BitPosition get_bit_position(int var) const;
+
+    /*
+      Adds the assignment var := value to the deltas, merging it into the
+      delta of the variable's bin if there already is one. A later
+      assignment to the same variable overrides an earlier one.
+    */
+    void add_to_deltas(std::vector<BinDelta> &deltas, int var, int value) const;
+
     int get_num_bins() const { return num_bins; }
 };
 }
@@ -51,6 +51,10 @@ public:
         int right_state_id);
 
     int get_abstract_state_id(const State& state) const;
+
+    const std::shared_ptr<PlanningTask>& get_task() const;
+    int get_num_nodes() const;
+    const Node& get_node(NodeID node_id) const;
 };
 
 class Node {
@@ -87,6 +91,24 @@ public:
         return var;
     }
 
+    int get_value() const
+    {
+        assert(is_split());
+        return value;
+    }
+
+    NodeID get_left_child() const
+    {
+        assert(is_split());
+        return left_child;
+    }
+
+    NodeID get_right_child() const
+    {
+        assert(is_split());
+        return right_child;
+    }
+
     NodeID get_child(int value) const
     {
         assert(is_split());
@@ -9,6 +9,7 @@
 
 #include <functional>
 #include <memory>
+#include <mutex>
 
 /*
   A PerTaskInformation<T> acts like a HashMap<TaskID, T>
@@ -19,6 +20,10 @@
   (2) If a task is destroyed, its associated data in all PerTaskInformation
       objects is automatically destroyed as well.
 
+  Accesses are synchronized, so that different threads can access entries at
+  the same time, e.g., when constructing state registries for different tasks
+  concurrently. Destroying a task is not synchronized with accesses from other
+  threads, since the subscription bookkeeping is not thread-safe.
 */
 template <class Entry>
 class PerTaskInformation : public subscriber::Subscriber<PlanningTask> {
@@ -34,6 +39,7 @@ class PerTaskInformation : public subscriber::Subscriber<PlanningTask> {
         std::function<std::unique_ptr<Entry>(const PlanningTaskProxy&)>;
     EntryConstructor entry_constructor;
     utils::HashMap<TaskID, std::unique_ptr<Entry>> entries;
+    std::mutex mutex;
 
 public:
     /*
@@ -55,6 +61,7 @@ public:
 
     Entry& operator[](const PlanningTaskProxy& task_proxy)
     {
+        std::lock_guard lock(mutex);
         TaskID id = task_proxy.get_id();
         const auto& it = entries.find(id);
         if (it == entries.end()) {
@@ -66,6 +73,7 @@ public:
 
     virtual void notify_service_destroyed(const PlanningTask* task) override
     {
+        std::lock_guard lock(mutex);
         TaskID id = PlanningTaskProxy(*task).get_id();
         entries.erase(id);
     }
@@ -5,14 +5,16 @@
 #include "downward/axioms.h"
 #include "downward/state_id.h"
 
-#include "downward/algorithms/int_hash_set.h"
+#include "downward/algorithms/compact_int_hash_set.h"
 #include "downward/algorithms/int_packer.h"
 #include "downward/algorithms/segmented_vector.h"
 #include "downward/algorithms/subscriber.h"
 #include "downward/task_utils/task_properties.h"
 #include "downward/utils/hash.h"
 
+#include <memory_resource>
 #include <set>
+#include <span>
 #include <vector>
 
 /*
@@ -114,22 +116,29 @@ class IntPacker;
 using PackedStateBin = int_packer::IntPacker::Bin;
 
 class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
+    using StateDataPool = segmented_vector::SegmentedArrayVector<
+        PackedStateBin,
+        std::pmr::polymorphic_allocator<PackedStateBin>>;
+
     struct StateIDSemanticHash {
-        const segmented_vector::SegmentedArrayVector<PackedStateBin>&
-            state_data_pool;
+        const StateDataPool& state_data_pool;
         int state_size;
         StateIDSemanticHash(
-            const segmented_vector::SegmentedArrayVector<PackedStateBin>&
-                state_data_pool,
+            const StateDataPool& state_data_pool,
             int state_size)
             : state_data_pool(state_data_pool)
             , state_size(state_size)
         {
         }
 
-        int_hash_set::HashType operator()(int id) const
+        compact_int_hash_set::HashType operator()(int id) const
+        {
+            return hash_data(state_data_pool[id], state_size);
+        }
+
+        static compact_int_hash_set::HashType
+        hash_data(const PackedStateBin* data, int state_size)
         {
-            const PackedStateBin* data = state_data_pool[id];
             utils::HashState hash_state;
             for (int i = 0; i < state_size; ++i) {
                 hash_state.feed(data[i]);
@@ -139,12 +148,10 @@ class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
     };
 
     struct StateIDSemanticEqual {
-        const segmented_vector::SegmentedArrayVector<PackedStateBin>&
-            state_data_pool;
+        const StateDataPool& state_data_pool;
         int state_size;
         StateIDSemanticEqual(
-            const segmented_vector::SegmentedArrayVector<PackedStateBin>&
-                state_data_pool,
+            const StateDataPool& state_data_pool,
             int state_size)
             : state_data_pool(state_data_pool)
             , state_size(state_size)
@@ -164,24 +171,55 @@ class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
       this registry and find their IDs. States are compared/hashed semantically,
       i.e. the actual state data is compared, not the memory location.
     */
-    using StateIDSet =
-        int_hash_set::IntHashSet<StateIDSemanticHash, StateIDSemanticEqual>;
+    using StateIDSet = compact_int_hash_set::
+        CompactIntHashSet<StateIDSemanticHash, StateIDSemanticEqual>;
 
     PlanningTaskProxy task_proxy;
     const int_packer::IntPacker& state_packer;
     AxiomEvaluator& axiom_evaluator;
     const int num_variables;
 
-    segmented_vector::SegmentedArrayVector<PackedStateBin> state_data_pool;
+    StateDataPool state_data_pool;
     StateIDSet registered_states;
 
     std::unique_ptr<State> cached_initial_state;
 
+    /*
+      Scratch space of get_successor_states. The fired effects of outcome i
+      are batch_effects[batch_offsets[i]] to batch_effects[batch_offsets[i+1]].
+    */
+    std::vector<FactPair> batch_effects;
+    std::vector<size_t> batch_offsets;
+    std::vector<PackedStateBin> batch_buffers;
+    std::vector<compact_int_hash_set::HashType> batch_hashes;
+    std::vector<size_t> batch_representatives;
+
     StateID insert_id_or_pop_state();
+    StateID insert_id_or_pop_state(compact_int_hash_set::HashType hash);
     int get_bins_per_state() const;
 
+    void register_successor_batch(
+        const PackedStateBin* predecessor,
+        std::vector<StateID>& successor_ids);
+
+    /*
+      Registers the first num_outcomes candidate states in batch_buffers and
+      appends their IDs to successor_ids.
+    */
+    void register_candidates(
+        size_t num_outcomes,
+        std::vector<StateID>& successor_ids);
+
 public:
-    explicit StateRegistry(const PlanningTaskProxy& task_proxy);
+    /*
+      The packed data of the registered states is allocated from
+      state_memory, e.g. to keep it in a file-backed memory resource. The
+      hash set of registered states always stays in the default memory.
+    */
+    explicit StateRegistry(
+        const PlanningTaskProxy& task_proxy,
+        std::pmr::memory_resource* state_memory =
+            std::pmr::get_default_resource());
 
     const PlanningTaskProxy& get_task_proxy() const { return task_proxy; }
 
@@ -259,6 +297,63 @@ public:
         }
     }
 
+    /*
+      Registers the successor states of all outcomes of one operator and
+      appends their IDs to successor_ids, in the order of the outcomes.
+      outcome_effects is a range containing the effects of each outcome.
+
+      This is cheaper than calling get_successor_state for each outcome: the
+      effect prefix shared by all outcomes is only applied once, duplicate
+      successors within the batch are only looked up once, and the hash
+      buckets of all successors are prefetched before they are looked up.
+      Tasks with axioms fall back to get_successor_state.
+    */
+    template <typename OutcomeEffects>
+    void get_successor_states(
+        const State& predecessor,
+        const OutcomeEffects& outcome_effects,
+        std::vector<StateID>& successor_ids)
+    {
+        if (task_properties::has_axioms(task_proxy)) {
+            for (const auto& effects : outcome_effects) {
+                successor_ids.push_back(
+                    get_successor_state(predecessor, effects).get_id());
+            }
+            return;
+        }
+
+        batch_effects.clear();
+        batch_offsets.assign(1, 0);
+        for (const auto& effects : outcome_effects) {
+            for (auto effect : effects) {
+                if (does_fire(effect, predecessor)) {
+                    batch_effects.push_back(effect.get_fact().get_pair());
+                }
+            }
+            batch_offsets.push_back(batch_effects.size());
+        }
+
+        register_successor_batch(predecessor.get_buffer(), successor_ids);
+    }
+
+    using BinDelta = int_packer::IntPacker::BinDelta;
+
+    /*
+      Like get_successor_states above, but the effects of each outcome are
+      given as precomputed bin deltas, which requires them to be
+      unconditional. The deltas of outcome i are
+      deltas[outcome_offsets[i]] to deltas[outcome_offsets[i + 1]].
+      Applying an outcome then takes one AND and one OR per changed bin
+      instead of one IntPacker::set per effect.
+
+      Must not be used for tasks with axioms.
+    */
+    void get_successor_states(
+        const State& predecessor,
+        std::span<const BinDelta> deltas,
+        std::span<const int> outcome_offsets,
+        std::vector<StateID>& successor_ids);
+
     /*
       Returns the number of states registered so far.
     */
@@ -1033,6 +1033,16 @@ public:
         std::vector<int>&& values);
     // Construct a state with only unpacked data.
     State(const PlanningTask& task, std::vector<int>&& values);
+    /*
+      Construct a state with packed data registered in a registry other than
+      StateRegistry, e.g. probfd::ConcurrentStateRegistry. The state has an
+      ID, but get_registry() returns nullptr.
+    */
+    State(
+        const PlanningTask& task,
+        const int_packer::IntPacker& state_packer,
+        StateID id,
+        const PackedStateBin* buffer);
 
     bool operator==(const State& other) const;
     bool operator!=(const State& other) const;
@@ -1164,6 +1174,15 @@ public:
         return State(*task, registry, id, buffer, std::move(state_values));
     }
 
+    // This method is meant to be called only by other state registries.
+    State create_state(
+        const int_packer::IntPacker& state_packer,
+        StateID id,
+        const PackedStateBin* buffer) const
+    {
+        return State(*task, state_packer, id, buffer);
+    }
+
     State get_initial_state() const
     {
         return create_state(task->get_initial_state_values());
@@ -1253,8 +1272,11 @@ inline bool State::operator==(const State& other) const
                   << "intentional." << std::endl;
         utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
     }
-    if (registry) {
-        // Both states are registered and from the same registry.
+    if (registry || id != StateID::no_state) {
+        /*
+          Both states are registered and from the same registry, possibly
+          one that is not a StateRegistry.
+        */
         return id == other.id;
     } else {
         // Both states are unregistered.
@@ -29,7 +29,7 @@ namespace probfd {
 template <typename State, typename Action>
 std::unique_ptr<MultiPolicy<State, Action>> compute_optimal_projection_policy(
     MDP<State, Action>& mdp,
-    std::span<const value_t> value_table,
+    std::span<const stored_value_t> value_table,
     param_type<State> initial_state,
     utils::RandomNumberGenerator& rng,
     bool wildcard);
@@ -45,7 +45,7 @@ std::unique_ptr<MultiPolicy<State, Action>> compute_optimal_projection_policy(
 template <typename State, typename Action>
 std::unique_ptr<MultiPolicy<State, Action>> compute_greedy_projection_policy(
     MDP<State, Action>& mdp,
-    std::span<const value_t> value_table,
+    std::span<const stored_value_t> value_table,
     param_type<State> initial_state,
     utils::RandomNumberGenerator& rng,
     bool wildcard);
@@ -12,6 +12,7 @@
 
 #include "downward/utils/rng.h"
 
+#include <algorithm>
 #include <cassert>
 #include <deque>
 #include <unordered_set>
@@ -20,10 +21,26 @@
 
 namespace probfd {
 
+namespace internal {
+
+// The value table may be stored with less precision than value_t. Its values
+// are then only equal to the values they were rounded from up to the rounding
+// error.
+inline bool
+is_stored_value_equal(value_t stored, value_t value, value_t tolerance = 0_vt)
+{
+    return is_approx_equal(
+        stored,
+        value,
+        std::max(tolerance, 2 * get_stored_value_error(value)));
+}
+
+} // namespace internal
+
 template <typename State, typename Action>
 std::unique_ptr<MultiPolicy<State, Action>> compute_optimal_projection_policy(
     MDP<State, Action>& mdp,
-    std::span<const value_t> value_table,
+    std::span<const stored_value_t> value_table,
     param_type<State> initial_state,
     utils::RandomNumberGenerator& rng,
     bool wildcard)
@@ -47,7 +64,7 @@ std::unique_ptr<MultiPolicy<State, Action>> compute_optimal_projection_policy(
 
         // Skip states in which termination is optimal
         const value_t term_cost = mdp.get_termination_info(s).get_cost();
-        if (value == term_cost) {
+        if (internal::is_stored_value_equal(value, term_cost)) {
             goals.push_back(s);
             continue;
         }
@@ -61,7 +78,9 @@ std::unique_ptr<MultiPolicy<State, Action>> compute_optimal_projection_policy(
             value_t op_value = mdp.get_action_cost(op) +
                                successor_dist.expectation(value_table);
 
-            if (!is_approx_equal(value, op_value)) continue;
+            if (!internal::is_stored_value_equal(value, op_value, g_epsilon)) {
+                continue;
+            }
 
             for (const StateID succ : successor_dist.support()) {
                 if (closed.insert(succ).second) {
@@ -135,7 +154,7 @@ std::unique_ptr<MultiPolicy<State, Action>> compute_optimal_projection_policy(
 template <typename State, typename Action>
 std::unique_ptr<MultiPolicy<State, Action>> compute_greedy_projection_policy(
     MDP<State, Action>& mdp,
-    std::span<const value_t> value_table,
+    std::span<const stored_value_t> value_table,
     param_type<State> initial_state,
     utils::RandomNumberGenerator& rng,
     bool wildcard)
@@ -158,7 +177,7 @@ std::unique_ptr<MultiPolicy<State, Action>> compute_greedy_projection_policy(
 
         // Skip states in which termination is optimal
         const value_t term_cost = mdp.get_termination_info(state).get_cost();
-        if (value == term_cost) {
+        if (internal::is_stored_value_equal(value, term_cost)) {
             continue;
         }
 
@@ -179,7 +198,7 @@ std::unique_ptr<MultiPolicy<State, Action>> compute_greedy_projection_policy(
             const value_t op_value = mdp.get_action_cost(op) +
                                      successor_dist.expectation(value_table);
 
-            return is_approx_equal(value, op_value);
+            return internal::is_stored_value_equal(value, op_value, g_epsilon);
         });
 
         assert(it != transitions.end());
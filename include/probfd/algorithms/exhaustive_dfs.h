@@ -13,6 +13,7 @@
 
 #include <deque>
 #include <limits>
+#include <memory_resource>
 
 // Forward Declarations
 namespace probfd::algorithms {
@@ -172,7 +173,13 @@ struct SearchNodeInformation {
 
 template <bool UseInterval>
 struct SearchNodeInfos : public StateProperties {
-    storage::PerStateStorage<SearchNodeInformation<UseInterval>> infos;
+    storage::PolymorphicPerStateStorage<SearchNodeInformation<UseInterval>>
+        infos;
+
+    explicit SearchNodeInfos(std::pmr::memory_resource* memory)
+        : infos(SearchNodeInformation<UseInterval>(), memory)
+    {
+    }
 
     SearchNodeInformation<UseInterval>& operator[](StateID state_id)
     {
@@ -235,6 +242,11 @@ class ExhaustiveDepthFirstSearch : public MDPAlgorithm<State, Action> {
     std::deque<StackInformation> stack_infos_;
     std::vector<StateID> neighbors_;
 
+    // Scratch space for the batched evaluation of new successor states.
+    std::vector<StateID> new_successors_;
+    std::vector<State> new_states_;
+    std::vector<value_t> new_estimates_;
+
     bool last_all_dead_ = true;
     bool last_all_marked_dead_ = true;
 
@@ -245,7 +257,9 @@ public:
         std::shared_ptr<TransitionSorterType> transition_sorting,
         Interval cost_bound,
         bool path_updates,
-        bool only_propagate_when_changed);
+        bool only_propagate_when_changed,
+        std::pmr::memory_resource* per_state_memory =
+            std::pmr::get_default_resource());
 
     Interval solve(
         MDPType& mdp,
@@ -280,6 +294,18 @@ private:
         param_type<State> state,
         SearchNodeInfo& info);
 
+    // Initializes all states in new_successors_ with a single call to the
+    // heuristic and clears new_successors_.
+    void initialize_new_successors(MDPType& mdp, EvaluatorType& heuristic);
+
+    // Handles goal states. Returns true if the state needs to be evaluated.
+    bool initialize_termination(
+        MDPType& mdp,
+        param_type<State> state,
+        SearchNodeInfo& info);
+
+    bool set_heuristic_estimate(SearchNodeInfo& info, value_t estimate);
+
     bool push_state(
         MDPType& mdp,
         EvaluatorType& heuristic,
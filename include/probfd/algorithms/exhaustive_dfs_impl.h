@@ -10,6 +10,7 @@
 
 #include "probfd/evaluator.h"
 
+#include <algorithm>
 #include <cassert>
 #include <ranges>
 
@@ -62,7 +63,8 @@ ExhaustiveDepthFirstSearch<State, Action, UseInterval>::
         std::shared_ptr<TransitionSorterType> transition_sorting,
         Interval cost_bound,
         bool path_updates,
-        bool only_propagate_when_changed)
+        bool only_propagate_when_changed,
+        std::pmr::memory_resource* per_state_memory)
     : transition_sort_(transition_sorting)
     , cost_bound_(cost_bound)
     , trivial_bound_([=] {
@@ -74,6 +76,7 @@ ExhaustiveDepthFirstSearch<State, Action, UseInterval>::
     }())
     , value_propagation_(path_updates)
     , only_propagate_when_changed_(only_propagate_when_changed)
+    , search_space_(per_state_memory)
 {
 }
 
@@ -157,6 +160,57 @@ bool ExhaustiveDepthFirstSearch<State, Action, UseInterval>::
         SearchNodeInfo& info)
 {
     assert(info.is_new());
+
+    if (!initialize_termination(mdp, state, info)) return false;
+
+    return set_heuristic_estimate(info, heuristic.evaluate(state));
+}
+
+template <typename State, typename Action, bool UseInterval>
+void ExhaustiveDepthFirstSearch<State, Action, UseInterval>::
+    initialize_new_successors(MDPType& mdp, EvaluatorType& heuristic)
+{
+    std::ranges::sort(new_successors_);
+    const auto duplicates = std::ranges::unique(new_successors_);
+    new_successors_.erase(duplicates.begin(), duplicates.end());
+
+    // Initialize goal states right away and keep the others for evaluation.
+    std::size_t num_evaluated = 0;
+
+    for (const StateID succ_id : new_successors_) {
+        State succ = mdp.get_state(succ_id);
+        if (!initialize_termination(mdp, succ, search_space_[succ_id])) {
+            continue;
+        }
+
+        new_successors_[num_evaluated++] = succ_id;
+        new_states_.push_back(std::move(succ));
+    }
+
+    new_successors_.resize(num_evaluated);
+    new_estimates_.resize(num_evaluated);
+
+    heuristic.evaluate_batch(new_states_, new_estimates_);
+
+    for (std::size_t i = 0; i != num_evaluated; ++i) {
+        set_heuristic_estimate(
+            search_space_[new_successors_[i]],
+            new_estimates_[i]);
+    }
+
+    new_successors_.clear();
+    new_states_.clear();
+    new_estimates_.clear();
+}
+
+template <typename State, typename Action, bool UseInterval>
+bool ExhaustiveDepthFirstSearch<State, Action, UseInterval>::
+    initialize_termination(
+        MDPType& mdp,
+        param_type<State> state,
+        SearchNodeInfo& info)
+{
+    assert(info.is_new());
     info.value = trivial_bound_;
 
     TerminationInfo term_info = mdp.get_termination_info(state);
@@ -170,7 +224,15 @@ bool ExhaustiveDepthFirstSearch<State, Action, UseInterval>::
         return false;
     }
 
-    const value_t estimate = heuristic.evaluate(state);
+    return true;
+}
+
+template <typename State, typename Action, bool UseInterval>
+bool ExhaustiveDepthFirstSearch<State, Action, UseInterval>::
+    set_heuristic_estimate(SearchNodeInfo& info, value_t estimate)
+{
+    const value_t term_cost = info.term_cost;
+
     if (estimate == term_cost) {
         info.value = AlgorithmValueType(term_cost);
         info.mark_dead_end();
@@ -211,6 +273,16 @@ bool ExhaustiveDepthFirstSearch<State, Action, UseInterval>::push_state(
         transition_sort_->sort(state, aops, successors, search_space_);
     }
 
+    for (const auto& succs : successors) {
+        for (const StateID succ_id : succs.support()) {
+            if (succ_id != state_id && search_space_[succ_id].is_new()) {
+                new_successors_.push_back(succ_id);
+            }
+        }
+    }
+
+    initialize_new_successors(mdp, heuristic);
+
     expansion_infos_.emplace_back(stack_infos_.size());
     stack_infos_.emplace_back(state_id);
 
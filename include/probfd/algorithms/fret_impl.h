@@ -86,7 +86,7 @@ auto FRET<State, Action, StateInfoT, GreedyGraphGenerator>::compute_policy(
         const QState quotient_state = quotient.get_state(quotient_id);
         queue.pop_front();
 
-        auto& base_info = base_algorithm_->state_infos_[quotient_id];
+        auto&& base_info = base_algorithm_->state_infos_[quotient_id];
         std::optional quotient_action = base_info.get_policy();
 
         // Terminal states have no policy decision.
@@ -342,7 +342,7 @@ bool FRET<State, Action, StateInfoT, GreedyGraphGenerator>::
                         quotient.build_quotient(scc, *scc.begin());
                     }
 
-                    auto& base_info = base_algorithm_->state_infos_[state_id];
+                    auto&& base_info = base_algorithm_->state_infos_[state_id];
                     base_info.set_on_fringe();
                     base_algorithm_->update_policy(base_info, std::nullopt);
 
@@ -427,7 +427,7 @@ bool ValueGraph<State, Action, StateInfoT>::get_successors(
 {
     assert(successors.empty());
 
-    auto& state_info = base_algorithm.state_infos_[qstate];
+    auto&& state_info = base_algorithm.state_infos_[qstate];
 
     const QState state = quotient.get_state(qstate);
     const value_t termination_cost =
@@ -469,7 +469,7 @@ bool PolicyGraph<State, Action, StateInfoT>::get_successors(
     std::vector<QAction>& aops,
     std::vector<StateID>& successors)
 {
-    auto& base_info = base_algorithm.state_infos_[quotient_state_id];
+    auto&& base_info = base_algorithm.state_infos_[quotient_state_id];
     auto a = base_info.get_policy();
 
     if (!a.has_value()) return false;
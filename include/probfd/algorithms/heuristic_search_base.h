@@ -25,6 +25,7 @@ template <typename>
 struct Transition;
 template <typename, typename>
 class CostFunction;
+class TerminationInfo;
 } // namespace probfd
 
 namespace probfd::algorithms {
@@ -84,9 +85,17 @@ class StateInfos : public StateProperties {
     storage::PerStateStorage<StateInfo> state_infos_;
 
 public:
+    static constexpr size_t BYTES_PER_STATE = sizeof(StateInfo);
+
     StateInfo& operator[](StateID sid) { return state_infos_[sid]; }
     const StateInfo& operator[](StateID sid) const { return state_infos_[sid]; }
 
+    [[nodiscard]]
+    size_t size() const
+    {
+        return state_infos_.size();
+    }
+
     value_t lookup_value(StateID state_id) override
     {
         return state_infos_[state_id].get_value();
@@ -100,6 +109,77 @@ public:
     void reset() { std::ranges::for_each(state_infos_, &StateInfo::clear); }
 };
 
+/**
+ * @brief Stores the flags, values and policy actions of the states in
+ * separate dense arrays. Accessing the information of a state returns a proxy
+ * state information object referring to the array entries of the state.
+ *
+ * State information types using the SplitLayout may add member functions
+ * and flags to PerStateBaseInformation, but no data members.
+ */
+template <typename StateInfo>
+    requires(StateInfo::SplitStorage)
+class StateInfos<StateInfo> : public StateProperties {
+    using ValueType = StoredAlgorithmValue<StateInfo::UseInterval>;
+    using PolicyType = typename StateInfo::PolicyType;
+
+    storage::PerStateStorage<std::uint8_t> flags_;
+    storage::PerStateStorage<ValueType> values_;
+    storage::PerStateStorage<PolicyType> policies_;
+
+public:
+    static constexpr size_t BYTES_PER_STATE =
+        sizeof(std::uint8_t) + sizeof(ValueType) +
+        (StateInfo::StorePolicy ? sizeof(PolicyType) : 0);
+
+    StateInfo operator[](StateID sid)
+    {
+        if constexpr (StateInfo::StorePolicy) {
+            return StateInfo{{{policies_[sid]}, {flags_[sid]}, values_[sid]}};
+        } else {
+            return StateInfo{{{}, {flags_[sid]}, values_[sid]}};
+        }
+    }
+
+    const StateInfo operator[](StateID sid) const
+    {
+        // Only the const member functions of the returned proxy can be used,
+        // so the entries are never modified through the casted references.
+        auto& flags = const_cast<std::uint8_t&>(flags_[sid]);
+        auto& value = const_cast<ValueType&>(values_[sid]);
+
+        if constexpr (StateInfo::StorePolicy) {
+            auto& policy = const_cast<PolicyType&>(policies_[sid]);
+            return StateInfo{{{policy}, {flags}, value}};
+        } else {
+            return StateInfo{{{}, {flags}, value}};
+        }
+    }
+
+    [[nodiscard]]
+    size_t size() const
+    {
+        return flags_.size();
+    }
+
+    value_t lookup_value(StateID state_id) override
+    {
+        return (*this)[state_id].get_value();
+    }
+
+    Interval lookup_bounds(StateID state_id) override
+    {
+        return (*this)[state_id].get_bounds();
+    }
+
+    void reset()
+    {
+        for (size_t i = 0; i != flags_.size(); ++i) {
+            (*this)[i].clear();
+        }
+    }
+};
+
 } // namespace internal
 
 /**
@@ -140,6 +220,11 @@ public:
 
     using AlgorithmValueType = AlgorithmValue<UseInterval>;
 
+    /// Refers to the information of a single state. This is a proxy object
+    /// if the state information is split into separate arrays.
+    using StateInfoRef = std::
+        conditional_t<StateInfo::SplitStorage, StateInfo, StateInfo&>;
+
 private:
     // Algorithm parameters
     const std::shared_ptr<PolicyPickerType> policy_chooser_;
@@ -150,6 +235,14 @@ protected:
 
     internal::Statistics statistics_;
 
+private:
+    // Scratch space for the batched evaluation of new successor states.
+    std::vector<StateID> new_successors_;
+    std::vector<State> new_states_;
+    std::vector<value_t> new_estimates_;
+    std::vector<value_t> new_termination_costs_;
+
+protected:
     struct BellmanResult {
         AlgorithmValueType best_value;
         std::optional<TransitionType> transition;
@@ -227,7 +320,7 @@ public:
      * otherwise false.
      */
     bool update_value(
-        StateInfo& state_info,
+        StateInfoRef state_info,
         AlgorithmValueType other,
         value_t epsilon = g_epsilon);
 
@@ -238,7 +331,7 @@ public:
      * Returns true if the greedy action has changed and false otherwise.
      */
     bool update_policy(
-        StateInfo& state_info,
+        StateInfoRef state_info,
         const std::optional<TransitionType>& transition)
         requires(StorePolicy);
 
@@ -252,7 +345,7 @@ protected:
         MDPType& mdp,
         EvaluatorType& h,
         param_type<State> state,
-        StateInfo& state_info,
+        StateInfoRef state_info,
         std::vector<TransitionType>& transitions);
 
     void generate_non_tip_transitions(
@@ -267,7 +360,22 @@ private:
         MDPType& mdp,
         EvaluatorType& h,
         param_type<State> state,
-        StateInfo& state_info);
+        StateInfoRef state_info);
+
+    /*
+     * Initializes all states in new_successors_ with a single call to the
+     * evaluator and clears new_successors_. The list may contain duplicates.
+     */
+    void initialize_new_successors(MDPType& mdp, EvaluatorType& h);
+
+    // Returns true and initializes the state if it is a goal state.
+    bool
+    initialize_if_goal(const TerminationInfo& term, StateInfoRef state_info);
+
+    void set_heuristic_estimate(
+        StateInfoRef state_info,
+        value_t estimate,
+        value_t termination_cost);
 
     AlgorithmValueType compute_qvalue(
         value_t action_cost,
@@ -17,6 +17,7 @@
 #include "downward/utils/collections.h"
 
 #include <cassert>
+#include <cmath>
 #include <deque>
 
 namespace probfd::algorithms::heuristic_search {
@@ -151,7 +152,7 @@ auto HeuristicSearchBase<State, Action, StateInfoT>::select_greedy_transition(
 
 template <typename State, typename Action, typename StateInfoT>
 bool HeuristicSearchBase<State, Action, StateInfoT>::update_value(
-    StateInfo& state_info,
+    StateInfoRef state_info,
     AlgorithmValueType other,
     value_t epsilon)
 {
@@ -163,7 +164,7 @@ bool HeuristicSearchBase<State, Action, StateInfoT>::update_value(
 
 template <typename State, typename Action, typename StateInfoT>
 bool HeuristicSearchBase<State, Action, StateInfoT>::update_policy(
-    StateInfo& state_info,
+    StateInfoRef state_info,
     const std::optional<TransitionType>& transition)
     requires(StorePolicy)
 {
@@ -179,7 +180,7 @@ void HeuristicSearchBase<State, Action, StateInfoT>::initialize_initial_state(
     EvaluatorType& h,
     param_type<State> state)
 {
-    StateInfo& info = this->state_infos_[mdp.get_state_id(state)];
+    StateInfoRef info = this->state_infos_[mdp.get_state_id(state)];
 
     if (info.is_value_initialized()) return;
 
@@ -194,7 +195,7 @@ void HeuristicSearchBase<State, Action, StateInfoT>::expand_and_initialize(
     MDPType& mdp,
     EvaluatorType& h,
     param_type<State> state,
-    StateInfo& state_info,
+    StateInfoRef state_info,
     std::vector<TransitionType>& transitions)
 {
     assert(!state_info.is_goal_or_terminal());
@@ -228,9 +229,9 @@ void HeuristicSearchBase<State, Action, StateInfoT>::expand_and_initialize(
                 continue;
             }
             loop = false;
-            auto& succ_info = state_infos_[succ_id];
-            if (succ_info.is_value_initialized()) continue;
-            initialize(mdp, h, mdp.get_state(succ_id), succ_info);
+            if (!state_infos_[succ_id].is_value_initialized()) {
+                new_successors_.push_back(succ_id);
+            }
         }
 
         if (!loop && loop_it != end) {
@@ -242,6 +243,8 @@ void HeuristicSearchBase<State, Action, StateInfoT>::expand_and_initialize(
         return loop;
     });
 
+    initialize_new_successors(mdp, h);
+
     if (transitions.empty()) {
         ++statistics_.self_loop_states;
         state_info.set_terminal();
@@ -276,7 +279,35 @@ template <typename State, typename Action, typename StateInfoT>
 void HeuristicSearchBase<State, Action, StateInfoT>::print_statistics(
     std::ostream& out) const
 {
-    out << "  Stored " << sizeof(StateInfo) << " bytes per state" << std::endl;
+    out << "  Stored " << internal::StateInfos<StateInfo>::BYTES_PER_STATE
+        << " bytes per state" << std::endl;
+
+    if constexpr (!std::same_as<stored_value_t, value_t>) {
+        // The rounding error grows with the magnitude of the stored values.
+        value_t largest = 0_vt;
+        for (size_t i = 0; i != state_infos_.size(); ++i) {
+            const Interval bounds = state_infos_[i].get_bounds();
+            for (const value_t bound : {bounds.lower, bounds.upper}) {
+                if (std::isfinite(bound)) {
+                    largest = std::max(largest, std::abs(bound));
+                }
+            }
+        }
+
+        const value_t error = get_stored_value_error(largest);
+
+        out << "  Stored state values in single precision: "
+            << sizeof(StoredAlgorithmValue<UseInterval>) << " instead of "
+            << sizeof(AlgorithmValueType) << " bytes per state" << std::endl;
+        out << "  Largest value rounding error: " << error << std::endl;
+
+        if (error > g_epsilon) {
+            out << "  Warning: The rounding error exceeds the tolerance "
+                << g_epsilon << ". Value changes below the rounding error "
+                << "are ignored." << std::endl;
+        }
+    }
+
     statistics_.print(out);
 }
 
@@ -285,31 +316,87 @@ void HeuristicSearchBase<State, Action, StateInfoT>::initialize(
     MDPType& mdp,
     EvaluatorType& h,
     param_type<State> state,
-    StateInfo& state_info)
+    StateInfoRef state_info)
 {
     assert(!state_info.is_value_initialized());
 
-    statistics_.evaluated_states++;
+    const TerminationInfo term = mdp.get_termination_info(state);
 
-    TerminationInfo term = mdp.get_termination_info(state);
-    const value_t t_cost = term.get_cost();
+    if (initialize_if_goal(term, state_info)) return;
 
-    if (term.is_goal_state()) {
-        statistics_.goal_states++;
-        state_info.set_goal();
-        state_info.value = AlgorithmValueType(t_cost);
-        return;
+    set_heuristic_estimate(state_info, h.evaluate(state), term.get_cost());
+}
+
+template <typename State, typename Action, typename StateInfoT>
+void HeuristicSearchBase<State, Action, StateInfoT>::initialize_new_successors(
+    MDPType& mdp,
+    EvaluatorType& h)
+{
+    std::ranges::sort(new_successors_);
+    const auto duplicates = std::ranges::unique(new_successors_);
+    new_successors_.erase(duplicates.begin(), duplicates.end());
+
+    // Initialize goal states right away and keep the others for evaluation.
+    std::size_t num_evaluated = 0;
+
+    for (const StateID succ_id : new_successors_) {
+        State succ = mdp.get_state(succ_id);
+        const TerminationInfo term = mdp.get_termination_info(succ);
+
+        if (initialize_if_goal(term, state_infos_[succ_id])) continue;
+
+        new_successors_[num_evaluated++] = succ_id;
+        new_states_.push_back(std::move(succ));
+        new_termination_costs_.push_back(term.get_cost());
     }
 
-    const value_t estimate = h.evaluate(state);
+    new_successors_.resize(num_evaluated);
+    new_estimates_.resize(num_evaluated);
 
+    h.evaluate_batch(new_states_, new_estimates_);
+
+    for (std::size_t i = 0; i != num_evaluated; ++i) {
+        set_heuristic_estimate(
+            state_infos_[new_successors_[i]],
+            new_estimates_[i],
+            new_termination_costs_[i]);
+    }
+
+    new_successors_.clear();
+    new_states_.clear();
+    new_estimates_.clear();
+    new_termination_costs_.clear();
+}
+
+template <typename State, typename Action, typename StateInfoT>
+bool HeuristicSearchBase<State, Action, StateInfoT>::initialize_if_goal(
+    const TerminationInfo& term,
+    StateInfoRef state_info)
+{
+    statistics_.evaluated_states++;
+
+    if (!term.is_goal_state()) return false;
+
+    statistics_.goal_states++;
+    state_info.set_goal();
+    state_info.value = as_stored_value(AlgorithmValueType(term.get_cost()));
+    return true;
+}
+
+template <typename State, typename Action, typename StateInfoT>
+void HeuristicSearchBase<State, Action, StateInfoT>::set_heuristic_estimate(
+    StateInfoRef state_info,
+    value_t estimate,
+    value_t termination_cost)
+{
     if constexpr (UseInterval) {
-        state_info.value = Interval(estimate, t_cost);
+        state_info.value =
+            as_stored_value(Interval(estimate, termination_cost));
     } else {
-        state_info.value = estimate;
+        state_info.value = as_stored_value(estimate);
     }
 
-    if (estimate == t_cost) {
+    if (estimate == termination_cost) {
         statistics_.pruned_states++;
         state_info.set_terminal();
     } else {
@@ -10,17 +10,41 @@
 #include "probfd/types.h"
 
 #include <cassert>
+#include <concepts>
 #include <cstdint>
 #include <optional>
 
 namespace probfd::algorithms::heuristic_search {
 
-template <typename, bool StorePolicy = false>
+/**
+ * @brief Layout tag for state information objects which hold their members
+ * directly. The heuristic search base stores one such object per state.
+ */
+struct InlineLayout {
+    template <typename T>
+    using Member = T;
+};
+
+/**
+ * @brief Layout tag for state information objects which are proxies
+ * referring to their members. The heuristic search base stores flags, values
+ * and policy actions in separate dense arrays, so that Bellman backups only
+ * touch the values.
+ *
+ * @see internal::StateInfos
+ */
+struct SplitLayout {
+    template <typename T>
+    using Member = T&;
+};
+
+template <typename, bool StorePolicy = false, typename Layout = InlineLayout>
 struct StatesPolicy {};
 
-template <typename Action>
-struct StatesPolicy<Action, true> {
-    std::optional<Action> policy = std::nullopt;
+template <typename Action, typename Layout>
+struct StatesPolicy<Action, true, Layout> {
+    typename Layout::template Member<std::optional<Action>> policy =
+        std::nullopt;
 
     std::optional<Action> get_policy() const { return policy; }
 
@@ -43,7 +67,8 @@ struct StatesPolicy<Action, true> {
     }
 };
 
-struct StateFlags {
+template <typename Layout = InlineLayout>
+struct BasicStateFlags {
     static constexpr uint8_t INITIALIZED = 1;
     static constexpr uint8_t TERMINAL = 2;
     static constexpr uint8_t GOAL = 4;
@@ -51,7 +76,7 @@ struct StateFlags {
     static constexpr uint8_t MASK = 7;
     static constexpr uint8_t BITS = 3;
 
-    uint8_t info = 0;
+    typename Layout::template Member<uint8_t> info = 0;
 
     [[nodiscard]]
     bool is_value_initialized() const
@@ -109,16 +134,35 @@ struct StateFlags {
     }
 };
 
-template <typename Action, bool StorePolicy_, bool UseInterval_>
+using StateFlags = BasicStateFlags<>;
+
+/**
+ * @brief The state information common to all heuristic search algorithms.
+ *
+ * With the SplitLayout, an object of this type only refers to the flags,
+ * value and policy of a state. Default member initializers are only used by
+ * the InlineLayout, split objects are always constructed from references.
+ */
+template <
+    typename Action,
+    bool StorePolicy_,
+    bool UseInterval_,
+    typename Layout_ = InlineLayout>
 struct PerStateBaseInformation
-    : public StatesPolicy<Action, StorePolicy_>
-    , public StateFlags {
+    : public StatesPolicy<Action, StorePolicy_, Layout_>
+    , public BasicStateFlags<Layout_> {
+    using Layout = Layout_;
+
     static constexpr bool StorePolicy = StorePolicy_;
     static constexpr bool UseInterval = UseInterval_;
+    static constexpr bool SplitStorage = std::same_as<Layout, SplitLayout>;
+
+    using PolicyType = std::optional<Action>;
 
-    AlgorithmValue<UseInterval> value;
+    typename Layout::template Member<StoredAlgorithmValue<UseInterval>> value;
 
-    /// Checks if the value bounds are epsilon-close.
+    /// Checks if the value bounds are epsilon-close, or as close as the
+    /// rounding error of the stored bounds permits.
     [[nodiscard]]
     bool bounds_agree() const
     {
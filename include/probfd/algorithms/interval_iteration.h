@@ -13,6 +13,7 @@
 #include "probfd/mdp_algorithm.h"
 
 #include <limits>
+#include <memory_resource>
 
 /// Namespace dedicated to interval iteration on MaxProb MDPs.
 namespace probfd::algorithms::interval_iteration {
@@ -50,6 +51,12 @@ struct Statistics {
  * than epsilon away, ensuring that any of the value functions is at most
  * epsilon away from the optimal value function.
  *
+ * If more than one thread is requested, the recursive decompositions of the
+ * end component decomposition run concurrently, and the value iterations use
+ * the parallel mode of topological value iteration, which solves independent
+ * SCCs concurrently and iterates the lower and upper bounds of an SCC
+ * concurrently before closing the gap between them.
+ *
  * @note This implementation outputs the values of the upper bounding value
  * function.
  *
@@ -79,6 +86,9 @@ class IntervalIteration : public MDPAlgorithm<State, Action> {
     // Algorithm parameters
     const bool extract_probability_one_states_;
 
+    // Memory of the value table of solve().
+    std::pmr::memory_resource* const per_state_memory_;
+
     // Algorithm state
     QuotientQRAnalysis qr_analysis_;
     Decomposer ec_decomposer_;
@@ -89,7 +99,10 @@ class IntervalIteration : public MDPAlgorithm<State, Action> {
 public:
     explicit IntervalIteration(
         bool extract_probability_one_states,
-        bool expand_goals);
+        bool expand_goals,
+        std::pmr::memory_resource* per_state_memory =
+            std::pmr::get_default_resource(),
+        unsigned num_threads = 1);
 
     Interval solve(
         MDPType& mdp,
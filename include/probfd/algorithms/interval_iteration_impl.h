@@ -17,11 +17,14 @@ namespace probfd::algorithms::interval_iteration {
 template <typename State, typename Action>
 IntervalIteration<State, Action>::IntervalIteration(
     bool extract_probability_one_states,
-    bool expand_goals)
+    bool expand_goals,
+    std::pmr::memory_resource* per_state_memory,
+    unsigned num_threads)
     : extract_probability_one_states_(extract_probability_one_states)
+    , per_state_memory_(per_state_memory)
     , qr_analysis_(expand_goals)
-    , ec_decomposer_(expand_goals)
-    , vi_(expand_goals)
+    , ec_decomposer_(expand_goals, num_threads)
+    , vi_(expand_goals, num_threads)
 {
 }
 
@@ -36,7 +39,9 @@ Interval IntervalIteration<State, Action>::solve(
     utils::CountdownTimer timer(max_time);
     std::unique_ptr sys = create_quotient(mdp, heuristic, state, timer);
     std::vector<StateID> dead, one;
-    storage::PerStateStorage<Interval> value_store;
+    storage::PolymorphicPerStateStorage<Interval> value_store(
+        Interval(),
+        per_state_memory_);
     return mysolve(mdp, heuristic, state, value_store, dead, one, *sys, timer);
 }
 
@@ -53,12 +53,13 @@ struct Statistics {
     void print(std::ostream& out) const;
 };
 
-template <typename Action, bool UseInterval>
+template <typename Action, bool UseInterval, typename Layout>
 struct PerStateInformation
     : public heuristic_search::
-          PerStateBaseInformation<Action, true, UseInterval> {
+          PerStateBaseInformation<Action, true, UseInterval, Layout> {
 private:
-    using Base = typename heuristic_search::PerStateBaseInformation<Action, true, UseInterval>;
+    using Base = typename heuristic_search::
+        PerStateBaseInformation<Action, true, UseInterval, Layout>;
 
 public:
     static constexpr uint8_t VISITED = 0b01 << Base::BITS;
@@ -120,13 +121,19 @@ public:
  * @tparam Action - The action type of the MDP model.
  * @tparam UseInterval - Whether intervals or real values are used as state
  * values.
+ * @tparam Layout - The memory layout of the state information, either
+ * heuristic_search::InlineLayout or heuristic_search::SplitLayout.
  */
-template <typename State, typename Action, bool UseInterval>
+template <
+    typename State,
+    typename Action,
+    bool UseInterval,
+    typename Layout = heuristic_search::InlineLayout>
 class LRTDP
     : public heuristic_search::FRETHeuristicSearchAlgorithm<
           State,
           Action,
-          internal::PerStateInformation<Action, UseInterval>> {
+          internal::PerStateInformation<Action, UseInterval, Layout>> {
     using Base = typename LRTDP::FRETHeuristicSearchAlgorithm;
 
     using AlgorithmValueType = Base::AlgorithmValueType;
@@ -135,6 +142,8 @@ public:
     using StateInfo = typename Base::StateInfo;
 
 private:
+    using StateInfoRef = typename Base::StateInfoRef;
+
     using MDPType = typename Base::MDPType;
     using EvaluatorType = typename Base::EvaluatorType;
     using PolicyPickerType = typename Base::PolicyPicker;
@@ -23,8 +23,8 @@ inline void Statistics::print(std::ostream& out) const
 
 } // namespace internal
 
-template <typename State, typename Action, bool UseInterval>
-LRTDP<State, Action, UseInterval>::LRTDP(
+template <typename State, typename Action, bool UseInterval, typename Layout>
+LRTDP<State, Action, UseInterval, Layout>::LRTDP(
     std::shared_ptr<PolicyPickerType> policy_chooser,
     TrialTerminationCondition stop_consistent,
     std::shared_ptr<SuccessorSamplerType> succ_sampler)
@@ -34,14 +34,14 @@ LRTDP<State, Action, UseInterval>::LRTDP(
 {
 }
 
-template <typename State, typename Action, bool UseInterval>
-void LRTDP<State, Action, UseInterval>::reset_search_state()
+template <typename State, typename Action, bool UseInterval, typename Layout>
+void LRTDP<State, Action, UseInterval, Layout>::reset_search_state()
 {
     this->state_infos_.reset();
 }
 
-template <typename State, typename Action, bool UseInterval>
-Interval LRTDP<State, Action, UseInterval>::do_solve(
+template <typename State, typename Action, bool UseInterval, typename Layout>
+Interval LRTDP<State, Action, UseInterval, Layout>::do_solve(
     MDPType& mdp,
     EvaluatorType& heuristic,
     param_type<State> state,
@@ -51,10 +51,10 @@ Interval LRTDP<State, Action, UseInterval>::do_solve(
     utils::CountdownTimer timer(max_time);
 
     const StateID state_id = mdp.get_state_id(state);
-    const StateInfo& state_info = this->state_infos_[state_id];
+    const StateInfoRef state_info = this->state_infos_[state_id];
 
-    progress.register_bound("v", [&state_info]() {
-        return as_interval(state_info.value);
+    progress.register_bound("v", [this, state_id]() {
+        return as_interval(this->state_infos_[state_id].value);
     });
 
     progress.register_print(
@@ -69,15 +69,15 @@ Interval LRTDP<State, Action, UseInterval>::do_solve(
     return state_info.get_bounds();
 }
 
-template <typename State, typename Action, bool UseInterval>
-void LRTDP<State, Action, UseInterval>::print_additional_statistics(
+template <typename State, typename Action, bool UseInterval, typename Layout>
+void LRTDP<State, Action, UseInterval, Layout>::print_additional_statistics(
     std::ostream& out) const
 {
     statistics_.print(out);
 }
 
-template <typename State, typename Action, bool UseInterval>
-void LRTDP<State, Action, UseInterval>::trial(
+template <typename State, typename Action, bool UseInterval, typename Layout>
+void LRTDP<State, Action, UseInterval, Layout>::trial(
     MDPType& mdp,
     EvaluatorType& heuristic,
     StateID initial_state,
@@ -96,7 +96,7 @@ void LRTDP<State, Action, UseInterval>::trial(
 
         const StateID state_id = current_trial_.back();
 
-        auto& state_info = this->state_infos_[state_id];
+        StateInfoRef state_info = this->state_infos_[state_id];
 
         if (state_info.is_solved()) {
             current_trial_.pop_back();
@@ -167,7 +167,7 @@ void LRTDP<State, Action, UseInterval>::trial(
     if (stop_consistent_ == REVISITED) {
         for (const StateID state :
              current_trial_ | std::views::reverse | std::views::drop(1)) {
-            auto& info = this->state_infos_[state];
+            StateInfoRef info = this->state_infos_[state];
             assert(info.is_closed());
             info.unmark_closed();
         }
@@ -184,8 +184,8 @@ void LRTDP<State, Action, UseInterval>::trial(
     } while (!current_trial_.empty());
 }
 
-template <typename State, typename Action, bool UseInterval>
-bool LRTDP<State, Action, UseInterval>::check_and_solve(
+template <typename State, typename Action, bool UseInterval, typename Layout>
+bool LRTDP<State, Action, UseInterval, Layout>::check_and_solve(
     MDPType& mdp,
     EvaluatorType& heuristic,
     StateID init_state_id,
@@ -196,7 +196,7 @@ bool LRTDP<State, Action, UseInterval>::check_and_solve(
     ClearGuard guard(visited_);
 
     {
-        StateInfo& state_info = this->state_infos_[init_state_id];
+        StateInfoRef state_info = this->state_infos_[init_state_id];
         if (state_info.is_solved()) return true;
         policy_queue_.emplace_back(init_state_id);
         state_info.mark_closed();
@@ -210,7 +210,7 @@ bool LRTDP<State, Action, UseInterval>::check_and_solve(
         const auto state_id = policy_queue_.back();
         policy_queue_.pop_back();
 
-        auto& info = this->state_infos_[state_id];
+        StateInfoRef info = this->state_infos_[state_id];
         assert(!info.is_solved());
         assert(info.is_closed());
 
@@ -268,7 +268,7 @@ bool LRTDP<State, Action, UseInterval>::check_and_solve(
         }
 
         for (StateID succ_id : transition->successor_dist.support()) {
-            StateInfo& succ_info = this->state_infos_[succ_id];
+            StateInfoRef succ_info = this->state_infos_[succ_id];
             if (!succ_info.is_closed() && !succ_info.is_solved()) {
                 succ_info.mark_closed();
                 policy_queue_.emplace_back(succ_id);
@@ -277,7 +277,7 @@ bool LRTDP<State, Action, UseInterval>::check_and_solve(
     } while (!policy_queue_.empty());
 
     for (StateID sid : visited_) {
-        StateInfo& info = this->state_infos_[sid];
+        StateInfoRef info = this->state_infos_[sid];
 
         if (info.is_solved()) continue;
 
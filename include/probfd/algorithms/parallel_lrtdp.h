@@ -0,0 +1,313 @@
+#ifndef PROBFD_ALGORITHMS_PARALLEL_LRTDP_H
+#define PROBFD_ALGORITHMS_PARALLEL_LRTDP_H
+
+#include "probfd/algorithms/lrtdp.h"
+#include "probfd/algorithms/types.h"
+
+#include "probfd/storage/concurrent_per_state_storage.h"
+
+#include "probfd/mdp_algorithm.h"
+
+#include "downward/utils/rng.h"
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <unordered_set>
+#include <vector>
+
+// Forward Declarations
+namespace utils {
+class CountdownTimer;
+}
+
+/// Namespace dedicated to the multi-threaded variant of LRTDP.
+namespace probfd::algorithms::parallel_lrtdp {
+
+using lrtdp::TrialTerminationCondition;
+
+/**
+ * @brief Statistics of a single worker thread.
+ */
+struct ThreadStatistics {
+    unsigned long long trials = 0;
+    unsigned long long trial_bellman_backups = 0;
+    unsigned long long check_and_solve_bellman_backups = 0;
+    unsigned long long labelled_states = 0;
+
+    // Labelling attempts that found the greedy envelope epsilon-consistent,
+    // but had to be discarded since a state value changed in the meantime,
+    // e.g. by another worker.
+    unsigned long long inconclusive_labellings = 0;
+
+    // Wall-clock seconds spent waiting for the expansion lock.
+    double lock_wait_time = 0.0;
+};
+
+/**
+ * @brief Parallel LRTDP statistics.
+ */
+struct Statistics {
+    unsigned long long evaluated_states = 0;
+    unsigned long long pruned_states = 0;
+    unsigned long long goal_states = 0;
+    unsigned long long expanded_states = 0;
+    unsigned long long terminal_states = 0;
+    unsigned long long self_loop_states = 0;
+
+    value_t initial_state_estimate = 0;
+
+    std::vector<ThreadStatistics> thread_statistics;
+
+    void print(std::ostream& out) const;
+};
+
+namespace internal {
+
+struct Successor {
+    StateID state_id;
+    value_t probability;
+};
+
+template <typename Action>
+struct CachedTransition {
+    Action action;
+    value_t cost;
+
+    // Range of the successors within StateEntry::successors.
+    unsigned successors_begin;
+    unsigned successors_end;
+};
+
+/*
+ * The shared information of a state. The value bounds are updated with
+ * atomic max (lower bound) and atomic min (upper bound) operations. The
+ * termination cost is written before the INITIALIZED flag, the transitions
+ * are written before the EXPANDED flag is set with release semantics and
+ * are immutable afterwards.
+ */
+template <typename Action>
+struct StateEntry {
+    static constexpr std::uint8_t INITIALIZED = 1 << 0;
+    static constexpr std::uint8_t EXPANDED = 1 << 1;
+    static constexpr std::uint8_t SOLVED = 1 << 2;
+    static constexpr std::uint8_t TERMINAL = 1 << 3;
+
+    std::atomic<value_t> lower = 0_vt;
+    std::atomic<value_t> upper = INFINITE_VALUE;
+    std::atomic<std::uint8_t> flags = 0;
+
+    value_t termination_cost = INFINITE_VALUE;
+
+    std::vector<CachedTransition<Action>> transitions;
+    std::vector<Successor> successors;
+
+    bool has_flag(std::uint8_t flag) const
+    {
+        return (flags.load(std::memory_order_acquire) & flag) != 0;
+    }
+
+    void set_flag(std::uint8_t flag)
+    {
+        flags.fetch_or(flag, std::memory_order_release);
+    }
+
+    bool is_solved() const { return has_flag(SOLVED | TERMINAL); }
+};
+
+} // namespace internal
+
+/**
+ * @brief Implements a multi-threaded variant of labelled real-time dynamic
+ * programming (LRTDP) \cite bonet:geffner:icaps-03.
+ *
+ * Several workers run LRTDP trials from the initial state concurrently,
+ * sharing one table of state values. Every worker samples successors with its
+ * own random number generator, so that the workers explore different parts
+ * of the greedy policy graph. The algorithm terminates when the initial state
+ * is labelled as solved.
+ *
+ * The MDP and the heuristic are not thread-safe, so expanding a state, which
+ * generates its transitions and evaluates its new successors, is serialized
+ * by a lock. The transitions of an expanded state are cached in the shared
+ * table, all Bellman backups afterwards run without locking. Value updates
+ * are monotone: the lower bound is raised with an atomic max and the upper
+ * bound is lowered with an atomic min, which preserves admissibility when
+ * several workers update the same state. Consequently, a state counts as
+ * epsilon-consistent if its Bellman backup does not raise its lower bound (or
+ * lower its upper bound) by more than epsilon. As for LRTDP, an admissible
+ * heuristic is required.
+ *
+ * Labelling uses the check-and-solve procedure of LRTDP. Since another worker
+ * may update a state of the greedy envelope after it was checked, all workers
+ * share a counter which is incremented on each change of a state value by
+ * more than epsilon. The envelope is only labelled as solved if the counter
+ * did not change during the check, i.e., if the envelope was
+ * epsilon-consistent at a single point in time. Otherwise, the labelling
+ * attempt is discarded and repeated by a later trial. Since every state value
+ * can only change finitely often by more than epsilon, some attempt
+ * eventually succeeds.
+ *
+ * Unlike LRTDP, the greedy policy is not stored. Ties between greedy
+ * transitions are broken in favour of the first one generated by the MDP.
+ *
+ * @tparam State - The state type of the MDP model.
+ * @tparam Action - The action type of the MDP model.
+ * @tparam UseInterval - Whether intervals or real values are used as state
+ * values.
+ */
+template <typename State, typename Action, bool UseInterval>
+class ParallelLRTDP : public MDPAlgorithm<State, Action> {
+    using Base = typename ParallelLRTDP::MDPAlgorithm;
+
+    using PolicyType = typename Base::PolicyType;
+    using MDPType = typename Base::MDPType;
+    using EvaluatorType = typename Base::EvaluatorType;
+
+    using AlgorithmValueType = AlgorithmValue<UseInterval>;
+
+    using StateEntry = internal::StateEntry<Action>;
+    using CachedTransition = internal::CachedTransition<Action>;
+
+    struct Worker {
+        utils::RandomNumberGenerator rng;
+        ThreadStatistics& statistics;
+
+        std::vector<StateID> current_trial;
+        std::vector<StateID> policy_queue;
+        std::vector<StateID> visited;
+        std::unordered_set<StateID> closed;
+
+        Worker(int seed, ThreadStatistics& statistics);
+    };
+
+    struct BellmanResult {
+        AlgorithmValueType value;
+        const CachedTransition* greedy;
+    };
+
+    // Algorithm parameters
+    const TrialTerminationCondition stop_consistent_;
+    const unsigned num_threads_;
+    const int random_seed_;
+
+    // Algorithm state
+    storage::ConcurrentPerStateStorage<StateEntry> state_entries_;
+    std::atomic<bool> stop_ = false;
+    std::atomic<unsigned long long> trials_ = 0;
+
+    // Incremented whenever a state value changes by more than epsilon.
+    std::atomic<unsigned long long> value_changes_ = 0;
+
+    // Guards the MDP, the heuristic and the members below.
+    std::mutex expansion_mutex_;
+    std::vector<Transition<Action>> transitions_;
+    std::vector<StateID> new_successors_;
+    std::vector<State> new_states_;
+    std::vector<value_t> new_estimates_;
+    std::vector<value_t> new_termination_costs_;
+
+    Statistics statistics_;
+
+public:
+    /**
+     * @brief Constructs a parallel LRTDP solver object.
+     *
+     * @param stop_consistent - The trial termination condition.
+     * @param num_threads - The number of workers. Zero uses one worker per
+     * hardware thread.
+     * @param random_seed - The seed of the random number generators of the
+     * workers. Worker i uses the seed random_seed + i.
+     */
+    ParallelLRTDP(
+        TrialTerminationCondition stop_consistent,
+        unsigned num_threads,
+        int random_seed);
+
+    std::unique_ptr<PolicyType> compute_policy(
+        MDPType& mdp,
+        EvaluatorType& heuristic,
+        param_type<State> state,
+        ProgressReport progress,
+        double max_time) override;
+
+    Interval solve(
+        MDPType& mdp,
+        EvaluatorType& heuristic,
+        param_type<State> state,
+        ProgressReport progress,
+        double max_time) override;
+
+    void print_statistics(std::ostream& out) const override;
+
+    [[nodiscard]]
+    Statistics get_statistics() const;
+
+private:
+    void run_worker(
+        MDPType& mdp,
+        EvaluatorType& heuristic,
+        StateID initial_state,
+        Worker& worker,
+        ProgressReport* progress,
+        utils::CountdownTimer& timer);
+
+    void trial(
+        MDPType& mdp,
+        EvaluatorType& heuristic,
+        StateID initial_state,
+        Worker& worker,
+        utils::CountdownTimer& timer);
+
+    bool check_and_solve(
+        MDPType& mdp,
+        EvaluatorType& heuristic,
+        StateID init_state_id,
+        Worker& worker,
+        utils::CountdownTimer& timer);
+
+    StateEntry& get_expanded_entry(
+        MDPType& mdp,
+        EvaluatorType& heuristic,
+        StateID state_id,
+        Worker& worker);
+
+    // Must be called with the expansion lock held.
+    void expand(
+        MDPType& mdp,
+        EvaluatorType& heuristic,
+        StateID state_id,
+        StateEntry& entry);
+
+    // Must be called with the expansion lock held.
+    void initialize_new_successors(MDPType& mdp, EvaluatorType& heuristic);
+
+    void set_initial_value(
+        StateEntry& entry,
+        value_t estimate,
+        value_t termination_cost);
+
+    BellmanResult compute_bellman(StateID state_id, const StateEntry& entry);
+
+    // Returns true if a bound changed by more than epsilon.
+    bool update_value(StateEntry& entry, const AlgorithmValueType& value);
+
+    AlgorithmValueType lookup_value(StateID state_id);
+
+    Interval lookup_bounds(StateID state_id);
+
+    StateID sample_successor(
+        const StateEntry& entry,
+        const CachedTransition& transition,
+        Worker& worker);
+};
+
+} // namespace probfd::algorithms::parallel_lrtdp
+
+#define GUARD_INCLUDE_PROBFD_ALGORITHMS_PARALLEL_LRTDP_H
+#include "probfd/algorithms/parallel_lrtdp_impl.h"
+#undef GUARD_INCLUDE_PROBFD_ALGORITHMS_PARALLEL_LRTDP_H
+
+#endif // PROBFD_ALGORITHMS_PARALLEL_LRTDP_H
@@ -0,0 +1,709 @@
+#ifndef GUARD_INCLUDE_PROBFD_ALGORITHMS_PARALLEL_LRTDP_H
+#error "This file should only be included from parallel_lrtdp.h"
+#endif
+
+#include "probfd/algorithms/utils.h"
+
+#include "probfd/policies/map_policy.h"
+
+#include "probfd/utils/thread_pool.h"
+
+#include "probfd/evaluator.h"
+#include "probfd/mdp.h"
+#include "probfd/transition.h"
+
+#include "downward/utils/countdown_timer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <deque>
+#include <ranges>
+
+namespace probfd::algorithms::parallel_lrtdp {
+
+inline void Statistics::print(std::ostream& out) const
+{
+    out << "  Initial state value estimation: " << initial_state_estimate
+        << std::endl;
+    out << "  Evaluated state(s): " << evaluated_states << std::endl;
+    out << "  Pruned state(s): " << pruned_states << std::endl;
+    out << "  Goal state(s): " << goal_states << std::endl;
+    out << "  Terminal state(s): " << terminal_states << std::endl;
+    out << "  Self-loop state(s): " << self_loop_states << std::endl;
+    out << "  Expanded state(s): " << expanded_states << std::endl;
+
+    ThreadStatistics total;
+    for (const ThreadStatistics& thread_stats : thread_statistics) {
+        total.trials += thread_stats.trials;
+        total.trial_bellman_backups += thread_stats.trial_bellman_backups;
+        total.check_and_solve_bellman_backups +=
+            thread_stats.check_and_solve_bellman_backups;
+        total.labelled_states += thread_stats.labelled_states;
+        total.inconclusive_labellings += thread_stats.inconclusive_labellings;
+    }
+
+    out << "  Trials: " << total.trials << std::endl;
+    out << "  Bellman backups (trials): " << total.trial_bellman_backups
+        << std::endl;
+    out << "  Bellman backups (check&solved): "
+        << total.check_and_solve_bellman_backups << std::endl;
+    out << "  Labelled state(s): " << total.labelled_states << std::endl;
+    out << "  Inconclusive labelling(s): " << total.inconclusive_labellings
+        << std::endl;
+
+    for (std::size_t i = 0; i != thread_statistics.size(); ++i) {
+        const ThreadStatistics& thread_stats = thread_statistics[i];
+        out << "  Thread " << i << ": " << thread_stats.trials
+            << " trial(s), "
+            << thread_stats.trial_bellman_backups +
+                   thread_stats.check_and_solve_bellman_backups
+            << " Bellman backup(s), " << thread_stats.labelled_states
+            << " labelled state(s), " << thread_stats.lock_wait_time
+            << "s waiting for expansions" << std::endl;
+    }
+}
+
+namespace internal {
+
+// Raises target to value and returns the previous value.
+inline value_t fetch_max(std::atomic<value_t>& target, value_t value)
+{
+    value_t old = target.load(std::memory_order_relaxed);
+    while (old < value &&
+           !target.compare_exchange_weak(
+               old,
+               value,
+               std::memory_order_relaxed)) {
+    }
+    return old;
+}
+
+// Lowers target to value and returns the previous value.
+inline value_t fetch_min(std::atomic<value_t>& target, value_t value)
+{
+    value_t old = target.load(std::memory_order_relaxed);
+    while (old > value &&
+           !target.compare_exchange_weak(
+               old,
+               value,
+               std::memory_order_relaxed)) {
+    }
+    return old;
+}
+
+} // namespace internal
+
+template <typename State, typename Action, bool UseInterval>
+ParallelLRTDP<State, Action, UseInterval>::Worker::Worker(
+    int seed,
+    ThreadStatistics& statistics)
+    : rng(seed)
+    , statistics(statistics)
+{
+}
+
+template <typename State, typename Action, bool UseInterval>
+ParallelLRTDP<State, Action, UseInterval>::ParallelLRTDP(
+    TrialTerminationCondition stop_consistent,
+    unsigned num_threads,
+    int random_seed)
+    : stop_consistent_(stop_consistent)
+    , num_threads_(resolve_num_threads(num_threads))
+    , random_seed_(random_seed)
+{
+}
+
+template <typename State, typename Action, bool UseInterval>
+auto ParallelLRTDP<State, Action, UseInterval>::compute_policy(
+    MDPType& mdp,
+    EvaluatorType& heuristic,
+    param_type<State> initial_state,
+    ProgressReport progress,
+    double max_time) -> std::unique_ptr<PolicyType>
+{
+    this->solve(mdp, heuristic, initial_state, progress, max_time);
+
+    using MapPolicy = policies::MapPolicy<State, Action>;
+    std::unique_ptr<MapPolicy> policy(new MapPolicy(&mdp));
+
+    const StateID initial_state_id = mdp.get_state_id(initial_state);
+
+    // All workers have finished, so the cached transitions of the greedy
+    // policy graph can be traversed without synchronization.
+    std::deque<StateID> queue;
+    std::unordered_set<StateID> visited;
+    queue.push_back(initial_state_id);
+    visited.insert(initial_state_id);
+
+    do {
+        const StateID state_id = queue.front();
+        queue.pop_front();
+
+        const StateEntry& entry = state_entries_[state_id];
+
+        if (!entry.has_flag(StateEntry::EXPANDED)) continue;
+
+        const BellmanResult result = compute_bellman(state_id, entry);
+
+        // Terminal states have no policy decision.
+        if (!result.greedy) continue;
+
+        policy->emplace_decision(
+            state_id,
+            result.greedy->action,
+            lookup_bounds(state_id));
+
+        for (unsigned i = result.greedy->successors_begin;
+             i != result.greedy->successors_end;
+             ++i) {
+            const StateID succ_id = entry.successors[i].state_id;
+            if (visited.insert(succ_id).second) {
+                queue.push_back(succ_id);
+            }
+        }
+    } while (!queue.empty());
+
+    return policy;
+}
+
+template <typename State, typename Action, bool UseInterval>
+Interval ParallelLRTDP<State, Action, UseInterval>::solve(
+    MDPType& mdp,
+    EvaluatorType& heuristic,
+    param_type<State> state,
+    ProgressReport progress,
+    double max_time)
+{
+    utils::CountdownTimer timer(max_time);
+
+    const StateID state_id = mdp.get_state_id(state);
+    StateEntry& entry = state_entries_[state_id];
+
+    if (!entry.has_flag(StateEntry::INITIALIZED)) {
+        new_successors_.push_back(state_id);
+        initialize_new_successors(mdp, heuristic);
+        statistics_.initial_state_estimate = as_lower_bound(
+            lookup_value(state_id));
+    }
+
+    progress.register_bound("v", [this, state_id]() {
+        return lookup_bounds(state_id);
+    });
+
+    progress.register_print([&](std::ostream& out) {
+        out << "trials=" << trials_.load(std::memory_order_relaxed);
+    });
+
+    statistics_.thread_statistics.assign(num_threads_, ThreadStatistics());
+    stop_ = false;
+
+    parallel_for(num_threads_, num_threads_, [&](std::size_t i) {
+        Worker worker(
+            random_seed_ + static_cast<int>(i),
+            statistics_.thread_statistics[i]);
+
+        // The progress report is not thread-safe, only the first worker
+        // prints it.
+        run_worker(
+            mdp,
+            heuristic,
+            state_id,
+            worker,
+            i == 0 ? &progress : nullptr,
+            timer);
+    });
+
+    return lookup_bounds(state_id);
+}
+
+template <typename State, typename Action, bool UseInterval>
+void ParallelLRTDP<State, Action, UseInterval>::print_statistics(
+    std::ostream& out) const
+{
+    out << "  Stored " << sizeof(StateEntry) << " bytes per state"
+        << std::endl;
+    out << "  Threads: " << num_threads_ << std::endl;
+    statistics_.print(out);
+}
+
+template <typename State, typename Action, bool UseInterval>
+Statistics ParallelLRTDP<State, Action, UseInterval>::get_statistics() const
+{
+    return statistics_;
+}
+
+template <typename State, typename Action, bool UseInterval>
+void ParallelLRTDP<State, Action, UseInterval>::run_worker(
+    MDPType& mdp,
+    EvaluatorType& heuristic,
+    StateID initial_state,
+    Worker& worker,
+    ProgressReport* progress,
+    utils::CountdownTimer& timer)
+{
+    const StateEntry& initial_entry = state_entries_[initial_state];
+
+    try {
+        while (!initial_entry.is_solved() &&
+               !stop_.load(std::memory_order_relaxed)) {
+            trial(mdp, heuristic, initial_state, worker, timer);
+            ++worker.statistics.trials;
+            trials_.fetch_add(1, std::memory_order_relaxed);
+            if (progress) progress->print();
+        }
+    } catch (...) {
+        // Let the other workers give up as well, e.g. if the time limit is
+        // exceeded.
+        stop_.store(true, std::memory_order_relaxed);
+        throw;
+    }
+}
+
+template <typename State, typename Action, bool UseInterval>
+void ParallelLRTDP<State, Action, UseInterval>::trial(
+    MDPType& mdp,
+    EvaluatorType& heuristic,
+    StateID initial_state,
+    Worker& worker,
+    utils::CountdownTimer& timer)
+{
+    using enum TrialTerminationCondition;
+
+    std::vector<StateID>& current_trial = worker.current_trial;
+
+    ClearGuard guard(current_trial);
+
+    current_trial.push_back(initial_state);
+
+    // The closed set records the states of the trial for REVISITED.
+    for (ClearGuard _(worker.closed);;) {
+        if (stop_.load(std::memory_order_relaxed)) return;
+        timer.throw_if_expired();
+
+        const StateID state_id = current_trial.back();
+        StateEntry& entry =
+            get_expanded_entry(mdp, heuristic, state_id, worker);
+
+        if (entry.is_solved()) {
+            current_trial.pop_back();
+            break;
+        }
+
+        ++worker.statistics.trial_bellman_backups;
+
+        const BellmanResult result = compute_bellman(state_id, entry);
+        const bool value_changed = update_value(entry, result.value);
+
+        if (!result.greedy) {
+            entry.set_flag(StateEntry::SOLVED);
+            current_trial.pop_back();
+            break;
+        }
+
+        if ((stop_consistent_ == CONSISTENT && !value_changed) ||
+            (stop_consistent_ == INCONSISTENT && value_changed) ||
+            (stop_consistent_ == REVISITED &&
+             !worker.closed.insert(state_id).second)) {
+            break;
+        }
+
+        current_trial.push_back(
+            sample_successor(entry, *result.greedy, worker));
+    }
+
+    while (!current_trial.empty()) {
+        if (stop_.load(std::memory_order_relaxed)) return;
+        timer.throw_if_expired();
+
+        if (!check_and_solve(
+                mdp,
+                heuristic,
+                current_trial.back(),
+                worker,
+                timer)) {
+            break;
+        }
+
+        current_trial.pop_back();
+    }
+}
+
+template <typename State, typename Action, bool UseInterval>
+bool ParallelLRTDP<State, Action, UseInterval>::check_and_solve(
+    MDPType& mdp,
+    EvaluatorType& heuristic,
+    StateID init_state_id,
+    Worker& worker,
+    utils::CountdownTimer& timer)
+{
+    std::vector<StateID>& policy_queue = worker.policy_queue;
+    auto& visited = worker.visited;
+    auto& closed = worker.closed;
+
+    ClearGuard guard(policy_queue, visited, closed);
+
+    if (state_entries_[init_state_id].is_solved()) return true;
+
+    // Value changes of other workers after this point invalidate the check.
+    const unsigned long long value_changes = value_changes_.load();
+
+    policy_queue.push_back(init_state_id);
+    closed.insert(init_state_id);
+
+    bool rv = true;
+
+    do {
+        timer.throw_if_expired();
+
+        const StateID state_id = policy_queue.back();
+        policy_queue.pop_back();
+
+        StateEntry& entry =
+            get_expanded_entry(mdp, heuristic, state_id, worker);
+
+        if (entry.is_solved()) continue;
+
+        ++worker.statistics.check_and_solve_bellman_backups;
+
+        const BellmanResult result = compute_bellman(state_id, entry);
+        const bool value_changed = update_value(entry, result.value);
+
+        visited.push_back(state_id);
+
+        if constexpr (UseInterval) {
+            if (!lookup_bounds(state_id).bounds_approximately_equal()) {
+                rv = false;
+                continue;
+            }
+        } else {
+            if (value_changed) {
+                rv = false;
+                continue;
+            }
+        }
+
+        if (!result.greedy) {
+            entry.set_flag(StateEntry::SOLVED);
+            continue;
+        }
+
+        for (unsigned i = result.greedy->successors_begin;
+             i != result.greedy->successors_end;
+             ++i) {
+            const StateID succ_id = entry.successors[i].state_id;
+            if (!state_entries_[succ_id].is_solved() &&
+                closed.insert(succ_id).second) {
+                policy_queue.push_back(succ_id);
+            }
+        }
+    } while (!policy_queue.empty());
+
+    if (rv && value_changes_.load() != value_changes) {
+        ++worker.statistics.inconclusive_labellings;
+        rv = false;
+    }
+
+    if (rv) {
+        for (const StateID state_id : visited) {
+            StateEntry& entry = state_entries_[state_id];
+            if (entry.is_solved()) continue;
+            entry.set_flag(StateEntry::SOLVED);
+            ++worker.statistics.labelled_states;
+        }
+    } else {
+        // Back up the states in reverse order of their visit.
+        for (const StateID state_id : visited | std::views::reverse) {
+            StateEntry& entry = state_entries_[state_id];
+            if (entry.is_solved()) continue;
+
+            ++worker.statistics.check_and_solve_bellman_backups;
+            update_value(entry, compute_bellman(state_id, entry).value);
+        }
+    }
+
+    return rv;
+}
+
+template <typename State, typename Action, bool UseInterval>
+auto ParallelLRTDP<State, Action, UseInterval>::get_expanded_entry(
+    MDPType& mdp,
+    EvaluatorType& heuristic,
+    StateID state_id,
+    Worker& worker) -> StateEntry&
+{
+    StateEntry& entry = state_entries_[state_id];
+
+    if (entry.has_flag(StateEntry::EXPANDED | StateEntry::TERMINAL)) {
+        return entry;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    std::lock_guard lock(expansion_mutex_);
+    worker.statistics.lock_wait_time +=
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+            .count();
+
+    // Another worker may have expanded the state while we were waiting.
+    if (!entry.has_flag(StateEntry::EXPANDED | StateEntry::TERMINAL)) {
+        expand(mdp, heuristic, state_id, entry);
+    }
+
+    return entry;
+}
+
+template <typename State, typename Action, bool UseInterval>
+void ParallelLRTDP<State, Action, UseInterval>::expand(
+    MDPType& mdp,
+    EvaluatorType& heuristic,
+    StateID state_id,
+    StateEntry& entry)
+{
+    assert(entry.has_flag(StateEntry::INITIALIZED));
+    assert(transitions_.empty());
+
+    ClearGuard _(transitions_);
+
+    ++statistics_.expanded_states;
+
+    const State state = mdp.get_state(state_id);
+    mdp.generate_all_transitions(state, transitions_);
+
+    for (const Transition<Action>& transition : transitions_) {
+        const auto successors_begin =
+            static_cast<unsigned>(entry.successors.size());
+
+        value_t loop_prob = 0_vt;
+
+        for (const auto& [succ_id, prob] : transition.successor_dist) {
+            if (succ_id == state_id) {
+                loop_prob += prob;
+                continue;
+            }
+
+            entry.successors.push_back(internal::Successor{succ_id, prob});
+
+            if (!state_entries_[succ_id].has_flag(StateEntry::INITIALIZED)) {
+                new_successors_.push_back(succ_id);
+            }
+        }
+
+        const auto successors_end =
+            static_cast<unsigned>(entry.successors.size());
+
+        // Drop pure self-loops, normalize the others. Repeating the action
+        // until the state is left costs cost / (1 - loop_prob) in
+        // expectation.
+        if (successors_begin == successors_end) continue;
+
+        value_t cost = mdp.get_action_cost(transition.action);
+
+        if (loop_prob != 0_vt) {
+            const value_t scale = 1_vt / (1_vt - loop_prob);
+            for (unsigned i = successors_begin; i != successors_end; ++i) {
+                entry.successors[i].probability *= scale;
+            }
+            cost *= scale;
+        }
+
+        entry.transitions.push_back(
+            {transition.action, cost, successors_begin, successors_end});
+    }
+
+    initialize_new_successors(mdp, heuristic);
+
+    if (entry.transitions.empty()) {
+        if (transitions_.empty()) {
+            ++statistics_.terminal_states;
+        } else {
+            ++statistics_.self_loop_states;
+        }
+
+        // This is a value change like any other, a labelling attempt which
+        // has already checked a predecessor is no longer valid.
+        update_value(entry, AlgorithmValueType(entry.termination_cost));
+        entry.set_flag(StateEntry::TERMINAL);
+        return;
+    }
+
+    entry.set_flag(StateEntry::EXPANDED);
+}
+
+template <typename State, typename Action, bool UseInterval>
+void ParallelLRTDP<State, Action, UseInterval>::initialize_new_successors(
+    MDPType& mdp,
+    EvaluatorType& heuristic)
+{
+    std::ranges::sort(new_successors_);
+    const auto duplicates = std::ranges::unique(new_successors_);
+    new_successors_.erase(duplicates.begin(), duplicates.end());
+
+    // Initialize goal states right away and keep the others for evaluation.
+    std::size_t num_evaluated = 0;
+
+    for (const StateID succ_id : new_successors_) {
+        State succ = mdp.get_state(succ_id);
+        const TerminationInfo term = mdp.get_termination_info(succ);
+
+        ++statistics_.evaluated_states;
+
+        StateEntry& entry = state_entries_[succ_id];
+        entry.termination_cost = term.get_cost();
+
+        if (term.is_goal_state()) {
+            ++statistics_.goal_states;
+            entry.lower.store(term.get_cost(), std::memory_order_relaxed);
+            entry.upper.store(term.get_cost(), std::memory_order_relaxed);
+            entry.set_flag(StateEntry::INITIALIZED | StateEntry::TERMINAL);
+            continue;
+        }
+
+        new_successors_[num_evaluated++] = succ_id;
+        new_states_.push_back(std::move(succ));
+        new_termination_costs_.push_back(term.get_cost());
+    }
+
+    new_successors_.resize(num_evaluated);
+    new_estimates_.resize(num_evaluated);
+
+    heuristic.evaluate_batch(new_states_, new_estimates_);
+
+    for (std::size_t i = 0; i != num_evaluated; ++i) {
+        set_initial_value(
+            state_entries_[new_successors_[i]],
+            new_estimates_[i],
+            new_termination_costs_[i]);
+    }
+
+    new_successors_.clear();
+    new_states_.clear();
+    new_estimates_.clear();
+    new_termination_costs_.clear();
+}
+
+template <typename State, typename Action, bool UseInterval>
+void ParallelLRTDP<State, Action, UseInterval>::set_initial_value(
+    StateEntry& entry,
+    value_t estimate,
+    value_t termination_cost)
+{
+    entry.lower.store(estimate, std::memory_order_relaxed);
+    entry.upper.store(termination_cost, std::memory_order_relaxed);
+
+    if (estimate == termination_cost) {
+        ++statistics_.pruned_states;
+        entry.set_flag(StateEntry::INITIALIZED | StateEntry::TERMINAL);
+    } else {
+        entry.set_flag(StateEntry::INITIALIZED);
+    }
+}
+
+template <typename State, typename Action, bool UseInterval>
+auto ParallelLRTDP<State, Action, UseInterval>::compute_bellman(
+    StateID,
+    const StateEntry& entry) -> BellmanResult
+{
+    assert(entry.has_flag(StateEntry::EXPANDED));
+
+    const value_t termination_cost = entry.termination_cost;
+
+    AlgorithmValueType best_value(termination_cost);
+    const CachedTransition* greedy = nullptr;
+    value_t greedy_lower = termination_cost;
+
+    for (const CachedTransition& transition : entry.transitions) {
+        AlgorithmValueType q(transition.cost);
+
+        for (unsigned i = transition.successors_begin;
+             i != transition.successors_end;
+             ++i) {
+            const internal::Successor& succ = entry.successors[i];
+            q += succ.probability * lookup_value(succ.state_id);
+        }
+
+        set_min(best_value, q);
+
+        // Ties are broken in favour of the first transition.
+        const value_t q_lower = as_lower_bound(q);
+        if (!greedy || q_lower < greedy_lower) {
+            greedy = &transition;
+            greedy_lower = q_lower;
+        }
+    }
+
+    if (as_lower_bound(best_value) == termination_cost) {
+        return {AlgorithmValueType(termination_cost), nullptr};
+    }
+
+    return {best_value, greedy};
+}
+
+template <typename State, typename Action, bool UseInterval>
+bool ParallelLRTDP<State, Action, UseInterval>::update_value(
+    StateEntry& entry,
+    const AlgorithmValueType& value)
+{
+    const value_t new_lower = as_lower_bound(value);
+    const value_t old_lower = internal::fetch_max(entry.lower, new_lower);
+
+    bool changed =
+        new_lower > old_lower && !is_approx_equal(old_lower, new_lower);
+
+    if constexpr (UseInterval) {
+        const value_t new_upper = value.upper;
+        const value_t old_upper = internal::fetch_min(entry.upper, new_upper);
+        changed = changed || (new_upper < old_upper &&
+                              !is_approx_equal(old_upper, new_upper));
+    }
+
+    if (changed) {
+        ++value_changes_;
+    }
+
+    return changed;
+}
+
+template <typename State, typename Action, bool UseInterval>
+auto ParallelLRTDP<State, Action, UseInterval>::lookup_value(StateID state_id)
+    -> AlgorithmValueType
+{
+    const StateEntry& entry = state_entries_[state_id];
+    if constexpr (UseInterval) {
+        return Interval(
+            entry.lower.load(std::memory_order_relaxed),
+            entry.upper.load(std::memory_order_relaxed));
+    } else {
+        return entry.lower.load(std::memory_order_relaxed);
+    }
+}
+
+template <typename State, typename Action, bool UseInterval>
+Interval ParallelLRTDP<State, Action, UseInterval>::lookup_bounds(
+    StateID state_id)
+{
+    if constexpr (UseInterval) {
+        return lookup_value(state_id);
+    } else {
+        return Interval(lookup_value(state_id), INFINITE_VALUE);
+    }
+}
+
+template <typename State, typename Action, bool UseInterval>
+StateID ParallelLRTDP<State, Action, UseInterval>::sample_successor(
+    const StateEntry& entry,
+    const CachedTransition& transition,
+    Worker& worker)
+{
+    value_t r = worker.rng.random();
+
+    for (unsigned i = transition.successors_begin;
+         i != transition.successors_end - 1;
+         ++i) {
+        r -= entry.successors[i].probability;
+        if (r < 0_vt) return entry.successors[i].state_id;
+    }
+
+    return entry.successors[transition.successors_end - 1].state_id;
+}
+
+} // namespace probfd::algorithms::parallel_lrtdp
@@ -0,0 +1,188 @@
+#ifndef PROBFD_ALGORITHMS_SCC_BELLMAN_MATRIX_H
+#define PROBFD_ALGORITHMS_SCC_BELLMAN_MATRIX_H
+
+#include "probfd/algorithms/utils.h"
+
+#include "probfd/value_type.h"
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace probfd::algorithms {
+
+/**
+ * @brief The Bellman equations of a strongly connected component in
+ * compressed sparse row layout.
+ *
+ * The states of the SCC are numbered densely in the order in which they are
+ * added. For every state, the matrix stores the precomputed minimum over the
+ * Q values of the actions leaving the SCC. For every remaining Q value, it
+ * stores the constant part and a row of successors, given by their local
+ * indices and transition probabilities in two contiguous arrays. The values
+ * of the states are kept in a dense vector during value iteration, so a
+ * Bellman backup reads consecutive memory except for the successor values,
+ * which all lie within the same small vector.
+ *
+ * A sweep performs the same arithmetic in the same order as a backup of the
+ * states through pointers to their successor values, so both yield
+ * bit-identical values.
+ *
+ * @tparam AlgorithmValueType - Either value_t or Interval.
+ */
+template <typename AlgorithmValueType>
+class SCCBellmanMatrix {
+    // Per state, in order of local indices.
+    std::vector<AlgorithmValueType> values_;
+    std::vector<AlgorithmValueType> state_conv_parts_;
+    std::vector<unsigned> state_q_ends_; // One past the last Q value.
+
+    // Per state. The index of the Q value that was minimal in the last
+    // backup, relative to the first Q value of the state, or -1 if the
+    // precomputed minimum of the leaving actions was.
+    std::vector<int> best_q_values_;
+
+    // Per Q value.
+    std::vector<AlgorithmValueType> q_conv_parts_;
+    std::vector<unsigned> q_successor_ends_; // One past the last successor.
+
+    // Per successor.
+    std::vector<unsigned> successors_;
+    std::vector<value_t> probabilities_;
+
+public:
+    /**
+     * @brief Removes all states, keeping the allocated memory.
+     */
+    void clear()
+    {
+        values_.clear();
+        state_conv_parts_.clear();
+        state_q_ends_.clear();
+        best_q_values_.clear();
+        q_conv_parts_.clear();
+        q_successor_ends_.clear();
+        successors_.clear();
+        probabilities_.clear();
+    }
+
+    /**
+     * @brief Adds a state with the given initial value and the given
+     * minimum over the Q values of actions leaving the SCC. Returns its
+     * local index.
+     */
+    unsigned add_state(AlgorithmValueType value, AlgorithmValueType conv_part)
+    {
+        const auto index = static_cast<unsigned>(values_.size());
+        values_.push_back(value);
+        state_conv_parts_.push_back(conv_part);
+        state_q_ends_.push_back(static_cast<unsigned>(q_conv_parts_.size()));
+        best_q_values_.push_back(-1);
+        return index;
+    }
+
+    /**
+     * @brief Adds a Q value with the given constant part to the last state.
+     */
+    void add_q_value(AlgorithmValueType conv_part)
+    {
+        assert(!values_.empty());
+        q_conv_parts_.push_back(conv_part);
+        q_successor_ends_.push_back(
+            static_cast<unsigned>(successors_.size()));
+        ++state_q_ends_.back();
+    }
+
+    /**
+     * @brief Adds the successor with the given local index to the last Q
+     * value.
+     */
+    void add_successor(unsigned index, value_t probability)
+    {
+        assert(!q_conv_parts_.empty());
+        successors_.push_back(index);
+        probabilities_.push_back(probability);
+        ++q_successor_ends_.back();
+    }
+
+    [[nodiscard]]
+    std::size_t num_states() const
+    {
+        return values_.size();
+    }
+
+    [[nodiscard]]
+    const AlgorithmValueType& get_value(unsigned index) const
+    {
+        return values_[index];
+    }
+
+    /**
+     * @brief Returns the index of the Q value of the state that was minimal
+     * in its last backup, relative to the first Q value of the state, or -1
+     * if none of them was smaller than the minimum of the actions leaving
+     * the SCC.
+     */
+    [[nodiscard]]
+    int get_best_q_value(unsigned index) const
+    {
+        return best_q_values_[index];
+    }
+
+    /**
+     * @brief Backs up all states in order of their local indices.
+     *
+     * The callable \p update_value is called with a reference to the
+     * current value of the state and its new value. It must assign the new
+     * value and return whether the state has not converged yet. Returns
+     * true if all states have converged.
+     */
+    template <typename UpdateFunction>
+    bool sweep(UpdateFunction update_value)
+    {
+        bool converged = true;
+
+        const auto num_states = static_cast<unsigned>(values_.size());
+
+        unsigned q = 0;
+        unsigned k = 0;
+
+        for (unsigned i = 0; i != num_states; ++i) {
+            AlgorithmValueType v = state_conv_parts_[i];
+            int best = -1;
+
+            const unsigned first_q = q;
+
+            for (const unsigned q_end = state_q_ends_[i]; q != q_end; ++q) {
+                AlgorithmValueType res = q_conv_parts_[q];
+
+                for (const unsigned k_end = q_successor_ends_[q]; k != k_end;
+                     ++k) {
+                    res += probabilities_[k] * values_[successors_[k]];
+                }
+
+                // Same as set_min, but inlined for plain values.
+                bool improved;
+                if constexpr (std::is_same_v<AlgorithmValueType, value_t>) {
+                    improved = res < v;
+                    if (improved) v = res;
+                } else {
+                    improved = set_min(v, res);
+                }
+
+                if (improved) best = static_cast<int>(q - first_q);
+            }
+
+            best_q_values_[i] = best;
+
+            if (update_value(values_[i], v)) converged = false;
+        }
+
+        return converged;
+    }
+};
+
+} // namespace probfd::algorithms
+
+#endif // PROBFD_ALGORITHMS_SCC_BELLMAN_MATRIX_H
@@ -12,6 +12,7 @@
 
 #include <deque>
 #include <limits>
+#include <memory_resource>
 #include <ostream>
 #include <set>
 #include <vector>
@@ -100,9 +101,6 @@ class TATopologicalValueIteration : public MDPAlgorithm<State, Action> {
         // Pointers to successor values which have not yet converged,
         // self-loops excluded.
         std::vector<ItemProbabilityPair<StateID>> scc_successors;
-
-        template <typename ValueStore>
-        AlgorithmValueType compute_q_value(ValueStore& value_store) const;
     };
 
     struct ExplorationInfo {
@@ -275,7 +273,13 @@ class TATopologicalValueIteration : public MDPAlgorithm<State, Action> {
         }
     };
 
-    storage::PerStateStorage<StateInfo> state_information_;
+    // Memory of the state information and the value table of solve().
+    std::pmr::memory_resource* per_state_memory_ =
+        std::pmr::get_default_resource();
+
+    storage::PolymorphicPerStateStorage<StateInfo> state_information_{
+        StateInfo(),
+        per_state_memory_};
     std::vector<ExplorationInfo> exploration_stack_;
     std::deque<StackInfo> stack_;
 
@@ -290,6 +294,16 @@ class TATopologicalValueIteration : public MDPAlgorithm<State, Action> {
 public:
     TATopologicalValueIteration() = default;
 
+    /**
+     * @brief Allocates the per-state information and values from the given
+     * memory resource, e.g. to keep them in a file on disk.
+     */
+    explicit TATopologicalValueIteration(
+        std::pmr::memory_resource* per_state_memory)
+        : per_state_memory_(per_state_memory)
+    {
+    }
+
     explicit TATopologicalValueIteration(std::size_t num_states_hint)
     {
         exploration_stack_.reserve(num_states_hint);
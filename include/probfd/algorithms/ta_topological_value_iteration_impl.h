@@ -2,6 +2,7 @@
 #error "This file should only be included from ta_topological_value_iteration.h"
 #endif
 
+#include "probfd/algorithms/scc_bellman_matrix.h"
 #include "probfd/algorithms/utils.h"
 
 #include "probfd/utils/guards.h"
@@ -15,6 +16,7 @@
 #include "downward/utils/countdown_timer.h"
 
 #include <type_traits>
+#include <unordered_map>
 
 namespace probfd::algorithms::ta_topological_vi {
 
@@ -165,20 +167,6 @@ TATopologicalValueIteration<State, Action, UseInterval>::ExplorationInfo::
     return *successor;
 }
 
-template <typename State, typename Action, bool UseInterval>
-template <typename ValueStore>
-auto TATopologicalValueIteration<State, Action, UseInterval>::QValueInfo::
-    compute_q_value(ValueStore& value_store) const -> AlgorithmValueType
-{
-    AlgorithmValueType res = conv_part;
-
-    for (auto& [state_id, prob] : scc_successors) {
-        res += prob * value_store[state_id];
-    }
-
-    return res;
-}
-
 template <typename State, typename Action, bool UseInterval>
 TATopologicalValueIteration<State, Action, UseInterval>::StackInfo::StackInfo(
     StateID state_id,
@@ -274,7 +262,9 @@ Interval TATopologicalValueIteration<State, Action, UseInterval>::solve(
     ProgressReport,
     double max_time)
 {
-    storage::PerStateStorage<AlgorithmValueType> value_store;
+    storage::PolymorphicPerStateStorage<AlgorithmValueType> value_store(
+        AlgorithmValueType(),
+        per_state_memory_);
     return this
         ->solve(mdp, heuristic, mdp.get_state_id(state), value_store, max_time);
 }
@@ -834,48 +824,60 @@ void TATopologicalValueIteration<State, Action, UseInterval>::scc_found(
     {
         TimerScope _(statistics_.vi_timer);
 
-        struct VIInfo {
-            AlgorithmValueType* value;
-            AlgorithmValueType conv_part;
-            std::vector<QValueInfo> transitions;
-        };
-
-        std::vector<VIInfo> table;
-        table.reserve(scc.size());
-
-        for (auto it = scc.begin(); it != scc.end(); ++it) {
-            auto& t = table.emplace_back(it->value, it->conv_part);
-            auto& tr = it->non_ec_transitions;
-            t.transitions.reserve(tr.size());
-            for (auto it2 = tr.begin(); it2 != tr.end();) {
-                t.transitions.push_back(std::move(tr.extract(it2++).value()));
+        // Lay out the SCC as a sparse matrix over a dense value vector.
+        SCCBellmanMatrix<AlgorithmValueType> matrix;
+
+        {
+            std::unordered_map<StateID, unsigned> indices;
+            indices.reserve(scc.size());
+
+            unsigned next_index = 0;
+            for (const StackInfo& stk_info : scc) {
+                indices.emplace(stk_info.state_id, next_index++);
+            }
+
+            for (StackInfo& stk_info : scc) {
+                matrix.add_state(*stk_info.value, stk_info.conv_part);
+
+                auto& tr = stk_info.non_ec_transitions;
+                for (const QValueInfo& info : tr) {
+                    matrix.add_q_value(info.conv_part);
+                    for (const auto& [state_id, prob] : info.scc_successors) {
+                        const auto it = indices.find(state_id);
+                        assert(it != indices.end());
+                        matrix.add_successor(it->second, prob);
+                    }
+                }
+
+                // Free memory
+                std::decay_t<decltype(tr)>().swap(tr);
             }
         }
 
+        // Write the values back, also if the time limit is reached.
+        scope_exit write_back([&] {
+            unsigned i = 0;
+            for (StackInfo& stk_info : scc) {
+                *stk_info.value = matrix.get_value(i++);
+            }
+        });
+
         bool converged;
 
         do {
             timer.throw_if_expired();
 
-            converged = true;
-            auto it = table.begin();
-
-            do {
-                AlgorithmValueType v = it->conv_part;
-
-                for (const QValueInfo& info : it->transitions) {
-                    set_min(v, info.compute_q_value(value_store));
-                }
-
+            converged = matrix.sweep([](AlgorithmValueType& value,
+                                        AlgorithmValueType new_value) {
                 if constexpr (UseInterval) {
-                    update(*it->value, v);
-                    if (!it->value->bounds_equal()) converged = false;
+                    update(value, new_value);
+                    return !value.bounds_equal();
                 } else {
-                    if (update(*it->value, v)) converged = false;
+                    return update(value, new_value);
                 }
+            });
 
-                ++statistics_.bellman_backups;
-            } while (++it != table.end());
+            statistics_.bellman_backups += scc.size();
         } while (!converged);
     }
 
@@ -8,9 +8,11 @@
 #include "probfd/distribution.h"
 #include "probfd/mdp_algorithm.h"
 
+#include <atomic>
 #include <deque>
 #include <limits>
 #include <ostream>
+#include <utility>
 #include <vector>
 
 // Forward Declarations
@@ -18,6 +20,10 @@ namespace utils {
 class CountdownTimer;
 }
 
+namespace probfd {
+class ThreadPool;
+}
+
 namespace probfd::policies {
 template <typename, typename>
 class MapPolicy;
@@ -26,6 +32,42 @@ class MapPolicy;
 /// Namespace dedicated to Topological Value Iteration (TVI).
 namespace probfd::algorithms::topological_vi {
 
+/**
+ * @brief The order in which the states of a non-singleton SCC are backed up.
+ */
+enum class SCCUpdateOrder {
+    /// Sweep over the states in stack order until a sweep changes no value.
+    ROUND_ROBIN,
+
+    /// Sweep over the states in reverse stack order, i.e., states closer to
+    /// the exits of the SCC first. States none of whose successors changed
+    /// since their last backup are skipped.
+    BACKWARD_GAUSS_SEIDEL,
+
+    /// Back up the state whose successors changed the most first, using a
+    /// priority queue. A backward sweep over the states with changed
+    /// successors confirms convergence once the queue runs empty.
+    PRIORITIZED_SWEEPING
+};
+
+/**
+ * @brief Statistics of a single worker thread of the parallel mode.
+ */
+struct ThreadStatistics {
+    unsigned long long sccs = 0;
+    unsigned long long singleton_sccs = 0;
+    unsigned long long bellman_backups = 0;
+    unsigned long long saved_backups = 0;
+
+    // Wall-clock seconds spent solving SCCs.
+    double vi_time = 0.0;
+
+    // Interval mode only. The part of vi_time spent in the separate sweeps
+    // of the lower and upper bounds.
+    double lower_bound_time = 0.0;
+    double upper_bound_time = 0.0;
+};
+
 /**
  * @brief Topological value iteration statistics.
  */
@@ -38,6 +80,21 @@ struct Statistics {
     unsigned long long bellman_backups = 0;
     unsigned long long pruned = 0;
 
+    // Backups skipped by the non-default SCC update orders since no
+    // successor value of the state changed since its last backup.
+    unsigned long long saved_backups = 0;
+
+    // Wall-clock seconds of the exploration. In serial mode, this includes
+    // value iteration.
+    double exploration_time = 0.0;
+
+    // Parallel mode only. Wall-clock seconds spent solving the condensation
+    // DAG.
+    double solve_time = 0.0;
+
+    // Only filled in parallel mode, one entry per worker thread.
+    std::vector<ThreadStatistics> thread_statistics;
+
     void print(std::ostream& out) const;
 };
 
@@ -57,6 +114,31 @@ struct Statistics {
  * this algorithm must be used, which eliminates as traps on-the-fly to
  * guarantee convergence.
  *
+ * If more than one thread is requested, the algorithm runs in two phases.
+ * First, the reachable state space is explored and its SCCs are collected
+ * with Tarjan's algorithm as usual, but all arithmetic depending on the
+ * values of other SCCs is deferred. Afterwards, the SCC condensation DAG is
+ * solved bottom-up on a work-stealing thread pool, where an SCC is scheduled
+ * as soon as all of its successor SCCs have converged. Since the deferred
+ * arithmetic is replayed in exploration order, the resulting values are
+ * bit-identical to the ones computed by the serial algorithm.
+ *
+ * With value intervals, the parallel mode additionally iterates the lower
+ * and the upper bounds of a non-singleton SCC concurrently, each until it
+ * changes by at most epsilon. The bounds only depend on the same bound of
+ * other states, so the two sweeps write disjoint memory. Afterwards, the
+ * usual joint iteration runs until both bounds are epsilon-close, which
+ * often takes a single sweep. The values then satisfy the same guarantee
+ * as the serial ones, but are not bit-identical to them.
+ *
+ * By default, the states of an SCC are backed up round-robin until no value
+ * changes. Alternatively, the SCC can be iterated in backward Gauss-Seidel
+ * order or by prioritized sweeping (see SCCUpdateOrder). Both only back up
+ * states whose successor values have changed since their last backup, for
+ * which they build the predecessor relation of the SCC once it is entered.
+ * They use the same convergence test as the default order, but yield
+ * different values within epsilon.
+ *
  * @see interval_iteration::IntervalIteration
  * @see ta_topological_value_iteration::TATopologicalValueIteration
  *
@@ -96,11 +178,27 @@ class TopologicalValueIteration : public MDPAlgorithm<State, Action> {
         // self-loops excluded.
         std::vector<ItemProbabilityPair<AlgorithmValueType*>> nconv_successors;
 
+        // Parallel mode only. Pointers to successor values which have
+        // converged, i.e., belong to a child SCC. Their contribution to
+        // conv_part is added once the child SCCs are solved.
+        std::vector<ItemProbabilityPair<AlgorithmValueType*>> conv_successors;
+
+        // Parallel mode only. The self-loop probability whose normalization
+        // is still to be applied to conv_part.
+        value_t self_loop_prob = 0_vt;
+
         QValueInfo(Action action, value_t action_cost);
 
-        bool finalize_transition(value_t self_loop_prob);
+        bool finalize_transition(value_t self_loop_prob, bool defer);
+
+        void resolve_deferred();
 
         AlgorithmValueType compute_q_value() const;
+
+        // Interval mode only. Computes the lower or upper bound of the Q
+        // value, reading only that bound of the successor values.
+        template <bool Upper>
+        value_t compute_q_value_bound() const;
     };
 
     struct StackInfo {
@@ -122,9 +220,62 @@ class TopologicalValueIteration : public MDPAlgorithm<State, Action> {
         // The optimal action among those leaving the SCC.
         std::optional<Action> best_converged = std::nullopt;
 
+        // Parallel mode only. Q values of actions leaving the SCC, in the
+        // order in which they would have been folded into conv_part.
+        std::vector<QValueInfo> conv_qs;
+
+        // Parallel mode only. Indices of the child SCCs of this state.
+        std::vector<unsigned> successor_sccs;
+
         StackInfo(StateID state_id, AlgorithmValueType& value_ref);
 
+        void resolve_deferred();
+
         bool update_value();
+
+        // Interval mode only. Updates either bound of the state value.
+        // Returns true if it changed by more than epsilon.
+        template <bool Upper>
+        bool update_value_bound();
+    };
+
+    // Bookkeeping of the non-default SCC update orders for a single SCC.
+    struct SCCBackupTracker {
+        // For each state, the SCC states with a transition to it, together
+        // with the maximal probability of such a transition.
+        std::vector<std::vector<std::pair<unsigned, value_t>>> predecessors;
+
+        // Whether a successor value changed since the last backup.
+        std::vector<bool> dirty;
+
+        // Whether the last backup reported non-convergence.
+        std::vector<bool> unconverged;
+
+        explicit SCCBackupTracker(auto& scc);
+
+        // Backs up the state with the given index, marks its predecessors
+        // dirty if its value changed and returns the absolute change.
+        value_t backup(auto& scc, unsigned index, auto& statistics);
+
+        // Backs up all dirty states in reverse stack order. Returns true if
+        // all states have converged.
+        bool sweep(auto& scc, auto& statistics);
+    };
+
+    // A node of the SCC condensation DAG built in parallel mode.
+    struct SCCInfo {
+        std::vector<StackInfo> states;
+
+        // SCCs that have a transition into this SCC.
+        std::vector<unsigned> parents;
+
+        // Number of child SCCs that have not converged yet.
+        std::atomic<unsigned> pending_children = 0;
+
+        // Interval mode only. Number of bound sweeps still running.
+        std::atomic<unsigned> pending_bounds = 0;
+
+        explicit SCCInfo(std::vector<StackInfo> states);
     };
 
     struct ExplorationInfo {
@@ -151,7 +302,7 @@ class TopologicalValueIteration : public MDPAlgorithm<State, Action> {
         void update_lowlink(unsigned upd);
 
         bool next_transition(MDPType& mdp);
-        bool next_successor();
+        bool next_successor(bool defer);
 
         bool forward_non_loop_transition(MDPType& mdp, const State& state);
         bool forward_non_loop_successor();
@@ -164,16 +315,33 @@ class TopologicalValueIteration : public MDPAlgorithm<State, Action> {
 
     // Algorithm parameters
     const bool expand_goals_;
+    const unsigned num_threads_;
+    const SCCUpdateOrder update_order_;
 
     // Algorithm state
     storage::PerStateStorage<StateInfo> state_information_;
     std::deque<ExplorationInfo> exploration_stack_;
-    std::vector<StackInfo> stack_;
+    std::deque<StackInfo> stack_;
+
+    // Parallel mode only. The SCCs in reverse topological order.
+    std::deque<SCCInfo> sccs_;
 
     Statistics statistics_;
 
 public:
-    explicit TopologicalValueIteration(bool expand_goals);
+    /**
+     * @brief Constructs the algorithm.
+     *
+     * @param expand_goals - Whether goal states are expanded.
+     * @param num_threads - The number of threads used to solve independent
+     * SCCs concurrently. Values greater than one enable the parallel mode.
+     * @param update_order - The order in which the states of an SCC are
+     * backed up.
+     */
+    explicit TopologicalValueIteration(
+        bool expand_goals,
+        unsigned num_threads = 1,
+        SCCUpdateOrder update_order = SCCUpdateOrder::ROUND_ROBIN);
 
     std::unique_ptr<PolicyType> compute_policy(
         MDPType& mdp,
@@ -251,9 +419,75 @@ private:
         utils::CountdownTimer& timer);
 
     /**
-     * Handle the new SCC and perform value iteration on it.
+     * Handle the new SCC and perform value iteration on it. In parallel
+     * mode, the SCC is only added to the condensation DAG instead.
      */
     void scc_found(auto scc, MapPolicy* policy, utils::CountdownTimer& timer);
+
+    /**
+     * Performs value iteration on an SCC whose successor SCCs have all
+     * converged.
+     */
+    void solve_scc(auto& scc, auto& statistics, utils::CountdownTimer& timer)
+        const;
+
+    /**
+     * Performs value iteration on a non-singleton SCC in backward
+     * Gauss-Seidel order.
+     */
+    static void solve_scc_backward(
+        auto& scc,
+        auto& statistics,
+        utils::CountdownTimer& timer);
+
+    /**
+     * Performs value iteration on a non-singleton SCC by prioritized
+     * sweeping.
+     */
+    static void solve_scc_prioritized(
+        auto& scc,
+        auto& statistics,
+        utils::CountdownTimer& timer);
+
+    /**
+     * Adds the SCC to the condensation DAG and registers it as a parent of
+     * all of its child SCCs.
+     */
+    void add_scc_to_dag(auto scc);
+
+    /**
+     * Solves the collected condensation DAG in parallel.
+     */
+    void solve_dag(MapPolicy* policy, utils::CountdownTimer& timer);
+
+    /**
+     * Solves the SCC with the given index and schedules all parent SCCs
+     * that become ready afterwards.
+     */
+    void solve_dag_node(
+        ThreadPool& pool,
+        unsigned scc_index,
+        utils::CountdownTimer& timer);
+
+    /**
+     * Interval mode only. Iterates one bound of the SCC with the given
+     * index. The sweep finishing last solves the SCC jointly and completes
+     * the node.
+     */
+    template <bool Upper>
+    void sweep_dag_node_bound(
+        ThreadPool& pool,
+        unsigned scc_index,
+        utils::CountdownTimer& timer);
+
+    /**
+     * Schedules all parent SCCs of the solved SCC with the given index that
+     * become ready.
+     */
+    void finish_dag_node(
+        ThreadPool& pool,
+        unsigned scc_index,
+        utils::CountdownTimer& timer);
 };
 
 } // namespace probfd::algorithms::topological_vi
@@ -2,16 +2,25 @@
 #error "This file should only be included from topological_value_iteration.h"
 #endif
 
+#include "probfd/algorithms/scc_bellman_matrix.h"
 #include "probfd/algorithms/utils.h"
 
 #include "probfd/policies/map_policy.h"
 
+#include "probfd/utils/guards.h"
+#include "probfd/utils/thread_pool.h"
+
 #include "probfd/evaluator.h"
 #include "probfd/progress_report.h"
 
+#include "downward/algorithms/priority_queues.h"
 #include "downward/utils/countdown_timer.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <type_traits>
+#include <unordered_map>
 
 namespace probfd::algorithms::topological_vi {
 
@@ -24,6 +33,31 @@ inline void Statistics::print(std::ostream& out) const
     out << "  Maximal SCCs: " << sccs << " (" << singleton_sccs
         << " are singleton)" << std::endl;
     out << "  Bellman backups: " << bellman_backups << std::endl;
+    if (saved_backups != 0) {
+        out << "  Saved Bellman backups: " << saved_backups << std::endl;
+    }
+    out << "  Exploration time: " << exploration_time << "s" << std::endl;
+
+    if (thread_statistics.empty()) return;
+
+    out << "  Parallel solving time: " << solve_time << "s" << std::endl;
+
+    for (std::size_t i = 0; i != thread_statistics.size(); ++i) {
+        const ThreadStatistics& thread_stats = thread_statistics[i];
+        out << "  Thread " << i << ": " << thread_stats.sccs << " SCC(s) ("
+            << thread_stats.singleton_sccs << " singleton), "
+            << thread_stats.bellman_backups << " Bellman backup(s), "
+            << thread_stats.saved_backups << " saved, "
+            << thread_stats.vi_time << "s in VI";
+
+        if (thread_stats.lower_bound_time != 0.0 ||
+            thread_stats.upper_bound_time != 0.0) {
+            out << " (" << thread_stats.lower_bound_time << "s lower bound, "
+                << thread_stats.upper_bound_time << "s upper bound)";
+        }
+
+        out << std::endl;
+    }
 }
 
 template <typename State, typename Action, bool UseInterval>
@@ -58,15 +92,18 @@ bool TopologicalValueIteration<State, Action, UseInterval>::ExplorationInfo::
 
 template <typename State, typename Action, bool UseInterval>
 bool TopologicalValueIteration<State, Action, UseInterval>::ExplorationInfo::
-    next_successor()
+    next_successor(bool defer)
 {
-    ++successor;
-    if (forward_non_loop_successor()) return true;
+    if (++successor != transition.end() && forward_non_loop_successor()) {
+        return true;
+    }
 
     auto& tinfo = stack_info.nconv_qs.back();
 
-    if (tinfo.finalize_transition(self_loop_prob)) {
-        if (set_min(stack_info.conv_part, tinfo.conv_part)) {
+    if (tinfo.finalize_transition(self_loop_prob, defer)) {
+        if (defer) {
+            stack_info.conv_qs.push_back(std::move(tinfo));
+        } else if (set_min(stack_info.conv_part, tinfo.conv_part)) {
             stack_info.best_converged = tinfo.action;
         }
         stack_info.nconv_qs.pop_back();
@@ -138,13 +175,18 @@ TopologicalValueIteration<State, Action, UseInterval>::QValueInfo::QValueInfo(
 
 template <typename State, typename Action, bool UseInterval>
 bool TopologicalValueIteration<State, Action, UseInterval>::QValueInfo::
-    finalize_transition(value_t self_loop_prob)
+    finalize_transition(value_t self_loop_prob, bool defer)
 {
     if (self_loop_prob != 0_vt) {
         // Apply self-loop normalization
         const value_t normalization = 1_vt / (1_vt - self_loop_prob);
 
-        conv_part *= normalization;
+        // The converged part is incomplete when deferring, normalize later.
+        if (defer) {
+            this->self_loop_prob = self_loop_prob;
+        } else {
+            conv_part *= normalization;
+        }
 
         for (auto& pair : nconv_successors) {
             pair.probability *= normalization;
@@ -154,6 +196,24 @@ bool TopologicalValueIteration<State, Action, UseInterval>::QValueInfo::
     return nconv_successors.empty();
 }
 
+template <typename State, typename Action, bool UseInterval>
+void TopologicalValueIteration<State, Action, UseInterval>::QValueInfo::
+    resolve_deferred()
+{
+    // Same order of operations as in the serial exploration.
+    for (auto& [value, prob] : conv_successors) {
+        conv_part += prob * (*value);
+    }
+
+    if (self_loop_prob != 0_vt) {
+        const value_t normalization = 1_vt / (1_vt - self_loop_prob);
+        conv_part *= normalization;
+    }
+
+    std::vector<ItemProbabilityPair<AlgorithmValueType*>>().swap(
+        conv_successors);
+}
+
 template <typename State, typename Action, bool UseInterval>
 auto TopologicalValueIteration<State, Action, UseInterval>::QValueInfo::
     compute_q_value() const -> AlgorithmValueType
@@ -167,6 +227,22 @@ auto TopologicalValueIteration<State, Action, UseInterval>::QValueInfo::
     return res;
 }
 
+template <typename State, typename Action, bool UseInterval>
+template <bool Upper>
+value_t TopologicalValueIteration<State, Action, UseInterval>::QValueInfo::
+    compute_q_value_bound() const
+{
+    static_assert(UseInterval);
+
+    value_t res = Upper ? conv_part.upper : conv_part.lower;
+
+    for (auto& [value, prob] : nconv_successors) {
+        res += prob * (Upper ? value->upper : value->lower);
+    }
+
+    return res;
+}
+
 template <typename State, typename Action, bool UseInterval>
 TopologicalValueIteration<State, Action, UseInterval>::StackInfo::StackInfo(
     StateID state_id,
@@ -176,6 +252,31 @@ TopologicalValueIteration<State, Action, UseInterval>::StackInfo::StackInfo(
 {
 }
 
+template <typename State, typename Action, bool UseInterval>
+void TopologicalValueIteration<State, Action, UseInterval>::StackInfo::
+    resolve_deferred()
+{
+    for (QValueInfo& info : conv_qs) {
+        info.resolve_deferred();
+        if (set_min(conv_part, info.conv_part)) {
+            best_converged = info.action;
+        }
+    }
+
+    std::vector<QValueInfo>().swap(conv_qs);
+
+    for (QValueInfo& info : nconv_qs) {
+        info.resolve_deferred();
+    }
+}
+
+template <typename State, typename Action, bool UseInterval>
+TopologicalValueIteration<State, Action, UseInterval>::SCCInfo::SCCInfo(
+    std::vector<StackInfo> states)
+    : states(std::move(states))
+{
+}
+
 template <typename State, typename Action, bool UseInterval>
 bool TopologicalValueIteration<State, Action, UseInterval>::StackInfo::
     update_value()
@@ -197,10 +298,40 @@ bool TopologicalValueIteration<State, Action, UseInterval>::StackInfo::
     }
 }
 
+template <typename State, typename Action, bool UseInterval>
+template <bool Upper>
+bool TopologicalValueIteration<State, Action, UseInterval>::StackInfo::
+    update_value_bound()
+{
+    static_assert(UseInterval);
+
+    value_t v = Upper ? conv_part.upper : conv_part.lower;
+
+    for (const QValueInfo& info : nconv_qs) {
+        v = std::min(v, info.template compute_q_value_bound<Upper>());
+    }
+
+    // Same monotonic update of the bound as in update(Interval&, Interval).
+    if constexpr (Upper) {
+        const bool changed = is_approx_less(v, value->upper);
+        value->upper = std::min(value->upper, v);
+        return changed;
+    } else {
+        const bool changed = is_approx_greater(v, value->lower);
+        value->lower = std::max(value->lower, v);
+        return changed;
+    }
+}
+
 template <typename State, typename Action, bool UseInterval>
 TopologicalValueIteration<State, Action, UseInterval>::
-    TopologicalValueIteration(bool expand_goals)
+    TopologicalValueIteration(
+        bool expand_goals,
+        unsigned num_threads,
+        SCCUpdateOrder update_order)
     : expand_goals_(expand_goals)
+    , num_threads_(num_threads)
+    , update_order_(update_order)
 {
 }
 
@@ -263,6 +394,26 @@ Interval TopologicalValueIteration<State, Action, UseInterval>::solve(
 {
     utils::CountdownTimer timer(max_time);
 
+    // If the time limit is reached, drop the partial exploration so that the
+    // next call starts afresh. Unsolved states are explored again.
+    scope_exit _([this] {
+        for (const StackInfo& stk_info : stack_) {
+            state_information_[stk_info.state_id].status = StateInfo::NEW;
+        }
+
+        for (const SCCInfo& info : sccs_) {
+            for (const StackInfo& stk_info : info.states) {
+                state_information_[stk_info.state_id].status = StateInfo::NEW;
+            }
+        }
+
+        exploration_stack_.clear();
+        stack_.clear();
+        sccs_.clear();
+    });
+
+    const auto start = std::chrono::steady_clock::now();
+
     StateInfo& iinfo = state_information_[init_state_id];
     AlgorithmValueType& init_value = value_store[init_state_id];
 
@@ -289,6 +440,19 @@ Interval TopologicalValueIteration<State, Action, UseInterval>::solve(
             exploration_stack_.pop_back();
 
             if (exploration_stack_.empty()) {
+                const auto explored = std::chrono::steady_clock::now();
+                statistics_.exploration_time +=
+                    std::chrono::duration<double>(explored - start).count();
+
+                if (num_threads_ > 1) {
+                    solve_dag(policy, timer);
+                    sccs_.clear();
+                    statistics_.solve_time +=
+                        std::chrono::duration<double>(
+                            std::chrono::steady_clock::now() - explored)
+                            .count();
+                }
+
                 if constexpr (UseInterval) {
                     return init_value;
                 } else {
@@ -304,15 +468,19 @@ Interval TopologicalValueIteration<State, Action, UseInterval>::solve(
             AlgorithmValueType& s_value = value_store[succ_id];
             QValueInfo& tinfo = explore->stack_info.nconv_qs.back();
 
-            if (backtrack_from_scc) {
-                tinfo.conv_part += prob * s_value;
-            } else {
+            if (!backtrack_from_scc) {
                 explore->update_lowlink(lowlink);
                 tinfo.nconv_successors.emplace_back(&s_value, prob);
+            } else if (num_threads_ > 1) {
+                tinfo.conv_successors.emplace_back(&s_value, prob);
+                explore->stack_info.successor_sccs.push_back(
+                    state_information_[succ_id].stack_id);
+            } else {
+                tinfo.conv_part += prob * s_value;
             }
-        } while (
-            (!explore->next_successor() && !explore->next_transition(mdp)) ||
-            !successor_loop(mdp, *explore, value_store, timer));
+        } while ((!explore->next_successor(num_threads_ > 1) &&
+                  !explore->next_transition(mdp)) ||
+                 !successor_loop(mdp, *explore, value_store, timer));
     }
 }
 
@@ -338,7 +506,7 @@ bool TopologicalValueIteration<State, Action, UseInterval>::initialize_state(
     ExplorationInfo& exp_info,
     auto& value_store)
 {
-    assert(state_information_[exp_info.state_id].status == StateInfo::NEW);
+    assert(state_information_[exp_info.state_id].status == StateInfo::ONSTACK);
 
     const State state = mdp.get_state(exp_info.state_id);
 
@@ -413,13 +581,21 @@ bool TopologicalValueIteration<State, Action, UseInterval>::successor_loop(
                 return true; // recursion on new state
             }
 
-            case StateInfo::CLOSED: tinfo.conv_part += prob * s_value; break;
+            case StateInfo::CLOSED:
+                if (num_threads_ > 1) {
+                    tinfo.conv_successors.emplace_back(&s_value, prob);
+                    explore.stack_info.successor_sccs.push_back(
+                        succ_info.stack_id);
+                } else {
+                    tinfo.conv_part += prob * s_value;
+                }
+                break;
 
             case StateInfo::ONSTACK:
                 explore.update_lowlink(succ_info.stack_id);
                 tinfo.nconv_successors.emplace_back(&s_value, prob);
             }
-        } while (explore.next_successor());
+        } while (explore.next_successor(num_threads_ > 1));
     } while (explore.next_transition(mdp));
 
     return false;
@@ -433,60 +609,509 @@ void TopologicalValueIteration<State, Action, UseInterval>::scc_found(
 {
     assert(!scc.empty());
 
-    ++statistics_.sccs;
+    if (num_threads_ > 1) {
+        add_scc_to_dag(scc);
+        stack_.erase(scc.begin(), scc.end());
+        return;
+    }
+
+    // Mark all states as closed
+    for (StackInfo& stk_info : scc) {
+        StateInfo& state_info = state_information_[stk_info.state_id];
+        assert(state_info.status == StateInfo::ONSTACK);
+        assert(scc.size() == 1 || !stk_info.nconv_qs.empty());
+        state_info.status = StateInfo::CLOSED;
+    }
+
+    solve_scc(scc, statistics_, timer);
+
+    // Extract a policy from this SCC
+    if (policy && scc.size() != 1) {
+        for (StackInfo& stk_info : scc) {
+            if constexpr (UseInterval) {
+                policy->emplace_decision(
+                    stk_info.state_id,
+                    *stk_info.best_action,
+                    *stk_info.value);
+            } else {
+                policy->emplace_decision(
+                    stk_info.state_id,
+                    *stk_info.best_action,
+                    Interval(*stk_info.value, INFINITE_VALUE));
+            }
+        }
+    }
+
+    stack_.erase(scc.begin(), scc.end());
+}
+
+template <typename State, typename Action, bool UseInterval>
+void TopologicalValueIteration<State, Action, UseInterval>::solve_scc(
+    auto& scc,
+    auto& statistics,
+    utils::CountdownTimer& timer) const
+{
+    ++statistics.sccs;
 
     if (scc.size() == 1) {
         // Singleton SCCs can only transition to a child SCC. The state
         // value has already converged due to topological ordering.
-        ++statistics_.singleton_sccs;
+        ++statistics.singleton_sccs;
         StackInfo& single = scc.front();
-        StateInfo& state_info = state_information_[single.state_id];
         update(*single.value, single.conv_part);
-        assert(state_info.status == StateInfo::ONSTACK);
-        state_info.status = StateInfo::CLOSED;
-    } else {
-        // Mark all states as closed
+        return;
+    }
+
+    switch (update_order_) {
+    case SCCUpdateOrder::ROUND_ROBIN: break;
+    case SCCUpdateOrder::BACKWARD_GAUSS_SEIDEL:
+        solve_scc_backward(scc, statistics, timer);
+        return;
+    case SCCUpdateOrder::PRIORITIZED_SWEEPING:
+        solve_scc_prioritized(scc, statistics, timer);
+        return;
+    }
+
+    // Lay out the SCC as a sparse matrix over a dense value vector.
+    SCCBellmanMatrix<AlgorithmValueType> matrix;
+
+    {
+        std::unordered_map<const AlgorithmValueType*, unsigned> indices;
+        indices.reserve(scc.size());
+
+        unsigned next_index = 0;
         for (StackInfo& stk_info : scc) {
-            StateInfo& state_info = state_information_[stk_info.state_id];
-            assert(state_info.status == StateInfo::ONSTACK);
-            assert(!stk_info.nconv_qs.empty());
-            state_info.status = StateInfo::CLOSED;
+            indices.emplace(stk_info.value, next_index++);
         }
 
-        // Now run VI on the SCC until convergence
-        bool converged;
+        for (StackInfo& stk_info : scc) {
+            matrix.add_state(*stk_info.value, stk_info.conv_part);
+
+            for (const QValueInfo& info : stk_info.nconv_qs) {
+                matrix.add_q_value(info.conv_part);
+                for (const auto& [value, prob] : info.nconv_successors) {
+                    const auto it = indices.find(value);
+                    assert(it != indices.end());
+                    matrix.add_successor(it->second, prob);
+                }
+            }
+        }
+    }
 
-        do {
-            timer.throw_if_expired();
+    // Write the values back, also if the time limit is reached.
+    scope_exit _([&] {
+        unsigned i = 0;
+        for (StackInfo& stk_info : scc) {
+            *stk_info.value = matrix.get_value(i);
 
-            converged = true;
-            auto it = scc.begin();
+            const int best = matrix.get_best_q_value(i++);
+            stk_info.best_action = best == -1
+                                       ? stk_info.best_converged
+                                       : stk_info.nconv_qs[best].action;
+        }
+    });
 
-            do {
-                if (it->update_value()) converged = false;
-                ++statistics_.bellman_backups;
-            } while (++it != scc.end());
-        } while (!converged);
+    // Now run VI on the SCC until convergence
+    bool converged;
 
-        // Extract a policy from this SCC
-        if (policy) {
-            for (StackInfo& stk_info : scc) {
-                if constexpr (UseInterval) {
-                    policy->emplace_decision(
-                        stk_info.state_id,
-                        *stk_info.best_action,
-                        *stk_info.value);
-                } else {
-                    policy->emplace_decision(
-                        stk_info.state_id,
-                        *stk_info.best_action,
-                        Interval(*stk_info.value, INFINITE_VALUE));
+    do {
+        timer.throw_if_expired();
+
+        converged = matrix.sweep([](AlgorithmValueType& value,
+                                    AlgorithmValueType new_value) {
+            if constexpr (UseInterval) {
+                update(value, new_value);
+                return !value.bounds_approximately_equal();
+            } else {
+                return update(value, new_value);
+            }
+        });
+
+        statistics.bellman_backups += scc.size();
+    } while (!converged);
+}
+
+template <typename State, typename Action, bool UseInterval>
+void TopologicalValueIteration<State, Action, UseInterval>::solve_scc_backward(
+    auto& scc,
+    auto& statistics,
+    utils::CountdownTimer& timer)
+{
+    SCCBackupTracker tracker(scc);
+
+    do {
+        timer.throw_if_expired();
+    } while (!tracker.sweep(scc, statistics));
+}
+
+template <typename State, typename Action, bool UseInterval>
+void TopologicalValueIteration<State, Action, UseInterval>::
+    solve_scc_prioritized(
+        auto& scc,
+        auto& statistics,
+        utils::CountdownTimer& timer)
+{
+    SCCBackupTracker tracker(scc);
+
+    const auto size = static_cast<unsigned>(scc.size());
+
+    // Maximal change of a successor value since the last backup of the
+    // state. The queue is ordered by negated priorities and contains stale
+    // entries, which are recognized by comparing with this vector.
+    std::vector<value_t> priorities(size, INFINITE_VALUE);
+    priority_queues::HeapQueue<value_t, unsigned> queue;
+
+    for (unsigned i = 0; i != size; ++i) {
+        queue.push(-INFINITE_VALUE, i);
+    }
+
+    for (;;) {
+        unsigned pops = 0;
+
+        while (!queue.empty()) {
+            if ((++pops & 1023) == 0) timer.throw_if_expired();
+
+            const auto [key, index] = queue.pop();
+            if (!tracker.dirty[index] || -key != priorities[index]) continue;
+
+            priorities[index] = 0_vt;
+
+            const value_t change = tracker.backup(scc, index, statistics);
+
+            for (const auto& [pred, prob] : tracker.predecessors[index]) {
+                // Bounds the change of the predecessor value. Changes within
+                // epsilon are not propagated eagerly, the predecessor is
+                // only marked dirty and backed up by the next sweep.
+                const value_t priority = prob * change;
+                if (priority > g_epsilon && priority > priorities[pred]) {
+                    priorities[pred] = priority;
+                    queue.push(-priority, pred);
                 }
             }
         }
+
+        timer.throw_if_expired();
+
+        // Values only stop changing by more than epsilon if no backup of a
+        // sweep does, so perform one to confirm convergence.
+        if (tracker.sweep(scc, statistics)) return;
+
+        for (unsigned i = 0; i != size; ++i) {
+            if (tracker.dirty[i]) {
+                priorities[i] = INFINITE_VALUE;
+                queue.push(-INFINITE_VALUE, i);
+            } else {
+                priorities[i] = 0_vt;
+            }
+        }
     }
+}
 
-    stack_.erase(scc.begin(), scc.end());
+template <typename State, typename Action, bool UseInterval>
+TopologicalValueIteration<State, Action, UseInterval>::SCCBackupTracker::
+    SCCBackupTracker(auto& scc)
+    : predecessors(scc.size())
+    , dirty(scc.size(), true)
+    , unconverged(scc.size(), true)
+{
+    const auto size = static_cast<unsigned>(scc.size());
+
+    std::unordered_map<const AlgorithmValueType*, unsigned> indices;
+    indices.reserve(size);
+
+    for (unsigned i = 0; i != size; ++i) {
+        indices.emplace(scc[i].value, i);
+    }
+
+    for (unsigned i = 0; i != size; ++i) {
+        for (const QValueInfo& info : scc[i].nconv_qs) {
+            for (const auto& [value, prob] : info.nconv_successors) {
+                const auto it = indices.find(value);
+                assert(it != indices.end());
+                predecessors[it->second].emplace_back(i, prob);
+            }
+        }
+    }
+
+    // Keep the maximal transition probability per predecessor.
+    for (auto& preds : predecessors) {
+        std::ranges::sort(preds, [](const auto& left, const auto& right) {
+            return left.first < right.first ||
+                   (left.first == right.first && left.second > right.second);
+        });
+        const auto [first, last] = std::ranges::unique(
+            preds,
+            {},
+            &std::pair<unsigned, value_t>::first);
+        preds.erase(first, last);
+    }
+}
+
+template <typename State, typename Action, bool UseInterval>
+value_t TopologicalValueIteration<State, Action, UseInterval>::
+    SCCBackupTracker::backup(auto& scc, unsigned index, auto& statistics)
+{
+    StackInfo& stk_info = scc[index];
+
+    const AlgorithmValueType old_value = *stk_info.value;
+
+    unconverged[index] = stk_info.update_value();
+    dirty[index] = false;
+    ++statistics.bellman_backups;
+
+    const AlgorithmValueType& new_value = *stk_info.value;
+
+    // Compare first, the difference of equal infinite values is NaN.
+    auto get_change = [](value_t before, value_t after) {
+        return before == after ? 0_vt : std::abs(after - before);
+    };
+
+    value_t change;
+
+    if constexpr (UseInterval) {
+        change = std::max(
+            get_change(old_value.lower, new_value.lower),
+            get_change(old_value.upper, new_value.upper));
+    } else {
+        change = get_change(old_value, new_value);
+    }
+
+    if (change != 0_vt) {
+        for (const auto& [pred, prob] : predecessors[index]) {
+            dirty[pred] = true;
+        }
+    }
+
+    return change;
+}
+
+template <typename State, typename Action, bool UseInterval>
+bool TopologicalValueIteration<State, Action, UseInterval>::SCCBackupTracker::
+    sweep(auto& scc, auto& statistics)
+{
+    bool converged = true;
+
+    for (auto i = static_cast<unsigned>(scc.size()); i-- != 0;) {
+        if (dirty[i]) {
+            backup(scc, i, statistics);
+        } else {
+            // The backup would yield the same value. Without intervals, this
+            // means the state converged. With intervals, the state keeps its
+            // previous bound gap.
+            ++statistics.saved_backups;
+            if constexpr (!UseInterval) unconverged[i] = false;
+        }
+
+        if (unconverged[i]) converged = false;
+    }
+
+    return converged;
+}
+
+template <typename State, typename Action, bool UseInterval>
+void TopologicalValueIteration<State, Action, UseInterval>::add_scc_to_dag(
+    auto scc)
+{
+    const auto scc_index = static_cast<unsigned>(sccs_.size());
+
+    std::vector<unsigned> children;
+
+    // Mark all states as closed. For closed states, the stack id is reused
+    // to store the index of the SCC.
+    for (StackInfo& stk_info : scc) {
+        StateInfo& state_info = state_information_[stk_info.state_id];
+        assert(state_info.status == StateInfo::ONSTACK);
+        state_info.status = StateInfo::CLOSED;
+        state_info.stack_id = scc_index;
+
+        children.insert(
+            children.end(),
+            stk_info.successor_sccs.begin(),
+            stk_info.successor_sccs.end());
+        std::vector<unsigned>().swap(stk_info.successor_sccs);
+    }
+
+    std::ranges::sort(children);
+    const auto [first, last] = std::ranges::unique(children);
+    children.erase(first, last);
+
+    SCCInfo& info = sccs_.emplace_back(std::vector<StackInfo>(
+        std::make_move_iterator(scc.begin()),
+        std::make_move_iterator(scc.end())));
+
+    info.pending_children = static_cast<unsigned>(children.size());
+
+    for (const unsigned child : children) {
+        sccs_[child].parents.push_back(scc_index);
+    }
+}
+
+template <typename State, typename Action, bool UseInterval>
+void TopologicalValueIteration<State, Action, UseInterval>::solve_dag(
+    MapPolicy* policy,
+    utils::CountdownTimer& timer)
+{
+    statistics_.thread_statistics.assign(num_threads_, ThreadStatistics());
+
+    {
+        ThreadPool pool(num_threads_);
+
+        // Leaves of the condensation DAG are ready right away. Collect them
+        // before submitting any, since running tasks make other SCCs ready.
+        std::vector<unsigned> leaves;
+        for (unsigned i = 0; i != sccs_.size(); ++i) {
+            if (sccs_[i].pending_children == 0) leaves.push_back(i);
+        }
+
+        for (const unsigned i : leaves) {
+            pool.submit([this, &pool, i, &timer] {
+                solve_dag_node(pool, i, timer);
+            });
+        }
+
+        pool.wait();
+    }
+
+    for (const ThreadStatistics& thread_stats :
+         statistics_.thread_statistics) {
+        statistics_.sccs += thread_stats.sccs;
+        statistics_.singleton_sccs += thread_stats.singleton_sccs;
+        statistics_.bellman_backups += thread_stats.bellman_backups;
+        statistics_.saved_backups += thread_stats.saved_backups;
+    }
+
+    // Extract a policy from the non-singleton SCCs
+    if (!policy) return;
+
+    for (SCCInfo& info : sccs_) {
+        if (info.states.size() == 1) continue;
+
+        for (StackInfo& stk_info : info.states) {
+            if constexpr (UseInterval) {
+                policy->emplace_decision(
+                    stk_info.state_id,
+                    *stk_info.best_action,
+                    *stk_info.value);
+            } else {
+                policy->emplace_decision(
+                    stk_info.state_id,
+                    *stk_info.best_action,
+                    Interval(*stk_info.value, INFINITE_VALUE));
+            }
+        }
+    }
+}
+
+template <typename State, typename Action, bool UseInterval>
+void TopologicalValueIteration<State, Action, UseInterval>::solve_dag_node(
+    ThreadPool& pool,
+    unsigned scc_index,
+    utils::CountdownTimer& timer)
+{
+    ThreadStatistics& thread_stats =
+        statistics_.thread_statistics[pool.get_worker_index()];
+
+    SCCInfo& info = sccs_[scc_index];
+
+    const auto start = std::chrono::steady_clock::now();
+
+    // All child SCCs have converged, add their values.
+    for (StackInfo& stk_info : info.states) {
+        stk_info.resolve_deferred();
+    }
+
+    if constexpr (UseInterval) {
+        // Iterate the lower and upper bounds concurrently first.
+        if (info.states.size() != 1) {
+            info.pending_bounds = 2;
+            pool.submit([this, &pool, scc_index, &timer] {
+                sweep_dag_node_bound<true>(pool, scc_index, timer);
+            });
+
+            thread_stats.vi_time +=
+                std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+
+            sweep_dag_node_bound<false>(pool, scc_index, timer);
+            return;
+        }
+    }
+
+    solve_scc(info.states, thread_stats, timer);
+
+    thread_stats.vi_time += std::chrono::duration<double>(
+                                std::chrono::steady_clock::now() - start)
+                                .count();
+
+    finish_dag_node(pool, scc_index, timer);
+}
+
+template <typename State, typename Action, bool UseInterval>
+template <bool Upper>
+void TopologicalValueIteration<State, Action, UseInterval>::
+    sweep_dag_node_bound(
+        ThreadPool& pool,
+        unsigned scc_index,
+        utils::CountdownTimer& timer)
+{
+    ThreadStatistics& thread_stats =
+        statistics_.thread_statistics[pool.get_worker_index()];
+
+    SCCInfo& info = sccs_[scc_index];
+
+    const auto start = std::chrono::steady_clock::now();
+
+    bool converged;
+
+    do {
+        timer.throw_if_expired();
+
+        converged = true;
+
+        for (StackInfo& stk_info : info.states) {
+            if (stk_info.template update_value_bound<Upper>()) {
+                converged = false;
+            }
+
+            ++thread_stats.bellman_backups;
+        }
+    } while (!converged);
+
+    const auto swept = std::chrono::steady_clock::now();
+    const double sweep_time =
+        std::chrono::duration<double>(swept - start).count();
+
+    thread_stats.vi_time += sweep_time;
+    (Upper ? thread_stats.upper_bound_time : thread_stats.lower_bound_time) +=
+        sweep_time;
+
+    // The other sweep is still running.
+    if (--info.pending_bounds != 0) return;
+
+    // Close the remaining gap between the bounds and extract the policy.
+    solve_scc(info.states, thread_stats, timer);
+
+    thread_stats.vi_time += std::chrono::duration<double>(
+                                std::chrono::steady_clock::now() - swept)
+                                .count();
+
+    finish_dag_node(pool, scc_index, timer);
+}
+
+template <typename State, typename Action, bool UseInterval>
+void TopologicalValueIteration<State, Action, UseInterval>::finish_dag_node(
+    ThreadPool& pool,
+    unsigned scc_index,
+    utils::CountdownTimer& timer)
+{
+    for (const unsigned parent : sccs_[scc_index].parents) {
+        if (--sccs_[parent].pending_children == 0) {
+            pool.submit([this, &pool, parent, &timer] {
+                solve_dag_node(pool, parent, timer);
+            });
+        }
+    }
 }
 
 } // namespace probfd::algorithms::topological_vi
@@ -8,6 +8,7 @@
 
 #include "downward/utils/timer.h"
 
+#include <optional>
 #include <type_traits>
 #include <vector>
 
@@ -296,6 +297,31 @@ public:
 
     [[nodiscard]]
     bool was_visited(StateID state_id) const;
+
+    /**
+     * @brief Checks if the state represented by \p state_id has been labelled
+     * as solved.
+     */
+    [[nodiscard]]
+    bool is_solved(StateID state_id) const;
+
+    /**
+     * @brief Returns the greedy quotient action currently selected for the
+     * state represented by \p state_id, if any.
+     */
+    [[nodiscard]]
+    std::optional<QAction> lookup_policy(StateID state_id) const;
+
+    /**
+     * @brief Discards the search information of the state represented by
+     * \p state_id.
+     *
+     * The state is re-initialized from the heuristic when it is encountered
+     * during the next search, while all other states keep their values and
+     * solved labels. This allows to warm-start the search after parts of the
+     * MDP have changed.
+     */
+    void reset_state(StateID state_id);
 };
 
 } // namespace probfd::algorithms::trap_aware_dfhs
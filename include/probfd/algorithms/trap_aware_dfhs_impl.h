@@ -697,4 +697,26 @@ bool TADepthFirstHeuristicSearch<State, Action, UseInterval>::was_visited(
     return algorithm_.was_visited(state_id);
 }
 
+template <typename State, typename Action, bool UseInterval>
+bool TADepthFirstHeuristicSearch<State, Action, UseInterval>::is_solved(
+    StateID state_id) const
+{
+    return algorithm_.state_infos_[state_id].is_solved();
+}
+
+template <typename State, typename Action, bool UseInterval>
+auto TADepthFirstHeuristicSearch<State, Action, UseInterval>::lookup_policy(
+    StateID state_id) const -> std::optional<QAction>
+{
+    return algorithm_.state_infos_[state_id].get_policy();
+}
+
+template <typename State, typename Action, bool UseInterval>
+void TADepthFirstHeuristicSearch<State, Action, UseInterval>::reset_state(
+    StateID state_id)
+{
+    using StateInfo = TADFHSImpl<State, Action, UseInterval>::StateInfo;
+    algorithm_.state_infos_[state_id] = StateInfo();
+}
+
 } // namespace probfd::algorithms::trap_aware_dfhs
@@ -13,6 +13,12 @@ namespace probfd::algorithms {
 template <bool UseInterval>
 using AlgorithmValue = std::conditional_t<UseInterval, Interval, value_t>;
 
+/// The value type in which heuristic search algorithms store the values of
+/// the states. Equal to AlgorithmValue unless compiled with mixed precision.
+template <bool UseInterval>
+using StoredAlgorithmValue =
+    std::conditional_t<UseInterval, StoredInterval, stored_value_t>;
+
 } // namespace probfd::algorithms
 
 #endif
\ No newline at end of file
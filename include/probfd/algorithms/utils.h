@@ -11,7 +11,12 @@
 // Forward Declarations
 namespace probfd {
 struct Interval;
-}
+#if defined(PROBFD_MIXED_PRECISION)
+struct StoredInterval;
+#else
+using StoredInterval = Interval;
+#endif
+} // namespace probfd
 
 namespace probfd::algorithms {
 
@@ -65,6 +70,12 @@ Interval as_interval(value_t lower_bound);
 /// Returns the value unchanged.
 Interval as_interval(Interval value);
 
+/// Rounds a value down to the stored value type.
+stored_value_t as_stored_value(value_t value);
+
+/// Rounds the bounds of an interval outwards to the stored value type.
+StoredInterval as_stored_value(Interval value);
+
 /**
  * @brief Computes the assignments `lhs.lower <- min(lhs.lower, rhs.lower)` and
  * `lower <- min(lhs.lower, rhs.lower)`.
@@ -95,6 +106,27 @@ bool update(Interval& lhs, Interval rhs, value_t epsilon = g_epsilon);
 // Value update
 bool update(value_t& lhs, value_t rhs, value_t epsilon = g_epsilon);
 
+#if defined(PROBFD_MIXED_PRECISION)
+/**
+ * @brief Intersects a stored interval with an interval. The intersection is
+ * computed in double precision and rounded outwards when stored.
+ *
+ * @returns \b true if and only if a bound changed by more than \p epsilon and
+ * the stored interval changed. Changes which are absorbed by rounding are not
+ * reported, so algorithms waiting for convergence terminate even if the
+ * rounding error exceeds \p epsilon.
+ */
+bool update(StoredInterval& lhs, Interval rhs, value_t epsilon = g_epsilon);
+
+/**
+ * @brief Assigns a value to a stored value, rounding it down.
+ *
+ * @returns \b true if and only if the value changed by more than \p epsilon
+ * and the stored value changed.
+ */
+bool update(stored_value_t& lhs, value_t rhs, value_t epsilon = g_epsilon);
+#endif
+
 } // namespace probfd::algorithms
 
 #endif
\ No newline at end of file
@@ -6,6 +6,15 @@ namespace probfd {
 /// Typedef for the state value type
 using value_t = double;
 
+/// Typedef for the value type of heuristic lookup tables and the state value
+/// tables of heuristic search algorithms. Single precision if compiled with
+/// the CMake option USE_MIXED_PRECISION.
+#if defined(PROBFD_MIXED_PRECISION)
+using stored_value_t = float;
+#else
+using stored_value_t = value_t;
+#endif
+
 } // namespace probfd
 
 #endif // PROBFD_ALIASES_H
@@ -12,18 +12,13 @@
 
 #include "downward/algorithms/segmented_vector.h"
 
+#include "downward/utils/logging.h"
+
 #include <iosfwd>
 #include <memory>
 #include <vector>
 
 // Forward Declarations
-namespace merge_and_shrink {
-class Distances;
-class FactoredTransitionSystem;
-class TransitionSystem;
-struct Factor;
-} // namespace merge_and_shrink
-
 namespace probfd {
 template <typename>
 class Distribution;
@@ -32,10 +27,30 @@ class ProbabilisticTask;
 
 namespace probfd::bisimulation {
 
+/**
+ * @brief The probabilistic bisimulation quotient of the state space reachable
+ * from the initial state of a task.
+ *
+ * The quotient is computed by signature-based partition refinement over the
+ * explicit state space. Initially, the goal states, the states that cannot
+ * reach a goal state and all other states form one block each. In each round,
+ * the signature of a state consists of its block and the pairs of an
+ * applicable operator and the distribution over blocks it induces. States
+ * with distinct signatures are split into different blocks until the
+ * partition is stable. The signatures are computed and hashed in parallel.
+ *
+ * Goal states and states that cannot reach a goal state are collapsed into
+ * terminal quotient states without applicable actions.
+ */
 class BisimilarStateSpace : public MDP<QuotientState, QuotientAction> {
+    struct CachedSuccessor {
+        int state;
+        value_t probability;
+    };
+
     struct CachedTransition {
-        unsigned op;
-        int* successors;
+        unsigned num_successors;
+        CachedSuccessor* successors;
     };
 
     std::shared_ptr<ProbabilisticTask> task_;
@@ -46,16 +61,27 @@ class BisimilarStateSpace : public MDP<QuotientState, QuotientAction> {
         transitions_;
 
     // Storage for transitions
-    std::vector<std::unique_ptr<int[]>> store_;
+    std::vector<std::unique_ptr<CachedSuccessor[]>> store_;
 
     std::vector<bool> goal_flags_;
 
+    QuotientState initial_state_;
+    int dead_end_state_ = -1;
+
 public:
+    /**
+     * @brief Computes the probabilistic bisimulation of the task's reachable
+     * state space, using up to \p num_threads threads to compute the
+     * signatures.
+     *
+     * Prints the number of blocks and the time of each refinement round and
+     * the reduction ratio to \p log.
+     */
     BisimilarStateSpace(
         std::shared_ptr<ProbabilisticTask> task,
         std::shared_ptr<FDRCostFunction> task_cost_function,
-        const TaskProxy& det_task_proxy,
-        const merge_and_shrink::TransitionSystem& transition_system);
+        unsigned num_threads,
+        utils::LogProxy log);
 
     ~BisimilarStateSpace() override;
 
@@ -85,9 +111,15 @@ public:
 
     value_t get_action_cost(QuotientAction action) override;
 
+    /// Gets the quotient state of the initial state.
+    QuotientState get_initial_state() const;
+
     /// Checks whether the given quotient state is a goal state.
     bool is_goal_state(QuotientState s) const;
 
+    /// Checks whether the given quotient state cannot reach a goal state.
+    bool is_dead_end(QuotientState s) const;
+
     /// Gets the number of states in the probabilistic bisimulation.
     unsigned num_bisimilar_states() const;
 
@@ -95,9 +127,6 @@ public:
     unsigned num_transitions() const;
 };
 
-merge_and_shrink::Factor
-compute_bisimulation_on_determinization(const TaskProxy& det_task_proxy);
-
 } // namespace probfd::bisimulation
 
 #endif // PROBFD_BISIMULATION_BISIMILAR_STATE_SPACE_H
\ No newline at end of file
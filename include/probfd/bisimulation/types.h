@@ -1,8 +1,8 @@
 #ifndef PROBFD_BISIMULATION_TYPES_H
 #define PROBFD_BISIMULATION_TYPES_H
 
-/// This namespace contains the implementation of deterministic bisimulation
-/// quotients for SSPs, based on merge-and-shrink.
+/// This namespace contains the implementation of probabilistic bisimulation
+/// quotients for SSPs, based on signature-based partition refinement.
 namespace probfd::bisimulation {
 
 /// Represents a state in the probabilistic bisimulation quotient.
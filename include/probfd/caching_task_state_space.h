@@ -3,21 +3,24 @@
 
 #include "probfd/task_state_space.h"
 
-#include "probfd/storage/segmented_memory_pool.h"
+#include "probfd/storage/per_state_storage.h"
 
+#include "probfd/distribution.h"
 #include "probfd/fdr_types.h"
 #include "probfd/types.h"
 
-#include "downward/per_state_information.h"
+#include "downward/operator_id.h"
 
+#include <cstdint>
 #include <limits>
 #include <memory>
+#include <memory_resource>
+#include <span>
 #include <vector>
 
 // Forward Declarations
 class Evaluator;
 class State;
-class OperatorID;
 
 namespace utils {
 class LogProxy;
@@ -25,36 +28,127 @@ class LogProxy;
 
 namespace probfd {
 class ProbabilisticTask;
-template <typename>
-class Distribution;
 } // namespace probfd
 
 namespace probfd {
 
+/**
+ * @brief A task state space that caches the transitions of every expanded
+ * state.
+ *
+ * The explored MDP is stored in a flat compressed-sparse-row layout. The
+ * applicable operators of all cached states are stored in one contiguous
+ * array, in which every state owns a contiguous block. A second array maps
+ * every cached operator to the beginning of its successor distribution in a
+ * third array of (successor, probability) pairs. The successor distributions
+ * are stored in the same sorted, duplicate-free form as Distribution, so no
+ * operator proxies have to be consulted on a cache hit.
+ *
+ * Optionally, the cache can be given a memory budget. Whenever the cached
+ * arrays exceed the budget, the least recently used entries are evicted
+ * until only half of the budget is in use, and the arrays are compacted.
+ * Evicted transitions are recomputed on their next lookup. The budget
+ * bounds the size of the cached data, the capacity of the underlying
+ * arrays may exceed it temporarily.
+ */
 class CachingTaskStateSpace : public TaskStateSpace {
     struct CacheEntry {
+        static constexpr std::uint32_t UNINITIALIZED =
+            std::numeric_limits<std::uint32_t>::max();
+
         [[nodiscard]]
         bool is_initialized() const
         {
-            return naops != std::numeric_limits<unsigned>::max();
+            return first_action != UNINITIALIZED;
+        }
+
+        std::uint32_t first_action = UNINITIALIZED;
+        std::uint32_t num_actions = 0;
+
+        // Value of the access clock at the last lookup of this entry.
+        std::uint32_t last_access = 0;
+    };
+
+    struct CacheStatistics {
+        unsigned long long hits = 0;
+        unsigned long long misses = 0;
+        unsigned long long evictions = 0;
+        unsigned long long compactions = 0;
+
+        void print(utils::LogProxy log) const;
+    };
+
+    /**
+     * @brief A zero-copy view of the cached transitions of a state.
+     *
+     * The view references the cache storage directly. It is invalidated by
+     * the next transition generation call for a state that is not cached
+     * yet.
+     */
+    class TransitionsView {
+        std::span<const OperatorID> aops_;
+        const std::size_t* offsets_;
+        const ItemProbabilityPair<StateID>* outcomes_;
+
+    public:
+        TransitionsView(
+            std::span<const OperatorID> aops,
+            const std::size_t* offsets,
+            const ItemProbabilityPair<StateID>* outcomes);
+
+        /// Returns the number of applicable operators.
+        [[nodiscard]]
+        std::size_t size() const
+        {
+            return aops_.size();
+        }
+
+        /// Returns the applicable operators.
+        [[nodiscard]]
+        std::span<const OperatorID> get_actions() const
+        {
+            return aops_;
         }
 
-        unsigned naops = std::numeric_limits<unsigned>::max();
-        OperatorID* aops = nullptr;
-        StateID* succs = nullptr;
+        /// Returns the successor distribution of the i-th applicable operator.
+        [[nodiscard]]
+        std::span<const ItemProbabilityPair<StateID>>
+        get_successors(std::size_t i) const
+        {
+            return {outcomes_ + offsets_[i], outcomes_ + offsets_[i + 1]};
+        }
     };
 
-    PerStateInformation<CacheEntry> cache_;
-    storage::SegmentedMemoryPool<> cache_data_;
+    const std::size_t max_cache_bytes_;
+
+    storage::PerStateStorage<CacheEntry> cache_;
+
+    // CSR arrays. action_offsets_ has one more element than cached_aops_.
+    std::vector<OperatorID> cached_aops_;
+    std::vector<std::size_t> action_offsets_ = {0};
+    std::vector<ItemProbabilityPair<StateID>> cached_outcomes_;
+
+    // The cached states in the order of their blocks in the CSR arrays.
+    // Only maintained if the cache is memory-bounded.
+    std::vector<StateID> cached_states_;
+
+    // Incremented on every lookup.
+    std::uint32_t access_clock_ = 0;
+
+    CacheStatistics cache_statistics_;
 
     std::vector<OperatorID> aops_;
-    std::vector<StateID> successors_;
+    Distribution<StateID> successor_dist_;
 
 public:
     CachingTaskStateSpace(
         std::shared_ptr<ProbabilisticTask> task,
         utils::LogProxy log,
-        std::vector<std::shared_ptr<::Evaluator>> path_dependent_evaluators);
+        std::vector<std::shared_ptr<::Evaluator>> path_dependent_evaluators,
+        std::size_t max_cache_bytes = std::numeric_limits<std::size_t>::max(),
+        bool flat_successor_generator = false,
+        std::pmr::memory_resource* state_memory =
+            std::pmr::get_default_resource());
 
     void generate_applicable_actions(
         const State& state,
@@ -80,13 +174,31 @@ private:
     void compute_successor_states(
         const State& s,
         OperatorID op_id,
-        std::vector<StateID>& successors);
+        Distribution<StateID>& successors);
 
     void setup_cache(const State& state, CacheEntry& entry);
 
     CacheEntry& lookup(const State& state);
+
+    TransitionsView get_view(const CacheEntry& entry) const;
+
+    // Returns the transitions of the state, computing and caching them first
+    // if necessary.
+    TransitionsView lookup_transitions(const State& state);
+
+    [[nodiscard]]
+    std::size_t get_cached_bytes() const;
+
+    [[nodiscard]]
+    bool is_bounded() const;
+
+    std::uint32_t advance_access_clock();
+
+    void renumber_access_stamps();
+
+    void evict_least_recently_used();
 };
 
 } // namespace probfd
 
-#endif // PROBFD_CACHING_TASK_STATE_SPACE_H
\ No newline at end of file
+#endif // PROBFD_CACHING_TASK_STATE_SPACE_H
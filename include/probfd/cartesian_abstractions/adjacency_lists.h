@@ -0,0 +1,66 @@
+#ifndef PROBFD_CARTESIAN_ADJACENCY_LISTS_H
+#define PROBFD_CARTESIAN_ADJACENCY_LISTS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace probfd::cartesian_abstractions {
+
+/**
+ * @brief Stores a list of integers for each abstract state.
+ *
+ * All lists share one buffer, in which each list occupies a contiguous block
+ * whose capacity is a power of two. If a list outgrows its block, it is moved
+ * to a block of twice the capacity and the old block is put on a free list,
+ * from which blocks of the same capacity are reused. The buffer is compacted
+ * once the free blocks make up more than a quarter of it.
+ */
+class AdjacencyLists {
+    struct Block {
+        std::uint32_t offset = 0;
+        std::uint32_t size = 0;
+        std::uint32_t capacity = 0;
+    };
+
+    std::vector<int> buffer_;
+    std::vector<Block> blocks_;
+
+    // Offsets of the unused blocks, indexed by the logarithm of the capacity.
+    std::vector<std::vector<std::uint32_t>> free_blocks_;
+    std::size_t free_capacity_ = 0;
+
+    std::size_t num_compactions_ = 0;
+
+    std::uint32_t allocate_block(std::uint32_t capacity);
+    void free_block(const Block& block);
+    void compact();
+
+public:
+    /// Appends an empty list.
+    void add_list();
+
+    /// Appends \p value to the list with index \p list.
+    void push_back(int list, int value);
+
+    /// Removes all elements of a list. The list keeps its block.
+    void clear(int list);
+
+    [[nodiscard]]
+    std::span<const int> operator[](int list) const;
+
+    /// Returns the number of lists.
+    [[nodiscard]]
+    std::size_t size() const;
+
+    [[nodiscard]]
+    std::size_t get_num_compactions() const;
+
+    [[nodiscard]]
+    std::size_t estimate_memory_in_bytes() const;
+};
+
+} // namespace probfd::cartesian_abstractions
+
+#endif // PROBFD_CARTESIAN_ADJACENCY_LISTS_H
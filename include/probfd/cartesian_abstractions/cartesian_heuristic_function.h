@@ -1,13 +1,14 @@
 #ifndef PROBFD_CARTESIAN_ABSTRACTIONS_CARTESIAN_HEURISTIC_FUNCTION_H
 #define PROBFD_CARTESIAN_ABSTRACTIONS_CARTESIAN_HEURISTIC_FUNCTION_H
 
+#include "probfd/cartesian_abstractions/flat_refinement_hierarchy.h"
 #include "probfd/cartesian_abstractions/types.h"
 
 #include "probfd/value_type.h"
 
-#include "downward/cartesian_abstractions/refinement_hierarchy.h"
-
+#include <cstddef>
 #include <memory>
+#include <span>
 #include <vector>
 
 // Forward Declarations
@@ -16,13 +17,15 @@ class State;
 namespace probfd::cartesian_abstractions {
 
 /*
-  Store RefinementHierarchy and heuristic values for looking up abstract state
-  IDs and corresponding heuristic values efficiently.
+  Store a flattened copy of the RefinementHierarchy and heuristic values for
+  looking up abstract state IDs and corresponding heuristic values
+  efficiently. If compiled with mixed precision, the heuristic values are
+  rounded down to single precision.
 */
 class CartesianHeuristicFunction {
     // Avoid const to enable moving.
-    std::unique_ptr<RefinementHierarchy> refinement_hierarchy_;
-    std::vector<value_t> h_values_;
+    FlatRefinementHierarchy refinement_hierarchy_;
+    std::vector<stored_value_t> h_values_;
 
 public:
     CartesianHeuristicFunction(
@@ -36,6 +39,19 @@ public:
 
     [[nodiscard]]
     value_t get_value(const State& state) const;
+
+    /*
+      Stores the heuristic value of the i-th state at the i-th position of
+      values.
+    */
+    void get_values(std::span<const State> states, std::span<value_t> values)
+        const;
+
+    [[nodiscard]]
+    bool uses_lookup_table() const;
+
+    [[nodiscard]]
+    std::size_t estimate_memory_in_bytes() const;
 };
 
 } // namespace probfd::cartesian_abstractions
@@ -75,6 +75,11 @@ public:
     CEGARResult
     run_refinement_loop(const std::shared_ptr<ProbabilisticTask>& task);
 
+    // Build abstraction, using the given split selector for the task.
+    CEGARResult run_refinement_loop(
+        const std::shared_ptr<ProbabilisticTask>& task,
+        std::unique_ptr<SplitSelector> split_selector);
+
 private:
     bool may_keep_refining(const CartesianAbstraction& abstraction) const;
 
@@ -24,6 +24,7 @@ class ProbabilisticTask;
 
 namespace probfd::cartesian_abstractions {
 class CartesianHeuristicFunction;
+struct CEGARResult;
 class FlawGeneratorFactory;
 class SplitSelectorFactory;
 class SubtaskGenerator;
@@ -37,6 +38,10 @@ namespace probfd::cartesian_abstractions {
   RefinementHierarchies from Abstractions to
   CartesianHeuristicFunctions, allow extracting
   CartesianHeuristicFunctions into AdditiveCartesianHeuristic.
+
+  With more than one thread, the abstractions of a subtask generator are
+  refined concurrently against a snapshot of the remaining costs and then
+  re-saturated sequentially in their original order.
 */
 class CostSaturation {
     const std::vector<std::shared_ptr<SubtaskGenerator>> subtask_generators_;
@@ -46,6 +51,7 @@ class CostSaturation {
     const int max_non_looping_transitions_;
     const double max_time_;
     const bool use_general_costs_;
+    const unsigned num_threads_;
     mutable utils::LogProxy log_;
 
     std::vector<CartesianHeuristicFunction> heuristic_functions_;
@@ -59,10 +65,15 @@ class CostSaturation {
     std::shared_ptr<ProbabilisticTask>
     get_remaining_costs_task(std::shared_ptr<ProbabilisticTask>& parent) const;
     bool state_is_dead_end(const State& state) const;
+    void add_abstraction(CEGARResult& result);
     void build_abstractions(
         const std::vector<std::shared_ptr<ProbabilisticTask>>& subtasks,
         const utils::CountdownTimer& timer,
         std::function<bool()> should_abort);
+    void build_abstractions_in_parallel(
+        const std::vector<std::shared_ptr<ProbabilisticTask>>& subtasks,
+        const utils::CountdownTimer& timer,
+        const std::function<bool()>& should_abort);
     void print_statistics(utils::Duration init_time) const;
 
 public:
@@ -75,6 +86,7 @@ public:
         int max_non_looping_transitions,
         double max_time,
         bool use_general_costs,
+        unsigned num_threads,
         utils::LogProxy log);
 
     ~CostSaturation();
@@ -0,0 +1,80 @@
+#ifndef PROBFD_CARTESIAN_ABSTRACTIONS_FLAT_REFINEMENT_HIERARCHY_H
+#define PROBFD_CARTESIAN_ABSTRACTIONS_FLAT_REFINEMENT_HIERARCHY_H
+
+#include "probfd/cartesian_abstractions/types.h"
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+
+// Forward Declarations
+class PlanningTask;
+class State;
+
+namespace probfd::cartesian_abstractions {
+
+/*
+  A read-only copy of a finished RefinementHierarchy that is laid out for
+  fast lookups.
+
+  The inner nodes that are reachable from the root are stored in breadth-first
+  order, so the upper levels, which every lookup visits, share few cache
+  lines. An inner node selects its child by comparing the state's value of its
+  variable with its split value, without a branch. Leaves are not stored;
+  instead, a child index holds the bitwise complement of the abstract state ID.
+
+  If the product of the domain sizes of the variables occurring in the
+  hierarchy is at most four times the number of inner nodes (or tiny), the
+  abstract state IDs of all assignments to these variables are tabulated and a
+  lookup is a single mixed-radix ranking.
+*/
+class FlatRefinementHierarchy {
+    struct InnerNode {
+        int var;
+        int value;
+        // Index 1 for the split value, index 0 for all other values.
+        std::array<int, 2> children;
+    };
+
+    std::shared_ptr<PlanningTask> task_;
+
+    // Index of the root node, or the complement of the only abstract state.
+    int root_;
+    std::vector<InnerNode> nodes_;
+
+    // Variables, ranking multipliers and contents of the lookup table.
+    std::vector<int> table_vars_;
+    std::vector<int> table_multipliers_;
+    std::vector<int> table_;
+
+    void build_lookup_table(std::vector<int> vars);
+
+    int traverse(const int* values) const;
+    int lookup(const int* values) const;
+
+public:
+    explicit FlatRefinementHierarchy(
+        const RefinementHierarchy& hierarchy,
+        bool allow_lookup_table = true);
+
+    int get_abstract_state_id(const State& state) const;
+
+    /*
+      Stores the abstract state ID of the i-th state at the i-th position of
+      ids. Without a lookup table, the traversals of several states are
+      interleaved so that their memory accesses overlap.
+    */
+    void get_abstract_state_ids(
+        std::span<const State> states,
+        std::span<int> ids) const;
+
+    bool uses_lookup_table() const;
+
+    std::size_t estimate_memory_in_bytes() const;
+};
+
+} // namespace probfd::cartesian_abstractions
+
+#endif // PROBFD_CARTESIAN_ABSTRACTIONS_FLAT_REFINEMENT_HIERARCHY_H
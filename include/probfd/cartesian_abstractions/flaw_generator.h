@@ -41,7 +41,7 @@ public:
         utils::LogProxy& log,
         utils::CountdownTimer& timer) = 0;
 
-    virtual void notify_split() = 0;
+    virtual void notify_split(int v) = 0;
 
     virtual void print_statistics(utils::LogProxy& log) = 0;
 };
@@ -5,11 +5,13 @@
 #include "probfd/cartesian_abstractions/types.h"
 
 #include <memory>
+#include <vector>
 
 // Forward Declarations
 namespace utils {
 class CountdownTimer;
-}
+class LogProxy;
+} // namespace utils
 
 namespace probfd::quotients {
 template <typename, typename>
@@ -23,6 +25,11 @@ template <typename State, typename Action>
 class ArbitraryTiebreaker;
 }
 
+namespace probfd::algorithms::trap_aware_dfhs {
+template <typename, typename, bool>
+class TADepthFirstHeuristicSearch;
+}
+
 namespace probfd::cartesian_abstractions {
 class AbstractState;
 class CartesianAbstraction;
@@ -34,6 +41,13 @@ namespace probfd::cartesian_abstractions {
 
 /**
  * @brief Find an optimal policy using ILAO*.
+ *
+ * The solver persists across refinement steps. After a split, only the split
+ * states, the states whose transitions were rewired and the solved states
+ * whose greedy policy leads into them are discarded. All other solved states
+ * keep their values and solved labels and are not explored again. Discarded
+ * states are re-initialized from the heuristic, which stores the last bound
+ * computed for them and passes the bound of a split state on to its children.
  */
 class ILAOPolicyGenerator : public PolicyGenerator {
     std::shared_ptr<policy_pickers::ArbitraryTiebreaker<
@@ -41,14 +55,36 @@ class ILAOPolicyGenerator : public PolicyGenerator {
         quotients::QuotientAction<const ProbabilisticTransition*>>>
         picker_;
 
+    std::unique_ptr<algorithms::trap_aware_dfhs::TADepthFirstHeuristicSearch<
+        int,
+        const ProbabilisticTransition*,
+        false>>
+        solver_;
+
+    // States split since the last search.
+    std::vector<int> split_states_;
+
+    // Number of abstract states during the last search.
+    int num_searched_states_ = 0;
+
+    unsigned long long kept_solved_states_ = 0;
+    unsigned long long discarded_states_ = 0;
+
+    void discard_rewired_region(const CartesianAbstraction& abstraction);
+
 public:
     ILAOPolicyGenerator();
+    ~ILAOPolicyGenerator() override;
 
     std::unique_ptr<Solution> find_solution(
         CartesianAbstraction& abstraction,
         const AbstractState* init_id,
         CartesianHeuristic& heuristic,
         utils::CountdownTimer& time_limit) override;
+
+    void notify_split(int v) override;
+
+    void print_statistics(utils::LogProxy& log) override;
 };
 
 } // namespace probfd::cartesian_abstractions
@@ -8,6 +8,7 @@
 // Forward Declarations
 namespace utils {
 class CountdownTimer;
+class LogProxy;
 } // namespace utils
 
 namespace probfd::cartesian_abstractions {
@@ -26,6 +27,10 @@ public:
         const AbstractState* init_id,
         CartesianHeuristic& heuristic,
         utils::CountdownTimer& time_limit) = 0;
+
+    virtual void notify_split(int v) = 0;
+
+    virtual void print_statistics(utils::LogProxy& log) = 0;
 };
 
 } // namespace probfd::cartesian_abstractions
@@ -1,13 +1,17 @@
 #ifndef PROBFD_CARTESIAN_PROBABILISTIC_TRANSITION_SYSTEM_H
 #define PROBFD_CARTESIAN_PROBABILISTIC_TRANSITION_SYSTEM_H
 
+#include "probfd/cartesian_abstractions/adjacency_lists.h"
 #include "probfd/cartesian_abstractions/probabilistic_transition.h"
 #include "probfd/cartesian_abstractions/types.h"
 
 #include "probfd/value_type.h"
 
+#include "downward/utils/timer.h"
+
 #include <cstddef>
 #include <deque>
+#include <span>
 #include <vector>
 
 // Forward Declarations
@@ -35,18 +39,24 @@ class ProbabilisticTransitionSystem {
     const std::vector<std::vector<value_t>>
         probabilities_by_operator_and_outcome_;
 
-    // References to incoming and outgoing transitions
-    std::vector<std::vector<ProbabilisticTransition*>> outgoing_;
-    std::vector<std::vector<ProbabilisticTransition*>> incoming_;
+    // Ids of the incoming and outgoing transitions of each state.
+    AdjacencyLists outgoing_;
+    AdjacencyLists incoming_;
 
-    // The transition list. Using deque here to avoid invalidating references.
+    // The transitions, indexed by their id. Using deque here to avoid
+    // invalidating references, which are the actions of the abstract MDP.
     std::deque<ProbabilisticTransition> transitions_;
 
-    // The list of uniform self-loops, to be pruned during search.
-    std::deque<std::vector<int>> loops_;
+    // The operators inducing uniform self-loops, to be pruned during search.
+    AdjacencyLists loops_;
 
     size_t num_loops_ = 0;
 
+    // Re-used buffer for the transitions or loops of the split state.
+    std::vector<int> rewired_;
+
+    utils::Timer rewire_timer_ = utils::Timer(true);
+
     // Increases size of incoming and outgoing transition lists by one.
     void enlarge_vectors_by_one();
 
@@ -96,15 +106,19 @@ public:
     value_t get_probability(int op_index, int eff_index) const;
 
     [[nodiscard]]
-    const std::vector<std::vector<ProbabilisticTransition*>>&
-    get_incoming_transitions() const;
+    const ProbabilisticTransition& get_transition(int transition_id) const;
 
+    // Returns the ids of the non-looping transitions leading into state v.
     [[nodiscard]]
-    const std::vector<std::vector<ProbabilisticTransition*>>&
-    get_outgoing_transitions() const;
+    std::span<const int> get_incoming_transitions(int v) const;
 
+    // Returns the ids of the non-looping transitions leaving state v.
     [[nodiscard]]
-    const std::deque<std::vector<int>>& get_loops() const;
+    std::span<const int> get_outgoing_transitions(int v) const;
+
+    // Returns the operators inducing a uniform self-loop in state v.
+    [[nodiscard]]
+    std::span<const int> get_loops(int v) const;
 
     [[nodiscard]]
     const std::deque<ProbabilisticTransition>& get_transitions() const;
@@ -121,6 +135,9 @@ public:
     [[nodiscard]]
     int get_num_loops() const;
 
+    [[nodiscard]]
+    size_t estimate_memory_in_bytes() const;
+
     void print_statistics(utils::LogProxy& log) const;
 };
 
@@ -165,10 +165,24 @@ public:
 
     virtual std::unique_ptr<SplitSelector>
     create_split_selector(const std::shared_ptr<ProbabilisticTask>& task) = 0;
+
+    /*
+      Creates a split selector that shares no state with the other split
+      selectors of this factory, so that it can be used concurrently with
+      them. Must be called in a deterministic order to obtain reproducible
+      splits.
+    */
+    virtual std::unique_ptr<SplitSelector> create_independent_split_selector(
+        const std::shared_ptr<ProbabilisticTask>& task)
+    {
+        return create_split_selector(task);
+    }
 };
 
 /*
-  Select split in case there are multiple possible splits.
+  Select split in case there are multiple possible splits. The split selectors
+  draw from the generator of the factory, except for independent split
+  selectors, which use their own generator seeded from it.
 */
 class SplitSelectorRandomFactory : public SplitSelectorFactory {
     std::shared_ptr<utils::RandomNumberGenerator> rng_;
@@ -179,6 +193,9 @@ public:
 
     std::unique_ptr<SplitSelector> create_split_selector(
         const std::shared_ptr<ProbabilisticTask>& task) override;
+
+    std::unique_ptr<SplitSelector> create_independent_split_selector(
+        const std::shared_ptr<ProbabilisticTask>& task) override;
 };
 
 /*
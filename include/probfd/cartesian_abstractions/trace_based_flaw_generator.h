@@ -62,7 +62,7 @@ public:
         utils::LogProxy& log,
         utils::CountdownTimer& timer) override;
 
-    void notify_split() override;
+    void notify_split(int v) override;
 
     void print_statistics(utils::LogProxy& log) override;
 };
@@ -0,0 +1,23 @@
+#ifndef PROBFD_CLI_PDBS_PDB_CACHE_OPTIONS_H
+#define PROBFD_CLI_PDBS_PDB_CACHE_OPTIONS_H
+
+#include <string>
+#include <tuple>
+
+// Forward Declarations
+namespace downward::cli::plugins {
+class Feature;
+class Options;
+} // namespace downward::cli::plugins
+
+namespace probfd::cli::pdbs {
+
+extern void
+add_pdb_cache_option_to_feature(downward::cli::plugins::Feature& feature);
+
+extern std::tuple<std::string> get_pdb_cache_arguments_from_options(
+    const downward::cli::plugins::Options& opts);
+
+} // namespace probfd::cli::pdbs
+
+#endif
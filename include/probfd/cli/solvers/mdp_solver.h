@@ -34,6 +34,9 @@ extern std::tuple<
     utils::Verbosity,
     std::vector<std::shared_ptr<::Evaluator>>,
     bool,
+    int,
+    bool,
+    std::optional<std::string>,
     std::shared_ptr<probfd::TaskEvaluatorFactory>,
     std::optional<probfd::value_t>,
     bool,
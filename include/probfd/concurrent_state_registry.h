@@ -0,0 +1,169 @@
+#ifndef PROBFD_CONCURRENT_STATE_REGISTRY_H
+#define PROBFD_CONCURRENT_STATE_REGISTRY_H
+
+#include "downward/algorithms/int_packer.h"
+#include "downward/state_id.h"
+#include "downward/task_proxy.h"
+
+#include "downward/task_utils/task_properties.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Forward Declarations
+class AxiomEvaluator;
+
+namespace utils {
+class LogProxy;
+}
+
+namespace probfd {
+
+/**
+ * @brief A state registry which can be shared by multiple threads.
+ *
+ * Like StateRegistry, this registry assigns consecutive IDs to the states in
+ * the order in which they are registered and stores their packed data.
+ * The packed data is stored in an append-only arena of fixed-size segments
+ * which are never moved, so the IDs and buffers of registered states stay
+ * valid while other threads register new states.
+ *
+ * Duplicate detection uses a hash set which is split into shards by hash
+ * value. Each shard is an open addressing table whose slots are only ever
+ * filled, never moved or cleared. Looking up a state which is already
+ * registered therefore takes no locks and never waits for other threads.
+ * Registering a new state locks its shard. A full shard is replaced by a
+ * table of twice the size, the old table is kept until the registry is
+ * destroyed since other threads may still be probing it.
+ *
+ * The states created by this registry have an ID and packed data, but no
+ * StateRegistry, so they cannot be used to index PerStateInformation.
+ * States of the same registry are compared by their IDs.
+ *
+ * Tasks with axioms are supported, but the evaluation of axioms is
+ * serialized.
+ */
+class ConcurrentStateRegistry {
+    static constexpr std::size_t SEGMENT_BITS = 14;
+    static constexpr std::size_t SEGMENT_SIZE = std::size_t(1) << SEGMENT_BITS;
+    // Covers all non-negative 32-bit state IDs.
+    static constexpr std::size_t MAX_SEGMENTS =
+        (std::size_t(1) << 31) >> SEGMENT_BITS;
+
+    static constexpr int SHARD_BITS = 6;
+    static constexpr std::size_t NUM_SHARDS = std::size_t(1) << SHARD_BITS;
+
+    struct Table;
+    struct Shard;
+
+    PlanningTaskProxy task_proxy_;
+    const int_packer::IntPacker& state_packer_;
+    AxiomEvaluator& axiom_evaluator_;
+    const int num_variables_;
+    const int num_bins_;
+    const bool has_axioms_;
+
+    std::unique_ptr<std::atomic<PackedStateBin*>[]> segments_;
+    std::unique_ptr<Shard[]> shards_;
+    std::atomic<int> num_states_ = 0;
+
+    std::mutex axiom_mutex_;
+
+    State initial_state_;
+
+public:
+    explicit ConcurrentStateRegistry(const PlanningTaskProxy& task_proxy);
+    ~ConcurrentStateRegistry();
+
+    ConcurrentStateRegistry(const ConcurrentStateRegistry&) = delete;
+    ConcurrentStateRegistry& operator=(const ConcurrentStateRegistry&) =
+        delete;
+
+    const PlanningTaskProxy& get_task_proxy() const { return task_proxy_; }
+
+    int get_num_variables() const { return num_variables_; }
+
+    const int_packer::IntPacker& get_state_packer() const
+    {
+        return state_packer_;
+    }
+
+    /*
+      Returns the state that was registered at the given ID. Never blocks.
+    */
+    State lookup_state(::StateID id) const;
+
+    /*
+      Returns the initial state, which is registered on construction and has
+      the ID zero. Its values are already unpacked, so threads can use it
+      concurrently.
+    */
+    const State& get_initial_state() const { return initial_state_; }
+
+    /*
+      Returns the state that results from applying the given effects to
+      predecessor and registers it if this was not done before.
+    */
+    template <typename Effects>
+    State get_successor_state(const State& predecessor, const Effects& effects)
+    {
+        PackedStateBin* buffer = get_scratch_buffer();
+
+        if (has_axioms_) {
+            predecessor.unpack();
+            std::vector<int> new_values = predecessor.get_unpacked_values();
+            for (auto effect : effects) {
+                if (does_fire(effect, predecessor)) {
+                    FactPair effect_pair = effect.get_fact().get_pair();
+                    new_values[effect_pair.var] = effect_pair.value;
+                }
+            }
+            evaluate_axioms(new_values);
+            for (int i = 0; i != num_variables_; ++i) {
+                state_packer_.set(buffer, i, new_values[i]);
+            }
+            return lookup_state(insert(buffer));
+        }
+
+        std::copy_n(predecessor.get_buffer(), num_bins_, buffer);
+        for (auto effect : effects) {
+            if (does_fire(effect, predecessor)) {
+                FactPair effect_pair = effect.get_fact().get_pair();
+                state_packer_.set(buffer, effect_pair.var, effect_pair.value);
+            }
+        }
+        return lookup_state(insert(buffer));
+    }
+
+    /*
+      Returns the number of states registered so far. While other threads
+      register states, the data of the most recent IDs may still be written.
+    */
+    std::size_t size() const { return num_states_.load(); }
+
+    int get_state_size_in_bytes() const;
+
+    void print_statistics(utils::LogProxy& log) const;
+
+private:
+    PackedStateBin* get_scratch_buffer() const;
+    void evaluate_axioms(std::vector<int>& values);
+
+    /*
+      Returns the ID of the state with the given packed data, registering it
+      if it is new. The buffer is copied.
+    */
+    ::StateID insert(const PackedStateBin* buffer);
+
+    PackedStateBin* get_state_buffer(int id) const;
+    PackedStateBin* allocate_state_buffer(int id);
+};
+
+} // namespace probfd
+
+#endif // PROBFD_CONCURRENT_STATE_REGISTRY_H
@@ -0,0 +1,87 @@
+#ifndef PROBFD_CONCURRENT_TASK_STATE_SPACE_H
+#define PROBFD_CONCURRENT_TASK_STATE_SPACE_H
+
+#include "probfd/task_utils/probabilistic_successor_generator.h"
+
+#include "probfd/concurrent_state_registry.h"
+#include "probfd/fdr_types.h"
+#include "probfd/mdp.h"
+#include "probfd/task_proxy.h"
+#include "probfd/types.h"
+
+#include "downward/utils/logging.h"
+
+#include "downward/task_proxy.h"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Forward Declarations
+class OperatorID;
+
+namespace probfd {
+template <typename>
+class Distribution;
+class ProbabilisticTask;
+} // namespace probfd
+
+namespace probfd {
+
+/**
+ * @brief A state space of a probabilistic planning task which can be used by
+ * multiple threads at the same time.
+ *
+ * The states are registered in a ConcurrentStateRegistry. Unlike
+ * TaskStateSpace, this state space does not notify path-dependent evaluators
+ * and does not count generator calls, so none of its methods write to shared
+ * data other than the registry.
+ *
+ * No solver uses this state space yet. ParallelLRTDP still expands states
+ * under a lock, since the heuristics and path-dependent evaluators it calls
+ * during an expansion are not thread-safe. This state space lets the
+ * transition generation move out of that lock once they are.
+ */
+class ConcurrentTaskStateSpace : public FDRStateSpace {
+    ProbabilisticTaskProxy task_proxy_;
+    mutable utils::LogProxy log_;
+
+    ConcurrentStateRegistry state_registry_;
+    successor_generator::ProbabilisticSuccessorGenerator gen_;
+
+public:
+    ConcurrentTaskStateSpace(
+        std::shared_ptr<ProbabilisticTask> task,
+        utils::LogProxy log);
+
+    StateID get_state_id(const State& state) final;
+    State get_state(StateID state_id) final;
+
+    void generate_applicable_actions(
+        const State& state,
+        std::vector<OperatorID>& result) final;
+
+    void generate_action_transitions(
+        const State& state,
+        OperatorID operator_id,
+        Distribution<StateID>& result) final;
+
+    void generate_all_transitions(
+        const State& state,
+        std::vector<OperatorID>& aops,
+        std::vector<Distribution<StateID>>& successors) final;
+
+    void generate_all_transitions(
+        const State& state,
+        std::vector<TransitionType>& transitions) final;
+
+    State get_initial_state() const;
+
+    size_t get_num_registered_states() const;
+
+    void print_statistics() const;
+};
+
+} // namespace probfd
+
+#endif // PROBFD_CONCURRENT_TASK_STATE_SPACE_H
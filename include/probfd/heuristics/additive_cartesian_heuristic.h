@@ -6,6 +6,7 @@
 #include "probfd/task_evaluator_factory.h"
 
 #include <memory>
+#include <span>
 #include <vector>
 
 // Forward Declarations
@@ -39,10 +40,15 @@ public:
         int max_states,
         int max_transitions,
         double max_time,
-        bool use_general_costs);
+        bool use_general_costs,
+        unsigned num_threads);
 
 protected:
     value_t evaluate(const State& ancestor_state) const override;
+
+    void evaluate_batch(
+        std::span<const State> ancestor_states,
+        std::span<value_t> values) const override;
 };
 
 class AdditiveCartesianHeuristicFactory : public TaskEvaluatorFactory {
@@ -59,6 +65,7 @@ class AdditiveCartesianHeuristicFactory : public TaskEvaluatorFactory {
     const bool use_general_costs;
 
     const utils::LogProxy log_;
+    const unsigned num_threads_;
 
 public:
     AdditiveCartesianHeuristicFactory(
@@ -72,7 +79,8 @@ public:
         int max_transitions,
         double max_time,
         bool use_general_costs,
-        utils::Verbosity verbosity);
+        utils::Verbosity verbosity,
+        int num_threads);
 
     std::unique_ptr<FDREvaluator> create_evaluator(
         std::shared_ptr<ProbabilisticTask> task,
@@ -5,6 +5,7 @@
 #include "probfd/task_evaluator_factory.h"
 
 #include <memory>
+#include <string>
 #include <vector>
 
 // Forward Declarations
@@ -38,7 +39,9 @@ public:
         utils::LogProxy log,
         std::shared_ptr<pdbs::PatternCollectionGenerator> generator,
         OrderingStrategy order,
-        std::shared_ptr<utils::RandomNumberGenerator> rng);
+        std::shared_ptr<utils::RandomNumberGenerator> rng,
+        unsigned num_threads,
+        const std::string& pdb_cache_dir);
 
     void print_statistics() const override
     {
@@ -55,6 +58,8 @@ class GZOCPHeuristicFactory : public TaskEvaluatorFactory {
     const GZOCPHeuristic::OrderingStrategy ordering_;
     const int random_seed_;
     const utils::Verbosity verbosity_;
+    const unsigned num_threads_;
+    const std::string pdb_cache_dir_;
 
 public:
     explicit GZOCPHeuristicFactory(
@@ -62,7 +67,9 @@ public:
             pattern_collection_generator_,
         GZOCPHeuristic::OrderingStrategy ordering_,
         int random_seed_,
-        utils::Verbosity verbosity_);
+        utils::Verbosity verbosity_,
+        int num_threads,
+        std::string pdb_cache_dir);
 
     std::unique_ptr<FDREvaluator> create_evaluator(
         std::shared_ptr<ProbabilisticTask> task,
@@ -1,12 +1,14 @@
 #ifndef PROBFD_HEURISTICS_PROBABILITY_AWARE_PDB_HEURISTIC_H
 #define PROBFD_HEURISTICS_PROBABILITY_AWARE_PDB_HEURISTIC_H
 
+#include "probfd/pdbs/multi_pattern_ranking.h"
 #include "probfd/pdbs/types.h"
 
 #include "probfd/heuristics/task_dependent_heuristic.h"
 #include "probfd/task_evaluator_factory.h"
 
 #include <memory>
+#include <string>
 #include <vector>
 
 // Forward Declarations
@@ -34,6 +36,7 @@ class ProbabilityAwarePDBHeuristic : public TaskDependentHeuristic {
     std::shared_ptr<pdbs::PPDBCollection> pdbs_;
     std::shared_ptr<std::vector<pdbs::PatternSubCollection>> subcollections_;
     std::shared_ptr<pdbs::SubCollectionFinder> subcollection_finder_;
+    pdbs::MultiPatternRanking ranking_;
 
 public:
     ProbabilityAwarePDBHeuristic(
@@ -41,20 +44,30 @@ public:
         std::shared_ptr<FDRCostFunction> task_cost_function,
         std::shared_ptr<pdbs::PatternCollectionGenerator> generator,
         double max_time_dominance_pruning,
+        unsigned num_threads,
+        const std::string& pdb_cache_dir,
         utils::LogProxy log);
 
     value_t evaluate(const State& state) const override;
+
+    void evaluate_batch(
+        std::span<const State> states,
+        std::span<value_t> values) const override;
 };
 
 class ProbabilityAwarePDBHeuristicFactory : public TaskEvaluatorFactory {
     const std::shared_ptr<probfd::pdbs::PatternCollectionGenerator> patterns_;
     const double max_time_dominance_pruning_;
+    const unsigned num_threads_;
+    const std::string pdb_cache_dir_;
     const utils::Verbosity verbosity_;
 
 public:
     ProbabilityAwarePDBHeuristicFactory(
         std::shared_ptr<probfd::pdbs::PatternCollectionGenerator> patterns,
         double max_time_dominance_pruning,
+        int num_threads,
+        std::string pdb_cache_dir,
         utils::Verbosity verbosity);
 
     std::unique_ptr<FDREvaluator> create_evaluator(
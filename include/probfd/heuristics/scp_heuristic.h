@@ -6,6 +6,7 @@
 #include "probfd/task_evaluator_factory.h"
 
 #include <memory>
+#include <string>
 #include <vector>
 
 // Forward Declarations
@@ -39,7 +40,9 @@ public:
         utils::LogProxy log,
         std::shared_ptr<pdbs::PatternCollectionGenerator> generator,
         OrderingStrategy order,
-        std::shared_ptr<utils::RandomNumberGenerator> rng);
+        std::shared_ptr<utils::RandomNumberGenerator> rng,
+        unsigned num_threads,
+        const std::string& pdb_cache_dir);
 
 protected:
     value_t evaluate(const State& state) const override;
@@ -51,6 +54,8 @@ class SCPHeuristicFactory : public TaskEvaluatorFactory {
     const SCPHeuristic::OrderingStrategy ordering_;
     const int random_seed_;
     const utils::Verbosity verbosity_;
+    const unsigned num_threads_;
+    const std::string pdb_cache_dir_;
 
 public:
     SCPHeuristicFactory(
@@ -58,7 +63,9 @@ public:
             pattern_collection_generator,
         SCPHeuristic::OrderingStrategy ordering,
         int random_seed,
-        utils::Verbosity verbosity);
+        utils::Verbosity verbosity,
+        int num_threads,
+        std::string pdb_cache_dir);
 
     std::unique_ptr<FDREvaluator> create_evaluator(
         std::shared_ptr<ProbabilisticTask> task,
@@ -5,6 +5,7 @@
 #include "probfd/task_evaluator_factory.h"
 
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace probfd::pdbs {
@@ -23,7 +24,9 @@ public:
         std::shared_ptr<ProbabilisticTask> task,
         std::shared_ptr<FDRCostFunction> task_cost_function,
         utils::LogProxy log,
-        std::shared_ptr<pdbs::PatternCollectionGenerator> generator);
+        std::shared_ptr<pdbs::PatternCollectionGenerator> generator,
+        unsigned num_threads,
+        const std::string& pdb_cache_dir);
 
     ~UCPHeuristic() override;
 
@@ -40,11 +43,15 @@ class UCPHeuristicFactory : public TaskEvaluatorFactory {
     const utils::Verbosity verbosity_;
     const std::shared_ptr<probfd::pdbs::PatternCollectionGenerator>
         pattern_collection_generator_;
+    const unsigned num_threads_;
+    const std::string pdb_cache_dir_;
 
 public:
     UCPHeuristicFactory(
         utils::Verbosity verbosity,
-        std::shared_ptr<probfd::pdbs::PatternCollectionGenerator> generator);
+        std::shared_ptr<probfd::pdbs::PatternCollectionGenerator> generator,
+        int num_threads,
+        std::string pdb_cache_dir);
 
     std::unique_ptr<FDREvaluator> create_evaluator(
         std::shared_ptr<ProbabilisticTask> task,
@@ -39,6 +39,36 @@ struct Interval {
     bool bounds_approximately_equal(value_t tolerance = g_epsilon) const;
 };
 
+#if defined(PROBFD_MIXED_PRECISION)
+/**
+ * @brief Stores an interval with bounds of the stored value type.
+ *
+ * The lower bound is rounded down and the upper bound is rounded up, so the
+ * stored interval contains the interval it was constructed from. Arithmetic
+ * is performed on the converted double precision interval.
+ */
+struct StoredInterval {
+    stored_value_t lower; ///< The Lower bound of the interval
+    stored_value_t upper; ///< The upper bound of the interval
+
+    /// Stores the given interval, rounding its bounds outwards.
+    explicit(false) StoredInterval(Interval val = Interval());
+
+    /// Converts the stored bounds back to a double precision interval.
+    explicit(false) operator Interval() const;
+
+    /**
+     * @brief Checks if the length is below a given tolerance, or below twice
+     * the rounding error of the stored bounds if that is larger.
+     */
+    [[nodiscard]]
+    bool bounds_approximately_equal(value_t tolerance = g_epsilon) const;
+};
+#else
+/// Intervals are stored in double precision.
+using StoredInterval = Interval;
+#endif
+
 /**
  * @brief Computes the component-wise addition of two intervals.
  *
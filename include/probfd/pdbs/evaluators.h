@@ -6,6 +6,8 @@
 #include "probfd/evaluator.h"
 #include "probfd/value_type.h"
 
+#include <span>
+
 // Forward Declarations
 namespace pdbs {
 class PatternDatabase;
@@ -42,7 +44,7 @@ public:
 };
 
 class IncrementalPPDBEvaluator : public StateRankEvaluator {
-    const std::vector<value_t>& value_table_;
+    std::span<const stored_value_t> value_table_;
 
     int left_multiplier_;
     int right_multiplier_;
@@ -50,7 +52,7 @@ class IncrementalPPDBEvaluator : public StateRankEvaluator {
 
 public:
     explicit IncrementalPPDBEvaluator(
-        const std::vector<value_t>& value_table,
+        std::span<const stored_value_t> value_table,
         const StateRankingFunction& mapper,
         int add_var);
 
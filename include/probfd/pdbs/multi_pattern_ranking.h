@@ -0,0 +1,119 @@
+#ifndef PROBFD_PDBS_MULTI_PATTERN_RANKING_H
+#define PROBFD_PDBS_MULTI_PATTERN_RANKING_H
+
+#include "probfd/pdbs/types.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Forward Declarations
+class State;
+
+namespace probfd::pdbs {
+class StateRankingFunction;
+}
+
+namespace probfd::pdbs {
+
+/**
+ * @brief Computes the abstract state ranks of a state for many projections at
+ * once.
+ *
+ * The ranking coefficients of all patterns are stored in a
+ * structure-of-arrays layout. The patterns are grouped into blocks of
+ * BLOCK_SIZE patterns. The r-th row of a block stores the r-th pattern
+ * variable and ranking coefficient of every pattern of the block in
+ * consecutive lanes. Shorter patterns are padded with a zero coefficient.
+ * A rank computation then reduces to one gather and one multiply-add per row
+ * and block, which is carried out with AVX2 if the CPU supports it. Otherwise,
+ * a scalar loop over the same layout is used. The kernel is selected at
+ * runtime. Construction fails with std::range_error if some abstract state
+ * rank does not fit into StateRank.
+ */
+class MultiPatternRanking {
+public:
+    /// The number of patterns ranked simultaneously.
+    static constexpr std::size_t BLOCK_SIZE = 8;
+
+private:
+    std::size_t num_patterns_ = 0;
+
+    // The first row of every block, plus one past the last row.
+    std::vector<std::size_t> block_rows_ = {0};
+
+    // Rows of BLOCK_SIZE lanes each.
+    std::vector<std::int32_t> variables_;
+    std::vector<std::int32_t> multipliers_;
+
+    bool use_avx2_ = false;
+
+public:
+    MultiPatternRanking() = default;
+
+    /**
+     * @brief Constructs the ranking kernel for the given ranking functions.
+     *
+     * If \p allow_simd is false, the scalar kernel is used even if the CPU
+     * supports AVX2.
+     */
+    explicit MultiPatternRanking(
+        std::span<const StateRankingFunction* const> ranking_functions,
+        bool allow_simd = true);
+
+    /**
+     * @brief Constructs the ranking kernel for the ranking functions of the
+     * PDBs of a collection.
+     */
+    explicit MultiPatternRanking(
+        const PPDBCollection& pdbs,
+        bool allow_simd = true);
+
+    /// Returns the number of patterns.
+    [[nodiscard]]
+    std::size_t num_patterns() const;
+
+    /// Returns true if the AVX2 kernel is used.
+    [[nodiscard]]
+    bool uses_avx2() const;
+
+    /**
+     * @brief Computes the ranks of a batch of states with unpacked values.
+     *
+     * The ranks are stored pattern-major, i.e., the rank of the j-th state
+     * for the i-th pattern is stored at position i * states.size() + j of
+     * \p ranks, which must have size num_patterns() * states.size().
+     */
+    void compute_ranks(
+        std::span<const State> states,
+        std::span<StateRank> ranks) const;
+
+    /**
+     * @brief Computes the ranks for the given variable assignment. The rank
+     * for the i-th pattern is stored at position i * stride of \p ranks.
+     */
+    void compute_ranks(
+        const int* values,
+        StateRank* ranks,
+        std::size_t stride) const;
+
+    /// Returns true if the CPU executing the program supports AVX2.
+    [[nodiscard]]
+    static bool cpu_supports_avx2();
+
+private:
+    void compute_ranks_scalar(
+        const int* values,
+        StateRank* ranks,
+        std::size_t stride) const;
+
+    void compute_ranks_avx2(
+        const int* values,
+        StateRank* ranks,
+        std::size_t stride) const;
+};
+
+} // namespace probfd::pdbs
+
+#endif // PROBFD_PDBS_MULTI_PATTERN_RANKING_H
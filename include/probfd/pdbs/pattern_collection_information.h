@@ -14,6 +14,10 @@ namespace pdbs {
 class PatternCollectionInformation;
 }
 
+namespace probfd::pdbs {
+class PDBCache;
+}
+
 namespace probfd::pdbs {
 
 /*
@@ -38,7 +42,7 @@ class PatternCollectionInformation {
 
     std::shared_ptr<SubCollectionFinder> subcollection_finder_;
 
-    void create_pdbs_if_missing();
+    void create_pdbs_if_missing(unsigned num_threads, const PDBCache* cache);
     void create_pattern_cliques_if_missing();
 
     [[nodiscard]]
@@ -69,7 +73,10 @@ public:
 
     [[nodiscard]]
     std::shared_ptr<PatternCollection> get_patterns() const;
-    std::shared_ptr<PPDBCollection> get_pdbs();
+    // If the PDBs are missing, they are computed using the given number of
+    // threads, or loaded from the given PDB cache if available.
+    std::shared_ptr<PPDBCollection>
+    get_pdbs(unsigned num_threads = 1, const PDBCache* cache = nullptr);
     std::shared_ptr<std::vector<PatternSubCollection>> get_subcollections();
     std::shared_ptr<SubCollectionFinder> get_subcollection_finder();
 };
@@ -0,0 +1,138 @@
+#ifndef PROBFD_PDBS_PDB_CACHE_H
+#define PROBFD_PDBS_PDB_CACHE_H
+
+#include "probfd/pdbs/types.h"
+
+#include "probfd/fdr_types.h"
+#include "probfd/task_proxy.h"
+
+#include "downward/utils/logging.h"
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+
+namespace probfd::pdbs {
+
+/**
+ * @brief Identifies the task and the cost function a PDB file was computed
+ * for. Stored in the file header and checked when the file is read.
+ */
+struct PDBFileKey {
+    std::uint64_t task_fingerprint = 0;
+    std::uint64_t cost_key = 0;
+
+    friend bool operator==(const PDBFileKey&, const PDBFileKey&) = default;
+};
+
+/**
+ * @brief Writes a probability-aware PDB to a binary PDB file.
+ *
+ * The file starts with a fixed header, which contains a magic number, the
+ * format version, a byte order mark, the size of stored_value_t, the number
+ * of pattern variables, the number of abstract states and the given key. It
+ * is followed by the pattern, the domain sizes of the pattern variables and,
+ * aligned for stored_value_t, the value table.
+ *
+ * @throws std::system_error if the file cannot be written.
+ */
+void write_pdb_file(
+    const std::filesystem::path& path,
+    const ProbabilityAwarePatternDatabase& pdb,
+    const PDBFileKey& key = {});
+
+/**
+ * @brief Reads a probability-aware PDB from a binary PDB file.
+ *
+ * The file is memory-mapped read-only and the value table of the returned
+ * PDB points into the mapping, so that processes loading the same file share
+ * its physical pages.
+ *
+ * @throws std::system_error if the file cannot be mapped.
+ * @throws std::runtime_error if the file is not a valid PDB file for the
+ * given variables and key, e.g. because it was written by a different format
+ * version, on a machine with different byte order or for a different task.
+ */
+std::unique_ptr<ProbabilityAwarePatternDatabase> read_pdb_file(
+    const std::filesystem::path& path,
+    VariablesProxy variables,
+    const PDBFileKey& key = {});
+
+/**
+ * @brief A directory of PDB files which can be reused across runs.
+ *
+ * A PDB file is keyed by a hash of the task, a hash of the operator cost
+ * function the PDB was computed for, and a hash of the pattern. The task
+ * hash covers the variable domains, the operators with their outcomes, the
+ * initial state and the goal, since states that are unreachable from the
+ * initial state are treated as dead ends, as well as the convergence
+ * epsilon. Files are written to a temporary file first and renamed
+ * afterwards, so that several processes can share one cache directory.
+ *
+ * The file header additionally stores a second, independently seeded hash
+ * of the task and the cost key. A loaded file is only used if both match and
+ * its pattern is the requested one, which guards against collisions of the
+ * file name.
+ *
+ * Invalid or unreadable files are treated as cache misses.
+ */
+class PDBCache {
+    std::filesystem::path directory_;
+    ProbabilisticTaskProxy task_proxy_;
+    std::uint64_t task_key_;
+    std::uint64_t task_fingerprint_;
+
+    mutable utils::LogProxy log_;
+    mutable std::mutex log_mutex_;
+
+    mutable std::atomic<unsigned long long> hits_ = 0;
+    mutable std::atomic<unsigned long long> misses_ = 0;
+    mutable std::atomic<unsigned long long> errors_ = 0;
+    mutable std::atomic<unsigned long long> next_temporary_ = 0;
+
+public:
+    /**
+     * @brief Opens the cache directory for the given task, creating the
+     * directory if it does not exist.
+     */
+    PDBCache(
+        std::filesystem::path directory,
+        ProbabilisticTaskProxy task_proxy,
+        utils::LogProxy log);
+
+    /**
+     * @brief Returns the key of the operator costs and termination costs of a
+     * cost function.
+     */
+    [[nodiscard]]
+    std::uint64_t get_cost_key(FDRSimpleCostFunction& cost_function) const;
+
+    /**
+     * @brief Returns the cached PDB for the pattern, or nullptr if there is
+     * none.
+     */
+    [[nodiscard]]
+    std::unique_ptr<ProbabilityAwarePatternDatabase>
+    load(const Pattern& pattern, std::uint64_t cost_key) const;
+
+    /**
+     * @brief Stores a PDB in the cache. Failures are counted, logged as a
+     * warning and otherwise ignored.
+     */
+    void store(
+        const ProbabilityAwarePatternDatabase& pdb,
+        std::uint64_t cost_key) const;
+
+    void print_statistics(utils::LogProxy log) const;
+
+private:
+    [[nodiscard]]
+    std::filesystem::path
+    get_path(const Pattern& pattern, std::uint64_t cost_key) const;
+};
+
+} // namespace probfd::pdbs
+
+#endif // PROBFD_PDBS_PDB_CACHE_H
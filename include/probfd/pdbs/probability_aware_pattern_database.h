@@ -10,11 +10,14 @@
 #include "probfd/fdr_types.h"
 
 #include <limits>
+#include <memory>
+#include <span>
 #include <vector>
 
 namespace probfd {
+class MappedFile;
 class ProbabilisticTaskProxy;
-}
+} // namespace probfd
 
 namespace probfd::pdbs {
 class ProjectionStateSpace;
@@ -36,7 +39,11 @@ namespace probfd::pdbs {
  */
 class ProbabilityAwarePatternDatabase {
     StateRankingFunction ranking_function_;
-    std::vector<value_t> value_table_;
+    std::vector<stored_value_t> value_table_;
+
+    // Set if the value table resides in a memory-mapped PDB file.
+    std::shared_ptr<const MappedFile> mapped_file_;
+    std::span<const stored_value_t> mapped_value_table_;
 
     ProbabilityAwarePatternDatabase(
         ProbabilisticTaskProxy task_proxy,
@@ -46,10 +53,25 @@ class ProbabilityAwarePatternDatabase {
         StateRankingFunction ranking_function);
 
 public:
+    /**
+     * @brief Construct a pattern database from a precomputed value table.
+     * If compiled with mixed precision, the values are rounded down to single
+     * precision.
+     */
     ProbabilityAwarePatternDatabase(
         StateRankingFunction ranking_function,
         std::vector<value_t> value_table);
 
+    /**
+     * @brief Construct a pattern database whose value table resides in a
+     * memory-mapped file. The mapping is kept alive as long as the pattern
+     * database exists.
+     */
+    ProbabilityAwarePatternDatabase(
+        StateRankingFunction ranking_function,
+        std::shared_ptr<const MappedFile> mapped_file,
+        std::span<const stored_value_t> value_table);
+
     /**
      * @brief Construct a probability-aware pattern database for a given task
      * and pattern.
@@ -277,9 +299,11 @@ public:
     [[nodiscard]]
     const StateRankingFunction& get_state_ranking_function() const;
 
-    /// Get the abstraction mapping of the pattern database.
+    /// Get the lookup table of the pattern database. If compiled with mixed
+    /// precision, the values are single precision lower bounds of the optimal
+    /// state values.
     [[nodiscard]]
-    const std::vector<value_t>& get_value_table() const;
+    std::span<const stored_value_t> get_value_table() const;
 
     /// Get the number of states in this PDB's projection.
     [[nodiscard]]
@@ -17,6 +17,14 @@ void compute_saturated_costs(
     std::span<const value_t> value_table,
     std::span<value_t> saturated_costs);
 
+#if defined(PROBFD_MIXED_PRECISION)
+/// Computes the saturated costs for the stored lookup table of a PDB.
+void compute_saturated_costs(
+    ProjectionStateSpace& state_space,
+    std::span<const stored_value_t> value_table,
+    std::span<value_t> saturated_costs);
+#endif
+
 } // namespace probfd::pdbs
 
 #endif // PROBFD_PDBS_SATURATION_H
@@ -6,6 +6,7 @@
 #include "probfd/value_type.h"
 
 #include <memory>
+#include <span>
 #include <vector>
 
 // Forward Declarations
@@ -39,6 +40,24 @@ public:
         const std::vector<PatternSubCollection>& subcollections,
         const State& state,
         value_t termination_cost);
+
+    /**
+     * Evaluates a batch of states given their abstract state ranks for every
+     * PDB of the collection, stored PDB-major as computed by
+     * MultiPatternRanking. Stores the value of the i-th state at the i-th
+     * position of \p values.
+     */
+    void evaluate_batch(
+        const PPDBCollection& database,
+        const std::vector<PatternSubCollection>& subcollections,
+        std::span<const StateRank> ranks,
+        std::span<value_t> values,
+        value_t termination_cost);
+
+private:
+    value_t evaluate_subcollections(
+        const std::vector<PatternSubCollection>& subcollections,
+        const std::vector<value_t>& estimates) const;
 };
 
 } // namespace probfd::pdbs
@@ -3,7 +3,10 @@
 
 #include "probfd/pdbs/types.h"
 
+#include "probfd/fdr_types.h"
+
 #include <iosfwd>
+#include <memory>
 #include <vector>
 
 namespace utils {
@@ -15,6 +18,7 @@ class ProbabilisticTaskProxy;
 }
 
 namespace probfd::pdbs {
+class PDBCache;
 class ProjectionStateSpace;
 class ProbabilityAwarePatternDatabase;
 } // namespace probfd::pdbs
@@ -27,6 +31,23 @@ std::vector<int> get_goals_in_random_order(
     ProbabilisticTaskProxy task_proxy,
     utils::RandomNumberGenerator& rng);
 
+/**
+ * @brief Computes the PDBs for all patterns of a pattern collection, using up
+ * to \p num_threads threads (zero means one per hardware thread).
+ *
+ * The i-th PDB of the result belongs to the i-th pattern, independent of the
+ * number of threads. The cost function is only read during the construction.
+ * If a PDB cache is given, cached PDBs are loaded from it and all other PDBs
+ * are stored in it after their construction.
+ */
+PPDBCollection compute_pdbs(
+    const ProbabilisticTaskProxy& task_proxy,
+    const std::shared_ptr<FDRSimpleCostFunction>& task_cost_function,
+    const PatternCollection& patterns,
+    unsigned num_threads,
+    const PDBCache* cache = nullptr,
+    bool operator_pruning = true);
+
 /**
  * @brief Dump the PDB's projection as a dot graph to a specified path with
  * or without transition labels shown.
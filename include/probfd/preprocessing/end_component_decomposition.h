@@ -20,9 +20,23 @@ namespace utils {
 class CountdownTimer;
 }
 
+namespace probfd {
+class ThreadPool;
+}
+
 /// This namespace contains preprocessing algorithms for SSPs.
 namespace probfd::preprocessing {
 
+/**
+ * @brief Statistics of a single worker thread of the parallel decomposition.
+ */
+struct ECDThreadStatistics {
+    unsigned long long decompositions = 0;
+
+    // Wall-clock seconds spent decomposing SCCs.
+    double time = 0.0;
+};
+
 /**
  * @brief Contains printable statistics for the end component decomposition.
  */
@@ -45,6 +59,22 @@ struct ECDStatistics {
 
     utils::Timer time;
 
+    // Wall-clock seconds of the Tarjan pass over the MDP, excluding the
+    // recursive decompositions of its SCCs in serial mode.
+    double exploration_time = 0.0;
+
+    // Wall-clock seconds of the recursive decompositions in serial mode. In
+    // parallel mode, the seconds spent waiting for the decompositions still
+    // running after the Tarjan pass.
+    double decomposition_time = 0.0;
+
+    // Parallel mode only. Wall-clock seconds spent building the quotients
+    // of the end components found by the worker threads.
+    double quotient_time = 0.0;
+
+    // Only filled in parallel mode, one entry per worker thread.
+    std::vector<ECDThreadStatistics> thread_statistics;
+
     void print(std::ostream& out) const;
 };
 
@@ -77,6 +107,13 @@ struct ECDStatistics {
  * it easy to extendt the final potimal value function for the quotient to
  * the optimal value function for the original MDP.
  *
+ * If more than one thread is requested, the SCCs of the MDP that have to be
+ * decomposed recursively are handed off to a thread pool while the Tarjan
+ * pass over the MDP continues on the calling thread. The recursive
+ * decompositions only need the zero-cost transitions inside the SCC, which
+ * are copied into the task, so they never access the MDP. The quotients of
+ * the end components they find are built on the calling thread afterwards.
+ *
  * @see algorithms::interval_iteration::IntervalIteration
  *
  * @tparam State - The state type of the underlying state space.
@@ -145,17 +182,35 @@ class EndComponentDecomposition {
     };
 
     struct StackInfo;
+    struct DecompositionTask;
+    struct EndComponentCollector;
 
     const bool expand_goals_;
+    const unsigned num_threads_;
 
     storage::PerStateStorage<StateInfo> state_infos_;
     std::deque<ExpansionInfo> expansion_queue_;
     std::vector<StackInfo> stack_;
 
+    // Parallel mode only. The pool running the recursive decompositions
+    // during build_quotient_system() and the decompositions themselves.
+    ThreadPool* pool_ = nullptr;
+    std::deque<DecompositionTask> tasks_;
+
     ECDStatistics stats_;
 
 public:
-    explicit EndComponentDecomposition(bool expand_goals);
+    /**
+     * @brief Constructs the decomposition.
+     *
+     * @param expand_goals - Whether goal states are expanded.
+     * @param num_threads - The number of threads used to decompose
+     * independent SCCs concurrently. Values greater than one enable the
+     * parallel mode.
+     */
+    explicit EndComponentDecomposition(
+        bool expand_goals,
+        unsigned num_threads = 1);
 
     /**
      * @brief Build the quotient of the MDP with respect to the maximal end
@@ -187,7 +242,7 @@ private:
     bool push(StateID state_id, StateInfo& info);
 
     void find_and_decompose_sccs(
-        QSystem& sys,
+        auto& sys,
         unsigned limit,
         utils::CountdownTimer& timer,
         auto&... mdp_and_h);
@@ -200,12 +255,26 @@ private:
 
     template <bool RootIteration>
     void scc_found(
-        QSystem& sys,
+        auto& sys,
         ExpansionInfo& e,
         StackInfo& s,
         utils::CountdownTimer& timer);
 
-    void decompose(QSystem& sys, unsigned start, utils::CountdownTimer& timer);
+    void decompose(auto& sys, unsigned start, utils::CountdownTimer& timer);
+
+    /**
+     * Moves the SCC starting at the given stack index into a new
+     * decomposition task and submits it to the thread pool.
+     */
+    void submit_decomposition(unsigned start, utils::CountdownTimer& timer);
+
+    /**
+     * Recursively decomposes the SCC of a task, collecting the end
+     * components found in the task.
+     */
+    void run_decomposition(
+        DecompositionTask& task,
+        utils::CountdownTimer& timer);
 };
 
 } // namespace probfd::preprocessing
@@ -2,11 +2,14 @@
 #error "This file should only be included from end_component_decomposition.h"
 #endif
 
+#include "probfd/utils/guards.h"
 #include "probfd/utils/language.h"
+#include "probfd/utils/thread_pool.h"
 
 #include "downward/utils/countdown_timer.h"
 
 #include <cassert>
+#include <chrono>
 #include <ranges>
 #include <type_traits>
 
@@ -25,6 +28,20 @@ inline void ECDStatistics::print(std::ostream& out) const
     out << "  End-component transitions: " << ec_transitions << std::endl;
     out << "  Recursive calls: " << recursions << std::endl;
     out << "  End component computation: " << time << std::endl;
+    out << "  Exploration time: " << exploration_time << "s" << std::endl;
+    out << "  Decomposition time: " << decomposition_time << "s"
+        << std::endl;
+
+    if (thread_statistics.empty()) return;
+
+    out << "  Quotient construction time: " << quotient_time << "s"
+        << std::endl;
+
+    for (std::size_t i = 0; i != thread_statistics.size(); ++i) {
+        const ECDThreadStatistics& thread_stats = thread_statistics[i];
+        out << "  Thread " << i << ": " << thread_stats.decompositions
+            << " decomposition(s), " << thread_stats.time << "s" << std::endl;
+    }
 }
 
 template <typename State, typename Action>
@@ -144,10 +161,53 @@ struct EndComponentDecomposition<State, Action>::StackInfo {
     }
 };
 
+template <typename State, typename Action>
+struct EndComponentDecomposition<State, Action>::DecompositionTask {
+    // The states of the SCC. Their state IDs and successors are local,
+    // i.e., indices into this vector.
+    std::vector<StackInfo> states;
+    std::vector<bool> expandable_goals;
+
+    // Maps local state IDs to the state IDs of the MDP.
+    std::vector<StateID> state_ids;
+
+    // The end components found. The representative comes first.
+    std::vector<std::vector<StackInfo>> end_components;
+
+    ECDStatistics stats;
+};
+
+/*
+ * Stands in for the quotient system during the decomposition of a task.
+ * Translates the end components back to the state IDs of the MDP and stores
+ * them in the task.
+ */
+template <typename State, typename Action>
+struct EndComponentDecomposition<State, Action>::EndComponentCollector {
+    DecompositionTask& task;
+
+    void build_new_quotient(auto scc, StackInfo& repr)
+    {
+        assert(&repr == &*scc.begin());
+        (void)repr;
+
+        auto& end_component = task.end_components.emplace_back();
+        end_component.reserve(scc.size());
+
+        for (StackInfo& stk_info : scc) {
+            StackInfo& copy =
+                end_component.emplace_back(task.state_ids[stk_info.stateid]);
+            copy.aops = std::move(stk_info.aops);
+        }
+    }
+};
+
 template <typename State, typename Action>
 EndComponentDecomposition<State, Action>::EndComponentDecomposition(
-    bool expand_goals)
+    bool expand_goals,
+    unsigned num_threads)
     : expand_goals_(expand_goals)
+    , num_threads_(num_threads)
 {
 }
 
@@ -165,8 +225,65 @@ auto EndComponentDecomposition<State, Action>::build_quotient_system(
 
     auto init_id = mdp.get_state_id(initial_state);
 
-    if (push(init_id, state_infos_[init_id], mdp, pruning_function)) {
-        find_and_decompose_sccs(*sys, 0, timer, mdp, pruning_function);
+    const auto start = std::chrono::steady_clock::now();
+
+    if (num_threads_ <= 1) {
+        if (push(init_id, state_infos_[init_id], mdp, pruning_function)) {
+            find_and_decompose_sccs(*sys, 0, timer, mdp, pruning_function);
+        }
+
+        stats_.exploration_time =
+            std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start)
+                .count() -
+            stats_.decomposition_time;
+    } else {
+        scope_exit _([this] {
+            pool_ = nullptr;
+            tasks_.clear();
+        });
+
+        stats_.thread_statistics.assign(num_threads_, ECDThreadStatistics());
+
+        {
+            ThreadPool pool(num_threads_);
+            pool_ = &pool;
+
+            if (push(init_id, state_infos_[init_id], mdp, pruning_function)) {
+                find_and_decompose_sccs(*sys, 0, timer, mdp, pruning_function);
+            }
+
+            const auto explored = std::chrono::steady_clock::now();
+            stats_.exploration_time =
+                std::chrono::duration<double>(explored - start).count();
+
+            pool.wait();
+
+            stats_.decomposition_time = std::chrono::duration<double>(
+                                            std::chrono::steady_clock::now() -
+                                            explored)
+                                            .count();
+        }
+
+        const auto quotient_start = std::chrono::steady_clock::now();
+
+        // Build the quotients in submission order, so that the quotient
+        // system does not depend on the thread schedule.
+        for (DecompositionTask& task : tasks_) {
+            for (auto& end_component : task.end_components) {
+                sys->build_new_quotient(end_component, end_component.front());
+            }
+
+            stats_.ec1 += task.stats.ec1;
+            stats_.eck += task.stats.eck;
+            stats_.ec_transitions += task.stats.ec_transitions;
+            stats_.recursions += task.stats.recursions;
+        }
+
+        stats_.quotient_time = std::chrono::duration<double>(
+                                   std::chrono::steady_clock::now() -
+                                   quotient_start)
+                                   .count();
     }
 
     assert(stack_.empty());
@@ -315,7 +432,7 @@ bool EndComponentDecomposition<State, Action>::push(
 
 template <typename State, typename Action>
 void EndComponentDecomposition<State, Action>::find_and_decompose_sccs(
-    QSystem& sys,
+    auto& sys,
     const unsigned limit,
     utils::CountdownTimer& timer,
     auto&... mdp_and_h)
@@ -447,14 +564,14 @@ bool EndComponentDecomposition<State, Action>::push_successor(
 template <typename State, typename Action>
 template <bool RootIteration>
 void EndComponentDecomposition<State, Action>::scc_found(
-    QSystem& sys,
+    auto& sys,
     ExpansionInfo& e,
     StackInfo& s,
     utils::CountdownTimer& timer)
 {
     auto scc = stack_ | std::views::drop(e.stck);
 
-    if (scc.size()) {
+    if (scc.size() == 1) {
         assert(s.aops.empty());
         const StateID scc_repr_id = s.stateid;
         StateInfo& info = state_infos_[scc_repr_id];
@@ -488,12 +605,29 @@ void EndComponentDecomposition<State, Action>::scc_found(
                 ++stats_.sccsk;
             }
 
+            if constexpr (RootIteration) {
+                if (pool_) {
+                    submit_decomposition(e.stck, timer);
+                    assert(stack_.size() == e.stck);
+                    return;
+                }
+            }
+
             for (const auto& stk_info : scc) {
                 assert(stk_info.successors.size() == stk_info.aops.size());
                 state_infos_[stk_info.stateid].explored = 0;
             }
 
-            decompose(sys, e.stck, timer);
+            if constexpr (RootIteration) {
+                const auto start = std::chrono::steady_clock::now();
+                decompose(sys, e.stck, timer);
+                stats_.decomposition_time +=
+                    std::chrono::duration<double>(
+                        std::chrono::steady_clock::now() - start)
+                        .count();
+            } else {
+                decompose(sys, e.stck, timer);
+            }
         } else {
             unsigned transitions = 0;
 
@@ -523,7 +657,7 @@ void EndComponentDecomposition<State, Action>::scc_found(
 
 template <typename State, typename Action>
 void EndComponentDecomposition<State, Action>::decompose(
-    QSystem& sys,
+    auto& sys,
     unsigned start,
     utils::CountdownTimer& timer)
 {
@@ -544,4 +678,76 @@ void EndComponentDecomposition<State, Action>::decompose(
     assert(expansion_queue_.size() == limit);
 }
 
+template <typename State, typename Action>
+void EndComponentDecomposition<State, Action>::submit_decomposition(
+    unsigned start,
+    utils::CountdownTimer& timer)
+{
+    auto scc = stack_ | std::views::drop(start);
+
+    DecompositionTask& task = tasks_.emplace_back();
+    task.states.reserve(scc.size());
+    task.expandable_goals.reserve(scc.size());
+    task.state_ids.reserve(scc.size());
+
+    // Translate to local state IDs while the states are still on the stack.
+    for (StackInfo& stk_info : scc) {
+        assert(stk_info.successors.size() == stk_info.aops.size());
+
+        for (auto& successors : stk_info.successors) {
+            for (StateID& succ_id : successors) {
+                assert(state_infos_[succ_id].onstack());
+                succ_id = state_infos_[succ_id].stackid - start;
+            }
+        }
+
+        const StateInfo& info = state_infos_[stk_info.stateid];
+        task.state_ids.push_back(stk_info.stateid);
+        task.expandable_goals.push_back(info.expandable_goal);
+
+        StackInfo& local = task.states.emplace_back(task.states.size());
+        local.aops = std::move(stk_info.aops);
+        local.successors = std::move(stk_info.successors);
+    }
+
+    // The states are closed from the point of view of the Tarjan pass.
+    for (const StateID state_id : task.state_ids) {
+        state_infos_[state_id].stackid = StateInfo::UNDEF;
+    }
+
+    stack_.erase(scc.begin(), scc.end());
+
+    pool_->submit([this, &task, &timer] { run_decomposition(task, timer); });
+}
+
+template <typename State, typename Action>
+void EndComponentDecomposition<State, Action>::run_decomposition(
+    DecompositionTask& task,
+    utils::CountdownTimer& timer)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    EndComponentDecomposition worker(expand_goals_);
+
+    for (unsigned i = 0; i != task.states.size(); ++i) {
+        StateInfo& info = worker.state_infos_[StateID(i)];
+        info.stackid = i;
+        info.expandable_goal = task.expandable_goals[i];
+    }
+
+    worker.stack_ = std::move(task.states);
+
+    EndComponentCollector collector{task};
+    worker.decompose(collector, 0, timer);
+
+    task.stats = worker.stats_;
+
+    ECDThreadStatistics& thread_stats =
+        stats_.thread_statistics[pool_->get_worker_index()];
+    ++thread_stats.decompositions;
+    thread_stats.time += std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - start)
+                             .count();
+}
+
 } // namespace probfd::preprocessing
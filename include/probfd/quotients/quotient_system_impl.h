@@ -661,12 +661,14 @@ void QuotientSystem<State, Action>::build_new_quotient(
         is_goal = is_goal || mem_term.is_goal_state();
 
         // Generate the applicable actions
+        const size_t prev_size = qinfo.aops_.size();
         mdp_.generate_applicable_actions(mem, qinfo.aops_);
 
-        // Partition actions
-        auto [pivot, last] = partition_actions(qinfo.aops_, aops);
+        // Partition the new actions
+        auto new_aops = qinfo.aops_ | std::views::drop(prev_size);
+        auto [pivot, last] = partition_actions(new_aops, aops);
 
-        b.num_outer_acts = std::distance(qinfo.aops_.begin(), pivot);
+        b.num_outer_acts = std::distance(new_aops.begin(), pivot);
         b.num_inner_acts = std::distance(pivot, last);
 
         qinfo.total_num_outer_acts_ += b.num_outer_acts;
@@ -73,6 +73,9 @@ public:
         utils::Verbosity verbosity,
         std::vector<std::shared_ptr<::Evaluator>> path_dependent_evaluators,
         bool cache,
+        int cache_memory_limit,
+        bool flat_successor_generator,
+        std::optional<std::string> state_storage_directory,
         const std::shared_ptr<TaskEvaluatorFactory>& eval,
         std::optional<value_t> report_epsilon,
         bool report_enabled,
@@ -98,6 +101,9 @@ public:
         utils::Verbosity verbosity,
         std::vector<std::shared_ptr<::Evaluator>> path_dependent_evaluators,
         bool cache,
+        int cache_memory_limit,
+        bool flat_successor_generator,
+        std::optional<std::string> state_storage_directory,
         const std::shared_ptr<TaskEvaluatorFactory>& eval,
         std::optional<value_t> report_epsilon,
         bool report_enabled,
@@ -141,6 +147,9 @@ public:
         utils::Verbosity verbosity,
         std::vector<std::shared_ptr<::Evaluator>> path_dependent_evaluators,
         bool cache,
+        int cache_memory_limit,
+        bool flat_successor_generator,
+        std::optional<std::string> state_storage_directory,
         const std::shared_ptr<TaskEvaluatorFactory>& eval,
         std::optional<value_t> report_epsilon,
         bool report_enabled,
@@ -225,6 +234,9 @@ public:
         utils::Verbosity verbosity,
         std::vector<std::shared_ptr<::Evaluator>> path_dependent_evaluators,
         bool cache,
+        int cache_memory_limit,
+        bool flat_successor_generator,
+        std::optional<std::string> state_storage_directory,
         const std::shared_ptr<TaskEvaluatorFactory>& eval,
         std::optional<value_t> report_epsilon,
         bool report_enabled,
@@ -269,6 +281,9 @@ public:
         utils::Verbosity verbosity,
         std::vector<std::shared_ptr<::Evaluator>> path_dependent_evaluators,
         bool cache,
+        int cache_memory_limit,
+        bool flat_successor_generator,
+        std::optional<std::string> state_storage_directory,
         const std::shared_ptr<TaskEvaluatorFactory>& eval,
         std::optional<value_t> report_epsilon,
         bool report_enabled,
@@ -11,10 +11,13 @@
 #include "downward/utils/logging.h"
 
 #include <memory>
+#include <memory_resource>
+#include <optional>
 #include <string>
 
 // Forward Declarations
 namespace probfd {
+class MappedMemoryResource;
 class ProbabilisticTask;
 class TaskCostFunctionFactory;
 class TaskEvaluatorFactory;
@@ -33,6 +36,11 @@ class MDPSolver : public SolverInterface {
 protected:
     const std::shared_ptr<ProbabilisticTask> task_;
 
+private:
+    // Backs the state arena and per-state arrays if they are kept on disk.
+    const std::unique_ptr<MappedMemoryResource> state_memory_;
+
+protected:
     const std::unique_ptr<TaskStateSpace> task_mdp_;
     const std::shared_ptr<FDRCostFunction> task_cost_function_;
 
@@ -53,6 +61,9 @@ public:
         utils::Verbosity verbosity,
         std::vector<std::shared_ptr<::Evaluator>> path_dependent_evaluators,
         bool cache,
+        int cache_memory_limit,
+        bool flat_successor_generator,
+        std::optional<std::string> state_storage_directory,
         std::shared_ptr<TaskEvaluatorFactory> heuristic_factory,
         std::optional<value_t> report_epsilon,
         bool report_enabled,
@@ -62,6 +73,15 @@ public:
 
     ~MDPSolver() override;
 
+    /**
+     * @brief Returns the memory resource from which algorithms should
+     * allocate per-state arrays that grow with the state space.
+     *
+     * This is a file-backed resource if a state storage directory was
+     * specified and the default resource otherwise.
+     */
+    std::pmr::memory_resource* get_per_state_memory() const;
+
     /**
      * @brief Factory method a new instance of the encapsulated MDP algorithm.
      */
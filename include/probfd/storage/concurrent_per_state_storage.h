@@ -0,0 +1,87 @@
+#ifndef PROBFD_STORAGE_CONCURRENT_PER_STATE_STORAGE_H
+#define PROBFD_STORAGE_CONCURRENT_PER_STATE_STORAGE_H
+
+#include "probfd/types.h"
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+
+namespace probfd::storage {
+
+/**
+ * @brief A per-state storage which can be accessed by multiple threads
+ * concurrently.
+ *
+ * The elements are stored in fixed-size segments which are allocated on first
+ * access and never moved afterwards, so that references to elements stay
+ * valid while other threads access, and thereby allocate, other elements.
+ * Segments are published through a fixed array of atomic pointers, so the
+ * storage itself never needs to be resized.
+ *
+ * Concurrent accesses to the same element must be synchronized by the
+ * element type itself.
+ *
+ * @tparam Element - The element type. Must be default constructible.
+ */
+template <typename Element>
+class ConcurrentPerStateStorage {
+    static constexpr std::size_t SEGMENT_BITS = 14;
+    static constexpr std::size_t SEGMENT_SIZE = std::size_t(1) << SEGMENT_BITS;
+    // Covers all non-negative 32-bit state ids of the state registry.
+    static constexpr std::size_t MAX_SEGMENTS =
+        (std::size_t(1) << 31) >> SEGMENT_BITS;
+
+    std::unique_ptr<std::atomic<Element*>[]> segments_;
+
+public:
+    ConcurrentPerStateStorage()
+        : segments_(new std::atomic<Element*>[MAX_SEGMENTS])
+    {
+        for (std::size_t i = 0; i != MAX_SEGMENTS; ++i) {
+            segments_[i].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    ~ConcurrentPerStateStorage()
+    {
+        for (std::size_t i = 0; i != MAX_SEGMENTS; ++i) {
+            delete[] segments_[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    ConcurrentPerStateStorage(const ConcurrentPerStateStorage&) = delete;
+    ConcurrentPerStateStorage&
+    operator=(const ConcurrentPerStateStorage&) = delete;
+
+    Element& operator[](StateID state_id)
+    {
+        const std::size_t index = state_id;
+        assert(index >> SEGMENT_BITS < MAX_SEGMENTS);
+
+        std::atomic<Element*>& slot = segments_[index >> SEGMENT_BITS];
+        Element* segment = slot.load(std::memory_order_acquire);
+
+        if (!segment) {
+            // Threads racing for the same segment allocate their own one,
+            // the losers delete it again.
+            Element* expected = nullptr;
+            segment = new Element[SEGMENT_SIZE];
+            if (!slot.compare_exchange_strong(
+                    expected,
+                    segment,
+                    std::memory_order_acq_rel,
+                    std::memory_order_acquire)) {
+                delete[] segment;
+                segment = expected;
+            }
+        }
+
+        return segment[index & (SEGMENT_SIZE - 1)];
+    }
+};
+
+} // namespace probfd::storage
+
+#endif // PROBFD_STORAGE_CONCURRENT_PER_STATE_STORAGE_H
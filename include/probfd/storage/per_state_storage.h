@@ -7,6 +7,7 @@
 
 #include "downward/algorithms/segmented_vector.h"
 
+#include <memory_resource>
 #include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
@@ -55,7 +56,7 @@ public:
     explicit PerStateStorage(
         const Element& default_value = Element(),
         const Allocator& alloc = Allocator())
-        : segmented_vector::SegmentedVector<Element>(alloc)
+        : segmented_vector::SegmentedVector<Element, Allocator>(alloc)
         , default_value_(default_value)
     {
     }
@@ -85,6 +86,11 @@ public:
     }
 };
 
+/// A PerStateStorage which allocates its memory from a memory resource.
+template <class Element>
+using PolymorphicPerStateStorage =
+    PerStateStorage<Element, std::pmr::polymorphic_allocator<Element>>;
+
 template <
     typename T,
     typename Hash = std::hash<StateID>,
@@ -1,6 +1,7 @@
 #ifndef PROBFD_TASK_STATE_SPACE_H
 #define PROBFD_TASK_STATE_SPACE_H
 
+#include "probfd/task_utils/outcome_deltas.h"
 #include "probfd/task_utils/probabilistic_successor_generator.h"
 
 #include "probfd/fdr_types.h"
@@ -16,6 +17,7 @@
 
 #include <cstddef>
 #include <memory>
+#include <memory_resource>
 #include <vector>
 
 // Forward Declarations
@@ -55,17 +57,24 @@ protected:
 
     StateRegistry state_registry_;
     successor_generator::ProbabilisticSuccessorGenerator gen_;
+    OutcomeDeltas outcome_deltas_;
 
     const std::vector<std::shared_ptr<::Evaluator>> notify_;
 
     Statistics statistics_;
 
+    // Scratch space for the successors of the outcomes of one operator.
+    std::vector<::StateID> outcome_successors_;
+
 public:
     TaskStateSpace(
         std::shared_ptr<ProbabilisticTask> task,
         utils::LogProxy log,
         std::vector<std::shared_ptr<::Evaluator>> path_dependent_evaluators =
-            {});
+            {},
+        bool flat_successor_generator = false,
+        std::pmr::memory_resource* state_memory =
+            std::pmr::get_default_resource());
 
     StateID get_state_id(const State& state) final;
     State get_state(StateID state_id) final;
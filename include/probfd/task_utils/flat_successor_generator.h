@@ -0,0 +1,84 @@
+#ifndef PROBFD_TASK_UTILS_FLAT_SUCCESSOR_GENERATOR_H
+#define PROBFD_TASK_UTILS_FLAT_SUCCESSOR_GENERATOR_H
+
+#include "downward/algorithms/int_packer.h"
+
+#include <cstddef>
+#include <vector>
+
+// Forward Declarations
+class OperatorID;
+class State;
+class PlanningTaskProxy;
+class VariablesProxy;
+
+namespace probfd::successor_generator {
+class ProbabilisticGeneratorBase;
+}
+
+namespace probfd::successor_generator {
+
+/*
+  The node types of the flat successor generator. A node is a sequence of
+  ints starting with its node type, children are referenced by their offset
+  in the code vector:
+
+  - fork:          [FORK, n, child_1, ..., child_n]
+  - vector switch: [SWITCH_VECTOR, var, child_0, ..., child_{d-1}], where d
+                   is the domain size of var and missing children are -1
+  - sorted switch: [SWITCH_SORTED, var, k, value_1, ..., value_k,
+                    child_1, ..., child_k], where the values are ascending
+  - single switch: [SWITCH_SINGLE, var, value, child]
+  - leaf:          [LEAF, n, op_id_1, ..., op_id_n]
+
+  Sorted switches replace the hash switches of the tree representation, so
+  that the whole generator lives in one vector.
+*/
+enum FlatNodeType : int {
+    FORK,
+    SWITCH_VECTOR,
+    SWITCH_SORTED,
+    SWITCH_SINGLE,
+    LEAF
+};
+
+/*
+  A successor generator compiled from the tree of ProbabilisticGeneratorBase
+  nodes into one contiguous vector of ints. It is evaluated in a loop without
+  virtual calls. The values of registered states are decoded from their
+  packed buffers into scratch space, so the state is not unpacked.
+
+  Generates the same operators in the same order as the tree it was compiled
+  from.
+*/
+class FlatSuccessorGenerator {
+    std::vector<int> code_;
+    std::vector<int_packer::IntPacker::BitPosition> bit_positions_;
+
+    // Bounds the number of fork children pending during the evaluation.
+    std::size_t max_pending_;
+
+public:
+    FlatSuccessorGenerator(
+        const PlanningTaskProxy& task_proxy,
+        const ProbabilisticGeneratorBase& root);
+
+    void generate_applicable_ops(
+        const State& state,
+        std::vector<OperatorID>& applicable_ops) const;
+
+    std::size_t get_code_size_in_bytes() const;
+
+private:
+    std::size_t
+    compute_max_pending(const VariablesProxy& variables, int offset) const;
+
+    template <typename ValueReader>
+    void generate_applicable_ops(
+        const ValueReader& get_value,
+        std::vector<OperatorID>& applicable_ops) const;
+};
+
+} // namespace probfd::successor_generator
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef PROBFD_TASK_UTILS_OUTCOME_DELTAS_H
+#define PROBFD_TASK_UTILS_OUTCOME_DELTAS_H
+
+#include "downward/algorithms/int_packer.h"
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+// Forward Declarations
+class OperatorID;
+
+namespace probfd {
+class ProbabilisticTaskProxy;
+}
+
+namespace probfd {
+
+/**
+ * @brief Precomputes the effects of the operator outcomes of a task as
+ * bin-level deltas on packed states.
+ *
+ * The unconditional effects of an outcome always change the same bits of a
+ * packed state, so they can be merged into one (keep mask, value) pair per
+ * changed bin. Applying an outcome then takes one AND and one OR per bin,
+ * instead of evaluating every effect through the task interface and setting
+ * its variable with IntPacker::set.
+ *
+ * Only operators whose outcomes have no conditional effects get deltas, the
+ * others have to use the generic path. Tasks with axioms get no deltas at
+ * all, since their successors have to be completed by the axiom evaluator.
+ *
+ * The deltas are laid out for StateRegistry::get_successor_states.
+ */
+class OutcomeDeltas {
+public:
+    using BinDelta = int_packer::IntPacker::BinDelta;
+
+private:
+    // Outcomes of operator i are outcome_offsets_[first_outcome_[i]] on.
+    std::vector<int> first_outcome_;
+    // Deltas of outcome j are deltas_[outcome_offsets_[j]] to
+    // deltas_[outcome_offsets_[j + 1]].
+    std::vector<int> outcome_offsets_;
+    std::vector<BinDelta> deltas_;
+    std::vector<bool> has_deltas_;
+    int num_operators_with_deltas_ = 0;
+
+public:
+    OutcomeDeltas(
+        const ProbabilisticTaskProxy& task_proxy,
+        const int_packer::IntPacker& state_packer);
+
+    /// Returns whether deltas were precomputed for the given operator.
+    bool has_deltas(OperatorID op_id) const;
+
+    /// Returns the deltas of all outcomes of all operators.
+    std::span<const BinDelta> get_deltas() const { return deltas_; }
+
+    /**
+     * @brief Returns the offsets of the deltas of the outcomes of the given
+     * operator in get_deltas(), one more than the number of outcomes.
+     */
+    std::span<const int> get_outcome_offsets(OperatorID op_id) const;
+
+    int get_num_operators_with_deltas() const
+    {
+        return num_operators_with_deltas_;
+    }
+
+    std::size_t get_size_in_bytes() const;
+};
+
+} // namespace probfd
+
+#endif // PROBFD_TASK_UTILS_OUTCOME_DELTAS_H
@@ -17,15 +17,25 @@ struct Transition;
 
 namespace probfd::successor_generator {
 class ProbabilisticGeneratorBase;
-}
+class FlatSuccessorGenerator;
+} // namespace probfd::successor_generator
 
 namespace probfd::successor_generator {
 class ProbabilisticSuccessorGenerator {
     std::unique_ptr<ProbabilisticGeneratorBase> root_;
 
+    // Only set if the flat representation is used.
+    std::unique_ptr<FlatSuccessorGenerator> flat_;
+
 public:
+    /*
+      If flat is true, the generator tree is compiled into a
+      FlatSuccessorGenerator, which is used to generate the applicable
+      operators instead.
+    */
     explicit ProbabilisticSuccessorGenerator(
-        const PlanningTaskProxy& task_proxy);
+        const PlanningTaskProxy& task_proxy,
+        bool flat = false);
     /*
       We cannot use the default destructor (implicitly or explicitly)
       here because GeneratorBase is a forward declaration and the
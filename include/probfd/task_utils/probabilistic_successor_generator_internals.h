@@ -29,6 +29,12 @@ public:
         const State& state,
         std::vector<Transition<OperatorID>>& transitions,
         TaskStateSpace& task_state_space) const = 0;
+
+    /*
+      Appends the flat representation of this node and its descendants to
+      code and returns the offset of this node. See FlatSuccessorGenerator.
+    */
+    virtual int compile(std::vector<int>& code) const = 0;
 };
 
 class ProbabilisticGeneratorForkBinary : public ProbabilisticGeneratorBase {
@@ -48,6 +54,8 @@ public:
         const State& state,
         std::vector<Transition<OperatorID>>& transitions,
         TaskStateSpace& task_state_space) const override;
+
+    int compile(std::vector<int>& code) const override;
 };
 
 class ProbabilisticGeneratorForkMulti : public ProbabilisticGeneratorBase {
@@ -65,6 +73,8 @@ public:
         const State& state,
         std::vector<Transition<OperatorID>>& transitions,
         TaskStateSpace& task_state_space) const override;
+
+    int compile(std::vector<int>& code) const override;
 };
 
 class ProbabilisticGeneratorSwitchVector : public ProbabilisticGeneratorBase {
@@ -86,6 +96,8 @@ public:
         const State& state,
         std::vector<Transition<OperatorID>>& transitions,
         TaskStateSpace& task_state_space) const override;
+
+    int compile(std::vector<int>& code) const override;
 };
 
 class ProbabilisticGeneratorSwitchHash : public ProbabilisticGeneratorBase {
@@ -107,6 +119,8 @@ public:
         const State& state,
         std::vector<Transition<OperatorID>>& transitions,
         TaskStateSpace& task_state_space) const override;
+
+    int compile(std::vector<int>& code) const override;
 };
 
 class ProbabilisticGeneratorSwitchSingle : public ProbabilisticGeneratorBase {
@@ -128,6 +142,8 @@ public:
         const State& state,
         std::vector<Transition<OperatorID>>& transitions,
         TaskStateSpace& task_state_space) const override;
+
+    int compile(std::vector<int>& code) const override;
 };
 
 class ProbabilisticGeneratorLeafVector : public ProbabilisticGeneratorBase {
@@ -145,6 +161,8 @@ public:
         const State& state,
         std::vector<Transition<OperatorID>>& transitions,
         TaskStateSpace& task_state_space) const override;
+
+    int compile(std::vector<int>& code) const override;
 };
 
 class ProbabilisticGeneratorLeafSingle : public ProbabilisticGeneratorBase {
@@ -161,6 +179,8 @@ public:
         const State& state,
         std::vector<Transition<OperatorID>>& transitions,
         TaskStateSpace& task_state_space) const override;
+
+    int compile(std::vector<int>& code) const override;
 };
 
 } // namespace probfd::successor_generator
@@ -1,6 +1,7 @@
 #ifndef PROBFD_TASKS_ROOT_TASK_H
 #define PROBFD_TASKS_ROOT_TASK_H
 
+#include <filesystem>
 #include <memory>
 #include <ostream>
 
@@ -15,7 +16,32 @@ namespace probfd::tasks {
 extern std::shared_ptr<ProbabilisticTask> g_root_task;
 
 extern std::unique_ptr<ProbabilisticTask> read_sas_task(std::istream& in);
+
+/**
+ * @brief Reads a task from a file in the binary SAS format.
+ *
+ * The file is memory-mapped and the task is built directly from the mapped
+ * data. The file is validated while reading; invalid files, including files
+ * written by a different format version or on a machine with a different
+ * byte order, terminate the planner with an input error.
+ *
+ * @see convert_sas_task_to_binary
+ */
+extern std::unique_ptr<ProbabilisticTask>
+read_binary_sas_task(const std::filesystem::path& path);
+
+/**
+ * @brief Reads a task in the text SAS format and writes it in the binary SAS
+ * format.
+ *
+ * The binary format stores the task after the metric has been applied to the
+ * operator costs and the termination cost.
+ */
+extern void convert_sas_task_to_binary(std::istream& in, std::ostream& out);
+
 extern std::shared_ptr<ProbabilisticTask> read_root_tasks(std::istream& in);
+extern std::shared_ptr<ProbabilisticTask>
+read_binary_root_tasks(const std::filesystem::path& path);
 
 extern void set_root_task(std::shared_ptr<ProbabilisticTask> task);
 
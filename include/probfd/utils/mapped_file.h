@@ -0,0 +1,44 @@
+#ifndef PROBFD_UTILS_MAPPED_FILE_H
+#define PROBFD_UTILS_MAPPED_FILE_H
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+namespace probfd {
+
+/**
+ * @brief A read-only, memory-mapped file.
+ *
+ * The file is mapped privately with read-only protection, so that the page
+ * cache is shared between all processes mapping the same file. On systems
+ * without mmap, the file contents are read into memory instead.
+ */
+class MappedFile {
+    const std::byte* data_ = nullptr;
+    std::size_t size_ = 0;
+
+    // Only used if memory mapping is unavailable.
+    std::vector<std::byte> buffer_;
+
+public:
+    /**
+     * @brief Maps the file at the given path.
+     *
+     * @throws std::system_error if the file cannot be opened or mapped.
+     */
+    explicit MappedFile(const std::filesystem::path& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /// Returns the contents of the file.
+    [[nodiscard]]
+    std::span<const std::byte> get_data() const;
+};
+
+} // namespace probfd
+
+#endif // PROBFD_UTILS_MAPPED_FILE_H
@@ -0,0 +1,97 @@
+#ifndef PROBFD_UTILS_MAPPED_MEMORY_RESOURCE_H
+#define PROBFD_UTILS_MAPPED_MEMORY_RESOURCE_H
+
+#include <cstddef>
+#include <filesystem>
+#include <memory_resource>
+#include <vector>
+
+namespace probfd {
+
+/**
+ * @brief A memory resource which allocates from a temporary file that is
+ * mapped into memory.
+ *
+ * The file is created in the given directory and removed immediately, so it
+ * disappears when the resource is destroyed or the process exits. It grows
+ * by chunks of the given size, each of which is mapped as shared memory.
+ * The operating system writes the pages of the file back to disk under
+ * memory pressure instead of failing, so the allocated memory may exceed the
+ * available RAM.
+ *
+ * Memory is handed out sequentially and only released when the resource is
+ * destroyed. The resource is meant for append-only data such as the state
+ * arena of a state registry or per-state arrays, whose pages are then
+ * written and read back in allocation order.
+ *
+ * On systems without mmap, memory is allocated from the default resource
+ * instead.
+ */
+class MappedMemoryResource : public std::pmr::memory_resource {
+    struct Chunk {
+        std::byte* data;
+        std::size_t size;
+    };
+
+    const std::filesystem::path path_;
+    const std::size_t chunk_size_;
+
+    int fd_ = -1;
+    std::size_t file_size_ = 0;
+
+    std::vector<Chunk> chunks_;
+    std::byte* current_ = nullptr;
+    std::size_t space_left_ = 0;
+
+    std::size_t allocated_bytes_ = 0;
+
+public:
+    static constexpr std::size_t DEFAULT_CHUNK_SIZE = std::size_t(64) << 20;
+
+    /**
+     * @brief Creates the backing file in the given directory.
+     *
+     * @throws std::system_error if the file cannot be created.
+     */
+    explicit MappedMemoryResource(
+        std::filesystem::path directory,
+        std::size_t chunk_size = DEFAULT_CHUNK_SIZE);
+    ~MappedMemoryResource() override;
+
+    MappedMemoryResource(const MappedMemoryResource&) = delete;
+    MappedMemoryResource& operator=(const MappedMemoryResource&) = delete;
+
+    /// Returns the directory of the backing file.
+    [[nodiscard]]
+    const std::filesystem::path& get_directory() const
+    {
+        return path_;
+    }
+
+    /// Returns the number of bytes handed out so far.
+    [[nodiscard]]
+    std::size_t get_allocated_bytes() const
+    {
+        return allocated_bytes_;
+    }
+
+    /// Returns the size of the backing file in bytes.
+    [[nodiscard]]
+    std::size_t get_file_size() const
+    {
+        return file_size_;
+    }
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment)
+        override;
+    bool do_is_equal(const std::pmr::memory_resource& other)
+        const noexcept override;
+
+    void add_chunk(std::size_t min_size);
+};
+
+} // namespace probfd
+
+#endif // PROBFD_UTILS_MAPPED_MEMORY_RESOURCE_H
@@ -0,0 +1,138 @@
+#ifndef PROBFD_UTILS_THREAD_POOL_H
+#define PROBFD_UTILS_THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace probfd {
+
+/**
+ * @brief A fixed-size work-stealing thread pool.
+ *
+ * Every worker owns a task deque. Tasks submitted from within a worker are
+ * pushed to the back of the worker's own deque and popped from the back
+ * again (LIFO), which keeps dependent work on the same core. Idle workers
+ * steal from the front of the deques of other workers. Tasks submitted from
+ * outside of the pool are distributed round-robin.
+ *
+ * If a task throws, the first exception is recorded, all tasks that did not
+ * start yet are discarded, and the exception is rethrown by wait().
+ */
+class ThreadPool {
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::vector<std::thread> workers_;
+
+    std::mutex idle_mutex_;
+    std::condition_variable work_available_;
+    std::condition_variable all_done_;
+
+    // Number of tasks that were submitted but did not finish yet.
+    std::atomic<std::size_t> pending_ = 0;
+    // Number of tasks currently sitting in one of the queues.
+    std::atomic<std::ptrdiff_t> queued_ = 0;
+    std::atomic<std::size_t> next_queue_ = 0;
+    std::atomic<bool> cancelled_ = false;
+    bool shutdown_ = false;
+
+    std::exception_ptr exception_;
+
+public:
+    /**
+     * @brief Starts \p num_threads worker threads.
+     */
+    explicit ThreadPool(unsigned num_threads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Returns the number of worker threads.
+     */
+    [[nodiscard]]
+    unsigned get_num_threads() const;
+
+    /**
+     * @brief Schedules a task for execution.
+     *
+     * May be called from within a running task.
+     */
+    void submit(std::function<void()> task);
+
+    /**
+     * @brief Blocks until all submitted tasks, including those submitted by
+     * other tasks in the meantime, have finished.
+     *
+     * Rethrows the first exception thrown by a task, if any. The pool can
+     * be reused afterwards.
+     */
+    void wait();
+
+    /**
+     * @brief Returns the index of the worker executing the calling thread,
+     * or get_num_threads() if called from a thread outside of this pool.
+     */
+    [[nodiscard]]
+    unsigned get_worker_index() const;
+
+private:
+    void run_worker(unsigned index);
+    bool try_pop(unsigned index, std::function<void()>& task);
+    void finish_task();
+};
+
+/**
+ * @brief Returns the number of threads to use if a user requested \p
+ * num_threads threads, where zero means one thread per hardware thread.
+ */
+unsigned resolve_num_threads(unsigned num_threads);
+
+/**
+ * @brief Calls \p f(i) for every i in [0, n) using up to \p num_threads
+ * threads, where zero means one thread per hardware thread, and waits until
+ * all calls have finished.
+ *
+ * If only one thread is used, the calls are made on the calling thread in
+ * ascending order. Otherwise, the first exception thrown by a call is
+ * rethrown after all running calls have finished.
+ */
+template <typename F>
+void parallel_for(unsigned num_threads, std::size_t n, F&& f)
+{
+    num_threads = resolve_num_threads(num_threads);
+
+    if (num_threads == 1 || n <= 1) {
+        for (std::size_t i = 0; i != n; ++i) {
+            f(i);
+        }
+        return;
+    }
+
+    ThreadPool pool(
+        static_cast<unsigned>(std::min<std::size_t>(num_threads, n)));
+
+    for (std::size_t i = 0; i != n; ++i) {
+        pool.submit([&f, i] { f(i); });
+    }
+
+    pool.wait();
+}
+
+} // namespace probfd
+
+#endif // PROBFD_UTILS_THREAD_POOL_H
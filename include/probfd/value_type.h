@@ -5,6 +5,7 @@
 
 #include <limits>
 #include <string>
+#include <vector>
 
 /// The top-level namespace of probabilistic Fast Downward.
 namespace probfd {
@@ -37,6 +38,25 @@ constexpr value_t operator"" _vt(unsigned long long value)
     return double_to_value(static_cast<double>(value));
 }
 
+/// Rounds a value to the stored value type towards negative infinity, so that
+/// a stored lower bound remains a lower bound.
+stored_value_t to_stored_lower_bound(value_t value);
+
+/// Rounds a value to the stored value type towards positive infinity, so that
+/// a stored upper bound remains an upper bound.
+stored_value_t to_stored_upper_bound(value_t value);
+
+/// Converts a table of lower bounds to the stored value type, rounding
+/// towards negative infinity. Does not copy if the types are the same.
+std::vector<stored_value_t> to_stored_lower_bounds(std::vector<value_t> values);
+
+/**
+ * @brief Returns the largest error introduced by rounding a value of the given
+ * magnitude to the stored value type, i.e., the distance between adjacent
+ * stored values. Returns zero for infinite values.
+ */
+value_t get_stored_value_error(value_t value);
+
 /// Equivalent to \f$|v_1 - v_2| \leq \epsilon\f$
 bool is_approx_equal(value_t v1, value_t v2, value_t epsilon = g_epsilon);
 
@@ -0,0 +1,102 @@
+// Measures how parallel LRTDP scales with the number of threads. Every
+// configuration solves the task from scratch with the blind heuristic.
+//
+// Usage: parallel_lrtdp_benchmark [max_threads] [sas_file]
+//
+// Without a SAS file, a generated blocksworld task is solved.
+
+#include "probfd/algorithms/parallel_lrtdp.h"
+
+#include "probfd/heuristics/constant_evaluator.h"
+
+#include "probfd/tasks/root_task.h"
+
+#include "probfd/progress_report.h"
+#include "probfd/task_cost_function.h"
+#include "probfd/task_proxy.h"
+#include "probfd/task_state_space.h"
+
+#include "downward/utils/logging.h"
+
+#include "tests/tasks/blocksworld.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+
+using namespace probfd;
+using namespace probfd::algorithms::parallel_lrtdp;
+
+namespace {
+
+std::shared_ptr<ProbabilisticTask> load_task(int argc, char** argv)
+{
+    if (argc > 2) {
+        std::ifstream in(argv[2]);
+        return tasks::read_sas_task(in);
+    }
+
+    return std::make_shared<tests::BlocksworldTask>(
+        8,
+        std::vector<std::vector<int>>{{1, 0}, {2}, {5, 4, 3}, {7, 6}},
+        std::vector<std::vector<int>>{{1, 4, 7}, {5, 3, 2, 0, 6}});
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const unsigned max_threads =
+        argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 8;
+
+    std::shared_ptr<ProbabilisticTask> task = load_task(argc, argv);
+    tasks::set_root_task(task);
+
+    std::cout << "Task: " << (argc > 2 ? argv[2] : "blocksworld (8 blocks)")
+              << "\n\n";
+
+    double baseline = 0.0;
+
+    for (unsigned threads = 1; threads <= max_threads; threads *= 2) {
+        heuristics::BlindEvaluator<State> heuristic;
+        TaskCostFunction cost_function(task);
+        TaskStateSpace state_space(task, utils::get_silent_log());
+        CompositeMDP<State, OperatorID> mdp{state_space, cost_function};
+
+        ProgressReport report(std::nullopt, std::cout, false);
+
+        ParallelLRTDP<State, OperatorID, false> lrtdp(
+            TrialTerminationCondition::TERMINAL,
+            threads,
+            0);
+
+        const auto start = std::chrono::steady_clock::now();
+        const Interval value = lrtdp.solve(
+            mdp,
+            heuristic,
+            state_space.get_initial_state(),
+            report,
+            std::numeric_limits<double>::infinity());
+        const auto end = std::chrono::steady_clock::now();
+
+        const double ms =
+            std::chrono::duration<double, std::milli>(end - start).count();
+        if (threads == 1) baseline = ms;
+
+        unsigned long long trials = 0;
+        for (const ThreadStatistics& stats :
+             lrtdp.get_statistics().thread_statistics) {
+            trials += stats.trials;
+        }
+
+        std::cout << std::setw(3) << threads << " thread(s)" << std::setw(12)
+                  << std::fixed << std::setprecision(1) << ms << " ms"
+                  << std::setw(8) << std::setprecision(2) << baseline / ms
+                  << "x  (" << trials << " trials, value "
+                  << std::setprecision(4) << value.lower << ")\n";
+    }
+}
@@ -0,0 +1,153 @@
+// Compares the fused multi-pattern ranking kernel against ranking every
+// pattern separately with its own state ranking function.
+//
+// Usage: pdb_ranking_benchmark [num_blocks] [num_states] [repetitions]
+
+#include "probfd/pdbs/multi_pattern_ranking.h"
+#include "probfd/pdbs/state_ranking_function.h"
+
+#include "probfd/task_proxy.h"
+
+#include "downward/utils/rng.h"
+
+#include "tests/tasks/blocksworld.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+using namespace probfd;
+using namespace probfd::pdbs;
+
+namespace {
+
+template <typename F>
+double measure_ns_per_state(int repetitions, std::size_t num_states, F&& f)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i != repetitions; ++i) {
+        f();
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    const double ns =
+        std::chrono::duration<double, std::nano>(end - start).count();
+    return ns / (static_cast<double>(repetitions) *
+                 static_cast<double>(num_states));
+}
+
+void print_result(
+    const std::string& name,
+    double ns_per_state,
+    double baseline,
+    long long checksum)
+{
+    std::cout << std::left << std::setw(24) << name << std::right
+              << std::setw(12) << std::fixed << std::setprecision(1)
+              << ns_per_state << " ns/state" << std::setw(8)
+              << std::setprecision(2) << baseline / ns_per_state
+              << "x  (checksum " << checksum << ")\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const int num_blocks = argc > 1 ? std::atoi(argv[1]) : 8;
+    const int num_states = argc > 2 ? std::atoi(argv[2]) : 10000;
+    const int repetitions = argc > 3 ? std::atoi(argv[3]) : 20;
+
+    std::vector<int> all_blocks(num_blocks);
+    std::iota(all_blocks.begin(), all_blocks.end(), 0);
+    tests::BlocksworldTask task(num_blocks, {all_blocks}, {all_blocks});
+
+    ProbabilisticTaskProxy task_proxy(task);
+    VariablesProxy variables = task_proxy.get_variables();
+    const int num_variables = static_cast<int>(variables.size());
+
+    // All patterns with one and two variables.
+    std::vector<StateRankingFunction> ranking_functions;
+    for (int i = 0; i != num_variables; ++i) {
+        ranking_functions.emplace_back(variables, Pattern{i});
+        for (int j = i + 1; j != num_variables; ++j) {
+            ranking_functions.emplace_back(variables, Pattern{i, j});
+        }
+    }
+
+    std::vector<const StateRankingFunction*> ranking_function_ptrs;
+    for (const StateRankingFunction& ranking_function : ranking_functions) {
+        ranking_function_ptrs.push_back(&ranking_function);
+    }
+
+    utils::RandomNumberGenerator rng(42);
+
+    std::vector<State> states;
+    states.reserve(num_states);
+    for (int i = 0; i != num_states; ++i) {
+        std::vector<int> values(num_variables);
+        for (int var = 0; var != num_variables; ++var) {
+            values[var] = rng.random(variables[var].get_domain_size());
+        }
+        states.emplace_back(task, std::move(values));
+        states.back().unpack();
+    }
+
+    const std::size_t num_patterns = ranking_functions.size();
+
+    std::cout << "Blocks: " << num_blocks << ", variables: " << num_variables
+              << ", patterns: " << num_patterns << ", states: " << num_states
+              << ", repetitions: " << repetitions << "\n\n";
+
+    long long checksum = 0;
+    const double baseline =
+        measure_ns_per_state(repetitions, states.size(), [&] {
+            checksum = 0;
+            for (const State& state : states) {
+                for (const StateRankingFunction& ranking_function :
+                     ranking_functions) {
+                    checksum += ranking_function.get_abstract_rank(state);
+                }
+            }
+        });
+    print_result("per-PDB loop", baseline, baseline, checksum);
+
+    std::vector<StateRank> ranks(num_patterns * states.size());
+
+    auto run_fused = [&](const MultiPatternRanking& ranking) {
+        const double single =
+            measure_ns_per_state(repetitions, states.size(), [&] {
+                checksum = 0;
+                for (const State& state : states) {
+                    ranking.compute_ranks(
+                        state.get_unpacked_values().data(),
+                        ranks.data(),
+                        1);
+                    checksum += std::accumulate(
+                        ranks.begin(),
+                        ranks.begin() + num_patterns,
+                        0LL);
+                }
+            });
+        const std::string name = ranking.uses_avx2() ? "AVX2" : "scalar";
+        print_result("fused " + name, single, baseline, checksum);
+
+        const double batch =
+            measure_ns_per_state(repetitions, states.size(), [&] {
+                ranking.compute_ranks(states, ranks);
+                checksum = std::accumulate(ranks.begin(), ranks.end(), 0LL);
+            });
+        print_result("fused " + name + " batch", batch, baseline, checksum);
+    };
+
+    run_fused(MultiPatternRanking(ranking_function_ptrs, false));
+
+    if (MultiPatternRanking::cpu_supports_avx2()) {
+        run_fused(MultiPatternRanking(ranking_function_ptrs));
+    } else {
+        std::cout << "AVX2 is not supported by this CPU.\n";
+    }
+}
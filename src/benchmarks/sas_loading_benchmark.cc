@@ -0,0 +1,94 @@
+// Compares the time needed to load a task from the text SAS format with the
+// time needed to load it from the memory-mapped binary SAS format.
+//
+// Usage: sas_loading_benchmark <sas_file> [repetitions]
+
+#include "probfd/tasks/root_task.h"
+
+#include "probfd/probabilistic_task.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+using namespace probfd;
+
+namespace {
+
+template <typename F>
+double measure_ms(int repetitions, F&& f)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i != repetitions; ++i) {
+        f();
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::milli>(end - start).count() /
+           repetitions;
+}
+
+void print_result(
+    const std::string& name,
+    double ms,
+    double baseline,
+    std::uintmax_t file_size)
+{
+    std::cout << std::left << std::setw(16) << name << std::right
+              << std::setw(12) << std::fixed << std::setprecision(3) << ms
+              << " ms" << std::setw(8) << std::setprecision(2)
+              << baseline / ms << "x  (" << file_size << " bytes)\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <sas_file> [repetitions]\n";
+        return EXIT_FAILURE;
+    }
+
+    const std::filesystem::path text_path = argv[1];
+    const int repetitions = argc > 2 ? std::atoi(argv[2]) : 10;
+
+    const std::filesystem::path binary_path =
+        std::filesystem::temp_directory_path() /
+        (text_path.stem().string() + ".psas");
+
+    {
+        std::ifstream in(text_path);
+        std::ofstream out(binary_path, std::ios::binary);
+        tasks::convert_sas_task_to_binary(in, out);
+    }
+
+    std::cout << "Task: " << text_path.string()
+              << ", repetitions: " << repetitions << "\n\n";
+
+    int num_operators = 0;
+
+    const double text = measure_ms(repetitions, [&] {
+        std::ifstream in(text_path);
+        num_operators = tasks::read_sas_task(in)->get_num_operators();
+    });
+    print_result("text", text, text, std::filesystem::file_size(text_path));
+
+    const double binary = measure_ms(repetitions, [&] {
+        num_operators = tasks::read_binary_sas_task(binary_path)
+                            ->get_num_operators();
+    });
+    print_result(
+        "binary (mmap)",
+        binary,
+        text,
+        std::filesystem::file_size(binary_path));
+
+    std::cout << "\nOperators: " << num_operators << "\n";
+
+    std::filesystem::remove(binary_path);
+}
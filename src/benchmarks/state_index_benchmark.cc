@@ -0,0 +1,136 @@
+// Compares IntHashSet and CompactIntHashSet as the index of a state
+// registry. Registers random packed states, then looks all of them up again
+// in random order, and reports the time and memory of both sets.
+//
+// Usage: state_index_benchmark [num_states] [bins_per_state]
+
+#include "downward/algorithms/compact_int_hash_set.h"
+#include "downward/algorithms/int_hash_set.h"
+
+#include "downward/utils/hash.h"
+#include "downward/utils/logging.h"
+#include "downward/utils/rng.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Bin = std::uint32_t;
+
+struct StateHash {
+    const std::vector<Bin>* data;
+    int num_bins;
+
+    unsigned int operator()(int id) const
+    {
+        utils::HashState hash_state;
+        for (int i = 0; i != num_bins; ++i) {
+            hash_state.feed((*data)[id * num_bins + i]);
+        }
+        return hash_state.get_hash32();
+    }
+};
+
+struct StateEqual {
+    const std::vector<Bin>* data;
+    int num_bins;
+
+    bool operator()(int lhs, int rhs) const
+    {
+        const Bin* lhs_data = data->data() + lhs * num_bins;
+        const Bin* rhs_data = data->data() + rhs * num_bins;
+        return std::equal(lhs_data, lhs_data + num_bins, rhs_data);
+    }
+};
+
+template <typename HashSet>
+void run(
+    const std::string& name,
+    const std::vector<Bin>& data,
+    int num_bins,
+    const std::vector<int>& lookup_order)
+{
+    const int num_states = data.size() / num_bins;
+    HashSet set(StateHash{&data, num_bins}, StateEqual{&data, num_bins});
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int id = 0; id != num_states; ++id) {
+        set.insert(id);
+    }
+    const auto middle = std::chrono::steady_clock::now();
+
+    int found = 0;
+    for (const int id : lookup_order) {
+        found += !set.insert(id).second;
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    const double insert_ms =
+        std::chrono::duration<double, std::milli>(middle - start).count();
+    const double lookup_ms =
+        std::chrono::duration<double, std::milli>(end - middle).count();
+
+    std::cout << std::left << std::setw(10) << name << std::right
+              << std::fixed << std::setprecision(1) << std::setw(10)
+              << insert_ms << " ms insert" << std::setw(8)
+              << insert_ms * 1e6 / num_states << " ns/state" << std::setw(10)
+              << lookup_ms << " ms lookup" << std::setw(8)
+              << lookup_ms * 1e6 / num_states << " ns/state" << std::setw(8)
+              << std::setprecision(2)
+              << static_cast<double>(set.get_size_in_bytes()) / num_states
+              << " bytes/state\n";
+
+    if (found != num_states) {
+        std::cerr << "Lookups failed!\n";
+        std::exit(EXIT_FAILURE);
+    }
+
+    utils::LogProxy log = utils::g_log;
+    set.print_statistics(log);
+    std::cout << "\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const int num_states = argc > 1 ? std::atoi(argv[1]) : 20000000;
+    const int num_bins = argc > 2 ? std::atoi(argv[2]) : 2;
+
+    // Random states are distinct with overwhelming probability. The state
+    // ID is stored in the first bin to make sure.
+    utils::RandomNumberGenerator rng(42);
+    std::vector<Bin> data(static_cast<std::size_t>(num_states) * num_bins);
+    for (int id = 0; id != num_states; ++id) {
+        data[id * num_bins] = id;
+        for (int i = 1; i < num_bins; ++i) {
+            data[id * num_bins + i] = rng.random(std::numeric_limits<int>::max());
+        }
+    }
+
+    std::vector<int> lookup_order(num_states);
+    std::iota(lookup_order.begin(), lookup_order.end(), 0);
+    rng.shuffle(lookup_order);
+
+    std::cout << num_states << " states with " << num_bins << " bins\n\n";
+
+    run<int_hash_set::IntHashSet<StateHash, StateEqual>>(
+        "int",
+        data,
+        num_bins,
+        lookup_order);
+    run<compact_int_hash_set::CompactIntHashSet<StateHash, StateEqual>>(
+        "compact",
+        data,
+        num_bins,
+        lookup_order);
+}
@@ -0,0 +1,138 @@
+// Compares solving a task with trap-aware topological value iteration while
+// keeping the registered states and the per-state arrays in main memory and
+// in a memory-mapped file on disk. Both configurations use the blind
+// heuristic.
+//
+// Usage: state_storage_benchmark [directory] [sas_file]
+//
+// The mapped file is created in the given directory, or in the temporary
+// directory by default. Without a SAS file, a generated blocksworld task is
+// solved.
+
+#include "probfd/algorithms/ta_topological_value_iteration.h"
+
+#include "probfd/heuristics/constant_evaluator.h"
+
+#include "probfd/tasks/root_task.h"
+
+#include "probfd/utils/mapped_memory_resource.h"
+
+#include "probfd/progress_report.h"
+#include "probfd/task_cost_function.h"
+#include "probfd/task_proxy.h"
+#include "probfd/task_state_space.h"
+
+#include "downward/utils/logging.h"
+
+#include "tests/tasks/blocksworld.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <string>
+
+using namespace probfd;
+using namespace probfd::algorithms::ta_topological_vi;
+
+namespace {
+
+std::shared_ptr<ProbabilisticTask> load_task(int argc, char** argv)
+{
+    if (argc > 2) {
+        std::ifstream in(argv[2]);
+        return tasks::read_sas_task(in);
+    }
+
+    return std::make_shared<tests::BlocksworldTask>(
+        8,
+        std::vector<std::vector<int>>{{1, 0}, {2}, {5, 4, 3}, {7, 6}},
+        std::vector<std::vector<int>>{{1, 4, 7}, {5, 3, 2, 0, 6}});
+}
+
+struct Result {
+    double ms = 0.0;
+    value_t value = 0.0;
+    size_t states = 0;
+};
+
+Result solve(
+    const std::shared_ptr<ProbabilisticTask>& task,
+    std::pmr::memory_resource* memory)
+{
+    heuristics::BlindEvaluator<State> heuristic;
+    TaskCostFunction cost_function(task);
+    TaskStateSpace state_space(
+        task,
+        utils::get_silent_log(),
+        {},
+        false,
+        memory);
+    CompositeMDP<State, OperatorID> mdp{state_space, cost_function};
+
+    ProgressReport report(std::nullopt, std::cout, false);
+
+    TATopologicalValueIteration<State, OperatorID> tvi(memory);
+
+    const auto start = std::chrono::steady_clock::now();
+    const Interval value = tvi.solve(
+        mdp,
+        heuristic,
+        state_space.get_initial_state(),
+        report,
+        std::numeric_limits<double>::infinity());
+    const auto end = std::chrono::steady_clock::now();
+
+    Result result;
+    result.ms = std::chrono::duration<double, std::milli>(end - start).count();
+    result.value = value.lower;
+    result.states = state_space.get_num_registered_states();
+    return result;
+}
+
+void print_result(const std::string& name, const Result& result)
+{
+    std::cout << std::left << std::setw(8) << name << std::right
+              << std::setw(12) << std::fixed << std::setprecision(1)
+              << result.ms << " ms  (" << result.states << " states, value "
+              << std::setprecision(4) << result.value << ")\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const std::filesystem::path directory =
+        argc > 1 ? std::filesystem::path(argv[1])
+                 : std::filesystem::temp_directory_path();
+
+    std::shared_ptr<ProbabilisticTask> task = load_task(argc, argv);
+    tasks::set_root_task(task);
+
+    std::cout << "Task: " << (argc > 2 ? argv[2] : "blocksworld (8 blocks)")
+              << "\n\n";
+
+    const Result in_memory = solve(task, std::pmr::get_default_resource());
+    print_result("memory", in_memory);
+
+    MappedMemoryResource mapped_memory(directory);
+    const Result mapped = solve(task, &mapped_memory);
+    print_result("mapped", mapped);
+
+    std::cout << "\nSlowdown: " << std::setprecision(2)
+              << mapped.ms / in_memory.ms << "x\n";
+    std::cout << "Mapped file: " << mapped_memory.get_file_size()
+              << " bytes, " << mapped_memory.get_allocated_bytes()
+              << " bytes allocated in " << directory << "\n";
+
+    if (in_memory.states != mapped.states ||
+        in_memory.value != mapped.value) {
+        std::cerr << "Results differ!\n";
+        return EXIT_FAILURE;
+    }
+}
@@ -0,0 +1,177 @@
+// Compares the tree and the flat representation of the successor generator
+// on reachable states sampled uniformly at random.
+//
+// Usage: successor_generator_benchmark [sas_file] [num_samples]
+//
+// Without a SAS file, a generated blocksworld task is used.
+
+#include "probfd/task_utils/probabilistic_successor_generator.h"
+
+#include "probfd/tasks/root_task.h"
+
+#include "probfd/probabilistic_task.h"
+#include "probfd/task_proxy.h"
+
+#include "downward/utils/rng.h"
+
+#include "downward/operator_id.h"
+#include "downward/state_registry.h"
+
+#include "tests/tasks/blocksworld.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace probfd;
+using successor_generator::ProbabilisticSuccessorGenerator;
+
+namespace {
+
+constexpr size_t MAX_EXPLORED_STATES = 1000000;
+
+std::shared_ptr<ProbabilisticTask> load_task(int argc, char** argv)
+{
+    if (argc > 1) {
+        std::ifstream in(argv[1]);
+        return tasks::read_sas_task(in);
+    }
+
+    return std::make_shared<tests::BlocksworldTask>(
+        8,
+        std::vector<std::vector<int>>{{1, 0}, {2}, {5, 4, 3}, {7, 6}},
+        std::vector<std::vector<int>>{{1, 4, 7}, {5, 3, 2, 0, 6}});
+}
+
+// Registers the reachable states breadth-first, up to a limit.
+void explore(
+    StateRegistry& registry,
+    const ProbabilisticTaskProxy& task_proxy,
+    const ProbabilisticSuccessorGenerator& generator)
+{
+    std::deque<::StateID> queue;
+    std::vector<OperatorID> aops;
+
+    queue.push_back(registry.get_initial_state().get_id());
+
+    while (!queue.empty() && registry.size() < MAX_EXPLORED_STATES) {
+        const State state = registry.lookup_state(queue.front());
+        queue.pop_front();
+
+        aops.clear();
+        generator.generate_applicable_ops(state, aops);
+
+        for (const OperatorID op_id : aops) {
+            for (const auto outcome :
+                 task_proxy.get_operators()[op_id].get_outcomes()) {
+                const size_t num_states = registry.size();
+                const State succ =
+                    registry.get_successor_state(state, outcome.get_effects());
+                if (registry.size() != num_states) {
+                    queue.push_back(succ.get_id());
+                }
+            }
+        }
+    }
+}
+
+struct Result {
+    double ms = 0.0;
+    unsigned long long operators = 0;
+};
+
+Result run(
+    const StateRegistry& registry,
+    const std::vector<::StateID>& samples,
+    const ProbabilisticSuccessorGenerator& generator)
+{
+    std::vector<OperatorID> aops;
+    Result result;
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (const ::StateID id : samples) {
+        // Look up the state again each time, as the search would do.
+        const State state = registry.lookup_state(id);
+        aops.clear();
+        generator.generate_applicable_ops(state, aops);
+        result.operators += aops.size();
+    }
+
+    const auto end = std::chrono::steady_clock::now();
+
+    result.ms = std::chrono::duration<double, std::milli>(end - start).count();
+    return result;
+}
+
+void print_result(
+    const std::string& name,
+    const Result& result,
+    size_t num_samples)
+{
+    std::cout << std::left << std::setw(8) << name << std::right
+              << std::setw(12) << std::fixed << std::setprecision(1)
+              << result.ms << " ms" << std::setw(10) << std::setprecision(1)
+              << result.ms * 1e6 / num_samples << " ns/state  ("
+              << result.operators << " operators)\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const size_t num_samples =
+        argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000000;
+
+    std::shared_ptr<ProbabilisticTask> task = load_task(argc, argv);
+    tasks::set_root_task(task);
+    ProbabilisticTaskProxy task_proxy(*task);
+
+    std::cout << "Task: " << (argc > 1 ? argv[1] : "blocksworld (8 blocks)")
+              << "\n";
+
+    const ProbabilisticSuccessorGenerator tree(task_proxy);
+    const ProbabilisticSuccessorGenerator flat(task_proxy, true);
+
+    StateRegistry registry(task_proxy);
+    explore(registry, task_proxy, tree);
+
+    utils::RandomNumberGenerator rng(42);
+    std::vector<::StateID> samples;
+    samples.reserve(num_samples);
+    for (size_t i = 0; i != num_samples; ++i) {
+        samples.emplace_back(rng.random(registry.size()));
+    }
+
+    std::cout << "Sampled " << num_samples << " of " << registry.size()
+              << " reachable states\n\n";
+
+    // Both generators must generate the same operators in the same order.
+    std::vector<OperatorID> tree_ops;
+    std::vector<OperatorID> flat_ops;
+    for (const ::StateID id : samples) {
+        tree_ops.clear();
+        flat_ops.clear();
+        tree.generate_applicable_ops(registry.lookup_state(id), tree_ops);
+        flat.generate_applicable_ops(registry.lookup_state(id), flat_ops);
+        if (tree_ops != flat_ops) {
+            std::cerr << "Generated operators differ!\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    const Result tree_result = run(registry, samples, tree);
+    print_result("tree", tree_result, num_samples);
+
+    const Result flat_result = run(registry, samples, flat);
+    print_result("flat", flat_result, num_samples);
+
+    std::cout << "\nSpeedup: " << std::setprecision(2)
+              << tree_result.ms / flat_result.ms << "x\n";
+}
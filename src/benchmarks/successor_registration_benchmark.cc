@@ -0,0 +1,210 @@
+// Compares registering the outcome successors of an operator one at a time
+// with registering them as one batch, with the effects of the outcomes either
+// applied one by one or as precomputed bin deltas. All variants explore the
+// reachable state space breadth-first from the initial state.
+//
+// Usage: successor_registration_benchmark [sas_file] [max_states]
+//
+// Without a SAS file, a generated blocksworld task is explored.
+
+#include "probfd/task_utils/outcome_deltas.h"
+#include "probfd/task_utils/probabilistic_successor_generator.h"
+
+#include "probfd/tasks/root_task.h"
+
+#include "probfd/probabilistic_task.h"
+#include "probfd/task_proxy.h"
+
+#include "downward/task_utils/task_properties.h"
+
+#include "downward/state_registry.h"
+
+#include "tests/tasks/blocksworld.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <ranges>
+#include <string>
+#include <vector>
+
+using namespace probfd;
+
+namespace {
+
+std::shared_ptr<ProbabilisticTask> load_task(int argc, char** argv)
+{
+    if (argc > 1) {
+        std::ifstream in(argv[1]);
+        return tasks::read_sas_task(in);
+    }
+
+    return std::make_shared<tests::BlocksworldTask>(
+        8,
+        std::vector<std::vector<int>>{{1, 0}, {2}, {5, 4, 3}, {7, 6}},
+        std::vector<std::vector<int>>{{1, 4, 7}, {5, 3, 2, 0, 6}});
+}
+
+struct Result {
+    double ms = 0.0;
+    unsigned long long successors = 0;
+    size_t states = 0;
+};
+
+template <typename RegisterSuccessors>
+Result explore(
+    const ProbabilisticTaskProxy& task_proxy,
+    size_t max_states,
+    RegisterSuccessors register_successors)
+{
+    StateRegistry registry(task_proxy);
+    successor_generator::ProbabilisticSuccessorGenerator generator(task_proxy);
+
+    std::deque<::StateID> queue;
+    std::vector<OperatorID> aops;
+    std::vector<::StateID> successors;
+
+    Result result;
+
+    const auto start = std::chrono::steady_clock::now();
+
+    queue.push_back(registry.get_initial_state().get_id());
+
+    while (!queue.empty()) {
+        const State state = registry.lookup_state(queue.front());
+        queue.pop_front();
+
+        aops.clear();
+        generator.generate_applicable_ops(state, aops);
+
+        for (const OperatorID op_id : aops) {
+            const size_t num_states = registry.size();
+
+            successors.clear();
+            register_successors(registry, state, op_id, successors);
+            result.successors += successors.size();
+
+            for (const ::StateID succ_id : successors) {
+                if (static_cast<size_t>(succ_id.get_value()) >= num_states &&
+                    registry.size() <= max_states) {
+                    queue.push_back(succ_id);
+                }
+            }
+        }
+    }
+
+    const auto end = std::chrono::steady_clock::now();
+
+    result.ms = std::chrono::duration<double, std::milli>(end - start).count();
+    result.states = registry.size();
+    return result;
+}
+
+void print_result(const std::string& name, const Result& result)
+{
+    std::cout << std::left << std::setw(12) << name << std::right
+              << std::setw(12) << std::fixed << std::setprecision(1)
+              << result.ms << " ms" << std::setw(14) << std::setprecision(0)
+              << result.successors / (result.ms / 1000.0)
+              << " successors/s  (" << result.states << " states)\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const size_t max_states =
+        argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000000;
+
+    std::shared_ptr<ProbabilisticTask> task = load_task(argc, argv);
+    tasks::set_root_task(task);
+    ProbabilisticTaskProxy task_proxy(*task);
+
+    std::cout << "Task: " << (argc > 1 ? argv[1] : "blocksworld (8 blocks)")
+              << "\n\n";
+
+    const Result single = explore(
+        task_proxy,
+        max_states,
+        [&](StateRegistry& registry,
+            const State& state,
+            OperatorID op_id,
+            std::vector<::StateID>& successors) {
+            const auto outcomes =
+                task_proxy.get_operators()[op_id].get_outcomes();
+            for (const ProbabilisticOutcomeProxy outcome : outcomes) {
+                successors.push_back(
+                    registry.get_successor_state(state, outcome.get_effects())
+                        .get_id());
+            }
+        });
+    print_result("per outcome", single);
+
+    const Result batched = explore(
+        task_proxy,
+        max_states,
+        [&](StateRegistry& registry,
+            const State& state,
+            OperatorID op_id,
+            std::vector<::StateID>& successors) {
+            const auto outcomes =
+                task_proxy.get_operators()[op_id].get_outcomes();
+            registry.get_successor_states(
+                state,
+                outcomes | std::views::transform(
+                               &ProbabilisticOutcomeProxy::get_effects),
+                successors);
+        });
+    print_result("batched", batched);
+
+    const OutcomeDeltas deltas(
+        task_proxy,
+        ::task_properties::g_state_packers[task_proxy]);
+
+    const Result delta = explore(
+        task_proxy,
+        max_states,
+        [&](StateRegistry& registry,
+            const State& state,
+            OperatorID op_id,
+            std::vector<::StateID>& successors) {
+            if (deltas.has_deltas(op_id)) {
+                registry.get_successor_states(
+                    state,
+                    deltas.get_deltas(),
+                    deltas.get_outcome_offsets(op_id),
+                    successors);
+                return;
+            }
+
+            const auto outcomes =
+                task_proxy.get_operators()[op_id].get_outcomes();
+            registry.get_successor_states(
+                state,
+                outcomes | std::views::transform(
+                               &ProbabilisticOutcomeProxy::get_effects),
+                successors);
+        });
+    print_result("deltas", delta);
+
+    std::cout << "\nSpeedup (batched): " << std::setprecision(2)
+              << single.ms / batched.ms << "x\n";
+    std::cout << "Speedup (deltas):  " << std::setprecision(2)
+              << single.ms / delta.ms << "x\n";
+    std::cout << "Operators with deltas: "
+              << deltas.get_num_operators_with_deltas() << "/"
+              << task_proxy.get_operators().size() << " ("
+              << deltas.get_size_in_bytes() << " bytes)\n";
+
+    if (single.states != batched.states ||
+        single.successors != batched.successors ||
+        single.states != delta.states ||
+        single.successors != delta.successors) {
+        std::cerr << "Explored state spaces differ!\n";
+        return EXIT_FAILURE;
+    }
+}
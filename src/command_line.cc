@@ -192,7 +192,10 @@ parse_cmd_line(int argc, const char** argv, bool is_unit_cost)
     for (int i = 1; i < argc; ++i) {
         string arg = argv[i];
 
-        if (arg == "--if-unit-cost") {
+        if (arg == "--binary-task" && i == 1) {
+            // The task file has already been read by the planner.
+            ++i;
+        } else if (arg == "--if-unit-cost") {
             active = is_unit_cost;
         } else if (arg == "--if-non-unit-cost") {
             active = !is_unit_cost;
@@ -210,9 +213,13 @@ parse_cmd_line(int argc, const char** argv, bool is_unit_cost)
 string usage(const string& progname)
 {
     return "usage: \n" + progname +
-           " [OPTIONS] --search SEARCH < OUTPUT\n\n"
+           " [OPTIONS] --search SEARCH < OUTPUT\n" + progname +
+           " --binary-task TASK [OPTIONS] --search SEARCH\n" + progname +
+           " --write-binary-task TASK < OUTPUT\n\n"
            "* SEARCH (SearchAlgorithm): configuration of the search algorithm\n"
-           "* OUTPUT (filename): translator output\n\n"
+           "* OUTPUT (filename): translator output\n"
+           "* TASK (filename): task in the binary format, which is written\n"
+           "    by --write-binary-task and memory-mapped by --binary-task\n\n"
            "Options:\n"
            "--maxprob\n"
            "    Use the MaxProb cost model, specifying a termination cost\n"
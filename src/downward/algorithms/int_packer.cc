@@ -1,5 +1,6 @@
 #include "downward/algorithms/int_packer.h"
 
+#include <algorithm>
 #include <cassert>
 
 using namespace std;
@@ -64,6 +65,28 @@ public:
         return (buffer[bin_index] & read_mask) >> shift;
     }
 
+    BitPosition get_bit_position() const
+    {
+        return {bin_index, shift, read_mask};
+    }
+
+    void add_to_deltas(vector<BinDelta>& deltas, int value) const
+    {
+        assert(value >= 0 && value < range);
+
+        // Variables with a single value take no bits.
+        if (read_mask == 0) return;
+
+        auto it = find_if(deltas.begin(), deltas.end(), [&](const BinDelta& d) {
+            return d.bin_index == bin_index;
+        });
+        if (it == deltas.end()) {
+            it = deltas.insert(it, {bin_index, ~Bin(0), 0});
+        }
+        it->keep_mask &= clear_mask;
+        it->value = (it->value & clear_mask) | (Bin(value) << shift);
+    }
+
     void set(Bin* buffer, int value) const
     {
         assert(value >= 0 && value < range);
@@ -92,6 +115,17 @@ void IntPacker::set(Bin* buffer, int var, int value) const
     var_infos[var].set(buffer, value);
 }
 
+IntPacker::BitPosition IntPacker::get_bit_position(int var) const
+{
+    return var_infos[var].get_bit_position();
+}
+
+void IntPacker::add_to_deltas(vector<BinDelta>& deltas, int var, int value)
+    const
+{
+    var_infos[var].add_to_deltas(deltas, value);
+}
+
 void IntPacker::pack_bins(const vector<int>& ranges)
 {
     assert(var_infos.empty());
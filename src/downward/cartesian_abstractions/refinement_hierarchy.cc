@@ -93,4 +93,19 @@ int RefinementHierarchy::get_abstract_state_id(const State& state) const
     State subtask_state = subtask_proxy.convert_ancestor_state(state);
     return nodes[get_node_id(subtask_state)].get_state_id();
 }
+
+const shared_ptr<PlanningTask>& RefinementHierarchy::get_task() const
+{
+    return task;
+}
+
+int RefinementHierarchy::get_num_nodes() const
+{
+    return static_cast<int>(nodes.size());
+}
+
+const Node& RefinementHierarchy::get_node(NodeID node_id) const
+{
+    return nodes[node_id];
+}
 } // namespace cartesian_abstractions
@@ -5,14 +5,20 @@
 
 #include "downward/utils/logging.h"
 
+#include <algorithm>
+
 using namespace std;
 
-StateRegistry::StateRegistry(const PlanningTaskProxy& task_proxy)
+StateRegistry::StateRegistry(
+    const PlanningTaskProxy& task_proxy,
+    std::pmr::memory_resource* state_memory)
     : task_proxy(task_proxy)
     , state_packer(task_properties::g_state_packers[task_proxy])
     , axiom_evaluator(g_axiom_evaluators[task_proxy])
     , num_variables(task_proxy.get_variables().size())
-    , state_data_pool(get_bins_per_state())
+    , state_data_pool(
+          get_bins_per_state(),
+          std::pmr::polymorphic_allocator<PackedStateBin>(state_memory))
     , registered_states(
           StateIDSemanticHash(state_data_pool, get_bins_per_state()),
           StateIDSemanticEqual(state_data_pool, get_bins_per_state()))
@@ -38,6 +44,20 @@ StateID StateRegistry::insert_id_or_pop_state()
     return StateID(result.first);
 }
 
+StateID
+StateRegistry::insert_id_or_pop_state(compact_int_hash_set::HashType hash)
+{
+    // Like insert_id_or_pop_state(), but with a precomputed hash.
+    StateID id(state_data_pool.size() - 1);
+    pair<int, bool> result = registered_states.insert_with_hash(id.value, hash);
+    if (!result.second) {
+        state_data_pool.pop_back();
+    }
+    assert(
+        registered_states.size() == static_cast<int>(state_data_pool.size()));
+    return StateID(result.first);
+}
+
 State StateRegistry::lookup_state(StateID id) const
 {
     const PackedStateBin* buffer = state_data_pool[id.value];
@@ -124,6 +144,151 @@ State StateRegistry::get_successor_state(
     }
 }
 
+void StateRegistry::register_successor_batch(
+    const PackedStateBin* predecessor,
+    vector<StateID>& successor_ids)
+{
+    const size_t num_outcomes = batch_offsets.size() - 1;
+    if (num_outcomes == 0) return;
+
+    const int num_bins = get_bins_per_state();
+
+    if (num_outcomes == 1) {
+        // Nothing to share, register the successor like get_successor_state.
+        state_data_pool.push_back(predecessor);
+        PackedStateBin* buffer = state_data_pool[state_data_pool.size() - 1];
+        for (const FactPair& fact : batch_effects) {
+            state_packer.set(buffer, fact.var, fact.value);
+        }
+        successor_ids.push_back(insert_id_or_pop_state());
+        return;
+    }
+
+    /*
+      Determine the longest sequence of fired effects that all outcomes start
+      with. If there is one, it is applied once to a shared buffer behind the
+      candidate buffers, which all candidate buffers are copied from.
+    */
+    size_t prefix = batch_offsets[1];
+    for (size_t i = 1; i != num_outcomes && prefix != 0; ++i) {
+        const size_t length =
+            min(prefix, batch_offsets[i + 1] - batch_offsets[i]);
+        const auto first = batch_effects.begin();
+        const auto other = first + batch_offsets[i];
+        prefix = mismatch(first, first + length, other).first - first;
+    }
+
+    batch_buffers.resize((num_outcomes + 1) * num_bins);
+    PackedStateBin* candidates = batch_buffers.data();
+    const PackedStateBin* shared = predecessor;
+
+    if (prefix != 0) {
+        PackedStateBin* buffer = candidates + num_outcomes * num_bins;
+        copy_n(predecessor, num_bins, buffer);
+        for (size_t j = 0; j != prefix; ++j) {
+            const FactPair& fact = batch_effects[j];
+            state_packer.set(buffer, fact.var, fact.value);
+        }
+        shared = buffer;
+    }
+
+    for (size_t i = 0; i != num_outcomes; ++i) {
+        PackedStateBin* buffer = candidates + i * num_bins;
+        copy_n(shared, num_bins, buffer);
+
+        for (size_t j = batch_offsets[i] + prefix; j != batch_offsets[i + 1];
+             ++j) {
+            const FactPair& fact = batch_effects[j];
+            state_packer.set(buffer, fact.var, fact.value);
+        }
+    }
+
+    register_candidates(num_outcomes, successor_ids);
+}
+
+void StateRegistry::get_successor_states(
+    const State& predecessor,
+    span<const BinDelta> deltas,
+    span<const int> outcome_offsets,
+    vector<StateID>& successor_ids)
+{
+    assert(!task_properties::has_axioms(task_proxy));
+    assert(!outcome_offsets.empty());
+
+    const size_t num_outcomes = outcome_offsets.size() - 1;
+    if (num_outcomes == 0) return;
+
+    const PackedStateBin* predecessor_buffer = predecessor.get_buffer();
+    const int num_bins = get_bins_per_state();
+
+    if (num_outcomes == 1) {
+        state_data_pool.push_back(predecessor_buffer);
+        PackedStateBin* buffer = state_data_pool[state_data_pool.size() - 1];
+        for (int j = outcome_offsets[0]; j != outcome_offsets[1]; ++j) {
+            deltas[j].apply(buffer);
+        }
+        successor_ids.push_back(insert_id_or_pop_state());
+        return;
+    }
+
+    batch_buffers.resize(num_outcomes * num_bins);
+    PackedStateBin* candidates = batch_buffers.data();
+
+    for (size_t i = 0; i != num_outcomes; ++i) {
+        PackedStateBin* buffer = candidates + i * num_bins;
+        copy_n(predecessor_buffer, num_bins, buffer);
+        for (int j = outcome_offsets[i]; j != outcome_offsets[i + 1]; ++j) {
+            deltas[j].apply(buffer);
+        }
+    }
+
+    register_candidates(num_outcomes, successor_ids);
+}
+
+void StateRegistry::register_candidates(
+    size_t num_outcomes,
+    vector<StateID>& successor_ids)
+{
+    const int num_bins = get_bins_per_state();
+    const PackedStateBin* candidates = batch_buffers.data();
+
+    batch_hashes.resize(num_outcomes);
+    batch_representatives.resize(num_outcomes);
+
+    for (size_t i = 0; i != num_outcomes; ++i) {
+        const PackedStateBin* buffer = candidates + i * num_bins;
+
+        const compact_int_hash_set::HashType hash =
+            StateIDSemanticHash::hash_data(buffer, num_bins);
+        batch_hashes[i] = hash;
+
+        // Deduplicate within the batch before probing the hash set.
+        batch_representatives[i] = i;
+        for (size_t k = 0; k != i; ++k) {
+            if (batch_representatives[k] == k && batch_hashes[k] == hash &&
+                equal(buffer, buffer + num_bins, candidates + k * num_bins)) {
+                batch_representatives[i] = k;
+                break;
+            }
+        }
+
+        if (batch_representatives[i] == i) registered_states.prefetch(hash);
+    }
+
+    const size_t first_id = successor_ids.size();
+
+    for (size_t i = 0; i != num_outcomes; ++i) {
+        const size_t representative = batch_representatives[i];
+        if (representative != i) {
+            successor_ids.push_back(successor_ids[first_id + representative]);
+            continue;
+        }
+
+        state_data_pool.push_back(candidates + i * num_bins);
+        successor_ids.push_back(insert_id_or_pop_state(batch_hashes[i]));
+    }
+}
+
 int StateRegistry::get_bins_per_state() const
 {
     return state_packer.get_num_bins();
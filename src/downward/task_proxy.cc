@@ -40,6 +40,23 @@ State::State(
     this->values = make_shared<vector<int>>(std::move(values));
 }
 
+State::State(
+    const PlanningTask& task,
+    const int_packer::IntPacker& state_packer,
+    StateID id,
+    const PackedStateBin* buffer)
+    : task(&task)
+    , registry(nullptr)
+    , id(id)
+    , buffer(buffer)
+    , values(nullptr)
+    , state_packer(&state_packer)
+    , num_variables(task.get_num_variables())
+{
+    assert(id != StateID::no_state);
+    assert(buffer);
+}
+
 State::State(const PlanningTask& task, vector<int>&& values)
     : task(&task)
     , registry(nullptr)
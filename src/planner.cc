@@ -10,6 +10,7 @@
 #include "probfd/task_utils/task_properties.h"
 #include "probfd/tasks/root_task.h"
 
+#include <fstream>
 #include <iostream>
 
 using namespace std;
@@ -26,10 +27,42 @@ int main(int argc, const char** argv)
         utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
     }
 
+    const string first_arg = argv[1];
+
+    if (first_arg == "--write-binary-task") {
+        if (argc != 3) {
+            utils::g_log << usage(argv[0]) << endl;
+            utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+        }
+
+        utils::g_log << "converting input to binary task file " << argv[2]
+                     << "..." << endl;
+        ofstream out(argv[2], ios::binary);
+        probfd::tasks::convert_sas_task_to_binary(cin, out);
+        out.close();
+
+        if (!out) {
+            cerr << "Failed to write binary task file " << argv[2] << endl;
+            utils::exit_with(ExitCode::SEARCH_CRITICAL_ERROR);
+        }
+
+        utils::g_log << "done converting input!" << endl;
+        utils::exit_with(ExitCode::SUCCESS);
+    }
+
     bool unit_cost = false;
-    if (static_cast<string>(argv[1]) != "--help") {
+    if (first_arg != "--help") {
         utils::g_log << "reading input..." << endl;
-        auto input_task = probfd::tasks::read_root_tasks(cin);
+        shared_ptr<ProbabilisticTask> input_task;
+        if (first_arg == "--binary-task") {
+            if (argc < 3) {
+                utils::g_log << usage(argv[0]) << endl;
+                utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+            }
+            input_task = probfd::tasks::read_binary_root_tasks(argv[2]);
+        } else {
+            input_task = probfd::tasks::read_root_tasks(cin);
+        }
         utils::g_log << "done reading input!" << endl;
         ProbabilisticTaskProxy task_proxy(*input_task);
         unit_cost = probfd::task_properties::is_unit_cost(task_proxy);
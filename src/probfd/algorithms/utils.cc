@@ -26,6 +26,16 @@ Interval as_interval(Interval value)
     return value;
 }
 
+stored_value_t as_stored_value(value_t value)
+{
+    return to_stored_lower_bound(value);
+}
+
+StoredInterval as_stored_value(Interval value)
+{
+    return StoredInterval(value);
+}
+
 bool set_min(Interval& lhs, Interval rhs)
 {
     set_min(lhs.upper, rhs.upper);
@@ -59,4 +69,24 @@ bool update(value_t& lhs, value_t rhs, value_t epsilon)
     return result;
 }
 
+#if defined(PROBFD_MIXED_PRECISION)
+bool update(StoredInterval& lhs, Interval rhs, value_t epsilon)
+{
+    const StoredInterval old = lhs;
+    Interval value = old;
+    const bool result = update(value, rhs, epsilon);
+    lhs = value;
+    return result && (lhs.lower != old.lower || lhs.upper != old.upper);
+}
+
+bool update(stored_value_t& lhs, value_t rhs, value_t epsilon)
+{
+    const stored_value_t old = lhs;
+    value_t value = old;
+    const bool result = update(value, rhs, epsilon);
+    lhs = to_stored_lower_bound(value);
+    return result && lhs != old;
+}
+#endif
+
 } // namespace probfd::algorithms
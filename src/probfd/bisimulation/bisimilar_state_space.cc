@@ -1,43 +1,29 @@
 #include "probfd/bisimulation/bisimilar_state_space.h"
 
-#include "probfd/task_utils/task_properties.h"
+#include "probfd/utils/thread_pool.h"
 
 #include "probfd/distribution.h"
+#include "probfd/task_state_space.h"
 #include "probfd/transition.h"
 
-#include "downward/merge_and_shrink/distances.h"
-#include "downward/merge_and_shrink/factored_transition_system.h"
-#include "downward/merge_and_shrink/merge_and_shrink_algorithm.h"
-#include "downward/merge_and_shrink/merge_and_shrink_representation.h"
-#include "downward/merge_and_shrink/merge_strategy_factory_precomputed.h"
-#include "downward/merge_and_shrink/merge_tree.h"
-#include "downward/merge_and_shrink/merge_tree_factory_linear.h"
-#include "downward/merge_and_shrink/shrink_bisimulation.h"
-#include "downward/merge_and_shrink/transition_system.h"
-#include "downward/merge_and_shrink/types.h"
-
-#include "downward/task_utils/variable_order_finder.h"
-
+#include "downward/utils/hash.h"
 #include "downward/utils/logging.h"
+#include "downward/utils/timer.h"
 
 #include "downward/task_proxy.h"
 
+#include <algorithm>
+#include <bit>
 #include <cassert>
-#include <limits>
+#include <cstdint>
+#include <deque>
 #include <memory>
+#include <numeric>
 #include <ranges>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
-class AbstractTask;
-namespace merge_and_shrink {
-class MergeStrategyFactory;
-class MergeTreeFactory;
-class ShrinkStrategy;
-} // namespace merge_and_shrink
-
-using namespace merge_and_shrink;
-
 namespace probfd {
 class ProbabilisticTask;
 
@@ -45,81 +31,351 @@ namespace bisimulation {
 
 static constexpr const int BUCKET_SIZE = 1024 * 64;
 
+namespace {
+
+// The reachable state space of a task as an explicit graph.
+struct ExplicitStateSpace {
+    std::vector<bool> goal_flags;
+
+    // Actions of each state, sorted by operator.
+    std::vector<std::size_t> action_offsets = {0};
+    std::vector<int> operators;
+
+    // Support of the successor distribution of each action.
+    std::vector<std::size_t> successor_offsets = {0};
+    std::vector<int> successors;
+    std::vector<value_t> probabilities;
+
+    std::size_t num_states() const { return goal_flags.size(); }
+};
+
+using BlockDistribution = std::vector<std::pair<int, value_t>>;
+
+} // namespace
+
+static ExplicitStateSpace explore_state_space(
+    std::shared_ptr<ProbabilisticTask> task,
+    FDRCostFunction& cost_function)
+{
+    TaskStateSpace state_space(std::move(task), utils::get_silent_log());
+    ExplicitStateSpace graph;
+
+    std::vector<OperatorID> aops;
+    std::vector<Distribution<StateID>> successors;
+    std::vector<std::size_t> order;
+
+    // Registering a state assigns the next ID, so this is a breadth-first
+    // search starting with the initial state.
+    [[maybe_unused]] const StateID init_id =
+        state_space.get_state_id(state_space.get_initial_state());
+    assert(init_id == 0);
+
+    for (std::size_t i = 0; i != state_space.get_num_registered_states(); ++i) {
+        const State state = state_space.get_state(i);
+        const bool is_goal =
+            cost_function.get_termination_info(state).is_goal_state();
+        graph.goal_flags.push_back(is_goal);
+
+        if (!is_goal) {
+            aops.clear();
+            successors.clear();
+            state_space.generate_all_transitions(state, aops, successors);
+
+            order.resize(aops.size());
+            std::iota(order.begin(), order.end(), 0);
+            std::ranges::sort(order, {}, [&](std::size_t j) {
+                return aops[j].get_index();
+            });
+
+            for (const std::size_t j : order) {
+                graph.operators.push_back(aops[j].get_index());
+                for (const auto& [succ_id, probability] : successors[j]) {
+                    graph.successors.push_back(static_cast<int>(succ_id.id));
+                    graph.probabilities.push_back(probability);
+                }
+                graph.successor_offsets.push_back(graph.successors.size());
+            }
+        }
+
+        graph.action_offsets.push_back(graph.operators.size());
+    }
+
+    return graph;
+}
+
+// Marks the states from which a goal state is reachable.
+static std::vector<bool> compute_alive_states(const ExplicitStateSpace& graph)
+{
+    const std::size_t num_states = graph.num_states();
+
+    std::vector<std::size_t> predecessor_offsets(num_states + 1, 0);
+    for (const int succ : graph.successors) {
+        ++predecessor_offsets[succ + 1];
+    }
+
+    std::partial_sum(
+        predecessor_offsets.begin(),
+        predecessor_offsets.end(),
+        predecessor_offsets.begin());
+
+    std::vector<int> predecessors(graph.successors.size());
+    std::vector<std::size_t> next(
+        predecessor_offsets.begin(),
+        predecessor_offsets.end() - 1);
+
+    for (std::size_t s = 0; s != num_states; ++s) {
+        for (std::size_t a = graph.action_offsets[s];
+             a != graph.action_offsets[s + 1];
+             ++a) {
+            for (std::size_t k = graph.successor_offsets[a];
+                 k != graph.successor_offsets[a + 1];
+                 ++k) {
+                predecessors[next[graph.successors[k]]++] = static_cast<int>(s);
+            }
+        }
+    }
+
+    std::vector<bool> alive(graph.goal_flags);
+    std::deque<int> queue;
+    for (std::size_t s = 0; s != num_states; ++s) {
+        if (alive[s]) queue.push_back(static_cast<int>(s));
+    }
+
+    while (!queue.empty()) {
+        const int s = queue.front();
+        queue.pop_front();
+
+        for (std::size_t k = predecessor_offsets[s];
+             k != predecessor_offsets[s + 1];
+             ++k) {
+            const int pred = predecessors[k];
+            if (!alive[pred]) {
+                alive[pred] = true;
+                queue.push_back(pred);
+            }
+        }
+    }
+
+    return alive;
+}
+
+// Computes the distribution over blocks induced by an action, sorted by block.
+static void compute_block_distribution(
+    const ExplicitStateSpace& graph,
+    std::size_t action,
+    const std::vector<int>& blocks,
+    BlockDistribution& result)
+{
+    result.clear();
+    for (std::size_t k = graph.successor_offsets[action];
+         k != graph.successor_offsets[action + 1];
+         ++k) {
+        result.emplace_back(
+            blocks[graph.successors[k]],
+            graph.probabilities[k]);
+    }
+
+    // Sorting the probabilities too makes the sums exact across states.
+    std::ranges::sort(result);
+
+    std::size_t size = 0;
+    for (const auto& [block, probability] : result) {
+        if (size != 0 && result[size - 1].first == block) {
+            result[size - 1].second += probability;
+        } else {
+            result[size++] = {block, probability};
+        }
+    }
+
+    result.resize(size);
+}
+
+static void compute_signature(
+    const ExplicitStateSpace& graph,
+    const std::vector<bool>& alive,
+    const std::vector<int>& blocks,
+    std::size_t state,
+    std::vector<std::uint64_t>& signature,
+    BlockDistribution& distribution)
+{
+    signature.clear();
+    signature.push_back(blocks[state]);
+
+    // Terminal states are never split.
+    if (graph.goal_flags[state] || !alive[state]) return;
+
+    for (std::size_t a = graph.action_offsets[state];
+         a != graph.action_offsets[state + 1];
+         ++a) {
+        compute_block_distribution(graph, a, blocks, distribution);
+
+        signature.push_back(graph.operators[a]);
+        signature.push_back(distribution.size());
+        for (const auto& [block, probability] : distribution) {
+            signature.push_back(block);
+            signature.push_back(std::bit_cast<std::uint64_t>(probability));
+        }
+    }
+}
+
+/*
+  Refines the partition until it is stable and returns the block of each
+  state. Blocks are numbered in the order of their first state, so the initial
+  state is in block 0.
+*/
+static std::vector<int> refine_partition(
+    const ExplicitStateSpace& graph,
+    const std::vector<bool>& alive,
+    unsigned num_threads,
+    utils::LogProxy& log)
+{
+    const std::size_t num_states = graph.num_states();
+
+    std::vector<int> blocks(num_states);
+    for (std::size_t s = 0; s != num_states; ++s) {
+        blocks[s] = graph.goal_flags[s] ? 0 : alive[s] ? 1 : 2;
+    }
+
+    std::vector<std::vector<std::uint64_t>> signatures(num_states);
+    std::vector<std::uint64_t> hashes(num_states);
+
+    auto hash = [&](int s) { return static_cast<std::size_t>(hashes[s]); };
+    auto equal = [&](int s, int t) { return signatures[s] == signatures[t]; };
+
+    const std::size_t num_chunks = std::min<std::size_t>(
+        num_states,
+        static_cast<std::size_t>(resolve_num_threads(num_threads)) * 8);
+
+    std::size_t num_blocks = 0;
+
+    for (int round = 1;; ++round) {
+        utils::Timer round_timer;
+
+        parallel_for(num_threads, num_chunks, [&](std::size_t chunk) {
+            BlockDistribution distribution;
+            const std::size_t begin = num_states * chunk / num_chunks;
+            const std::size_t end = num_states * (chunk + 1) / num_chunks;
+
+            for (std::size_t s = begin; s != end; ++s) {
+                compute_signature(
+                    graph,
+                    alive,
+                    blocks,
+                    s,
+                    signatures[s],
+                    distribution);
+                hashes[s] = utils::get_hash64(signatures[s]);
+            }
+        });
+
+        std::unordered_map<int, int, decltype(hash), decltype(equal)>
+            block_ids(num_states, hash, equal);
+
+        for (std::size_t s = 0; s != num_states; ++s) {
+            const int next_id = static_cast<int>(block_ids.size());
+            const auto it =
+                block_ids.try_emplace(static_cast<int>(s), next_id).first;
+            blocks[s] = it->second;
+        }
+
+        if (log.is_at_least_normal()) {
+            log << "Bisimulation round " << round << ": "
+                << block_ids.size() << " blocks [t=" << round_timer << "]"
+                << std::endl;
+        }
+
+        if (block_ids.size() == num_blocks) break;
+        num_blocks = block_ids.size();
+    }
+
+    return blocks;
+}
+
 BisimilarStateSpace::BisimilarStateSpace(
     std::shared_ptr<ProbabilisticTask> task,
     std::shared_ptr<FDRCostFunction> task_cost_function,
-    const TaskProxy& det_task_proxy,
-    const merge_and_shrink::TransitionSystem& transition_system)
+    unsigned num_threads,
+    utils::LogProxy log)
     : task_(std::move(task))
     , task_cost_function_(std::move(task_cost_function))
     , num_cached_transitions_(0)
-    , transitions_(transition_system.get_size() + 1)
-    , goal_flags_(transition_system.get_size() + 1, false)
 {
-    int dead_end_state = transitions_.size();
-
-    ProbabilisticTaskProxy task_proxy(*task_);
-    OperatorsProxy det_operators = det_task_proxy.get_operators();
-    ProbabilisticOperatorsProxy prob_operators = task_proxy.get_operators();
-
-    std::vector<std::pair<unsigned, unsigned>> g_to_p(det_operators.size());
-    for (unsigned p_op_id = 0; p_op_id < prob_operators.size(); ++p_op_id) {
-        const ProbabilisticOperatorProxy op = prob_operators[p_op_id];
-        const ProbabilisticOutcomesProxy outcomes = op.get_outcomes();
-        for (unsigned i = 0; i < outcomes.size(); ++i) {
-            const ProbabilisticOutcomeProxy outcome = outcomes[i];
-            g_to_p[outcome.get_determinization_id()] =
-                std::make_pair(p_op_id, i);
+    const ExplicitStateSpace graph =
+        explore_state_space(task_, *task_cost_function_);
+    const std::vector<bool> alive = compute_alive_states(graph);
+    const std::vector<int> blocks =
+        refine_partition(graph, alive, num_threads, log);
+
+    const std::size_t num_states = graph.num_states();
+
+    // The first state of each block represents it.
+    std::vector<int> representatives;
+    for (std::size_t s = 0; s != num_states; ++s) {
+        if (blocks[s] == static_cast<int>(representatives.size())) {
+            representatives.push_back(static_cast<int>(s));
         }
     }
 
+    const std::size_t num_blocks = representatives.size();
+
+    transitions_.resize(num_blocks);
+    goal_flags_.resize(num_blocks, false);
+    initial_state_ = QuotientState(blocks[0]);
+
     unsigned bucket_free = 0;
-    int* bucket_ptr = nullptr;
+    CachedSuccessor* bucket_ptr = nullptr;
     auto allocate = [this, &bucket_free, &bucket_ptr](unsigned size) {
         if (size > bucket_free) {
-            bucket_ptr = store_.emplace_back(new int[BUCKET_SIZE]).get();
+            bucket_ptr =
+                store_.emplace_back(new CachedSuccessor[BUCKET_SIZE]).get();
             bucket_free = BUCKET_SIZE;
         }
-        int* result = bucket_ptr;
+        CachedSuccessor* result = bucket_ptr;
         bucket_ptr += size;
         bucket_free -= size;
         return result;
     };
 
-    for (const LocalLabelInfo& local_info : transition_system) {
-        for (const int g_op_id : local_info.get_label_group()) {
-            for (const auto& trans : local_info.get_transitions()) {
-                std::vector<CachedTransition>& ts = transitions_[trans.src];
-                assert(trans.target != PRUNED_STATE);
-                const auto& op = g_to_p[g_op_id];
-
-                CachedTransition* t = nullptr;
-                for (auto& j : ts) {
-                    if (j.op == op.first) {
-                        t = &j;
-                        break;
-                    }
-                }
+    BlockDistribution distribution;
 
-                if (t == nullptr) {
-                    const OperatorID id = OperatorID(op.first);
-                    const int size = prob_operators[id].get_outcomes().size();
-                    t = &ts.emplace_back();
-                    t->op = op.first;
-                    t->successors = allocate(size);
-                    for (int j = 0; j != size; ++j) {
-                        t->successors[j] = dead_end_state;
-                    }
-                    ++num_cached_transitions_;
-                }
+    for (std::size_t b = 0; b != num_blocks; ++b) {
+        const int s = representatives[b];
+
+        if (graph.goal_flags[s]) {
+            goal_flags_[b] = true;
+            continue;
+        }
 
-                t->successors[op.second] = trans.target;
+        if (!alive[s]) {
+            dead_end_state_ = static_cast<int>(b);
+            continue;
+        }
+
+        std::vector<CachedTransition>& ts = transitions_[b];
+
+        for (std::size_t a = graph.action_offsets[s];
+             a != graph.action_offsets[s + 1];
+             ++a) {
+            compute_block_distribution(graph, a, blocks, distribution);
+
+            const auto size = static_cast<unsigned>(distribution.size());
+            CachedTransition& t = ts.emplace_back(size, allocate(size));
+
+            for (unsigned j = 0; j != size; ++j) {
+                t.successors[j] = {
+                    distribution[j].first,
+                    distribution[j].second};
             }
+
+            ++num_cached_transitions_;
         }
     }
 
-    for (std::size_t i = 0; i != goal_flags_.size(); ++i) {
-        goal_flags_[i] = transition_system.is_goal_state(i);
+    if (log.is_at_least_normal()) {
+        log << "Bisimulation reduced " << num_states << " reachable states to "
+            << num_blocks << " blocks (reduction ratio "
+            << static_cast<double>(num_states) / static_cast<double>(num_blocks)
+            << ")." << std::endl;
     }
 }
 
@@ -155,19 +411,12 @@ void BisimilarStateSpace::generate_action_transitions(
         std::to_underlying(a) <
         static_cast<int>(transitions_[std::to_underlying(state)].size()));
 
-    ProbabilisticTaskProxy task_proxy(*task_);
-    const ProbabilisticOperatorsProxy operators = task_proxy.get_operators();
-
     const CachedTransition& t =
         transitions_[std::to_underlying(state)][std::to_underlying(a)];
-    const ProbabilisticOperatorProxy& op = operators[t.op];
-    const ProbabilisticOutcomesProxy& outcomes = op.get_outcomes();
-
-    for (unsigned i = 0; i < outcomes.size(); ++i) {
-        const ProbabilisticOutcomeProxy outcome = outcomes[i];
-        const value_t probability = outcome.get_probability();
-        const StateID id = t.successors[i];
-        result.add_probability(id, probability);
+
+    for (unsigned i = 0; i < t.num_successors; ++i) {
+        const auto [succ, probability] = t.successors[i];
+        result.add_probability(succ, probability);
     }
 }
 
@@ -209,11 +458,21 @@ value_t BisimilarStateSpace::get_action_cost(QuotientAction)
     return 0;
 }
 
+QuotientState BisimilarStateSpace::get_initial_state() const
+{
+    return initial_state_;
+}
+
 bool BisimilarStateSpace::is_goal_state(QuotientState s) const
 {
     return goal_flags_[std::to_underlying(s)];
 }
 
+bool BisimilarStateSpace::is_dead_end(QuotientState s) const
+{
+    return std::to_underlying(s) == dead_end_state_;
+}
+
 unsigned BisimilarStateSpace::num_bisimilar_states() const
 {
     return transitions_.size();
@@ -224,44 +483,5 @@ unsigned BisimilarStateSpace::num_transitions() const
     return num_cached_transitions_;
 }
 
-merge_and_shrink::Factor
-compute_bisimulation_on_determinization(const TaskProxy& det_task_proxy)
-{
-    // Construct a linear merge tree
-    auto linear_merge_tree_factory = std::make_shared<MergeTreeFactoryLinear>(
-        variable_order_finder::VariableOrderType::LEVEL,
-        -1,
-        UpdateOption::USE_FIRST);
-
-    // Construct the merge strategy factory
-    auto merge_strategy_factory =
-        std::make_shared<MergeStrategyFactoryPrecomputed>(
-            linear_merge_tree_factory,
-            utils::Verbosity::SILENT);
-
-    // Construct a bisimulation-based shrinking strategy
-    auto shrinking =
-        std::make_shared<ShrinkBisimulation>(false, AtLimit::RETURN);
-
-    MergeAndShrinkAlgorithm mns_algorithm(
-        merge_strategy_factory,
-        shrinking,
-        nullptr,
-        true,
-        true,
-        std::numeric_limits<int>::max(),
-        std::numeric_limits<int>::max(),
-        std::numeric_limits<int>::max(),
-        std::numeric_limits<double>::infinity(),
-        utils::Verbosity::SILENT);
-
-    FactoredTransitionSystem fts =
-        mns_algorithm.build_factored_transition_system(det_task_proxy);
-
-    assert(fts.get_num_active_entries() == 1);
-
-    return fts.extract_factor(fts.get_size() - 1);
-}
-
 } // namespace bisimulation
 } // namespace probfd
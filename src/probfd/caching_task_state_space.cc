@@ -12,28 +12,50 @@
 #include "downward/operator_id.h"
 #include "downward/task_proxy.h"
 
+#include <algorithm>
 #include <cassert>
 #include <functional>
+#include <numeric>
 #include <ostream>
 #include <ranges>
 #include <span>
-#include <type_traits>
-
-using namespace std::ranges;
-using namespace std::views;
 
 class Evaluator;
 
 namespace probfd {
 
+void CachingTaskStateSpace::CacheStatistics::print(utils::LogProxy log) const
+{
+    log << "  Cache hits: " << hits << std::endl;
+    log << "  Cache misses: " << misses << std::endl;
+    log << "  Evicted cache entries: " << evictions << std::endl;
+    log << "  Cache compactions: " << compactions << std::endl;
+}
+
+CachingTaskStateSpace::TransitionsView::TransitionsView(
+    std::span<const OperatorID> aops,
+    const std::size_t* offsets,
+    const ItemProbabilityPair<StateID>* outcomes)
+    : aops_(aops)
+    , offsets_(offsets)
+    , outcomes_(outcomes)
+{
+}
+
 CachingTaskStateSpace::CachingTaskStateSpace(
     std::shared_ptr<ProbabilisticTask> task,
     utils::LogProxy log,
-    std::vector<std::shared_ptr<::Evaluator>> path_dependent_evaluators)
+    std::vector<std::shared_ptr<::Evaluator>> path_dependent_evaluators,
+    std::size_t max_cache_bytes,
+    bool flat_successor_generator,
+    std::pmr::memory_resource* state_memory)
     : TaskStateSpace(
           std::move(task),
           std::move(log),
-          std::move(path_dependent_evaluators))
+          std::move(path_dependent_evaluators),
+          flat_successor_generator,
+          state_memory)
+    , max_cache_bytes_(max_cache_bytes)
 {
 }
 
@@ -41,11 +63,8 @@ void CachingTaskStateSpace::generate_applicable_actions(
     const State& state,
     std::vector<OperatorID>& result)
 {
-    CacheEntry& entry = lookup(state);
-    result.reserve(entry.naops);
-    for (size_t i = 0; i != entry.naops; ++i) {
-        result.push_back(entry.aops[i]);
-    }
+    const TransitionsView view = lookup_transitions(state);
+    result.assign(view.get_actions().begin(), view.get_actions().end());
 
     ++statistics_.aops_generator_calls;
     statistics_.generated_operators += result.size();
@@ -56,21 +75,18 @@ void CachingTaskStateSpace::generate_action_transitions(
     OperatorID op_id,
     Distribution<StateID>& result)
 {
-    const ProbabilisticOperatorsProxy operators = task_proxy_.get_operators();
+    const TransitionsView view = lookup_transitions(state);
+    const auto aops = view.get_actions();
 
-    const CacheEntry& entry = lookup(state);
-    assert(entry.is_initialized());
-    const StateID* succs = entry.succs;
+    const auto it = std::ranges::find(aops, op_id);
+    assert(it != aops.end());
 
-    auto it = find_if(counted(entry.aops, entry.naops), [&](OperatorID id) {
-        if (op_id == id) return true;
-        succs += operators[id].get_outcomes().size();
-        return false;
-    });
+    const auto successors =
+        view.get_successors(static_cast<std::size_t>(it - aops.begin()));
+    result.reserve(successors.size());
 
-    for (const auto out = operators[*it];
-         const auto outcome : out.get_outcomes()) {
-        result.add_probability(*succs++, outcome.get_probability());
+    for (const auto& [succ_id, probability] : successors) {
+        result.add_probability(succ_id, probability);
     }
 
     ++statistics_.single_transition_generator_calls;
@@ -81,22 +97,19 @@ void CachingTaskStateSpace::generate_all_transitions(
     std::vector<OperatorID>& aops,
     std::vector<Distribution<StateID>>& successors)
 {
-    const ProbabilisticOperatorsProxy operators = task_proxy_.get_operators();
+    const TransitionsView view = lookup_transitions(state);
+    aops.reserve(view.size());
+    successors.reserve(view.size());
 
-    CacheEntry& entry = lookup(state);
-    const StateID* succs = entry.succs;
-    aops.reserve(entry.naops);
-    successors.reserve(entry.naops);
-
-    for (OperatorID op_id : counted(entry.aops, entry.naops)) {
-        aops.push_back(op_id);
+    for (std::size_t i = 0; i != view.size(); ++i) {
+        aops.push_back(view.get_actions()[i]);
 
         Distribution<StateID>& result = successors.emplace_back();
+        const auto outcomes = view.get_successors(i);
+        result.reserve(outcomes.size());
 
-        const ProbabilisticOperatorProxy op = operators[op_id];
-
-        for (const auto outcome : op.get_outcomes()) {
-            result.add_probability(*succs++, outcome.get_probability());
+        for (const auto& [succ_id, probability] : outcomes) {
+            result.add_probability(succ_id, probability);
         }
     }
 
@@ -108,58 +121,82 @@ void CachingTaskStateSpace::generate_all_transitions(
     const State& state,
     std::vector<TransitionType>& transitions)
 {
-    const ProbabilisticOperatorsProxy operators = task_proxy_.get_operators();
-
-    CacheEntry& entry = lookup(state);
-    const StateID* succs = entry.succs;
-    transitions.reserve(entry.naops);
+    const TransitionsView view = lookup_transitions(state);
+    transitions.reserve(view.size());
 
-    for (OperatorID op_id : counted(entry.aops, entry.naops)) {
-        TransitionType& t = transitions.emplace_back(op_id);
+    for (std::size_t i = 0; i != view.size(); ++i) {
+        TransitionType& t = transitions.emplace_back(view.get_actions()[i]);
         Distribution<StateID>& result = t.successor_dist;
 
-        const ProbabilisticOperatorProxy op = operators[op_id];
-        const ProbabilisticOutcomesProxy outcomes = op.get_outcomes();
-        const size_t num_outcomes = outcomes.size();
+        const auto outcomes = view.get_successors(i);
+        result.reserve(outcomes.size());
 
-        for (const auto outcome : outcomes) {
-            result.add_probability(*succs++, outcome.get_probability());
+        for (const auto& [succ_id, probability] : outcomes) {
+            result.add_probability(succ_id, probability);
         }
 
-        statistics_.generated_states += num_outcomes;
+        statistics_.generated_states += outcomes.size();
     }
 
     ++statistics_.all_transitions_generator_calls;
     statistics_.generated_operators += transitions.size();
 }
 
+auto CachingTaskStateSpace::lookup_transitions(const State& state)
+    -> TransitionsView
+{
+    return get_view(lookup(state));
+}
+
 void CachingTaskStateSpace::print_statistics() const
 {
     TaskStateSpace::print_statistics();
-    log_ << "  Stored arrays in bytes: " << cache_data_.size_in_bytes()
-         << std::endl;
+
+    log_ << "  Cached transitions: " << cached_aops_.size() << " ("
+         << cached_outcomes_.size() << " successor(s))" << std::endl;
+    log_ << "  Stored arrays in bytes: " << get_cached_bytes() << std::endl;
+
+    cache_statistics_.print(log_);
 }
 
 void CachingTaskStateSpace::compute_successor_states(
     const State& state,
     OperatorID op_id,
-    std::vector<StateID>& succs)
+    Distribution<StateID>& successors)
 {
     const ProbabilisticOperatorProxy op = task_proxy_.get_operators()[op_id];
     const auto outcomes = op.get_outcomes();
     const size_t num_outcomes = outcomes.size();
-    succs.reserve(num_outcomes);
+    successors.reserve(num_outcomes);
+
+    outcome_successors_.clear();
+    if (outcome_deltas_.has_deltas(op_id)) {
+        state_registry_.get_successor_states(
+            state,
+            outcome_deltas_.get_deltas(),
+            outcome_deltas_.get_outcome_offsets(op_id),
+            outcome_successors_);
+    } else {
+        state_registry_.get_successor_states(
+            state,
+            outcomes | std::views::transform(
+                           &ProbabilisticOutcomeProxy::get_effects),
+            outcome_successors_);
+    }
 
-    for (const ProbabilisticOutcomeProxy outcome : outcomes) {
-        State succ =
-            state_registry_.get_successor_state(state, outcome.get_effects());
+    for (size_t i = 0; i != num_outcomes; ++i) {
+        const ProbabilisticOutcomeProxy outcome = outcomes[i];
+        const ::StateID succ_id = outcome_successors_[i];
 
-        for (const auto& h : notify_) {
-            OperatorID det_op_id(outcome.get_determinization_id());
-            h->notify_state_transition(state, det_op_id, succ);
+        if (!notify_.empty()) {
+            const State succ = state_registry_.lookup_state(succ_id);
+            for (const auto& h : notify_) {
+                OperatorID det_op_id(outcome.get_determinization_id());
+                h->notify_state_transition(state, det_op_id, succ);
+            }
         }
 
-        succs.emplace_back(succ.get_id());
+        successors.add_probability(succ_id, outcome.get_probability());
     }
 
     ++statistics_.transition_computations;
@@ -168,46 +205,189 @@ void CachingTaskStateSpace::compute_successor_states(
 
 void CachingTaskStateSpace::setup_cache(const State& state, CacheEntry& entry)
 {
-    if (entry.is_initialized()) return;
-
-    assert(aops_.empty() && successors_.empty());
+    assert(!entry.is_initialized());
+    assert(aops_.empty() && successor_dist_.empty());
     compute_applicable_operators(state, aops_);
-    entry.naops = aops_.size();
 
-    if (entry.naops > 0) {
-        entry.aops = cache_data_.allocate<OperatorID>(aops_.size());
+    entry.first_action = static_cast<std::uint32_t>(cached_aops_.size());
+    entry.num_actions = static_cast<std::uint32_t>(aops_.size());
 
-        std::vector<StateID> succs;
-        for (size_t i = 0; i < aops_.size(); ++i) {
-            OperatorID op = aops_[i];
-            entry.aops[i] = op;
+    for (const OperatorID op : aops_) {
+        compute_successor_states(state, op, successor_dist_);
 
-            compute_successor_states(state, op, succs);
+        cached_aops_.push_back(op);
+        cached_outcomes_.insert(
+            cached_outcomes_.end(),
+            successor_dist_.begin(),
+            successor_dist_.end());
+        action_offsets_.push_back(cached_outcomes_.size());
 
-            for (const StateID s : succs) {
-                successors_.push_back(s);
-            }
+        successor_dist_.clear();
+    }
 
-            succs.clear();
-        }
+    aops_.clear();
+}
 
-        entry.succs = cache_data_.allocate<StateID>(successors_.size());
+CachingTaskStateSpace::CacheEntry&
+CachingTaskStateSpace::lookup(const State& state)
+{
+    const StateID state_id = state.get_id();
+    CacheEntry& entry = cache_[state_id];
+
+    if (entry.is_initialized()) {
+        ++cache_statistics_.hits;
+        entry.last_access = advance_access_clock();
+        return entry;
+    }
 
-        for (size_t i = 0; i != successors_.size(); ++i) {
-            entry.succs[i] = successors_[i];
+    ++cache_statistics_.misses;
+
+    setup_cache(state, entry);
+    entry.last_access = advance_access_clock();
+
+    if (is_bounded()) {
+        cached_states_.push_back(state_id);
+
+        if (get_cached_bytes() > max_cache_bytes_) {
+            evict_least_recently_used();
         }
+    }
 
-        aops_.clear();
-        successors_.clear();
+    return entry;
+}
+
+auto CachingTaskStateSpace::get_view(const CacheEntry& entry) const
+    -> TransitionsView
+{
+    assert(entry.is_initialized());
+    return TransitionsView(
+        std::span(cached_aops_).subspan(entry.first_action, entry.num_actions),
+        action_offsets_.data() + entry.first_action,
+        cached_outcomes_.data());
+}
+
+std::size_t CachingTaskStateSpace::get_cached_bytes() const
+{
+    return cached_aops_.size() * sizeof(OperatorID) +
+           action_offsets_.size() * sizeof(std::size_t) +
+           cached_outcomes_.size() * sizeof(ItemProbabilityPair<StateID>);
+}
+
+bool CachingTaskStateSpace::is_bounded() const
+{
+    return max_cache_bytes_ != std::numeric_limits<std::size_t>::max();
+}
+
+std::uint32_t CachingTaskStateSpace::advance_access_clock()
+{
+    if (access_clock_ == std::numeric_limits<std::uint32_t>::max()) {
+        renumber_access_stamps();
     }
+
+    return ++access_clock_;
 }
 
-CachingTaskStateSpace::CacheEntry&
-CachingTaskStateSpace::lookup(const State& state)
+void CachingTaskStateSpace::renumber_access_stamps()
 {
-    CacheEntry& entry = cache_[state];
-    setup_cache(state, entry);
-    return entry;
+    // Compress the stamps of the cached states to 1, 2, ... in recency
+    // order. The stamps of an unbounded cache are never read.
+    std::vector<StateID> order = cached_states_;
+    std::ranges::sort(order, {}, [&](StateID state_id) {
+        return cache_[state_id].last_access;
+    });
+
+    access_clock_ = 0;
+    for (const StateID state_id : order) {
+        cache_[state_id].last_access = ++access_clock_;
+    }
+}
+
+void CachingTaskStateSpace::evict_least_recently_used()
+{
+    ++cache_statistics_.compactions;
+
+    const std::size_t num_cached = cached_states_.size();
+    assert(num_cached > 0);
+
+    // Sort the cached blocks by the time of their last access.
+    std::vector<std::size_t> order(num_cached);
+    std::iota(order.begin(), order.end(), 0);
+    std::ranges::sort(order, {}, [&](std::size_t i) {
+        return cache_[cached_states_[i]].last_access;
+    });
+
+    // Evict down to half of the budget so that the arrays are not compacted
+    // on every subsequent miss. The most recently cached block is never
+    // evicted, since its view is returned to the caller.
+    const std::size_t target_bytes = max_cache_bytes_ / 2;
+    std::size_t bytes = get_cached_bytes();
+    std::vector<bool> evicted(num_cached, false);
+
+    for (std::size_t k = 0; k != num_cached - 1 && bytes > target_bytes; ++k) {
+        const std::size_t i = order[k];
+        const CacheEntry& entry = cache_[cached_states_[i]];
+        const std::size_t first = entry.first_action;
+        const std::size_t last = first + entry.num_actions;
+        bytes -= entry.num_actions * (sizeof(OperatorID) + sizeof(std::size_t));
+        bytes -= (action_offsets_[last] - action_offsets_[first]) *
+                 sizeof(ItemProbabilityPair<StateID>);
+        evicted[i] = true;
+    }
+
+    // Renumber the access stamps of the survivors in recency order so that
+    // the clock cannot overflow.
+    access_clock_ = 0;
+    for (const std::size_t i : order) {
+        if (evicted[i]) continue;
+        cache_[cached_states_[i]].last_access = ++access_clock_;
+    }
+
+    // Compact the arrays in place. Surviving blocks keep their relative
+    // order, so every block only ever moves towards the front.
+    std::size_t next_action = 0;
+    std::size_t next_outcome = 0;
+    std::size_t next_state = 0;
+
+    for (std::size_t i = 0; i != num_cached; ++i) {
+        const StateID state_id = cached_states_[i];
+        CacheEntry& entry = cache_[state_id];
+
+        if (evicted[i]) {
+            entry = CacheEntry();
+            ++cache_statistics_.evictions;
+            continue;
+        }
+
+        const std::size_t first = entry.first_action;
+        const std::size_t num_actions = entry.num_actions;
+        const std::size_t outcomes_begin = action_offsets_[first];
+        const std::size_t outcomes_end = action_offsets_[first + num_actions];
+
+        std::copy(
+            cached_aops_.begin() + first,
+            cached_aops_.begin() + first + num_actions,
+            cached_aops_.begin() + next_action);
+        std::copy(
+            cached_outcomes_.begin() + outcomes_begin,
+            cached_outcomes_.begin() + outcomes_end,
+            cached_outcomes_.begin() + next_outcome);
+
+        for (std::size_t k = 1; k <= num_actions; ++k) {
+            action_offsets_[next_action + k] =
+                action_offsets_[first + k] - outcomes_begin + next_outcome;
+        }
+
+        entry.first_action = static_cast<std::uint32_t>(next_action);
+        cached_states_[next_state++] = state_id;
+
+        next_action += num_actions;
+        next_outcome += outcomes_end - outcomes_begin;
+    }
+
+    cached_aops_.erase(cached_aops_.begin() + next_action, cached_aops_.end());
+    action_offsets_.resize(next_action + 1);
+    cached_outcomes_.resize(next_outcome);
+    cached_states_.resize(next_state);
 }
 
 } // namespace probfd
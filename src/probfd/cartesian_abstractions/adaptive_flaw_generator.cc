@@ -55,10 +55,10 @@ std::optional<Flaw> AdaptiveFlawGenerator::generate_flaw(
     return std::nullopt;
 }
 
-void AdaptiveFlawGenerator::notify_split()
+void AdaptiveFlawGenerator::notify_split(int v)
 {
     for (size_t i = current_generator_; i != generators_.size(); ++i) {
-        generators_[i]->notify_split();
+        generators_[i]->notify_split(v);
     }
 }
 
@@ -0,0 +1,136 @@
+#include "probfd/cartesian_abstractions/adjacency_lists.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <limits>
+
+using namespace std;
+
+namespace probfd::cartesian_abstractions {
+
+static constexpr uint32_t MIN_BLOCK_CAPACITY = 4;
+
+uint32_t AdjacencyLists::allocate_block(uint32_t capacity)
+{
+    assert(has_single_bit(capacity));
+
+    const auto size_class = static_cast<size_t>(countr_zero(capacity));
+
+    if (size_class < free_blocks_.size() &&
+        !free_blocks_[size_class].empty()) {
+        const uint32_t offset = free_blocks_[size_class].back();
+        free_blocks_[size_class].pop_back();
+        free_capacity_ -= capacity;
+        return offset;
+    }
+
+    assert(
+        buffer_.size() + capacity <= numeric_limits<uint32_t>::max() &&
+        "Adjacency list buffer overflow!");
+
+    const auto offset = static_cast<uint32_t>(buffer_.size());
+    buffer_.resize(buffer_.size() + capacity);
+    return offset;
+}
+
+void AdjacencyLists::free_block(const Block& block)
+{
+    if (block.capacity == 0) return;
+
+    const auto size_class = static_cast<size_t>(countr_zero(block.capacity));
+
+    if (size_class >= free_blocks_.size()) {
+        free_blocks_.resize(size_class + 1);
+    }
+
+    free_blocks_[size_class].push_back(block.offset);
+    free_capacity_ += block.capacity;
+}
+
+void AdjacencyLists::compact()
+{
+    vector<int> buffer;
+    buffer.reserve(buffer_.size() - free_capacity_);
+
+    // Lay out the blocks in the order of the lists.
+    for (Block& block : blocks_) {
+        const auto offset = static_cast<uint32_t>(buffer.size());
+        const auto begin = buffer_.begin() + block.offset;
+        buffer.insert(buffer.end(), begin, begin + block.size);
+        buffer.resize(offset + block.capacity);
+        block.offset = offset;
+    }
+
+    buffer_ = std::move(buffer);
+    free_blocks_.clear();
+    free_capacity_ = 0;
+    ++num_compactions_;
+}
+
+void AdjacencyLists::add_list()
+{
+    blocks_.emplace_back();
+}
+
+void AdjacencyLists::push_back(int list, int value)
+{
+    Block& block = blocks_[list];
+
+    if (block.size == block.capacity) {
+        const uint32_t capacity =
+            block.capacity == 0 ? MIN_BLOCK_CAPACITY : 2 * block.capacity;
+        const uint32_t offset = allocate_block(capacity);
+
+        copy_n(
+            buffer_.begin() + block.offset,
+            block.size,
+            buffer_.begin() + offset);
+
+        free_block(block);
+        block.offset = offset;
+        block.capacity = capacity;
+
+        if (4 * free_capacity_ > buffer_.size()) {
+            compact();
+        }
+    }
+
+    buffer_[block.offset + block.size++] = value;
+}
+
+void AdjacencyLists::clear(int list)
+{
+    blocks_[list].size = 0;
+}
+
+span<const int> AdjacencyLists::operator[](int list) const
+{
+    const Block& block = blocks_[list];
+    return {buffer_.data() + block.offset, block.size};
+}
+
+size_t AdjacencyLists::size() const
+{
+    return blocks_.size();
+}
+
+size_t AdjacencyLists::get_num_compactions() const
+{
+    return num_compactions_;
+}
+
+size_t AdjacencyLists::estimate_memory_in_bytes() const
+{
+    size_t bytes = buffer_.capacity() * sizeof(int) +
+                   blocks_.capacity() * sizeof(Block) +
+                   free_blocks_.capacity() * sizeof(vector<uint32_t>);
+
+    for (const auto& offsets : free_blocks_) {
+        bytes += offsets.capacity() * sizeof(uint32_t);
+    }
+
+    return bytes;
+}
+
+} // namespace probfd::cartesian_abstractions
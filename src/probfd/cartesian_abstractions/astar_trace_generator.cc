@@ -83,8 +83,7 @@ unique_ptr<Trace> AStarTraceGenerator::find_trace(
         }
     });
 
-    const auto& out =
-        abstraction.get_transition_system().get_outgoing_transitions();
+    const auto& transition_system = abstraction.get_transition_system();
 
     search_info_[init_id].decrease_g_value_to(0);
     open_queue_.push(heuristic.get_h_value(init_id), init_id);
@@ -111,10 +110,13 @@ unique_ptr<Trace> AStarTraceGenerator::find_trace(
             return solution;
         }
 
-        for (const ProbabilisticTransition* transition : out[state_id]) {
-            for (size_t i = 0; i != transition->target_ids.size(); ++i) {
-                int op_id = transition->op_id;
-                int succ_id = transition->target_ids[i];
+        for (const int transition_id :
+             transition_system.get_outgoing_transitions(state_id)) {
+            const ProbabilisticTransition& transition =
+                transition_system.get_transition(transition_id);
+            for (size_t i = 0; i != transition.target_ids.size(); ++i) {
+                int op_id = transition.op_id;
+                int succ_id = transition.target_ids[i];
 
                 const value_t op_cost = abstraction.get_cost(op_id);
                 assert(op_cost >= 0);
@@ -61,9 +61,9 @@ void CartesianAbstraction::generate_applicable_actions(
     int state,
     std::vector<const ProbabilisticTransition*>& result)
 {
-    for (const auto* t :
-         transition_system_->get_outgoing_transitions()[state]) {
-        result.push_back(t);
+    for (const int transition_id :
+         transition_system_->get_outgoing_transitions(state)) {
+        result.push_back(&transition_system_->get_transition(transition_id));
     }
 }
 
@@ -84,8 +84,9 @@ void CartesianAbstraction::generate_all_transitions(
     std::vector<const ProbabilisticTransition*>& aops,
     std::vector<Distribution<StateID>>& successors)
 {
-    for (const auto* t :
-         transition_system_->get_outgoing_transitions()[state]) {
+    for (const int transition_id :
+         transition_system_->get_outgoing_transitions(state)) {
+        const auto* t = &transition_system_->get_transition(transition_id);
         aops.push_back(t);
         generate_action_transitions(state, t, successors.emplace_back());
     }
@@ -95,8 +96,9 @@ void CartesianAbstraction::generate_all_transitions(
     int state,
     std::vector<TransitionType>& transitions)
 {
-    for (const auto* t :
-         transition_system_->get_outgoing_transitions()[state]) {
+    for (const int transition_id :
+         transition_system_->get_outgoing_transitions(state)) {
+        const auto* t = &transition_system_->get_transition(transition_id);
         TransitionType& transition = transitions.emplace_back(t);
         generate_action_transitions(state, t, transition.successor_dist);
     }
@@ -122,6 +124,12 @@ value_t CartesianAbstraction::get_cost(int op_index) const
     return operator_costs_[op_index];
 }
 
+void CartesianAbstraction::set_operator_costs(vector<value_t> operator_costs)
+{
+    assert(operator_costs.size() == operator_costs_.size());
+    operator_costs_ = std::move(operator_costs);
+}
+
 const AbstractState& CartesianAbstraction::get_initial_state() const
 {
     return *states_[init_id_];
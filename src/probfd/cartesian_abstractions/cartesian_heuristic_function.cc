@@ -4,6 +4,8 @@
 
 #include "downward/utils/collections.h"
 
+#include "downward/task_proxy.h"
+
 #include <cassert>
 #include <utility>
 
@@ -14,8 +16,8 @@ namespace probfd::cartesian_abstractions {
 CartesianHeuristicFunction::CartesianHeuristicFunction(
     unique_ptr<RefinementHierarchy>&& hierarchy,
     vector<value_t>&& h_values)
-    : refinement_hierarchy_(std::move(hierarchy))
-    , h_values_(std::move(h_values))
+    : refinement_hierarchy_(*hierarchy)
+    , h_values_(to_stored_lower_bounds(std::move(h_values)))
 {
 }
 
@@ -23,9 +25,35 @@ CartesianHeuristicFunction::~CartesianHeuristicFunction() = default;
 
 value_t CartesianHeuristicFunction::get_value(const State& state) const
 {
-    int abstract_state_id = refinement_hierarchy_->get_abstract_state_id(state);
+    int abstract_state_id = refinement_hierarchy_.get_abstract_state_id(state);
     assert(utils::in_bounds(abstract_state_id, h_values_));
     return h_values_[abstract_state_id];
 }
 
+void CartesianHeuristicFunction::get_values(
+    span<const State> states,
+    span<value_t> values) const
+{
+    assert(states.size() == values.size());
+
+    vector<int> abstract_state_ids(states.size());
+    refinement_hierarchy_.get_abstract_state_ids(states, abstract_state_ids);
+
+    for (size_t i = 0; i != states.size(); ++i) {
+        assert(utils::in_bounds(abstract_state_ids[i], h_values_));
+        values[i] = h_values_[abstract_state_ids[i]];
+    }
+}
+
+bool CartesianHeuristicFunction::uses_lookup_table() const
+{
+    return refinement_hierarchy_.uses_lookup_table();
+}
+
+size_t CartesianHeuristicFunction::estimate_memory_in_bytes() const
+{
+    return refinement_hierarchy_.estimate_memory_in_bytes() +
+           h_values_.capacity() * sizeof(stored_value_t);
+}
+
 } // namespace probfd::cartesian_abstractions
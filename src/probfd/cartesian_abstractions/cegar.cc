@@ -58,6 +58,15 @@ CEGAR::~CEGAR() = default;
 
 CEGARResult
 CEGAR::run_refinement_loop(const shared_ptr<ProbabilisticTask>& task)
+{
+    return run_refinement_loop(
+        task,
+        split_selector_factory_->create_split_selector(task));
+}
+
+CEGARResult CEGAR::run_refinement_loop(
+    const shared_ptr<ProbabilisticTask>& task,
+    std::unique_ptr<SplitSelector> split_selector)
 {
     if (log_.is_at_least_normal()) {
         log_ << "Start building abstraction." << endl;
@@ -72,8 +81,6 @@ CEGAR::run_refinement_loop(const shared_ptr<ProbabilisticTask>& task)
 
     std::unique_ptr<FlawGenerator> flaw_generator =
         flaw_generator_factory_->create_flaw_generator();
-    std::unique_ptr<SplitSelector> split_selector =
-        split_selector_factory_->create_split_selector(task);
 
     // Limit the time for building the abstraction.
     utils::CountdownTimer timer(max_time_);
@@ -280,7 +287,7 @@ void CEGAR::refine_abstraction(
     int id = abstract_state.get_id();
     abstraction.refine(refinement_hierarchy, abstract_state, split_var, wanted);
     heuristic.on_split(id);
-    flaw_generator.notify_split();
+    flaw_generator.notify_split(id);
 }
 
 } // namespace probfd::cartesian_abstractions
@@ -7,12 +7,15 @@
 #include "probfd/cartesian_abstractions/cegar.h"
 #include "probfd/cartesian_abstractions/evaluators.h"
 #include "probfd/cartesian_abstractions/probabilistic_transition_system.h"
+#include "probfd/cartesian_abstractions/split_selector.h"
 #include "probfd/cartesian_abstractions/subtask_generators.h"
 
 #include "probfd/task_utils/task_properties.h"
 
 #include "probfd/tasks/modified_operator_costs_task.h"
 
+#include "probfd/utils/thread_pool.h"
+
 #include "probfd/task_proxy.h"
 
 #include "downward/task_utils/task_properties.h"
@@ -23,6 +26,7 @@
 
 #include "downward/task_proxy.h"
 
+#include <algorithm>
 #include <cassert>
 #include <ostream>
 #include <utility>
@@ -53,9 +57,6 @@ static vector<value_t> compute_saturated_costs(
 
     const int num_states = static_cast<int>(h_values.size());
 
-    const auto& out_transitions = transition_system.get_outgoing_transitions();
-    const auto& loops = transition_system.get_loops();
-
     for (int state_id = 0; state_id < num_states; ++state_id) {
         value_t h = h_values[state_id];
 
@@ -65,13 +66,16 @@ static vector<value_t> compute_saturated_costs(
         */
         if (h == INFINITE_VALUE) continue;
 
-        for (const auto* transition : out_transitions[state_id]) {
-            const int op_id = transition->op_id;
+        for (const int transition_id :
+             transition_system.get_outgoing_transitions(state_id)) {
+            const ProbabilisticTransition& transition =
+                transition_system.get_transition(transition_id);
+            const int op_id = transition.op_id;
 
             value_t expectation = 0_vt;
 
-            for (size_t i = 0; i != transition->target_ids.size(); ++i) {
-                const int succ_id = transition->target_ids[i];
+            for (size_t i = 0; i != transition.target_ids.size(); ++i) {
+                const int succ_id = transition.target_ids[i];
                 const value_t succ_h = h_values[succ_id];
                 if (succ_h == INFINITE_VALUE) goto next_transition;
                 const value_t probability =
@@ -88,7 +92,7 @@ static vector<value_t> compute_saturated_costs(
         if (use_general_costs) {
             /* To prevent negative cost cycles, all operators inducing
                self-loops must have non-negative costs. */
-            for (int op_id : loops[state_id]) {
+            for (int op_id : transition_system.get_loops(state_id)) {
                 saturated_costs[op_id] = max(saturated_costs[op_id], 0_vt);
             }
         }
@@ -104,6 +108,7 @@ CostSaturation::CostSaturation(
     int max_non_looping_transitions,
     double max_time,
     bool use_general_costs,
+    unsigned num_threads,
     utils::LogProxy log)
     : subtask_generators_(subtask_generators)
     , flaw_generator_factory_(std::move(flaw_generator_factory))
@@ -112,6 +117,7 @@ CostSaturation::CostSaturation(
     , max_non_looping_transitions_(max_non_looping_transitions)
     , max_time_(max_time)
     , use_general_costs_(use_general_costs)
+    , num_threads_(num_threads)
     , log_(std::move(log))
     , num_abstractions_(0)
     , num_states_(0)
@@ -209,11 +215,46 @@ bool CostSaturation::state_is_dead_end(const State& state) const
     });
 }
 
+void CostSaturation::add_abstraction(CEGARResult& result)
+{
+    auto& [refinement_hierarchy, abstraction, heuristic] = result;
+
+    ++num_abstractions_;
+    num_states_ += abstraction->get_num_states();
+    num_non_looping_transitions_ +=
+        abstraction->get_transition_system().get_num_non_loops();
+    assert(num_states_ <= max_states_);
+
+    vector<value_t> goal_distances(
+        abstraction->get_num_states(),
+        INFINITE_VALUE);
+    compute_value_table(
+        *abstraction,
+        abstraction->get_initial_state().get_id(),
+        *heuristic,
+        goal_distances);
+    vector<value_t> saturated_costs = compute_saturated_costs(
+        abstraction->get_transition_system(),
+        goal_distances,
+        use_general_costs_);
+
+    heuristic_functions_.emplace_back(
+        std::move(refinement_hierarchy),
+        std::move(goal_distances));
+
+    reduce_remaining_costs(saturated_costs);
+}
+
 void CostSaturation::build_abstractions(
     const vector<shared_ptr<ProbabilisticTask>>& subtasks,
     const utils::CountdownTimer& timer,
     function<bool()> should_abort)
 {
+    if (num_threads_ > 1 && subtasks.size() > 1) {
+        build_abstractions_in_parallel(subtasks, timer, should_abort);
+        return;
+    }
+
     int rem_subtasks = static_cast<int>(subtasks.size());
     for (shared_ptr<ProbabilisticTask> subtask : subtasks) {
         subtask = get_remaining_costs_task(subtask);
@@ -229,33 +270,8 @@ void CostSaturation::build_abstractions(
             split_selector_factory_,
             log_);
 
-        auto [refinement_hierarchy, abstraction, heuristic] =
-            cegar.run_refinement_loop(subtask);
-
-        ++num_abstractions_;
-        num_states_ += abstraction->get_num_states();
-        num_non_looping_transitions_ +=
-            abstraction->get_transition_system().get_num_non_loops();
-        assert(num_states_ <= max_states_);
-
-        vector<value_t> goal_distances(
-            abstraction->get_num_states(),
-            INFINITE_VALUE);
-        compute_value_table(
-            *abstraction,
-            abstraction->get_initial_state().get_id(),
-            *heuristic,
-            goal_distances);
-        vector<value_t> saturated_costs = compute_saturated_costs(
-            abstraction->get_transition_system(),
-            goal_distances,
-            use_general_costs_);
-
-        heuristic_functions_.emplace_back(
-            std::move(refinement_hierarchy),
-            std::move(goal_distances));
-
-        reduce_remaining_costs(saturated_costs);
+        CEGARResult result = cegar.run_refinement_loop(subtask);
+        add_abstraction(result);
 
         if (should_abort()) break;
 
@@ -263,6 +279,103 @@ void CostSaturation::build_abstractions(
     }
 }
 
+void CostSaturation::build_abstractions_in_parallel(
+    const vector<shared_ptr<ProbabilisticTask>>& subtasks,
+    const utils::CountdownTimer& timer,
+    const function<bool()>& should_abort)
+{
+    const auto num_subtasks = static_cast<int>(subtasks.size());
+    const int num_concurrent =
+        min(static_cast<int>(num_threads_), num_subtasks);
+
+    /*
+      All abstractions are refined against a snapshot of the remaining costs.
+      The state and transition budgets are split evenly. The time limit is
+      split among the waves of up to num_concurrent abstractions refined at
+      the same time. Like the given timer, the timer of every refinement loop
+      measures the CPU time of the whole process, so it expires once all
+      threads of its wave together have used up the share of the wave.
+    */
+    const vector<value_t> snapshot_costs = remaining_costs_;
+    const int max_states = max(1, (max_states_ - num_states_) / num_subtasks);
+    const int max_transitions =
+        max(1,
+            (max_non_looping_transitions_ - num_non_looping_transitions_) /
+                num_subtasks);
+    const int num_waves = (num_subtasks + num_concurrent - 1) / num_concurrent;
+    const double max_time = timer.get_remaining_time() / num_waves;
+
+    utils::Timer refinement_timer;
+
+    /*
+      The split selectors are created in subtask order before the refinement
+      loops start, so that randomized split selectors are seeded
+      independently of the thread schedule.
+    */
+    vector<shared_ptr<ProbabilisticTask>> snapshot_subtasks;
+    vector<unique_ptr<SplitSelector>> split_selectors;
+    for (const shared_ptr<ProbabilisticTask>& subtask : subtasks) {
+        auto& snapshot_subtask = snapshot_subtasks.emplace_back(
+            make_shared<extra_tasks::ModifiedOperatorCostsTask>(
+                subtask,
+                vector<value_t>(snapshot_costs)));
+        split_selectors.push_back(
+            split_selector_factory_->create_independent_split_selector(
+                snapshot_subtask));
+    }
+
+    vector<unique_ptr<CEGARResult>> results(subtasks.size());
+
+    parallel_for(num_threads_, subtasks.size(), [&](size_t i) {
+        // The log is not thread-safe, so the refinement loops run silently.
+        CEGAR cegar(
+            max_states,
+            max_transitions,
+            max_time,
+            flaw_generator_factory_,
+            split_selector_factory_,
+            utils::get_silent_log());
+
+        results[i].reset(new CEGARResult(cegar.run_refinement_loop(
+            snapshot_subtasks[i],
+            std::move(split_selectors[i]))));
+    });
+
+    refinement_timer.stop();
+
+    /*
+      The goal distances computed by CEGAR are only admissible for the snapshot
+      costs, so we re-saturate the abstractions in order against the actual
+      remaining costs. Only the dead ends carry over, since they do not
+      depend on the operator costs.
+    */
+    utils::Timer saturation_timer;
+
+    for (const unique_ptr<CEGARResult>& result : results) {
+        result->abstraction->set_operator_costs(remaining_costs_);
+
+        CartesianHeuristic& heuristic = *result->heuristic;
+        for (int v = 0; v != result->abstraction->get_num_states(); ++v) {
+            if (heuristic.get_h_value(v) != INFINITE_VALUE) {
+                heuristic.set_h_value(v, 0_vt);
+            }
+        }
+
+        add_abstraction(*result);
+
+        if (should_abort()) break;
+    }
+
+    saturation_timer.stop();
+
+    if (log_.is_at_least_normal()) {
+        log_ << "Refined " << num_subtasks << " Cartesian abstractions on "
+             << num_concurrent << " threads in " << refinement_timer << endl;
+        log_ << "Time for re-saturating the abstractions: "
+             << saturation_timer << endl;
+    }
+}
+
 void CostSaturation::print_statistics(utils::Duration init_time) const
 {
     if (log_.is_at_least_normal()) {
@@ -271,6 +384,23 @@ void CostSaturation::print_statistics(utils::Duration init_time) const
              << init_time << endl;
         log_ << "Cartesian abstractions built: " << num_abstractions_ << endl;
         log_ << "Cartesian states: " << num_states_ << endl;
+        log_ << "Heuristic table memory: "
+             << num_states_ * sizeof(stored_value_t) << " bytes ("
+             << num_states_ * sizeof(value_t) << " bytes in double precision)"
+             << endl;
+
+        size_t lookup_memory = 0;
+        int num_lookup_tables = 0;
+        for (const CartesianHeuristicFunction& function :
+             heuristic_functions_) {
+            lookup_memory += function.estimate_memory_in_bytes();
+            if (function.uses_lookup_table()) ++num_lookup_tables;
+        }
+
+        log_ << "Abstractions with direct lookup tables: " << num_lookup_tables
+             << endl;
+        log_ << "Heuristic function memory: " << lookup_memory << " bytes"
+             << endl;
         log_ << "Total number of non-looping transitions: "
              << num_non_looping_transitions_ << endl;
         log_ << endl;
@@ -0,0 +1,189 @@
+#include "probfd/cartesian_abstractions/flat_refinement_hierarchy.h"
+
+#include "downward/cartesian_abstractions/refinement_hierarchy.h"
+
+#include "downward/abstract_task.h"
+#include "downward/task_proxy.h"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+using namespace std;
+
+namespace probfd::cartesian_abstractions {
+
+// Number of traversals that are interleaved by get_abstract_state_ids().
+static constexpr size_t BATCH_WIDTH = 8;
+
+// Tables up to this size are used regardless of the number of inner nodes.
+static constexpr size_t MIN_TABLE_SIZE = 64;
+
+FlatRefinementHierarchy::FlatRefinementHierarchy(
+    const RefinementHierarchy& hierarchy,
+    bool allow_lookup_table)
+    : task_(hierarchy.get_task())
+{
+    const int num_variables = task_->get_num_variables();
+
+    // Flat indices of the inner nodes of the hierarchy in breadth-first order.
+    vector<int> flat_ids(hierarchy.get_num_nodes(), UNDEFINED);
+    vector<NodeID> queue;
+    vector<bool> is_relevant(num_variables, false);
+
+    auto get_child = [&](NodeID node_id) {
+        const auto& node = hierarchy.get_node(node_id);
+        if (!node.is_split()) return ~node.get_state_id();
+        if (flat_ids[node_id] == UNDEFINED) {
+            flat_ids[node_id] = static_cast<int>(nodes_.size());
+            nodes_.emplace_back();
+            queue.push_back(node_id);
+        }
+        return flat_ids[node_id];
+    };
+
+    root_ = get_child(0);
+
+    for (size_t i = 0; i != queue.size(); ++i) {
+        const auto& node = hierarchy.get_node(queue[i]);
+        const int left = get_child(node.get_left_child());
+        const int right = get_child(node.get_right_child());
+        nodes_[i] = {node.get_var(), node.get_value(), {left, right}};
+        is_relevant[node.get_var()] = true;
+    }
+
+    if (!allow_lookup_table || nodes_.empty()) return;
+
+    const size_t max_table_size = max(MIN_TABLE_SIZE, 4 * nodes_.size());
+    size_t table_size = 1;
+    vector<int> vars;
+
+    for (int var = 0; var != num_variables; ++var) {
+        if (!is_relevant[var]) continue;
+        table_size *= task_->get_variable_domain_size(var);
+        if (table_size > max_table_size) return;
+        vars.push_back(var);
+    }
+
+    build_lookup_table(std::move(vars));
+}
+
+void FlatRefinementHierarchy::build_lookup_table(vector<int> vars)
+{
+    int table_size = 1;
+    for (int var : vars) {
+        table_multipliers_.push_back(table_size);
+        table_size *= task_->get_variable_domain_size(var);
+    }
+
+    table_.resize(table_size);
+
+    // Enumerate the assignments in the order of their ranks.
+    vector<int> values(task_->get_num_variables(), 0);
+    for (int& state_id : table_) {
+        state_id = traverse(values.data());
+
+        for (int var : vars) {
+            if (++values[var] < task_->get_variable_domain_size(var)) break;
+            values[var] = 0;
+        }
+    }
+
+    table_vars_ = std::move(vars);
+}
+
+int FlatRefinementHierarchy::traverse(const int* values) const
+{
+    int id = root_;
+    while (id >= 0) {
+        const InnerNode& node = nodes_[id];
+        id = node.children[values[node.var] == node.value];
+    }
+    return ~id;
+}
+
+int FlatRefinementHierarchy::lookup(const int* values) const
+{
+    if (table_.empty()) return traverse(values);
+
+    int rank = 0;
+    for (size_t i = 0; i != table_vars_.size(); ++i) {
+        rank += table_multipliers_[i] * values[table_vars_[i]];
+    }
+    return table_[rank];
+}
+
+int FlatRefinementHierarchy::get_abstract_state_id(const State& state) const
+{
+    const State subtask_state =
+        PlanningTaskProxy(*task_).convert_ancestor_state(state);
+    return lookup(subtask_state.get_unpacked_values().data());
+}
+
+void FlatRefinementHierarchy::get_abstract_state_ids(
+    span<const State> states,
+    span<int> ids) const
+{
+    assert(states.size() == ids.size());
+
+    const PlanningTaskProxy task_proxy(*task_);
+
+    vector<State> subtask_states;
+    subtask_states.reserve(min(BATCH_WIDTH, states.size()));
+
+    for (size_t begin = 0; begin < states.size(); begin += BATCH_WIDTH) {
+        const size_t width = min(BATCH_WIDTH, states.size() - begin);
+
+        subtask_states.clear();
+        for (size_t lane = 0; lane != width; ++lane) {
+            subtask_states.push_back(
+                task_proxy.convert_ancestor_state(states[begin + lane]));
+        }
+
+        if (!table_.empty()) {
+            for (size_t lane = 0; lane != width; ++lane) {
+                ids[begin + lane] =
+                    lookup(subtask_states[lane].get_unpacked_values().data());
+            }
+            continue;
+        }
+
+        array<const int*, BATCH_WIDTH> values;
+        array<int, BATCH_WIDTH> node_ids;
+        for (size_t lane = 0; lane != width; ++lane) {
+            values[lane] = subtask_states[lane].get_unpacked_values().data();
+            node_ids[lane] = root_;
+        }
+
+        // Advance all unfinished traversals by one level per round.
+        for (bool active = root_ >= 0; active;) {
+            active = false;
+            for (size_t lane = 0; lane != width; ++lane) {
+                int& id = node_ids[lane];
+                if (id < 0) continue;
+                const InnerNode& node = nodes_[id];
+                id = node.children[values[lane][node.var] == node.value];
+                active |= id >= 0;
+            }
+        }
+
+        for (size_t lane = 0; lane != width; ++lane) {
+            ids[begin + lane] = ~node_ids[lane];
+        }
+    }
+}
+
+bool FlatRefinementHierarchy::uses_lookup_table() const
+{
+    return !table_.empty();
+}
+
+size_t FlatRefinementHierarchy::estimate_memory_in_bytes() const
+{
+    return nodes_.capacity() * sizeof(InnerNode) +
+           (table_vars_.capacity() + table_multipliers_.capacity() +
+            table_.capacity()) *
+               sizeof(int);
+}
+
+} // namespace probfd::cartesian_abstractions
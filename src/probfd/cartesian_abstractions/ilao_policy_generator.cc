@@ -4,6 +4,7 @@
 #include "probfd/cartesian_abstractions/cartesian_abstraction.h"
 #include "probfd/cartesian_abstractions/evaluators.h"
 #include "probfd/cartesian_abstractions/probabilistic_transition.h"
+#include "probfd/cartesian_abstractions/probabilistic_transition_system.h"
 
 #include "probfd/algorithms/trap_aware_dfhs.h"
 
@@ -16,8 +17,10 @@
 #include "probfd/value_type.h"
 
 #include "downward/utils/countdown_timer.h"
+#include "downward/utils/logging.h"
 
 #include <optional>
+#include <ostream>
 
 using namespace std;
 
@@ -27,34 +30,109 @@ ILAOPolicyGenerator::ILAOPolicyGenerator()
     : picker_(new policy_pickers::ArbitraryTiebreaker<
               quotients::QuotientState<int, const ProbabilisticTransition*>,
               quotients::QuotientAction<const ProbabilisticTransition*>>(true))
+    , solver_(new algorithms::trap_aware_dfhs::TADepthFirstHeuristicSearch<
+              int,
+              const ProbabilisticTransition*,
+              false>(
+          picker_,
+          false,
+          algorithms::trap_aware_dfhs::BacktrackingUpdateType::SINGLE,
+          true,
+          false,
+          false,
+          true,
+          true))
 {
 }
 
+ILAOPolicyGenerator::~ILAOPolicyGenerator() = default;
+
+void ILAOPolicyGenerator::discard_rewired_region(
+    const CartesianAbstraction& abstraction)
+{
+    const auto& transition_system = abstraction.get_transition_system();
+    const int num_states = abstraction.get_num_states();
+
+    vector<bool> discarded(num_states, false);
+    vector<int> queue;
+
+    auto discard = [&](int state_id) {
+        if (discarded[state_id]) return;
+        discarded[state_id] = true;
+        queue.push_back(state_id);
+    };
+
+    // The split states, the new states and their predecessors were rewired.
+    for (int v : split_states_) {
+        discard(v);
+    }
+
+    for (int v = num_searched_states_; v != num_states; ++v) {
+        discard(v);
+    }
+
+    const size_t num_split = queue.size();
+    for (size_t i = 0; i != num_split; ++i) {
+        for (const int transition_id :
+             transition_system.get_incoming_transitions(queue[i])) {
+            discard(transition_system.get_transition(transition_id).source_id);
+        }
+    }
+
+    // Unsolved states and collapsed traps are discarded as well, since the
+    // quotient system is rebuilt for each search. A solved state is a trap
+    // if its greedy action belongs to another member state.
+    for (int i = 0; i != num_searched_states_; ++i) {
+        if (!solver_->was_visited(i)) continue;
+        auto action = solver_->lookup_policy(i);
+        if (!solver_->is_solved(i) ||
+            (action && action->state_id != StateID(i))) {
+            discard(i);
+        }
+    }
+
+    // Discard all solved states whose greedy policy reaches a discarded
+    // state.
+    while (!queue.empty()) {
+        const int state_id = queue.back();
+        queue.pop_back();
+
+        if (solver_->was_visited(state_id)) {
+            solver_->reset_state(state_id);
+            ++discarded_states_;
+        }
+
+        for (const int transition_id :
+             transition_system.get_incoming_transitions(state_id)) {
+            const ProbabilisticTransition& transition =
+                transition_system.get_transition(transition_id);
+            const int source_id = transition.source_id;
+            if (discarded[source_id]) continue;
+            auto action = solver_->lookup_policy(source_id);
+            if (action && action->action == &transition) discard(source_id);
+        }
+    }
+
+    for (int i = 0; i != num_searched_states_; ++i) {
+        if (!discarded[i] && solver_->is_solved(i)) ++kept_solved_states_;
+    }
+
+    split_states_.clear();
+    num_searched_states_ = num_states;
+}
+
 unique_ptr<Solution> ILAOPolicyGenerator::find_solution(
     CartesianAbstraction& abstraction,
     const AbstractState* state,
     CartesianHeuristic& heuristic,
     utils::CountdownTimer& timer)
 {
-    // TODO: ideally, this object should not be recreated each time, in
-    // particular the storage for the search state. Needs some way to clear
-    // the search state.
-    algorithms::trap_aware_dfhs::
-        TADepthFirstHeuristicSearch<int, const ProbabilisticTransition*, false>
-            talilao(
-                picker_,
-                false,
-                algorithms::trap_aware_dfhs::BacktrackingUpdateType::SINGLE,
-                true,
-                false,
-                false,
-                true,
-                true);
+    discard_rewired_region(abstraction);
 
     ProgressReport report(0.0_vt);
     report.disable();
 
-    auto policy = talilao.compute_policy(
+    auto policy = solver_->compute_policy(
         abstraction,
         heuristic,
         state->get_id(),
@@ -62,12 +140,27 @@ unique_ptr<Solution> ILAOPolicyGenerator::find_solution(
         timer.get_remaining_time());
 
     for (int i = 0; i != abstraction.get_num_states(); ++i) {
-        if (talilao.was_visited(i)) {
-            heuristic.set_h_value(i, talilao.lookup_bounds(i).lower);
+        if (solver_->was_visited(i)) {
+            heuristic.set_h_value(i, solver_->lookup_bounds(i).lower);
         }
     }
 
     return policy;
 }
 
+void ILAOPolicyGenerator::notify_split(int v)
+{
+    split_states_.push_back(v);
+}
+
+void ILAOPolicyGenerator::print_statistics(utils::LogProxy& log)
+{
+    if (log.is_at_least_normal()) {
+        log << "Solved abstract states kept across refinements: "
+            << kept_solved_states_ << endl;
+        log << "Abstract states discarded after refinements: "
+            << discarded_states_ << endl;
+    }
+}
+
 } // namespace probfd::cartesian_abstractions
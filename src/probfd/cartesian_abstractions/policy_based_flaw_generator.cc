@@ -101,8 +101,9 @@ std::optional<Flaw> PolicyBasedFlawGenerator::generate_flaw(
     return flaw;
 }
 
-void PolicyBasedFlawGenerator::notify_split()
+void PolicyBasedFlawGenerator::notify_split(int v)
 {
+    policy_generator_->notify_split(v);
 }
 
 void PolicyBasedFlawGenerator::print_statistics(utils::LogProxy& log)
@@ -112,6 +113,8 @@ void PolicyBasedFlawGenerator::print_statistics(utils::LogProxy& log)
             << endl;
         log << "Time for finding policy flaws: " << find_flaw_timer_ << endl;
     }
+
+    policy_generator_->print_statistics(log);
 }
 
 ILAOFlawGeneratorFactory::ILAOFlawGeneratorFactory(int max_search_states)
@@ -2,9 +2,12 @@
 #include "probfd/cartesian_abstractions/abstract_state.h"
 #include "probfd/cartesian_abstractions/probabilistic_transition.h"
 
+#include "probfd/utils/guards.h"
+
 #include "probfd/task_proxy.h"
 
 #include "downward/utils/logging.h"
+#include "downward/utils/timer.h"
 
 #include "downward/task_utils/task_properties.h"
 
@@ -17,7 +20,6 @@
 
 #include <ostream>
 #include <type_traits>
-#include <unordered_set>
 #include <utility>
 
 using namespace std;
@@ -143,9 +145,9 @@ size_t ProbabilisticTransitionSystem::get_num_operator_outcomes(int op_id) const
 
 void ProbabilisticTransitionSystem::enlarge_vectors_by_one()
 {
-    outgoing_.emplace_back();
-    incoming_.emplace_back();
-    loops_.emplace_back();
+    outgoing_.add_list();
+    incoming_.add_list();
+    loops_.add_list();
 }
 
 void ProbabilisticTransitionSystem::construct_trivial_abstraction(
@@ -156,7 +158,7 @@ void ProbabilisticTransitionSystem::construct_trivial_abstraction(
     assert(get_num_states() == 1);
 
     for (const auto& op : ops) {
-        loops_[0].emplace_back(op.get_id());
+        loops_.push_back(0, op.get_id());
     }
 
     num_loops_ += ops.size();
@@ -167,21 +169,22 @@ void ProbabilisticTransitionSystem::add_transition(
     int op_id,
     std::vector<int> target_ids)
 {
-    auto& transition =
-        transitions_.emplace_back(src_id, op_id, std::move(target_ids));
-    outgoing_[src_id].push_back(&transition);
-
-    std::unordered_set<int> seen;
-    for (int target_id : transition.target_ids) {
-        if (seen.insert(target_id).second) {
-            incoming_[target_id].push_back(&transition);
+    const int transition_id = static_cast<int>(transitions_.size());
+    const auto& targets =
+        transitions_.emplace_back(src_id, op_id, std::move(target_ids))
+            .target_ids;
+    outgoing_.push_back(src_id, transition_id);
+
+    for (auto it = targets.begin(); it != targets.end(); ++it) {
+        if (std::find(targets.begin(), it, *it) == it) {
+            incoming_.push_back(*it, transition_id);
         }
     }
 }
 
 void ProbabilisticTransitionSystem::add_loop(int src_id, int op_id)
 {
-    loops_[src_id].emplace_back(op_id);
+    loops_.push_back(src_id, op_id);
     ++num_loops_;
 }
 
@@ -194,23 +197,24 @@ void ProbabilisticTransitionSystem::rewire_incoming_transitions(
     int v1_id = v1.get_id();
     int v2_id = v2.get_id();
 
-    auto old_incoming = std::move(incoming_[v1_id]);
+    rewired_.assign(incoming_[v1_id].begin(), incoming_[v1_id].end());
+    incoming_.clear(v1_id);
 
-    for (ProbabilisticTransition* transition : old_incoming) {
-        assert(utils::contains(transition->target_ids, v1_id));
+    for (const int transition_id : rewired_) {
+        ProbabilisticTransition& transition = transitions_[transition_id];
+        assert(utils::contains(transition.target_ids, v1_id));
 
-        const int u_id = transition->source_id;
+        const int u_id = transition.source_id;
         const AbstractState& u = *states[u_id];
-        int op_id = transition->op_id;
+        int op_id = transition.op_id;
 
         // Note: Targets are updated in-place to avoid having to remove the
-        // transition from the vector only to re-add a rewired version later.
-        // This would change the positions of other transitions in the vector
-        // and invalidate the references in the incoming and outgoing
-        // transitions lists.
+        // transition only to re-add a rewired version later. This would
+        // change the transition id and invalidate the references held by the
+        // abstract MDP.
         // If rewiring produces two transitions, then the second one is added as
         // a new transition, while the first one is an in-place update.
-        std::vector<int>& target_ids = transition->target_ids;
+        std::vector<int>& target_ids = transition.target_ids;
 
         int pre = get_precondition_value(op_id, var);
         if (pre == UNDEFINED) {
@@ -266,14 +270,14 @@ void ProbabilisticTransitionSystem::rewire_incoming_transitions(
 
             if (v1_incoming) {
                 // Transition is incoming for v1.
-                incoming_[v1_id].push_back(transition);
-                assert(utils::contains(transition->target_ids, v1_id));
+                incoming_.push_back(v1_id, transition_id);
+                assert(utils::contains(transition.target_ids, v1_id));
             }
 
             if (v2_incoming) {
                 // Transition is incoming for v2.
-                incoming_[v2_id].push_back(transition);
-                assert(utils::contains(transition->target_ids, v2_id));
+                incoming_.push_back(v2_id, transition_id);
+                assert(utils::contains(transition.target_ids, v2_id));
             }
         } else {
             bool v1_possible = false;
@@ -298,11 +302,11 @@ void ProbabilisticTransitionSystem::rewire_incoming_transitions(
             assert(v1_possible || v2_possible);
 
             if (v1_possible) {
-                incoming_[v1_id].push_back(transition);
+                incoming_.push_back(v1_id, transition_id);
             }
 
             if (v2_possible) {
-                incoming_[v2_id].push_back(transition);
+                incoming_.push_back(v2_id, transition_id);
             }
         }
     }
@@ -317,12 +321,14 @@ void ProbabilisticTransitionSystem::rewire_outgoing_transitions(
     int v1_id = v1.get_id();
     int v2_id = v2.get_id();
 
-    auto old_outgoing = std::move(outgoing_[v1_id]);
+    rewired_.assign(outgoing_[v1_id].begin(), outgoing_[v1_id].end());
+    outgoing_.clear(v1_id);
 
-    for (ProbabilisticTransition* transition : old_outgoing) {
-        int op_id = transition->op_id;
+    for (const int transition_id : rewired_) {
+        ProbabilisticTransition& transition = transitions_[transition_id];
+        int op_id = transition.op_id;
 
-        std::vector<int>& target_ids = transition->target_ids;
+        std::vector<int>& target_ids = transition.target_ids;
 
         int pre = get_precondition_value(op_id, var);
 
@@ -353,25 +359,25 @@ void ProbabilisticTransitionSystem::rewire_outgoing_transitions(
 
             if (v1_possible) {
                 // Transition is still outgoing for v1. Re-add it.
-                outgoing_[v1_id].push_back(transition);
+                outgoing_.push_back(v1_id, transition_id);
                 if (v2_possible) {
                     // Copy transition to v2.
                     add_transition(v2_id, op_id, target_ids);
                 }
             } else {
                 // Transition is now outgoing for v2.
-                transition->source_id = v2_id;
-                outgoing_[v2_id].push_back(transition);
+                transition.source_id = v2_id;
+                outgoing_.push_back(v2_id, transition_id);
             }
         } else if (v1.contains(var, pre)) {
             // Transition is still outgoing for v1. Re-add it.
-            outgoing_[v1_id].push_back(transition);
+            outgoing_.push_back(v1_id, transition_id);
         } else {
             assert(v2.contains(var, pre));
 
             // Transition is now outgoing for v2.
-            transition->source_id = v2_id;
-            outgoing_[v2_id].push_back(transition);
+            transition.source_id = v2_id;
+            outgoing_.push_back(v2_id, transition_id);
         }
     }
 }
@@ -387,9 +393,10 @@ void ProbabilisticTransitionSystem::rewire_loops(
     int v1_id = v1.get_id();
     int v2_id = v2.get_id();
 
-    auto old_loops = std::move(loops_[v1_id]);
+    rewired_.assign(loops_[v1_id].begin(), loops_[v1_id].end());
+    loops_.clear(v1_id);
 
-    for (int op_id : old_loops) {
+    for (const int op_id : rewired_) {
         const int pre = get_precondition_value(op_id, var);
         const size_t num_outcomes = get_num_operator_outcomes(op_id);
 
@@ -496,7 +503,7 @@ void ProbabilisticTransitionSystem::rewire_loops(
         }
     }
 
-    num_loops_ -= old_loops.size();
+    num_loops_ -= rewired_.size();
 }
 
 void ProbabilisticTransitionSystem::rewire(
@@ -505,6 +512,8 @@ void ProbabilisticTransitionSystem::rewire(
     const AbstractState& v2,
     int var)
 {
+    TimerScope scope(rewire_timer_);
+
     // Make space for new transitions.
     enlarge_vectors_by_one();
 
@@ -521,22 +530,27 @@ ProbabilisticTransitionSystem::get_probability(int op_index, int eff_index)
     return probabilities_by_operator_and_outcome_[op_index][eff_index];
 }
 
-const std::vector<std::vector<ProbabilisticTransition*>>&
-ProbabilisticTransitionSystem::get_incoming_transitions() const
+const ProbabilisticTransition&
+ProbabilisticTransitionSystem::get_transition(int transition_id) const
+{
+    return transitions_[transition_id];
+}
+
+std::span<const int>
+ProbabilisticTransitionSystem::get_incoming_transitions(int v) const
 {
-    return incoming_;
+    return incoming_[v];
 }
 
-const std::vector<std::vector<ProbabilisticTransition*>>&
-ProbabilisticTransitionSystem::get_outgoing_transitions() const
+std::span<const int>
+ProbabilisticTransitionSystem::get_outgoing_transitions(int v) const
 {
-    return outgoing_;
+    return outgoing_[v];
 }
 
-const std::deque<std::vector<int>>&
-ProbabilisticTransitionSystem::get_loops() const
+std::span<const int> ProbabilisticTransitionSystem::get_loops(int v) const
 {
-    return loops_;
+    return loops_[v];
 }
 
 const std::deque<ProbabilisticTransition>&
@@ -566,11 +580,38 @@ int ProbabilisticTransitionSystem::get_num_loops() const
     return static_cast<int>(num_loops_);
 }
 
+size_t ProbabilisticTransitionSystem::estimate_memory_in_bytes() const
+{
+    size_t bytes = outgoing_.estimate_memory_in_bytes() +
+                   incoming_.estimate_memory_in_bytes() +
+                   loops_.estimate_memory_in_bytes() +
+                   transitions_.size() * sizeof(ProbabilisticTransition);
+
+    for (const ProbabilisticTransition& transition : transitions_) {
+        bytes += transition.target_ids.capacity() * sizeof(int);
+    }
+
+    return bytes;
+}
+
 void ProbabilisticTransitionSystem::print_statistics(utils::LogProxy& log) const
 {
     if (log.is_at_least_normal()) {
+        const int num_transitions = get_num_loops() + get_num_non_loops();
+        const size_t memory = estimate_memory_in_bytes();
+
         log << "Looping transitions: " << get_num_loops() << endl;
         log << "Non-looping transitions: " << get_num_non_loops() << endl;
+        log << "Transition system memory: " << memory << " bytes" << endl;
+        log << "Memory per transition: "
+            << static_cast<double>(memory) / std::max(num_transitions, 1)
+            << " bytes" << endl;
+        log << "Adjacency list compactions: "
+            << outgoing_.get_num_compactions() +
+                   incoming_.get_num_compactions() +
+                   loops_.get_num_compactions()
+            << endl;
+        log << "Time for rewiring transitions: " << rewire_timer_ << endl;
     }
 }
 
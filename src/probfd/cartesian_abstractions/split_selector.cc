@@ -163,6 +163,16 @@ SplitSelectorRandomFactory::create_split_selector(
     return std::make_unique<SplitSelectorRandom>(rng_);
 }
 
+std::unique_ptr<SplitSelector>
+SplitSelectorRandomFactory::create_independent_split_selector(
+    const std::shared_ptr<ProbabilisticTask>&)
+{
+    // The seeds only depend on the creation order.
+    return std::make_unique<SplitSelectorRandom>(
+        std::make_shared<utils::RandomNumberGenerator>(
+            rng_->random(numeric_limits<int>::max())));
+}
+
 std::unique_ptr<SplitSelector>
 SplitSelectorMinUnwantedFactory::create_split_selector(
     const std::shared_ptr<ProbabilisticTask>&)
@@ -67,6 +67,16 @@ public:
             "use_general_costs",
             "allow negative costs in cost partitioning",
             "true");
+        add_option<int>(
+            "threads",
+            "The number of threads used for the construction. The "
+            "abstractions of each subtask generator are refined concurrently "
+            "against the same remaining costs and are then re-saturated "
+            "sequentially in their original order. Zero uses one thread per "
+            "hardware thread. Note that the time limit accounts for the CPU "
+            "time of all threads.",
+            "1",
+            Bounds("0", "infinity"));
         add_task_dependent_heuristic_options_to_feature(*this);
     }
 
@@ -83,7 +93,8 @@ public:
             opts.get<int>("max_transitions"),
             opts.get<double>("max_time"),
             opts.get<bool>("use_general_costs"),
-            get_task_dependent_heuristic_arguments_from_options(opts));
+            get_task_dependent_heuristic_arguments_from_options(opts),
+            opts.get<int>("threads"));
     }
 };
 
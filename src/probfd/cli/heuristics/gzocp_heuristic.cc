@@ -3,6 +3,7 @@
 #include "downward/cli/utils/rng_options.h"
 
 #include "probfd/cli/heuristics/task_dependent_heuristic.h"
+#include "probfd/cli/pdbs/pdb_cache_options.h"
 
 #include "probfd/heuristics/gzocp_heuristic.h"
 
@@ -11,6 +12,7 @@ using namespace probfd::pdbs;
 using namespace probfd::heuristics;
 
 using namespace probfd::cli::heuristics;
+using namespace probfd::cli::pdbs;
 
 using namespace downward::cli::plugins;
 
@@ -34,6 +36,14 @@ public:
             "The order in which patterns are considered",
             "random");
 
+        add_option<int>(
+            "threads",
+            "The number of threads used to compute the PDBs. Zero uses one "
+            "thread per hardware thread.",
+            "1",
+            Bounds("0", "infinity"));
+        add_pdb_cache_option_to_feature(*this);
+
         add_rng_options_to_feature(*this);
         add_task_dependent_heuristic_options_to_feature(*this);
     }
@@ -45,7 +55,9 @@ public:
             opts.get<std::shared_ptr<PatternCollectionGenerator>>("patterns"),
             opts.get<GZOCPHeuristic::OrderingStrategy>("order"),
             get_rng_arguments_from_options(opts),
-            get_task_dependent_heuristic_arguments_from_options(opts));
+            get_task_dependent_heuristic_arguments_from_options(opts),
+            opts.get<int>("threads"),
+            get_pdb_cache_arguments_from_options(opts));
     }
 };
 
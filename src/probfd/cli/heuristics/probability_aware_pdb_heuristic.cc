@@ -1,6 +1,7 @@
 #include "downward/cli/plugins/plugin.h"
 
 #include "probfd/cli/heuristics/task_dependent_heuristic.h"
+#include "probfd/cli/pdbs/pdb_cache_options.h"
 
 #include "probfd/heuristics/probability_aware_pdb_heuristic.h"
 
@@ -9,6 +10,7 @@ using namespace probfd::pdbs;
 using namespace probfd::heuristics;
 
 using namespace probfd::cli::heuristics;
+using namespace probfd::cli::pdbs;
 
 using namespace downward::cli::plugins;
 
@@ -40,6 +42,14 @@ public:
             "",
             "classical_generator(generator=systematic(pattern_max_size=2))");
         add_option<double>("max_time_dominance_pruning", "", "0.0");
+        add_option<int>(
+            "threads",
+            "The number of threads used to compute the PDBs of the pattern "
+            "collection, if the pattern generator did not compute them "
+            "already. Zero uses one thread per hardware thread.",
+            "1",
+            Bounds("0", "infinity"));
+        add_pdb_cache_option_to_feature(*this);
         add_task_dependent_heuristic_options_to_feature(*this);
     }
 
@@ -49,6 +59,8 @@ public:
         return make_shared_from_arg_tuples<ProbabilityAwarePDBHeuristicFactory>(
             opts.get<std::shared_ptr<PatternCollectionGenerator>>("patterns"),
             opts.get<double>("max_time_dominance_pruning"),
+            opts.get<int>("threads"),
+            get_pdb_cache_arguments_from_options(opts),
             get_task_dependent_heuristic_arguments_from_options(opts));
     }
 };
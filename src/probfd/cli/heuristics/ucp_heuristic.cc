@@ -1,6 +1,7 @@
 #include "downward/cli/plugins/plugin.h"
 
 #include "probfd/cli/heuristics/task_dependent_heuristic.h"
+#include "probfd/cli/pdbs/pdb_cache_options.h"
 
 #include "probfd/heuristics/ucp_heuristic.h"
 
@@ -11,6 +12,7 @@ using namespace probfd::pdbs;
 using namespace probfd::heuristics;
 
 using namespace probfd::cli::heuristics;
+using namespace probfd::cli::pdbs;
 
 using namespace downward::cli::plugins;
 
@@ -26,6 +28,13 @@ public:
             "patterns",
             "The pattern generation algorithm.",
             "classical_generator(generator=systematic(pattern_max_size=2))");
+        add_option<int>(
+            "threads",
+            "The number of threads used to compute the PDBs. Zero uses one "
+            "thread per hardware thread.",
+            "1",
+            Bounds("0", "infinity"));
+        add_pdb_cache_option_to_feature(*this);
         add_task_dependent_heuristic_options_to_feature(*this);
     }
 
@@ -34,7 +43,9 @@ public:
     {
         return make_shared_from_arg_tuples<UCPHeuristicFactory>(
             get_task_dependent_heuristic_arguments_from_options(opts),
-            opts.get<std::shared_ptr<PatternCollectionGenerator>>("patterns"));
+            opts.get<std::shared_ptr<PatternCollectionGenerator>>("patterns"),
+            opts.get<int>("threads"),
+            get_pdb_cache_arguments_from_options(opts));
     }
 };
 
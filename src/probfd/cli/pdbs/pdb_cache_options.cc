@@ -0,0 +1,26 @@
+#include "downward/cli/plugins/plugin.h"
+
+#include "probfd/cli/pdbs/pdb_cache_options.h"
+
+using namespace downward::cli::plugins;
+
+namespace probfd::cli::pdbs {
+
+void add_pdb_cache_option_to_feature(Feature& feature)
+{
+    feature.add_option<std::string>(
+        "pdb_cache_dir",
+        "A directory in which the computed PDBs are stored and from which "
+        "they are loaded again in later runs for the same task. Loaded PDBs "
+        "are memory-mapped read-only, so that processes on the same host "
+        "share their physical pages. The empty string disables the cache.",
+        "\"\"");
+}
+
+std::tuple<std::string>
+get_pdb_cache_arguments_from_options(const Options& opts)
+{
+    return std::make_tuple(opts.get<std::string>("pdb_cache_dir"));
+}
+
+} // namespace probfd::cli::pdbs
@@ -16,12 +16,9 @@
 #include "probfd/progress_report.h"
 #include "probfd/task_cost_function.h"
 
-#include "probfd/tasks/determinization_task.h"
-
-#include "downward/merge_and_shrink/factored_transition_system.h"
-#include "downward/merge_and_shrink/merge_and_shrink_representation.h"
-#include "downward/merge_and_shrink/transition_system.h"
+#include "probfd/utils/thread_pool.h"
 
+#include "downward/utils/logging.h"
 #include "downward/utils/timer.h"
 
 #include <iostream>
@@ -36,22 +33,6 @@ using namespace downward::cli::plugins;
 
 namespace {
 
-merge_and_shrink::Factor
-compute_bisimulation_on_determinization(const TaskProxy& det_task_proxy)
-{
-    utils::Timer timer;
-
-    std::cout << "Computing all-outcomes determinization bisimulation..."
-              << std::endl;
-
-    auto factor =
-        bisimulation::compute_bisimulation_on_determinization(det_task_proxy);
-
-    std::cout << "AOD-bisimulation was constructed in " << timer << std::endl;
-
-    return factor;
-}
-
 void print_bisimulation_stats(
     std::ostream& out,
     double time,
@@ -69,10 +50,12 @@ class BisimulationIteration : public SolverInterface {
 
     const std::shared_ptr<ProbabilisticTask>& task_ = tasks::g_root_task;
     const bool interval_iteration_;
+    const unsigned num_threads_;
 
 public:
-    explicit BisimulationIteration(bool interval)
+    BisimulationIteration(bool interval, int num_threads)
         : interval_iteration_(interval)
+        , num_threads_(resolve_num_threads(static_cast<unsigned>(num_threads)))
     {
     }
 
@@ -88,32 +71,10 @@ public:
         using namespace algorithms::interval_iteration;
         using namespace algorithms::topological_vi;
 
-        ProbabilisticTaskProxy task_proxy(*task_);
-
         utils::Timer total_timer;
 
         std::cout << "Building bisimulation..." << std::endl;
 
-        std::shared_ptr determinization =
-            std::make_shared<tasks::DeterminizationTask>(task_);
-
-        TaskProxy det_task_proxy(*determinization);
-
-        auto [transition_system, state_mapping, distances] =
-            compute_bisimulation_on_determinization(det_task_proxy);
-
-        if (!transition_system->is_solvable(*distances)) {
-            std::cout << "Initial state recognized as unsolvable!" << std::endl;
-            print_analysis_result(Interval(1_vt, 1_vt));
-            std::cout << std::endl;
-            return false;
-        }
-
-        State initial = task_proxy.get_initial_state();
-        initial.unpack();
-        const auto initial_state =
-            QuotientState(state_mapping->get_value(initial));
-
         utils::Timer timer;
 
         std::shared_ptr task_cost_function =
@@ -122,8 +83,17 @@ public:
         bisimulation::BisimilarStateSpace state_space(
             task_,
             task_cost_function,
-            det_task_proxy,
-            *transition_system);
+            num_threads_,
+            utils::g_log);
+
+        const QState initial_state = state_space.get_initial_state();
+
+        if (state_space.is_dead_end(initial_state)) {
+            std::cout << "Initial state recognized as unsolvable!" << std::endl;
+            print_analysis_result(Interval(1_vt, 1_vt));
+            std::cout << std::endl;
+            return false;
+        }
 
         double time = timer();
         unsigned states = state_space.num_bisimilar_states();
@@ -189,13 +159,23 @@ public:
               "bisimulation_vi")
     {
         document_title("Bisimulation Value Iteration.");
+
+        add_option<int>(
+            "threads",
+            "The number of threads used to compute the signatures during "
+            "partition refinement. Zero uses one thread per hardware thread.",
+            "1",
+            Bounds("0", "infinity"));
     }
 
 protected:
     std::shared_ptr<BisimulationIteration>
-    create_component(const Options&, const utils::Context&) const override
+    create_component(const Options& opts, const utils::Context&)
+        const override
     {
-        return std::make_shared<BisimulationIteration>(false);
+        return std::make_shared<BisimulationIteration>(
+            false,
+            opts.get<int>("threads"));
     }
 };
 
@@ -207,13 +187,23 @@ public:
               "bisimulation_ii")
     {
         document_title("Bisimulation Interval Iteration.");
+
+        add_option<int>(
+            "threads",
+            "The number of threads used to compute the signatures during "
+            "partition refinement. Zero uses one thread per hardware thread.",
+            "1",
+            Bounds("0", "infinity"));
     }
 
 protected:
     std::shared_ptr<BisimulationIteration>
-    create_component(const Options&, const utils::Context&) const override
+    create_component(const Options& opts, const utils::Context&)
+        const override
     {
-        return std::make_shared<BisimulationIteration>(true);
+        return std::make_shared<BisimulationIteration>(
+            true,
+            opts.get<int>("threads"));
     }
 };
 
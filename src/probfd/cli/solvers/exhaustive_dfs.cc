@@ -44,6 +44,9 @@ public:
         utils::Verbosity verbosity,
         std::vector<std::shared_ptr<::Evaluator>> path_dependent_evaluators,
         bool cache,
+        int cache_memory_limit,
+        bool flat_successor_generator,
+        std::optional<std::string> state_storage_directory,
         const std::shared_ptr<TaskEvaluatorFactory>& eval,
         std::optional<value_t> report_epsilon,
         bool report_enabled,
@@ -54,6 +57,9 @@ public:
               verbosity,
               std::move(path_dependent_evaluators),
               cache,
+              cache_memory_limit,
+              flat_successor_generator,
+              std::move(state_storage_directory),
               eval,
               report_epsilon,
               report_enabled,
@@ -82,13 +88,15 @@ public:
                 transition_sort_,
                 cost_bound_,
                 path_updates_,
-                only_propagate_when_changed_);
+                only_propagate_when_changed_,
+                get_per_state_memory());
         } else {
             return std::make_unique<Algorithm>(
                 transition_sort_,
                 cost_bound_,
                 path_updates_,
-                only_propagate_when_changed_);
+                only_propagate_when_changed_,
+                get_per_state_memory());
         }
     }
 };
@@ -37,6 +37,9 @@ public:
         utils::Verbosity verbosity,
         std::vector<std::shared_ptr<::Evaluator>> path_dependent_evaluators,
         bool cache,
+        int cache_memory_limit,
+        bool flat_successor_generator,
+        std::optional<std::string> state_storage_directory,
         const std::shared_ptr<TaskEvaluatorFactory>& eval,
         std::optional<value_t> report_epsilon,
         bool report_enabled,
@@ -47,6 +50,9 @@ public:
               verbosity,
               std::move(path_dependent_evaluators),
               cache,
+              cache_memory_limit,
+              flat_successor_generator,
+              std::move(state_storage_directory),
               eval,
               report_epsilon,
               report_enabled,
@@ -6,11 +6,14 @@
 
 #include "probfd/algorithms/interval_iteration.h"
 
+#include "probfd/utils/thread_pool.h"
+
 #include "downward/operator_id.h"
 #include "downward/task_proxy.h"
 
 #include <memory>
 #include <string>
+#include <utility>
 
 using namespace utils;
 
@@ -25,8 +28,16 @@ using namespace downward::cli::plugins;
 namespace {
 
 class IntervalIterationSolver : public MDPSolver {
+    const unsigned num_threads_;
+
 public:
-    using MDPSolver::MDPSolver;
+    template <typename... Args>
+    explicit IntervalIterationSolver(int num_threads, Args&&... args)
+        : MDPSolver(std::forward<Args>(args)...)
+        , num_threads_(
+              resolve_num_threads(static_cast<unsigned>(num_threads)))
+    {
+    }
 
     std::string get_algorithm_name() const override
     {
@@ -37,7 +48,9 @@ public:
     {
         return std::make_unique<IntervalIteration<State, OperatorID>>(
             false,
-            false);
+            false,
+            get_per_state_memory(),
+            num_threads_);
     }
 };
 
@@ -50,6 +63,16 @@ public:
     {
         document_title("Interval Iteration");
 
+        add_option<int>(
+            "threads",
+            "The number of threads. If greater than one, the recursive "
+            "decompositions of the end component decomposition run "
+            "concurrently with its exploration, and value iteration solves "
+            "independent SCCs as well as the lower and upper bounds of each "
+            "SCC concurrently. Zero uses one thread per hardware thread. Note "
+            "that the time limit accounts for the CPU time of all threads.",
+            "1",
+            Bounds("0", "infinity"));
         add_base_solver_options_to_feature(*this);
     }
 
@@ -58,6 +81,7 @@ protected:
     create_component(const Options& options, const Context&) const override
     {
         return make_shared_from_arg_tuples<IntervalIterationSolver>(
+            options.get<int>("threads"),
             get_base_solver_args_from_options(options));
     }
 };
@@ -30,20 +30,27 @@ class LRTDPSolver : public MDPHeuristicSearch<Bisimulation, Fret> {
     template <typename State, typename Action, bool Interval>
     using LRTDP = LRTDP<State, Action, Interval>;
 
+    template <typename State, typename Action, bool Interval>
+    using SplitLRTDP = lrtdp::
+        LRTDP<State, Action, Interval, heuristic_search::SplitLayout>;
+
     using Sampler = SuccessorSampler<ActionType<Bisimulation, Fret>>;
 
     const std::shared_ptr<Sampler> successor_sampler_;
     const TrialTerminationCondition trial_termination_;
+    const bool split_layout_;
 
 public:
     template <typename... Args>
     LRTDPSolver(
         std::shared_ptr<Sampler> successor_sampler,
         TrialTerminationCondition trial_termination,
+        bool split_layout,
         Args&&... args)
         : MDPHeuristicSearch<Bisimulation, Fret>(std::forward<Args>(args)...)
         , successor_sampler_(std::move(successor_sampler))
         , trial_termination_(trial_termination)
+        , split_layout_(split_layout)
     {
     }
 
@@ -51,6 +58,11 @@ public:
 
     std::unique_ptr<FDRMDPAlgorithm> create_algorithm() override
     {
+        if (split_layout_) {
+            return this->template create_heuristic_search_algorithm<
+                SplitLRTDP>(trial_termination_, successor_sampler_);
+        }
+
         return this->template create_heuristic_search_algorithm<LRTDP>(
             trial_termination_,
             successor_sampler_);
@@ -86,6 +98,13 @@ public:
             "trial_termination",
             "",
             "terminal");
+
+        this->template add_option<bool>(
+            "split_layout",
+            "Store the flags, values and policy actions of the states in "
+            "separate arrays instead of one record per state. Bellman backups "
+            "then only touch the value array.",
+            "false");
     }
 
 protected:
@@ -110,6 +129,7 @@ protected:
         return make_shared_from_arg_tuples<LRTDPSolver<Bisimulation, Fret>>(
             options.get<std::shared_ptr<Sampler>>("successor_sampler"),
             options.get<TrialTerminationCondition>("trial_termination"),
+            options.get<bool>("split_layout"),
             get_mdp_hs_args_from_options<Bisimulation, Fret>(options));
     }
 };
@@ -26,6 +26,30 @@ void add_base_solver_options_to_feature(Feature& feature)
         "Whether the state space should be cached to avoid re-generating "
         "transitions. May drastically increase memory footprint.",
         "false");
+    feature.add_option<int>(
+        "cache_memory_limit",
+        "Memory budget of the transition cache in MiB. If the cached "
+        "transitions exceed the budget, the least recently used ones are "
+        "evicted and recomputed on demand. Only relevant if cache=true.",
+        "infinity",
+        Bounds("1", "infinity"));
+    feature.add_option<bool>(
+        "flat_successor_generator",
+        "Whether the successor generator should be compiled into a flat "
+        "array which is evaluated directly on packed states. Generates the "
+        "same operators as the default successor generator.",
+        "false");
+    feature.add_option<std::string>(
+        "state_storage_directory",
+        "If specified, the packed data of the registered states is kept in a "
+        "memory-mapped temporary file in this directory instead of main "
+        "memory. The solvers ta_topological_value_iteration, exhaustive_dfs "
+        "and interval_iteration also keep their per-state values and "
+        "information there. The operating system writes these pages to disk "
+        "under memory pressure, so state spaces larger than the main memory "
+        "can be solved. The hash set of registered states stays in main "
+        "memory.",
+        ArgumentInfo::NO_DEFAULT);
     feature.add_list_option<std::shared_ptr<::Evaluator>>(
         "path_dependent_evaluators",
         "A list of path-dependent classical planning evaluators to inform of "
@@ -67,6 +91,9 @@ std::tuple<
     utils::Verbosity,
     std::vector<std::shared_ptr<::Evaluator>>,
     bool,
+    int,
+    bool,
+    std::optional<std::string>,
     std::shared_ptr<TaskEvaluatorFactory>,
     std::optional<value_t>,
     bool,
@@ -81,6 +108,12 @@ get_base_solver_args_from_options(const Options& options)
             options.get_list<std::shared_ptr<::Evaluator>>(
                 "path_dependent_evaluators"),
             options.get<bool>("cache"),
+            options.get<int>("cache_memory_limit"),
+            options.get<bool>("flat_successor_generator"),
+            options.contains("state_storage_directory")
+                ? std::optional<std::string>(
+                      options.get<std::string>("state_storage_directory"))
+                : std::nullopt,
             options.get<std::shared_ptr<TaskEvaluatorFactory>>("eval"),
             options.contains("report_epsilon")
                 ? std::optional<value_t>(options.get<value_t>("report_epsilon"))
@@ -0,0 +1,119 @@
+#include "downward/cli/plugins/plugin.h"
+
+#include "probfd/cli/solvers/mdp_solver.h"
+#include "probfd/solvers/mdp_solver.h"
+
+#include "probfd/algorithms/parallel_lrtdp.h"
+
+#include "downward/operator_id.h"
+#include "downward/task_proxy.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+using namespace utils;
+
+using namespace probfd;
+using namespace probfd::solvers;
+using namespace probfd::algorithms::parallel_lrtdp;
+
+using namespace probfd::cli::solvers;
+
+using namespace downward::cli::plugins;
+
+namespace {
+
+class ParallelLRTDPSolver : public MDPSolver {
+    const TrialTerminationCondition trial_termination_;
+    const unsigned num_threads_;
+    const bool dual_bounds_;
+    const int random_seed_;
+
+public:
+    template <typename... Args>
+    explicit ParallelLRTDPSolver(
+        TrialTerminationCondition trial_termination,
+        int num_threads,
+        bool dual_bounds,
+        int random_seed,
+        Args&&... args)
+        : MDPSolver(std::forward<Args>(args)...)
+        , trial_termination_(trial_termination)
+        , num_threads_(static_cast<unsigned>(num_threads))
+        , dual_bounds_(dual_bounds)
+        , random_seed_(random_seed)
+    {
+    }
+
+    std::string get_algorithm_name() const override
+    {
+        return "parallel_lrtdp";
+    }
+
+    std::unique_ptr<FDRMDPAlgorithm> create_algorithm() override
+    {
+        if (dual_bounds_) {
+            return std::make_unique<ParallelLRTDP<State, OperatorID, true>>(
+                trial_termination_,
+                num_threads_,
+                random_seed_);
+        }
+
+        return std::make_unique<ParallelLRTDP<State, OperatorID, false>>(
+            trial_termination_,
+            num_threads_,
+            random_seed_);
+    }
+};
+
+class ParallelLRTDPSolverFeature
+    : public TypedFeature<SolverInterface, ParallelLRTDPSolver> {
+public:
+    ParallelLRTDPSolverFeature()
+        : TypedFeature<SolverInterface, ParallelLRTDPSolver>("parallel_lrtdp")
+    {
+        document_title("Parallel LRTDP.");
+        document_synopsis(
+            "Runs LRTDP trials in several threads which share one table of "
+            "state values. State expansions and heuristic evaluations are "
+            "serialized, Bellman backups and labelling run concurrently. "
+            "Successors are sampled according to their probabilities.");
+
+        add_option<TrialTerminationCondition>(
+            "trial_termination",
+            "",
+            "terminal");
+        add_option<int>(
+            "threads",
+            "The number of threads running trials. Zero uses one thread per "
+            "hardware thread. Note that the time limit accounts for the CPU "
+            "time of all threads.",
+            "1",
+            Bounds("0", "infinity"));
+        add_option<bool>("dual_bounds", "", "false");
+        add_option<int>(
+            "random_seed",
+            "The seed of the successor sampling of the first thread, thread i "
+            "uses random_seed + i.",
+            "0",
+            Bounds("0", "infinity"));
+        add_base_solver_options_to_feature(*this);
+    }
+
+protected:
+    std::shared_ptr<ParallelLRTDPSolver>
+    create_component(const Options& options, const Context&) const override
+    {
+        return make_shared_from_arg_tuples<ParallelLRTDPSolver>(
+            options.get<TrialTerminationCondition>("trial_termination"),
+            options.get<int>("threads"),
+            options.get<bool>("dual_bounds"),
+            options.get<int>("random_seed"),
+            get_base_solver_args_from_options(options));
+    }
+};
+
+FeaturePlugin<ParallelLRTDPSolverFeature> _plugin;
+
+} // namespace
@@ -31,7 +31,7 @@ public:
     {
         using TVIAlgorithm = algorithms::ta_topological_vi::
             TATopologicalValueIteration<State, OperatorID>;
-        return std::make_unique<TVIAlgorithm>();
+        return std::make_unique<TVIAlgorithm>(get_per_state_memory());
     }
 };
 
@@ -5,11 +5,14 @@
 
 #include "probfd/algorithms/topological_value_iteration.h"
 
+#include "probfd/utils/thread_pool.h"
+
 #include "downward/operator_id.h"
 #include "downward/task_proxy.h"
 
 #include <memory>
 #include <string>
+#include <utility>
 
 using namespace utils;
 
@@ -24,8 +27,21 @@ using namespace downward::cli::plugins;
 namespace {
 
 class TopologicalVISolver : public MDPSolver {
+    const unsigned num_threads_;
+    const SCCUpdateOrder update_order_;
+
 public:
-    using MDPSolver::MDPSolver;
+    template <typename... Args>
+    explicit TopologicalVISolver(
+        int num_threads,
+        SCCUpdateOrder update_order,
+        Args&&... args)
+        : MDPSolver(std::forward<Args>(args)...)
+        , num_threads_(
+              resolve_num_threads(static_cast<unsigned>(num_threads)))
+        , update_order_(update_order)
+    {
+    }
 
     std::string get_algorithm_name() const override
     {
@@ -35,7 +51,9 @@ public:
     std::unique_ptr<FDRMDPAlgorithm> create_algorithm() override
     {
         return std::make_unique<TopologicalValueIteration<State, OperatorID>>(
-            false);
+            false,
+            num_threads_,
+            update_order_);
     }
 };
 
@@ -47,6 +65,23 @@ public:
               "topological_value_iteration")
     {
         document_title("Topological Value Iteration.");
+        add_option<int>(
+            "threads",
+            "The number of threads used to solve independent SCCs "
+            "concurrently. If greater than one, the state space is explored "
+            "first and its SCC condensation is solved afterwards by a "
+            "work-stealing thread pool. With point values and the round-robin "
+            "SCC update order, this yields the same values as the serial "
+            "algorithm, otherwise values which differ from them by at most "
+            "epsilon. Zero uses one thread per hardware thread. Note that the "
+            "time limit accounts for the CPU time of all threads.",
+            "1",
+            Bounds("0", "infinity"));
+        add_option<SCCUpdateOrder>(
+            "scc_update_order",
+            "The order in which the states of a non-trivial SCC are backed "
+            "up.",
+            "round_robin");
         add_base_solver_options_to_feature(*this);
     }
 
@@ -55,10 +90,22 @@ protected:
     create_component(const Options& options, const Context&) const override
     {
         return make_shared_from_arg_tuples<TopologicalVISolver>(
+            options.get<int>("threads"),
+            options.get<SCCUpdateOrder>("scc_update_order"),
             get_base_solver_args_from_options(options));
     }
 };
 
 FeaturePlugin<TopologicalVISolverFeature> _plugin;
 
+TypedEnumPlugin<SCCUpdateOrder> _enum_plugin(
+    {{"round_robin",
+      "Sweep over the states until no value changes by more than epsilon."},
+     {"backward_gauss_seidel",
+      "Sweep over the states in reverse order of discovery, skipping states "
+      "whose successor values did not change since their last backup."},
+     {"prioritized_sweeping",
+      "Back up the state whose successor values changed the most first. "
+      "A final sweep confirms convergence."}});
+
 } // namespace
@@ -0,0 +1,264 @@
+#include "probfd/concurrent_state_registry.h"
+
+#include "downward/axioms.h"
+
+#include "downward/utils/hash.h"
+#include "downward/utils/logging.h"
+
+#include <cassert>
+
+using namespace std;
+
+namespace probfd {
+
+/*
+  An open addressing table with linear probing. A slot is zero if it is
+  empty, otherwise it holds the upper half of the state's hash in its upper
+  32 bits and the state's ID plus one in its lower 32 bits. Slots only
+  change from empty to full.
+*/
+struct ConcurrentStateRegistry::Table {
+    const size_t mask;
+    unique_ptr<atomic<uint64_t>[]> slots;
+
+    explicit Table(size_t capacity)
+        : mask(capacity - 1)
+        , slots(new atomic<uint64_t>[capacity])
+    {
+        assert((capacity & mask) == 0);
+        for (size_t i = 0; i != capacity; ++i) {
+            slots[i].store(0, memory_order_relaxed);
+        }
+    }
+
+    size_t capacity() const { return mask + 1; }
+};
+
+struct ConcurrentStateRegistry::Shard {
+    atomic<Table*> table = nullptr;
+
+    // Protects everything below and the insertion of new states.
+    mutex insert_mutex;
+    size_t num_entries = 0;
+    vector<unique_ptr<Table>> tables;
+};
+
+namespace {
+
+constexpr size_t INITIAL_SHARD_CAPACITY = 1024;
+
+uint64_t hash_buffer(const PackedStateBin* buffer, int num_bins)
+{
+    utils::HashState hash_state;
+    for (int i = 0; i != num_bins; ++i) {
+        hash_state.feed(buffer[i]);
+    }
+    return hash_state.get_hash64();
+}
+
+uint64_t make_slot(uint64_t hash, int id)
+{
+    return (hash & 0xFFFFFFFF00000000ULL) | static_cast<uint32_t>(id + 1);
+}
+
+int get_slot_id(uint64_t slot)
+{
+    return static_cast<int>(static_cast<uint32_t>(slot)) - 1;
+}
+
+} // namespace
+
+ConcurrentStateRegistry::ConcurrentStateRegistry(
+    const PlanningTaskProxy& task_proxy)
+    : task_proxy_(task_proxy)
+    , state_packer_(task_properties::g_state_packers[task_proxy])
+    , axiom_evaluator_(g_axiom_evaluators[task_proxy])
+    , num_variables_(task_proxy.get_variables().size())
+    , num_bins_(state_packer_.get_num_bins())
+    , has_axioms_(task_properties::has_axioms(task_proxy))
+    , segments_(new atomic<PackedStateBin*>[MAX_SEGMENTS])
+    , shards_(new Shard[NUM_SHARDS])
+    , initial_state_([this] {
+        for (size_t i = 0; i != MAX_SEGMENTS; ++i) {
+            segments_[i].store(nullptr, memory_order_relaxed);
+        }
+
+        for (size_t i = 0; i != NUM_SHARDS; ++i) {
+            Shard& shard = shards_[i];
+            shard.tables.push_back(
+                make_unique<Table>(INITIAL_SHARD_CAPACITY));
+            shard.table.store(shard.tables.back().get());
+        }
+
+        PackedStateBin* buffer = get_scratch_buffer();
+        // Avoid garbage values in half-full bins.
+        fill_n(buffer, num_bins_, 0);
+
+        State initial_state = task_proxy_.get_initial_state();
+        for (size_t i = 0; i < initial_state.size(); ++i) {
+            state_packer_.set(buffer, i, initial_state[i].get_value());
+        }
+
+        // Unpacked up front, since unpacking writes to the shared state.
+        State registered = lookup_state(insert(buffer));
+        registered.unpack();
+        return registered;
+    }())
+{
+}
+
+ConcurrentStateRegistry::~ConcurrentStateRegistry()
+{
+    for (size_t i = 0; i != MAX_SEGMENTS; ++i) {
+        delete[] segments_[i].load(memory_order_relaxed);
+    }
+}
+
+State ConcurrentStateRegistry::lookup_state(::StateID id) const
+{
+    assert(id.get_value() >= 0 &&
+           static_cast<size_t>(id.get_value()) < size());
+    const PackedStateBin* buffer = get_state_buffer(id.get_value());
+    return task_proxy_.create_state(state_packer_, id, buffer);
+}
+
+int ConcurrentStateRegistry::get_state_size_in_bytes() const
+{
+    return num_bins_ * sizeof(PackedStateBin);
+}
+
+void ConcurrentStateRegistry::print_statistics(utils::LogProxy& log) const
+{
+    size_t num_buckets = 0;
+    size_t num_tables = 0;
+    for (size_t i = 0; i != NUM_SHARDS; ++i) {
+        num_buckets += shards_[i].table.load()->capacity();
+        num_tables += shards_[i].tables.size();
+    }
+
+    log << "Number of registered states: " << size() << endl;
+    log << "Concurrent hash set load factor: " << size() << "/"
+        << num_buckets << " = "
+        << static_cast<double>(size()) / num_buckets << endl;
+    log << "Concurrent hash set resizes: " << num_tables - NUM_SHARDS
+        << endl;
+}
+
+PackedStateBin* ConcurrentStateRegistry::get_scratch_buffer() const
+{
+    // One buffer per thread, shared by all registries.
+    thread_local vector<PackedStateBin> buffer;
+    buffer.resize(num_bins_);
+    return buffer.data();
+}
+
+void ConcurrentStateRegistry::evaluate_axioms(vector<int>& values)
+{
+    lock_guard<mutex> guard(axiom_mutex_);
+    axiom_evaluator_.evaluate(values);
+}
+
+::StateID ConcurrentStateRegistry::insert(const PackedStateBin* buffer)
+{
+    const uint64_t hash = hash_buffer(buffer, num_bins_);
+    Shard& shard = shards_[hash >> (64 - SHARD_BITS)];
+
+    // Returns the ID of the state, or -1 if the table does not contain it.
+    auto probe = [&](const Table& table) {
+        for (size_t i = hash & table.mask;; i = (i + 1) & table.mask) {
+            const uint64_t slot = table.slots[i].load(memory_order_acquire);
+            if (slot == 0) return -1;
+            if ((slot ^ hash) >> 32 != 0) continue;
+            const int id = get_slot_id(slot);
+            if (equal(buffer, buffer + num_bins_, get_state_buffer(id))) {
+                return id;
+            }
+        }
+    };
+
+    // Lookups of registered states never lock.
+    if (int id = probe(*shard.table.load(memory_order_acquire)); id != -1) {
+        return ::StateID(id);
+    }
+
+    lock_guard<mutex> guard(shard.insert_mutex);
+
+    // Only threads holding the lock replace the table.
+    Table* table = shard.table.load(memory_order_relaxed);
+
+    // The state may have been inserted since the lock-free lookup.
+    if (int id = probe(*table); id != -1) {
+        return ::StateID(id);
+    }
+
+    // Keep the load factor of the table at most one half.
+    if (2 * (shard.num_entries + 1) > table->capacity()) {
+        auto new_table = make_unique<Table>(2 * table->capacity());
+        for (size_t i = 0; i != table->capacity(); ++i) {
+            const uint64_t slot = table->slots[i].load(memory_order_relaxed);
+            if (slot == 0) continue;
+            const uint64_t slot_hash =
+                hash_buffer(get_state_buffer(get_slot_id(slot)), num_bins_);
+            size_t j = slot_hash & new_table->mask;
+            while (new_table->slots[j].load(memory_order_relaxed) != 0) {
+                j = (j + 1) & new_table->mask;
+            }
+            new_table->slots[j].store(slot, memory_order_relaxed);
+        }
+
+        table = new_table.get();
+        shard.tables.push_back(std::move(new_table));
+        shard.table.store(table, memory_order_release);
+    }
+
+    const int id = num_states_.fetch_add(1);
+    copy_n(buffer, num_bins_, allocate_state_buffer(id));
+
+    size_t i = hash & table->mask;
+    while (table->slots[i].load(memory_order_relaxed) != 0) {
+        i = (i + 1) & table->mask;
+    }
+
+    // Publishes the state data to lock-free lookups.
+    table->slots[i].store(make_slot(hash, id), memory_order_release);
+    ++shard.num_entries;
+
+    return ::StateID(id);
+}
+
+PackedStateBin* ConcurrentStateRegistry::get_state_buffer(int id) const
+{
+    const size_t index = id;
+    PackedStateBin* segment =
+        segments_[index >> SEGMENT_BITS].load(memory_order_acquire);
+    assert(segment);
+    return segment + (index & (SEGMENT_SIZE - 1)) * num_bins_;
+}
+
+PackedStateBin* ConcurrentStateRegistry::allocate_state_buffer(int id)
+{
+    const size_t index = id;
+    assert(index >> SEGMENT_BITS < MAX_SEGMENTS);
+
+    atomic<PackedStateBin*>& slot = segments_[index >> SEGMENT_BITS];
+    PackedStateBin* segment = slot.load(memory_order_acquire);
+
+    if (!segment) {
+        // Threads racing for the same segment allocate their own one,
+        // the losers delete it again.
+        PackedStateBin* expected = nullptr;
+        segment = new PackedStateBin[SEGMENT_SIZE * num_bins_];
+        if (!slot.compare_exchange_strong(
+                expected,
+                segment,
+                memory_order_acq_rel,
+                memory_order_acquire)) {
+            delete[] segment;
+            segment = expected;
+        }
+    }
+
+    return segment + (index & (SEGMENT_SIZE - 1)) * num_bins_;
+}
+
+} // namespace probfd
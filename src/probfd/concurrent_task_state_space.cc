@@ -0,0 +1,97 @@
+#include "probfd/concurrent_task_state_space.h"
+
+#include "probfd/distribution.h"
+#include "probfd/task_proxy.h"
+#include "probfd/transition.h"
+
+#include "downward/operator_id.h"
+#include "downward/state_id.h"
+
+namespace probfd {
+
+ConcurrentTaskStateSpace::ConcurrentTaskStateSpace(
+    std::shared_ptr<ProbabilisticTask> task,
+    utils::LogProxy log)
+    : task_proxy_(*task)
+    , log_(std::move(log))
+    , state_registry_(task_proxy_)
+    , gen_(task_proxy_)
+{
+}
+
+StateID ConcurrentTaskStateSpace::get_state_id(const State& state)
+{
+    return state.get_id();
+}
+
+State ConcurrentTaskStateSpace::get_state(StateID state_id)
+{
+    return state_registry_.lookup_state(::StateID(state_id));
+}
+
+void ConcurrentTaskStateSpace::generate_applicable_actions(
+    const State& state,
+    std::vector<OperatorID>& result)
+{
+    gen_.generate_applicable_ops(state, result);
+}
+
+void ConcurrentTaskStateSpace::generate_action_transitions(
+    const State& state,
+    OperatorID op_id,
+    Distribution<StateID>& result)
+{
+    const ProbabilisticOperatorProxy op = task_proxy_.get_operators()[op_id];
+    const auto outcomes = op.get_outcomes();
+    result.reserve(outcomes.size());
+
+    for (const ProbabilisticOutcomeProxy outcome : outcomes) {
+        const State succ =
+            state_registry_.get_successor_state(state, outcome.get_effects());
+        result.add_probability(succ.get_id(), outcome.get_probability());
+    }
+}
+
+void ConcurrentTaskStateSpace::generate_all_transitions(
+    const State& state,
+    std::vector<OperatorID>& aops,
+    std::vector<Distribution<StateID>>& successors)
+{
+    generate_applicable_actions(state, aops);
+    successors.reserve(aops.size());
+
+    for (const OperatorID op_id : aops) {
+        generate_action_transitions(state, op_id, successors.emplace_back());
+    }
+}
+
+void ConcurrentTaskStateSpace::generate_all_transitions(
+    const State& state,
+    std::vector<TransitionType>& transitions)
+{
+    std::vector<OperatorID> aops;
+    generate_applicable_actions(state, aops);
+    transitions.reserve(aops.size());
+
+    for (const OperatorID op_id : aops) {
+        TransitionType& t = transitions.emplace_back(op_id);
+        generate_action_transitions(state, op_id, t.successor_dist);
+    }
+}
+
+State ConcurrentTaskStateSpace::get_initial_state() const
+{
+    return state_registry_.get_initial_state();
+}
+
+size_t ConcurrentTaskStateSpace::get_num_registered_states() const
+{
+    return state_registry_.size();
+}
+
+void ConcurrentTaskStateSpace::print_statistics() const
+{
+    state_registry_.print_statistics(log_);
+}
+
+} // namespace probfd
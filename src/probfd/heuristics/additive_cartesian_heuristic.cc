@@ -7,8 +7,11 @@
 
 #include "probfd/task_evaluator_factory.h"
 
+#include "probfd/utils/thread_pool.h"
+
 #include "downward/utils/logging.h"
 
+#include <algorithm>
 #include <cassert>
 #include <ostream>
 #include <utility>
@@ -27,7 +30,8 @@ static vector<CartesianHeuristicFunction> generate_heuristic_functions(
     int max_states,
     int max_transitions,
     double max_time,
-    bool use_general_costs)
+    bool use_general_costs,
+    unsigned num_threads)
 {
     if (log.is_at_least_normal()) {
         log << "Initializing additive Cartesian heuristic..." << endl;
@@ -41,6 +45,7 @@ static vector<CartesianHeuristicFunction> generate_heuristic_functions(
         max_transitions,
         max_time,
         use_general_costs,
+        num_threads,
         log);
 
     return cost_saturation.generate_heuristic_functions(task);
@@ -55,7 +60,8 @@ AdditiveCartesianHeuristic::AdditiveCartesianHeuristic(
     int max_states,
     int max_transitions,
     double max_time,
-    bool use_general_costs)
+    bool use_general_costs,
+    unsigned num_threads)
     : TaskDependentHeuristic(std::move(task), std::move(log))
     , heuristic_functions_(generate_heuristic_functions(
           this->task_,
@@ -66,7 +72,8 @@ AdditiveCartesianHeuristic::AdditiveCartesianHeuristic(
           max_states,
           max_transitions,
           max_time,
-          use_general_costs))
+          use_general_costs,
+          num_threads))
 {
 }
 
@@ -86,6 +93,31 @@ value_t AdditiveCartesianHeuristic::evaluate(const State& ancestor_state) const
     return sum_h;
 }
 
+void AdditiveCartesianHeuristic::evaluate_batch(
+    std::span<const State> ancestor_states,
+    std::span<value_t> values) const
+{
+    assert(ancestor_states.size() == values.size());
+
+    vector<State> states;
+    states.reserve(ancestor_states.size());
+    for (const State& ancestor_state : ancestor_states) {
+        states.push_back(task_proxy_.convert_ancestor_state(ancestor_state));
+    }
+
+    std::ranges::fill(values, 0_vt);
+
+    vector<value_t> function_values(states.size());
+    for (const CartesianHeuristicFunction& function : heuristic_functions_) {
+        function.get_values(states, function_values);
+        for (size_t i = 0; i != states.size(); ++i) {
+            assert(function_values[i] >= 0_vt);
+            // INFINITE_VALUE absorbs all further additions.
+            values[i] += function_values[i];
+        }
+    }
+}
+
 AdditiveCartesianHeuristicFactory::AdditiveCartesianHeuristicFactory(
     std::vector<shared_ptr<SubtaskGenerator>> subtasks,
     shared_ptr<FlawGeneratorFactory> flaw_generator_factory,
@@ -94,7 +126,8 @@ AdditiveCartesianHeuristicFactory::AdditiveCartesianHeuristicFactory(
     int max_transitions,
     double max_time,
     bool use_general_costs,
-    utils::Verbosity verbosity)
+    utils::Verbosity verbosity,
+    int num_threads)
     : subtask_generators(std::move(subtasks))
     , flaw_generator_factory(std::move(flaw_generator_factory))
     , split_selector_factory(std::move(split_selector_factory))
@@ -103,6 +136,7 @@ AdditiveCartesianHeuristicFactory::AdditiveCartesianHeuristicFactory(
     , max_time(max_time)
     , use_general_costs(use_general_costs)
     , log_(utils::get_log_for_verbosity(verbosity))
+    , num_threads_(resolve_num_threads(static_cast<unsigned>(num_threads)))
 {
 }
 
@@ -120,7 +154,8 @@ AdditiveCartesianHeuristicFactory::create_evaluator(
         max_states,
         max_transitions,
         max_time,
-        use_general_costs);
+        use_general_costs,
+        num_threads_);
 }
 
 } // namespace probfd::heuristics
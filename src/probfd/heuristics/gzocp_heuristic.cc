@@ -2,11 +2,14 @@
 
 #include "probfd/pdbs/pattern_collection_generator.h"
 #include "probfd/pdbs/pattern_collection_information.h"
+#include "probfd/pdbs/pdb_cache.h"
 #include "probfd/pdbs/probability_aware_pattern_database.h"
 #include "probfd/pdbs/projection_state_space.h"
 
 #include "probfd/task_utils/task_properties.h"
 
+#include "probfd/utils/thread_pool.h"
+
 #include "probfd/value_type.h"
 
 #include "downward/utils/collections.h"
@@ -26,10 +29,27 @@ using namespace probfd::pdbs;
 namespace probfd::heuristics {
 
 namespace {
+std::vector<std::set<int>>
+compute_affected_vars(const ProbabilisticTaskProxy& task_proxy)
+{
+    const auto operators = task_proxy.get_operators();
+
+    std::vector<std::set<int>> affected_vars;
+    affected_vars.reserve(operators.size());
+
+    for (const ProbabilisticOperatorProxy op : operators) {
+        auto& var_set = affected_vars.emplace_back();
+        task_properties::get_affected_vars(
+            op,
+            std::inserter(var_set, var_set.begin()));
+    }
+
+    return affected_vars;
+}
+
 class ExplicitTaskCostFunction : public FDRSimpleCostFunction {
     ProbabilisticTaskProxy task_proxy;
     std::vector<value_t> costs;
-    std::vector<std::set<int>> affected_vars;
 
 public:
     explicit ExplicitTaskCostFunction(const ProbabilisticTaskProxy& task_proxy)
@@ -38,14 +58,9 @@ public:
         const auto operators = task_proxy.get_operators();
 
         costs.reserve(operators.size());
-        affected_vars.reserve(operators.size());
 
         for (const ProbabilisticOperatorProxy op : operators) {
             costs.push_back(op.get_cost());
-            auto& var_set = affected_vars.emplace_back();
-            task_properties::get_affected_vars(
-                op,
-                std::inserter(var_set, var_set.begin()));
         }
     }
 
@@ -66,12 +81,13 @@ public:
         return INFINITE_VALUE;
     }
 
-    void decrease_costs(const ProbabilityAwarePatternDatabase& pdb)
+    void decrease_costs(
+        const Pattern& pattern,
+        const std::vector<std::set<int>>& affected_vars)
     {
         for (size_t op_id = 0; op_id != costs.size(); ++op_id) {
-            const bool affects_pdb = utils::have_common_element(
-                pdb.get_pattern(),
-                affected_vars[op_id]);
+            const bool affects_pdb =
+                utils::have_common_element(pattern, affected_vars[op_id]);
 
             if (affects_pdb) {
                 costs[op_id] = 0;
@@ -90,7 +106,9 @@ GZOCPHeuristic::GZOCPHeuristic(
     utils::LogProxy log,
     std::shared_ptr<PatternCollectionGenerator> generator,
     OrderingStrategy order,
-    std::shared_ptr<utils::RandomNumberGenerator> rng)
+    std::shared_ptr<utils::RandomNumberGenerator> rng,
+    unsigned num_threads,
+    const std::string& pdb_cache_dir)
     : TaskDependentHeuristic(task, std::move(log))
     , termination_cost_(task_cost_function->get_non_goal_termination_cost())
     , ordering_(order)
@@ -128,22 +146,67 @@ GZOCPHeuristic::GZOCPHeuristic(
     default: break;
     }
 
-    auto task_costs = std::make_shared<ExplicitTaskCostFunction>(task_proxy_);
+    // An operator is assigned zero cost as soon as it affects a previous
+    // pattern, independent of the PDBs computed for these patterns. Hence,
+    // the cost function of every projection is known in advance and the PDBs
+    // can be computed independently of each other.
+    const std::vector<std::set<int>> affected_vars =
+        compute_affected_vars(task_proxy_);
 
-    const State& initial_state = task_proxy_.get_initial_state();
+    std::vector<std::shared_ptr<ExplicitTaskCostFunction>> cost_functions;
+    cost_functions.reserve(patterns->size());
+
+    ExplicitTaskCostFunction task_costs(task_proxy_);
 
     for (const Pattern& pattern : *patterns) {
-        StateRankingFunction rankingf(task_proxy_.get_variables(), pattern);
+        cost_functions.push_back(
+            std::make_shared<ExplicitTaskCostFunction>(task_costs));
+        task_costs.decrease_costs(pattern, affected_vars);
+    }
+
+    const State& initial_state = task_proxy_.get_initial_state();
+
+    std::unique_ptr<PDBCache> pdb_cache;
+    if (!pdb_cache_dir.empty()) {
+        pdb_cache =
+            std::make_unique<PDBCache>(pdb_cache_dir, task_proxy_, log_);
+    }
+
+    std::vector<std::unique_ptr<ProbabilityAwarePatternDatabase>> pdbs(
+        patterns->size());
+
+    parallel_for(num_threads, patterns->size(), [&](std::size_t i) {
+        std::uint64_t cost_key = 0;
+
+        if (pdb_cache) {
+            cost_key = pdb_cache->get_cost_key(*cost_functions[i]);
+            pdbs[i] = pdb_cache->load((*patterns)[i], cost_key);
+            if (pdbs[i]) return;
+        }
+
+        StateRankingFunction rankingf(
+            task_proxy_.get_variables(),
+            (*patterns)[i]);
         ProjectionStateSpace state_space(
             task_proxy_,
-            task_costs,
+            cost_functions[i],
             rankingf,
             false);
         StateRank init_rank = rankingf.get_abstract_rank(initial_state);
-        auto& pdb =
-            pdbs_.emplace_back(state_space, std::move(rankingf), init_rank);
+        pdbs[i] = std::make_unique<ProbabilityAwarePatternDatabase>(
+            state_space,
+            std::move(rankingf),
+            init_rank);
+
+        if (pdb_cache) pdb_cache->store(*pdbs[i], cost_key);
+    });
+
+    for (auto& pdb : pdbs) {
+        pdbs_.push_back(std::move(*pdb));
+    }
 
-        task_costs->decrease_costs(pdb);
+    if (pdb_cache && log_.is_at_least_normal()) {
+        pdb_cache->print_statistics(log_);
     }
 }
 
@@ -168,11 +231,15 @@ GZOCPHeuristicFactory::GZOCPHeuristicFactory(
     std::shared_ptr<PatternCollectionGenerator> pattern_collection_generator,
     GZOCPHeuristic::OrderingStrategy ordering,
     int random_seed_,
-    utils::Verbosity verbosity)
+    utils::Verbosity verbosity,
+    int num_threads,
+    std::string pdb_cache_dir)
     : pattern_collection_generator_(std::move(pattern_collection_generator))
     , ordering_(ordering)
     , random_seed_(random_seed_)
     , verbosity_(verbosity)
+    , num_threads_(resolve_num_threads(static_cast<unsigned>(num_threads)))
+    , pdb_cache_dir_(std::move(pdb_cache_dir))
 {
 }
 
@@ -186,7 +253,9 @@ std::unique_ptr<FDREvaluator> GZOCPHeuristicFactory::create_evaluator(
         utils::get_log_for_verbosity(verbosity_),
         pattern_collection_generator_,
         ordering_,
-        utils::get_rng(random_seed_));
+        utils::get_rng(random_seed_),
+        num_threads_,
+        pdb_cache_dir_);
 }
 
 } // namespace probfd::heuristics
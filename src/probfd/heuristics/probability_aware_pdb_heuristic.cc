@@ -2,8 +2,11 @@
 
 #include "probfd/pdbs/pattern_collection_generator.h"
 #include "probfd/pdbs/pattern_collection_information.h"
+#include "probfd/pdbs/pdb_cache.h"
 #include "probfd/pdbs/probability_aware_pattern_database.h"
 
+#include "probfd/utils/thread_pool.h"
+
 #include "probfd/cost_function.h"
 #include "probfd/task_evaluator_factory.h"
 
@@ -22,6 +25,8 @@ ProbabilityAwarePDBHeuristic::ProbabilityAwarePDBHeuristic(
     std::shared_ptr<FDRCostFunction> task_cost_function,
     std::shared_ptr<PatternCollectionGenerator> generator,
     double max_time_dominance_pruning,
+    unsigned num_threads,
+    const std::string& pdb_cache_dir,
     utils::LogProxy log)
     : TaskDependentHeuristic(std::move(task), std::move(log))
     , termination_cost_(task_cost_function->get_non_goal_termination_cost())
@@ -36,7 +41,16 @@ ProbabilityAwarePDBHeuristic::ProbabilityAwarePDBHeuristic(
     std::shared_ptr<std::vector<pdbs::Pattern>> patterns =
         pattern_collection_info.get_patterns();
 
-    this->pdbs_ = pattern_collection_info.get_pdbs();
+    std::unique_ptr<PDBCache> pdb_cache;
+    if (!pdb_cache_dir.empty()) {
+        pdb_cache =
+            std::make_unique<PDBCache>(pdb_cache_dir, task_proxy_, log_);
+    }
+
+    utils::Timer pdb_timer;
+    this->pdbs_ =
+        pattern_collection_info.get_pdbs(num_threads, pdb_cache.get());
+    const double pdb_time = pdb_timer();
     this->subcollections_ = pattern_collection_info.get_subcollections();
     this->subcollection_finder_ =
         pattern_collection_info.get_subcollection_finder();
@@ -57,6 +71,8 @@ ProbabilityAwarePDBHeuristic::ProbabilityAwarePDBHeuristic(
         dominance_pruning_time = timer();
     }
 
+    ranking_ = MultiPatternRanking(*pdbs_);
+
     if (log_.is_at_least_normal()) {
         // Gather statistics.
         const double construction_time = construction_timer();
@@ -97,6 +113,10 @@ ProbabilityAwarePDBHeuristic::ProbabilityAwarePDBHeuristic(
              << "\n"
              << "  Average number of abstract states per PDB: "
              << avg_abstract_states << "\n"
+             << "  Value table memory: "
+             << abstract_states * sizeof(stored_value_t) << " bytes ("
+             << abstract_states * sizeof(value_t)
+             << " bytes in double precision)\n"
 
              << "  Largest pattern size: " << largest_pattern << "\n"
 
@@ -108,23 +128,65 @@ ProbabilityAwarePDBHeuristic::ProbabilityAwarePDBHeuristic(
              << avg_subcollection_size << "\n"
 
              << "  Generator time: " << generator_time << "s\n"
+             << "  PDB construction time: " << pdb_time << "s\n"
              << "  Dominance pruning time: " << dominance_pruning_time << "s\n"
+             << "  Ranking kernel: "
+             << (ranking_.uses_avx2() ? "AVX2" : "scalar") << "\n"
              << "  Total construction time: " << construction_time << "s\n";
+
+        if (pdb_cache) pdb_cache->print_statistics(log_);
     }
 }
 
 value_t ProbabilityAwarePDBHeuristic::evaluate(const State& state) const
 {
-    return subcollection_finder_
-        ->evaluate(*pdbs_, *subcollections_, state, termination_cost_);
+    // Reused across calls, so that single evaluations do not allocate.
+    thread_local std::vector<StateRank> ranks;
+    ranks.resize(ranking_.num_patterns());
+
+    state.unpack();
+    ranking_.compute_ranks(state.get_unpacked_values().data(), ranks.data(), 1);
+
+    value_t value;
+    subcollection_finder_->evaluate_batch(
+        *pdbs_,
+        *subcollections_,
+        ranks,
+        std::span(&value, 1),
+        termination_cost_);
+    return value;
+}
+
+void ProbabilityAwarePDBHeuristic::evaluate_batch(
+    std::span<const State> states,
+    std::span<value_t> values) const
+{
+    // The ranking kernel reads the unpacked values directly.
+    for (const State& state : states) {
+        state.unpack();
+    }
+
+    std::vector<StateRank> ranks(ranking_.num_patterns() * states.size());
+    ranking_.compute_ranks(states, ranks);
+
+    subcollection_finder_->evaluate_batch(
+        *pdbs_,
+        *subcollections_,
+        ranks,
+        values,
+        termination_cost_);
 }
 
 ProbabilityAwarePDBHeuristicFactory::ProbabilityAwarePDBHeuristicFactory(
     std::shared_ptr<PatternCollectionGenerator> patterns,
     double max_time_dominance_pruning,
+    int num_threads,
+    std::string pdb_cache_dir,
     utils::Verbosity verbosity)
     : patterns_(std::move(patterns))
     , max_time_dominance_pruning_(max_time_dominance_pruning)
+    , num_threads_(resolve_num_threads(static_cast<unsigned>(num_threads)))
+    , pdb_cache_dir_(std::move(pdb_cache_dir))
     , verbosity_(verbosity)
 {
 }
@@ -139,6 +201,8 @@ ProbabilityAwarePDBHeuristicFactory::create_evaluator(
         task_cost_function,
         patterns_,
         max_time_dominance_pruning_,
+        num_threads_,
+        pdb_cache_dir_,
         utils::get_log_for_verbosity(verbosity_));
 }
 
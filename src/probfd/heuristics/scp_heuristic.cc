@@ -2,10 +2,14 @@
 
 #include "probfd/pdbs/pattern_collection_generator.h"
 #include "probfd/pdbs/pattern_collection_information.h"
+#include "probfd/pdbs/pdb_cache.h"
 #include "probfd/pdbs/probability_aware_pattern_database.h"
 #include "probfd/pdbs/projection_state_space.h"
 #include "probfd/pdbs/saturation.h"
 
+#include "probfd/utils/guards.h"
+#include "probfd/utils/thread_pool.h"
+
 #include "probfd/value_type.h"
 
 #include "downward/utils/rng.h"
@@ -14,7 +18,12 @@
 #include "downward/task_utils/task_properties.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <optional>
 #include <utility>
 
 using namespace probfd::pdbs;
@@ -25,11 +34,15 @@ SCPHeuristicFactory::SCPHeuristicFactory(
     std::shared_ptr<PatternCollectionGenerator> pattern_collection_generator,
     SCPHeuristic::OrderingStrategy ordering,
     int random_seed,
-    utils::Verbosity verbosity)
+    utils::Verbosity verbosity,
+    int num_threads,
+    std::string pdb_cache_dir)
     : pattern_collection_generator_(std::move(pattern_collection_generator))
     , ordering_(ordering)
     , random_seed_(random_seed)
     , verbosity_(verbosity)
+    , num_threads_(resolve_num_threads(static_cast<unsigned>(num_threads)))
+    , pdb_cache_dir_(std::move(pdb_cache_dir))
 {
 }
 
@@ -43,7 +56,9 @@ std::unique_ptr<FDREvaluator> SCPHeuristicFactory::create_evaluator(
         utils::get_log_for_verbosity(verbosity_),
         pattern_collection_generator_,
         ordering_,
-        utils::get_rng(random_seed_));
+        utils::get_rng(random_seed_),
+        num_threads_,
+        pdb_cache_dir_);
 }
 
 namespace {
@@ -83,6 +98,27 @@ public:
     value_t& operator[](size_t i) { return costs[i]; }
     const value_t& operator[](size_t i) const { return costs[i]; }
 };
+
+struct Projection {
+    StateRankingFunction ranking_function;
+    std::unique_ptr<ProjectionStateSpace> state_space;
+};
+
+// Without operator pruning, the projection does not depend on the operator
+// costs, which are only queried when the PDB is computed.
+Projection build_projection(
+    const ProbabilisticTaskProxy& task_proxy,
+    const std::shared_ptr<FDRSimpleCostFunction>& task_costs,
+    const Pattern& pattern)
+{
+    StateRankingFunction rankingf(task_proxy.get_variables(), pattern);
+    auto state_space = std::make_unique<ProjectionStateSpace>(
+        task_proxy,
+        task_costs,
+        rankingf,
+        false);
+    return {std::move(rankingf), std::move(state_space)};
+}
 } // namespace
 
 SCPHeuristic::SCPHeuristic(
@@ -91,7 +127,9 @@ SCPHeuristic::SCPHeuristic(
     utils::LogProxy log,
     std::shared_ptr<PatternCollectionGenerator> generator,
     OrderingStrategy order,
-    std::shared_ptr<utils::RandomNumberGenerator> rng)
+    std::shared_ptr<utils::RandomNumberGenerator> rng,
+    unsigned num_threads,
+    const std::string& pdb_cache_dir)
     : TaskDependentHeuristic(task, std::move(log))
     , termination_cost_(task_cost_function->get_non_goal_termination_cost())
     , ordering_(order)
@@ -136,24 +174,114 @@ SCPHeuristic::SCPHeuristic(
 
     const State& initial_state = task_proxy_.get_initial_state();
 
-    for (const Pattern& pattern : *patterns) {
-        StateRankingFunction rankingf(task_proxy_.get_variables(), pattern);
-        ProjectionStateSpace state_space(
-            task_proxy_,
-            task_costs,
-            rankingf,
-            false);
-        const StateRank initial_state_rank =
-            rankingf.get_abstract_rank(initial_state);
-
-        auto& pdb = pdbs_.emplace_back(
-            state_space,
-            std::move(rankingf),
-            initial_state_rank);
+    const size_t num_patterns = patterns->size();
+
+    std::unique_ptr<PDBCache> pdb_cache;
+    if (!pdb_cache_dir.empty()) {
+        pdb_cache =
+            std::make_unique<PDBCache>(pdb_cache_dir, task_proxy_, log_);
+    }
+
+    // The saturation makes every PDB depend on its predecessors, but the
+    // projections do not. With multiple threads, the projections are
+    // therefore built by a thread pool in pattern order, while this thread
+    // computes and saturates the PDBs in the same order as soon as their
+    // projections are available. To bound the memory, the workers stay at
+    // most a fixed number of patterns ahead of this thread.
+    std::vector<std::promise<Projection>> projections(num_patterns);
+    std::vector<std::future<Projection>> futures;
+    std::atomic<size_t> next_pattern = 0;
+    std::atomic<bool> stop = false;
+
+    const size_t look_ahead = 2 * static_cast<size_t>(num_threads);
+    std::mutex window_mutex;
+    std::condition_variable window_cv;
+    size_t num_consumed = 0;
+
+    std::optional<ThreadPool> pool;
+
+    if (num_threads > 1 && num_patterns > 1) {
+        futures.reserve(num_patterns);
+        for (auto& promise : projections) {
+            futures.push_back(promise.get_future());
+        }
+
+        const auto num_workers = static_cast<unsigned>(
+            std::min<size_t>(num_threads - 1, num_patterns));
+        pool.emplace(num_workers);
+
+        for (unsigned i = 0; i != num_workers; ++i) {
+            pool->submit([&] {
+                for (size_t j; !stop && (j = next_pattern++) < num_patterns;) {
+                    {
+                        std::unique_lock lock(window_mutex);
+                        window_cv.wait(lock, [&] {
+                            return stop || j < num_consumed + look_ahead;
+                        });
+                    }
+
+                    if (stop) break;
+
+                    try {
+                        projections[j].set_value(build_projection(
+                            task_proxy_,
+                            task_costs,
+                            (*patterns)[j]));
+                    } catch (...) {
+                        projections[j].set_exception(std::current_exception());
+                    }
+                }
+            });
+        }
+    }
+
+    // Lets the workers exit early if this constructor throws.
+    scope_exit stop_workers([&] {
+        {
+            std::lock_guard lock(window_mutex);
+            stop = true;
+        }
+        window_cv.notify_all();
+    });
+
+    for (size_t i = 0; i != num_patterns; ++i) {
+        Projection projection =
+            pool ? futures[i].get()
+                 : build_projection(task_proxy_, task_costs, (*patterns)[i]);
+
+        if (pool) {
+            {
+                std::lock_guard lock(window_mutex);
+                ++num_consumed;
+            }
+            window_cv.notify_all();
+        }
+
+        const std::uint64_t cost_key =
+            pdb_cache ? pdb_cache->get_cost_key(*task_costs) : 0;
+
+        std::unique_ptr<ProbabilityAwarePatternDatabase> cached_pdb =
+            pdb_cache ? pdb_cache->load((*patterns)[i], cost_key) : nullptr;
+
+        ProbabilityAwarePatternDatabase* pdb;
+
+        if (cached_pdb) {
+            pdb = &pdbs_.emplace_back(std::move(*cached_pdb));
+        } else {
+            const StateRank initial_state_rank =
+                projection.ranking_function.get_abstract_rank(initial_state);
+
+            pdb = &pdbs_.emplace_back(
+                *projection.state_space,
+                std::move(projection.ranking_function),
+                initial_state_rank);
+
+            if (pdb_cache) pdb_cache->store(*pdb, cost_key);
+        }
 
         compute_saturated_costs(
-            state_space,
-            pdb.get_value_table(),
+            *projection.state_space,
+            pdb->get_value_table(),
             saturated_costs);
 
         auto& costs_ref = *task_costs;
@@ -169,6 +297,10 @@ SCPHeuristic::SCPHeuristic(
             }
         }
     }
+
+    if (pdb_cache && log_.is_at_least_normal()) {
+        pdb_cache->print_statistics(log_);
+    }
 }
 
 value_t SCPHeuristic::evaluate(const State& state) const
@@ -2,9 +2,13 @@
 
 #include "probfd/pdbs/pattern_collection_generator.h"
 #include "probfd/pdbs/pattern_collection_information.h"
+#include "probfd/pdbs/pdb_cache.h"
 #include "probfd/pdbs/probability_aware_pattern_database.h"
-#include "probfd/pdbs/projection_state_space.h"
+#include "probfd/pdbs/utils.h"
 
+#include "probfd/utils/thread_pool.h"
+
+#include "probfd/cost_function.h"
 #include "probfd/task_evaluator_factory.h"
 #include "probfd/value_type.h"
 
@@ -58,7 +62,9 @@ UCPHeuristic::UCPHeuristic(
     std::shared_ptr<ProbabilisticTask> task,
     std::shared_ptr<FDRCostFunction> task_cost_function,
     utils::LogProxy log,
-    std::shared_ptr<PatternCollectionGenerator> generator)
+    std::shared_ptr<PatternCollectionGenerator> generator,
+    unsigned num_threads,
+    const std::string& pdb_cache_dir)
     : TaskDependentHeuristic(task, std::move(log))
     , termination_cost_(task_cost_function->get_non_goal_termination_cost())
 {
@@ -75,17 +81,25 @@ UCPHeuristic::UCPHeuristic(
         task_proxy_,
         num_abstractions);
 
-    const State& initial_state = task_proxy_.get_initial_state();
-
-    for (const Pattern& pattern : *patterns) {
-        StateRankingFunction rankingf(task_proxy_.get_variables(), pattern);
-        ProjectionStateSpace state_space(
-            task_proxy_,
-            task_costs,
-            rankingf,
-            true);
-        StateRank init_rank = rankingf.get_abstract_rank(initial_state);
-        pdbs_.emplace_back(state_space, std::move(rankingf), init_rank);
+    std::unique_ptr<PDBCache> pdb_cache;
+    if (!pdb_cache_dir.empty()) {
+        pdb_cache =
+            std::make_unique<PDBCache>(pdb_cache_dir, task_proxy_, log_);
+    }
+
+    // The cost function is the same for all projections, so the PDBs are
+    // independent of each other.
+    for (auto& pdb : compute_pdbs(
+             task_proxy_,
+             task_costs,
+             *patterns,
+             num_threads,
+             pdb_cache.get())) {
+        pdbs_.push_back(std::move(*pdb));
+    }
+
+    if (pdb_cache && log_.is_at_least_normal()) {
+        pdb_cache->print_statistics(log_);
     }
 }
 
@@ -110,9 +124,13 @@ value_t UCPHeuristic::evaluate(const State& state) const
 
 UCPHeuristicFactory::UCPHeuristicFactory(
     utils::Verbosity verbosity,
-    std::shared_ptr<PatternCollectionGenerator> generator)
+    std::shared_ptr<PatternCollectionGenerator> generator,
+    int num_threads,
+    std::string pdb_cache_dir)
     : verbosity_(verbosity)
     , pattern_collection_generator_(std::move(generator))
+    , num_threads_(resolve_num_threads(static_cast<unsigned>(num_threads)))
+    , pdb_cache_dir_(std::move(pdb_cache_dir))
 {
 }
 
@@ -124,7 +142,9 @@ std::unique_ptr<FDREvaluator> UCPHeuristicFactory::create_evaluator(
         task,
         task_cost_function,
         utils::get_log_for_verbosity(verbosity_),
-        pattern_collection_generator_);
+        pattern_collection_generator_,
+        num_threads_,
+        pdb_cache_dir_);
 }
 
 } // namespace probfd::heuristics
@@ -1,5 +1,6 @@
 #include "probfd/interval.h"
 
+#include <algorithm>
 #include <ostream>
 
 namespace probfd {
@@ -43,6 +44,29 @@ bool Interval::bounds_approximately_equal(value_t tolerance) const
     return is_approx_equal(lower, upper, tolerance);
 }
 
+#if defined(PROBFD_MIXED_PRECISION)
+StoredInterval::StoredInterval(Interval val)
+    : lower(to_stored_lower_bound(val.lower))
+    , upper(to_stored_upper_bound(val.upper))
+{
+}
+
+StoredInterval::operator Interval() const
+{
+    return Interval(lower, upper);
+}
+
+bool StoredInterval::bounds_approximately_equal(value_t tolerance) const
+{
+    // Rounding outwards separates the bounds of a converged value by up to
+    // the rounding error of either bound.
+    return is_approx_equal(
+        lower,
+        upper,
+        std::max(tolerance, 2 * get_stored_value_error(upper)));
+}
+#endif
+
 Interval operator+(Interval lhs, Interval rhs)
 {
     return Interval(lhs.lower + rhs.lower, lhs.upper + rhs.upper);
@@ -0,0 +1,211 @@
+#include "probfd/pdbs/multi_pattern_ranking.h"
+
+#include "probfd/pdbs/probability_aware_pattern_database.h"
+#include "probfd/pdbs/state_ranking_function.h"
+
+#include "downward/task_proxy.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <stdexcept>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define PROBFD_HAS_AVX2_KERNEL
+#include <immintrin.h>
+#endif
+
+namespace probfd::pdbs {
+
+MultiPatternRanking::MultiPatternRanking(
+    std::span<const StateRankingFunction* const> ranking_functions,
+    bool allow_simd)
+    : num_patterns_(ranking_functions.size())
+    , use_avx2_(allow_simd && cpu_supports_avx2())
+{
+    for (std::size_t first = 0; first < num_patterns_; first += BLOCK_SIZE) {
+        const auto block = ranking_functions.subspan(
+            first,
+            std::min(BLOCK_SIZE, num_patterns_ - first));
+
+        std::size_t num_rows = 0;
+        for (const StateRankingFunction* ranking_function : block) {
+            num_rows = std::max<std::size_t>(
+                num_rows,
+                ranking_function->num_vars());
+        }
+
+        const std::size_t row_begin = block_rows_.back();
+        block_rows_.push_back(row_begin + num_rows);
+
+        // Padding lanes read variable 0 and multiply it with zero.
+        variables_.resize((row_begin + num_rows) * BLOCK_SIZE, 0);
+        multipliers_.resize((row_begin + num_rows) * BLOCK_SIZE, 0);
+
+        for (std::size_t lane = 0; lane != block.size(); ++lane) {
+            const StateRankingFunction& ranking_function = *block[lane];
+            const Pattern& pattern = ranking_function.get_pattern();
+
+            for (std::size_t i = 0; i != pattern.size(); ++i) {
+                const long long multiplier =
+                    ranking_function.get_multiplier(static_cast<int>(i));
+                const int domain_size =
+                    ranking_function.get_enumerator().get_domain_size(
+                        static_cast<int>(i));
+
+                // The largest partial rank must fit into the 32-bit lanes.
+                if (multiplier * domain_size - 1 >
+                    std::numeric_limits<StateRank>::max()) {
+                    throw std::range_error(
+                        "Abstract state ranks exceed the range of StateRank");
+                }
+
+                const std::size_t pos = (row_begin + i) * BLOCK_SIZE + lane;
+                variables_[pos] = pattern[i];
+                multipliers_[pos] = static_cast<std::int32_t>(multiplier);
+            }
+        }
+    }
+}
+
+MultiPatternRanking::MultiPatternRanking(
+    const PPDBCollection& pdbs,
+    bool allow_simd)
+    : MultiPatternRanking(
+          [&] {
+              std::vector<const StateRankingFunction*> ranking_functions;
+              ranking_functions.reserve(pdbs.size());
+              for (const auto& pdb : pdbs) {
+                  ranking_functions.push_back(
+                      &pdb->get_state_ranking_function());
+              }
+              return ranking_functions;
+          }(),
+          allow_simd)
+{
+}
+
+std::size_t MultiPatternRanking::num_patterns() const
+{
+    return num_patterns_;
+}
+
+bool MultiPatternRanking::uses_avx2() const
+{
+    return use_avx2_;
+}
+
+void MultiPatternRanking::compute_ranks(
+    std::span<const State> states,
+    std::span<StateRank> ranks) const
+{
+    assert(ranks.size() == num_patterns_ * states.size());
+
+    const std::size_t num_states = states.size();
+
+    for (std::size_t j = 0; j != num_states; ++j) {
+        compute_ranks(
+            states[j].get_unpacked_values().data(),
+            ranks.data() + j,
+            num_states);
+    }
+}
+
+void MultiPatternRanking::compute_ranks(
+    const int* values,
+    StateRank* ranks,
+    std::size_t stride) const
+{
+    if (use_avx2_) {
+        compute_ranks_avx2(values, ranks, stride);
+    } else {
+        compute_ranks_scalar(values, ranks, stride);
+    }
+}
+
+void MultiPatternRanking::compute_ranks_scalar(
+    const int* values,
+    StateRank* ranks,
+    std::size_t stride) const
+{
+    const std::size_t num_blocks = block_rows_.size() - 1;
+
+    for (std::size_t b = 0; b != num_blocks; ++b) {
+        StateRank block_ranks[BLOCK_SIZE] = {};
+
+        for (std::size_t r = block_rows_[b]; r != block_rows_[b + 1]; ++r) {
+            const std::int32_t* vars = variables_.data() + r * BLOCK_SIZE;
+            const std::int32_t* mults = multipliers_.data() + r * BLOCK_SIZE;
+
+            for (std::size_t lane = 0; lane != BLOCK_SIZE; ++lane) {
+                block_ranks[lane] += mults[lane] * values[vars[lane]];
+            }
+        }
+
+        const std::size_t first = b * BLOCK_SIZE;
+        const std::size_t lanes = std::min(BLOCK_SIZE, num_patterns_ - first);
+        for (std::size_t lane = 0; lane != lanes; ++lane) {
+            ranks[(first + lane) * stride] = block_ranks[lane];
+        }
+    }
+}
+
+#ifdef PROBFD_HAS_AVX2_KERNEL
+
+__attribute__((target("avx2"))) void MultiPatternRanking::compute_ranks_avx2(
+    const int* values,
+    StateRank* ranks,
+    std::size_t stride) const
+{
+    static_assert(BLOCK_SIZE * sizeof(std::int32_t) == sizeof(__m256i));
+
+    const std::size_t num_blocks = block_rows_.size() - 1;
+
+    for (std::size_t b = 0; b != num_blocks; ++b) {
+        __m256i acc = _mm256_setzero_si256();
+
+        for (std::size_t r = block_rows_[b]; r != block_rows_[b + 1]; ++r) {
+            const __m256i vars = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(
+                    variables_.data() + r * BLOCK_SIZE));
+            const __m256i mults = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i*>(
+                    multipliers_.data() + r * BLOCK_SIZE));
+            const __m256i vals = _mm256_i32gather_epi32(values, vars, 4);
+            acc = _mm256_add_epi32(acc, _mm256_mullo_epi32(vals, mults));
+        }
+
+        alignas(32) StateRank block_ranks[BLOCK_SIZE];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(block_ranks), acc);
+
+        const std::size_t first = b * BLOCK_SIZE;
+        const std::size_t lanes = std::min(BLOCK_SIZE, num_patterns_ - first);
+        for (std::size_t lane = 0; lane != lanes; ++lane) {
+            ranks[(first + lane) * stride] = block_ranks[lane];
+        }
+    }
+}
+
+bool MultiPatternRanking::cpu_supports_avx2()
+{
+    return __builtin_cpu_supports("avx2");
+}
+
+#else
+
+void MultiPatternRanking::compute_ranks_avx2(
+    const int* values,
+    StateRank* ranks,
+    std::size_t stride) const
+{
+    compute_ranks_scalar(values, ranks, stride);
+}
+
+bool MultiPatternRanking::cpu_supports_avx2()
+{
+    return false;
+}
+
+#endif
+
+} // namespace probfd::pdbs
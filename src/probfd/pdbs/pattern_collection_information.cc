@@ -2,6 +2,7 @@
 
 #include "probfd/pdbs/probability_aware_pattern_database.h"
 #include "probfd/pdbs/trivial_finder.h"
+#include "probfd/pdbs/utils.h"
 
 #include "downward/pdbs/pattern_collection_information.h"
 
@@ -98,20 +99,20 @@ bool PatternCollectionInformation::information_is_valid() const
     return true;
 }
 
-void PatternCollectionInformation::create_pdbs_if_missing()
+void PatternCollectionInformation::create_pdbs_if_missing(
+    unsigned num_threads,
+    const PDBCache* cache)
 {
     assert(patterns_);
     if (!pdbs_) {
         utils::Timer timer;
         cout << "Computing PDBs for pattern collection..." << endl;
-        pdbs_ = make_shared<PPDBCollection>();
-        for (const Pattern& pattern : *patterns_) {
-            pdbs_->emplace_back(new ProbabilityAwarePatternDatabase(
-                task_proxy_,
-                task_cost_function_,
-                pattern,
-                task_proxy_.get_initial_state()));
-        }
+        pdbs_ = make_shared<PPDBCollection>(compute_pdbs(
+            task_proxy_,
+            task_cost_function_,
+            *patterns_,
+            num_threads,
+            cache));
         cout << "Done computing PDBs for pattern collection: " << timer << endl;
     }
 }
@@ -148,9 +149,12 @@ shared_ptr<PatternCollection> PatternCollectionInformation::get_patterns() const
     return patterns_;
 }
 
-shared_ptr<PPDBCollection> PatternCollectionInformation::get_pdbs()
+shared_ptr<PPDBCollection>
+PatternCollectionInformation::get_pdbs(
+    unsigned num_threads,
+    const PDBCache* cache)
 {
-    create_pdbs_if_missing();
+    create_pdbs_if_missing(num_threads, cache);
     return pdbs_;
 }
 
@@ -0,0 +1,356 @@
+#include "probfd/pdbs/pdb_cache.h"
+
+#include "probfd/pdbs/probability_aware_pattern_database.h"
+#include "probfd/pdbs/state_ranking_function.h"
+
+#include "probfd/utils/mapped_file.h"
+
+#include "probfd/cost_function.h"
+#include "probfd/value_type.h"
+
+#include "downward/utils/hash.h"
+#include "downward/utils/logging.h"
+#include "downward/utils/system.h"
+
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <stdexcept>
+#include <system_error>
+
+namespace probfd::pdbs {
+
+namespace {
+constexpr char PDB_FILE_MAGIC[4] = {'P', 'P', 'D', 'B'};
+constexpr std::uint32_t PDB_FILE_VERSION = 2;
+constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+// Fed first into the fingerprint hash, to make it independent of the key.
+constexpr std::uint64_t FINGERPRINT_SEED = 0x9e3779b97f4a7c15;
+
+struct PDBFileHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t byte_order_mark;
+    std::uint32_t value_size;
+    std::uint32_t num_vars;
+    std::uint32_t reserved;
+    std::uint64_t num_states;
+    PDBFileKey key;
+};
+
+static_assert(sizeof(PDBFileHeader) == 48);
+
+// The pattern and the domain sizes are stored as 32-bit integers after the
+// header, the value table starts at the next multiple of
+// alignof(stored_value_t).
+std::size_t get_value_table_offset(std::size_t num_vars)
+{
+    constexpr std::size_t alignment = alignof(stored_value_t);
+    const std::size_t end =
+        sizeof(PDBFileHeader) + 2 * num_vars * sizeof(std::int32_t);
+    return (end + alignment - 1) / alignment * alignment;
+}
+
+void feed_value(utils::HashState& hash_state, value_t value)
+{
+    utils::feed(hash_state, std::bit_cast<std::uint64_t>(value));
+}
+
+void feed_task(utils::HashState& hash_state, ProbabilisticTaskProxy task_proxy)
+{
+    for (const VariableProxy var : task_proxy.get_variables()) {
+        utils::feed(hash_state, var.get_domain_size());
+    }
+
+    for (const ProbabilisticOperatorProxy op : task_proxy.get_operators()) {
+        utils::feed(hash_state, -1);
+
+        for (const FactProxy fact : op.get_preconditions()) {
+            utils::feed(hash_state, fact.get_pair().var);
+            utils::feed(hash_state, fact.get_pair().value);
+        }
+
+        for (const ProbabilisticOutcomeProxy outcome : op.get_outcomes()) {
+            utils::feed(hash_state, -2);
+            feed_value(hash_state, outcome.get_probability());
+
+            for (const ProbabilisticEffectProxy effect :
+                 outcome.get_effects()) {
+                utils::feed(hash_state, -3);
+
+                for (const FactProxy fact : effect.get_conditions()) {
+                    utils::feed(hash_state, fact.get_pair().var);
+                    utils::feed(hash_state, fact.get_pair().value);
+                }
+
+                const FactPair fact = effect.get_fact().get_pair();
+                utils::feed(hash_state, fact.var);
+                utils::feed(hash_state, fact.value);
+            }
+        }
+    }
+
+    utils::feed(hash_state, -4);
+    for (const FactProxy fact : task_proxy.get_goals()) {
+        utils::feed(hash_state, fact.get_pair().var);
+        utils::feed(hash_state, fact.get_pair().value);
+    }
+
+    utils::feed(hash_state, -5);
+    const State initial_state = task_proxy.get_initial_state();
+    initial_state.unpack();
+    utils::feed(hash_state, initial_state.get_unpacked_values());
+
+    // The value tables are only epsilon-accurate.
+    utils::feed(hash_state, -6);
+    feed_value(hash_state, g_epsilon);
+}
+} // namespace
+
+void write_pdb_file(
+    const std::filesystem::path& path,
+    const ProbabilityAwarePatternDatabase& pdb,
+    const PDBFileKey& key)
+{
+    const StateRankingFunction& ranking_function =
+        pdb.get_state_ranking_function();
+    const Pattern& pattern = ranking_function.get_pattern();
+    const std::span<const stored_value_t> value_table = pdb.get_value_table();
+
+    PDBFileHeader header{};
+    std::memcpy(header.magic, PDB_FILE_MAGIC, sizeof(header.magic));
+    header.version = PDB_FILE_VERSION;
+    header.byte_order_mark = BYTE_ORDER_MARK;
+    header.value_size = sizeof(stored_value_t);
+    header.num_vars = static_cast<std::uint32_t>(pattern.size());
+    header.num_states = value_table.size();
+    header.key = key;
+
+    std::vector<std::int32_t> variable_info;
+    variable_info.reserve(2 * pattern.size());
+    variable_info.insert(variable_info.end(), pattern.begin(), pattern.end());
+    for (std::size_t i = 0; i != pattern.size(); ++i) {
+        variable_info.push_back(
+            ranking_function.get_domain_size(static_cast<int>(i)));
+    }
+
+    const std::size_t padding =
+        get_value_table_offset(pattern.size()) - sizeof(PDBFileHeader) -
+        variable_info.size() * sizeof(std::int32_t);
+    const char zeros[alignof(stored_value_t)] = {};
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(
+        reinterpret_cast<const char*>(variable_info.data()),
+        static_cast<std::streamsize>(
+            variable_info.size() * sizeof(std::int32_t)));
+    out.write(zeros, static_cast<std::streamsize>(padding));
+    out.write(
+        reinterpret_cast<const char*>(value_table.data()),
+        static_cast<std::streamsize>(value_table.size_bytes()));
+    out.close();
+
+    if (!out) {
+        throw std::system_error(
+            std::make_error_code(std::errc::io_error),
+            path.string());
+    }
+}
+
+std::unique_ptr<ProbabilityAwarePatternDatabase> read_pdb_file(
+    const std::filesystem::path& path,
+    VariablesProxy variables,
+    const PDBFileKey& key)
+{
+    auto file = std::make_shared<const MappedFile>(path);
+    const std::span<const std::byte> data = file->get_data();
+
+    auto fail = [&](const char* reason) {
+        return std::runtime_error(
+            std::format("Invalid PDB file {}: {}", path.string(), reason));
+    };
+
+    PDBFileHeader header;
+    if (data.size() < sizeof(header)) throw fail("truncated header");
+    std::memcpy(&header, data.data(), sizeof(header));
+
+    if (std::memcmp(header.magic, PDB_FILE_MAGIC, sizeof(header.magic)) != 0) {
+        throw fail("bad magic number");
+    }
+
+    if (header.version != PDB_FILE_VERSION) throw fail("unsupported version");
+
+    if (header.byte_order_mark != BYTE_ORDER_MARK) {
+        throw fail("byte order mismatch");
+    }
+
+    // Files written with a different value precision are rejected.
+    if (header.value_size != sizeof(stored_value_t)) {
+        throw fail("value type mismatch");
+    }
+
+    if (header.key != key) throw fail("task or cost function mismatch");
+
+    const std::size_t num_vars = header.num_vars;
+    const std::size_t offset = get_value_table_offset(num_vars);
+
+    if (data.size() != offset + header.num_states * sizeof(stored_value_t)) {
+        throw fail("size mismatch");
+    }
+
+    std::vector<std::int32_t> variable_info(2 * num_vars);
+    std::memcpy(
+        variable_info.data(),
+        data.data() + sizeof(header),
+        variable_info.size() * sizeof(std::int32_t));
+
+    Pattern pattern(variable_info.begin(), variable_info.begin() + num_vars);
+
+    for (std::size_t i = 0; i != num_vars; ++i) {
+        const int var = pattern[i];
+        if (var < 0 || static_cast<std::size_t>(var) >= variables.size() ||
+            (i != 0 && var <= pattern[i - 1])) {
+            throw fail("invalid pattern");
+        }
+
+        if (variables[var].get_domain_size() != variable_info[num_vars + i]) {
+            throw fail("domain size mismatch");
+        }
+    }
+
+    StateRankingFunction ranking_function(variables, std::move(pattern));
+
+    if (ranking_function.num_states() != header.num_states) {
+        throw fail("number of abstract states mismatch");
+    }
+
+    // The mapping is page-aligned, so the value table is properly aligned.
+    const std::span<const stored_value_t> value_table(
+        reinterpret_cast<const stored_value_t*>(data.data() + offset),
+        header.num_states);
+
+    return std::make_unique<ProbabilityAwarePatternDatabase>(
+        std::move(ranking_function),
+        std::move(file),
+        value_table);
+}
+
+PDBCache::PDBCache(
+    std::filesystem::path directory,
+    ProbabilisticTaskProxy task_proxy,
+    utils::LogProxy log)
+    : directory_(std::move(directory))
+    , task_proxy_(task_proxy)
+    , log_(std::move(log))
+{
+    std::filesystem::create_directories(directory_);
+
+    utils::HashState key_state;
+    feed_task(key_state, task_proxy_);
+    task_key_ = key_state.get_hash64();
+
+    utils::HashState fingerprint_state;
+    utils::feed(fingerprint_state, FINGERPRINT_SEED);
+    feed_task(fingerprint_state, task_proxy_);
+    task_fingerprint_ = fingerprint_state.get_hash64();
+}
+
+std::uint64_t
+PDBCache::get_cost_key(FDRSimpleCostFunction& cost_function) const
+{
+    utils::HashState hash_state;
+
+    const std::size_t num_operators = task_proxy_.get_operators().size();
+    for (std::size_t i = 0; i != num_operators; ++i) {
+        feed_value(
+            hash_state,
+            cost_function.get_action_cost(OperatorID(static_cast<int>(i))));
+    }
+
+    feed_value(hash_state, cost_function.get_non_goal_termination_cost());
+
+    return hash_state.get_hash64();
+}
+
+std::unique_ptr<ProbabilityAwarePatternDatabase>
+PDBCache::load(const Pattern& pattern, std::uint64_t cost_key) const
+{
+    const std::filesystem::path path = get_path(pattern, cost_key);
+
+    std::error_code ec;
+    if (!std::filesystem::exists(path, ec)) {
+        ++misses_;
+        return nullptr;
+    }
+
+    try {
+        auto pdb = read_pdb_file(
+            path,
+            task_proxy_.get_variables(),
+            {task_fingerprint_, cost_key});
+
+        // Guards against hash collisions.
+        if (pdb->get_pattern() == pattern) {
+            ++hits_;
+            return pdb;
+        }
+    } catch (const std::exception&) {
+        ++errors_;
+    }
+
+    ++misses_;
+    return nullptr;
+}
+
+void PDBCache::store(
+    const ProbabilityAwarePatternDatabase& pdb,
+    std::uint64_t cost_key) const
+{
+    const std::filesystem::path path = get_path(pdb.get_pattern(), cost_key);
+
+    // Readers only ever see complete files.
+    std::filesystem::path temporary = path;
+    temporary += std::format(
+        ".{}.{}.tmp",
+        utils::get_process_id(),
+        next_temporary_++);
+
+    try {
+        write_pdb_file(temporary, pdb, {task_fingerprint_, cost_key});
+        std::filesystem::rename(temporary, path);
+    } catch (const std::exception& e) {
+        ++errors_;
+        std::error_code ec;
+        std::filesystem::remove(temporary, ec);
+
+        if (log_.is_warning()) {
+            std::lock_guard lock(log_mutex_);
+            log_ << "Warning: could not store PDB in cache file "
+                 << path.string() << ": " << e.what() << std::endl;
+        }
+    }
+}
+
+void PDBCache::print_statistics(utils::LogProxy log) const
+{
+    log << "  PDB cache directory: " << directory_.string() << "\n"
+        << "  PDB cache hits: " << hits_ << "\n"
+        << "  PDB cache misses: " << misses_ << "\n"
+        << "  PDB cache I/O errors: " << errors_ << "\n";
+}
+
+std::filesystem::path
+PDBCache::get_path(const Pattern& pattern, std::uint64_t cost_key) const
+{
+    return directory_ / std::format(
+                            "{:016x}-{:016x}-{:016x}.ppdb",
+                            task_key_,
+                            cost_key,
+                            utils::get_hash64(pattern));
+}
+
+} // namespace probfd::pdbs
@@ -13,27 +13,39 @@
 #include "downward/utils/collections.h"
 #include "downward/utils/countdown_timer.h"
 
+#include <cassert>
 #include <limits>
 #include <utility>
 
 namespace probfd::pdbs {
 
+namespace {
+// The values are computed in double precision and rounded down afterwards.
+std::vector<stored_value_t> compute_stored_value_table(
+    ProjectionStateSpace& mdp,
+    const StateRankingFunction& ranking_function,
+    StateRank initial_state,
+    const StateRankEvaluator& heuristic,
+    double max_time)
+{
+    std::vector<value_t> value_table(
+        ranking_function.num_states(),
+        std::numeric_limits<value_t>::quiet_NaN());
+    compute_value_table(mdp, initial_state, heuristic, value_table, max_time);
+    return to_stored_lower_bounds(std::move(value_table));
+}
+} // namespace
+
 ProbabilityAwarePatternDatabase::ProbabilityAwarePatternDatabase(
     ProbabilisticTaskProxy task_proxy,
     Pattern pattern)
     : ranking_function_(task_proxy.get_variables(), std::move(pattern))
-    , value_table_(
-          ranking_function_.num_states(),
-          std::numeric_limits<value_t>::quiet_NaN())
 {
 }
 
 ProbabilityAwarePatternDatabase::ProbabilityAwarePatternDatabase(
     StateRankingFunction ranking_function)
     : ranking_function_(std::move(ranking_function))
-    , value_table_(
-          ranking_function_.num_states(),
-          std::numeric_limits<value_t>::quiet_NaN())
 {
 }
 
@@ -41,10 +53,21 @@ ProbabilityAwarePatternDatabase::ProbabilityAwarePatternDatabase(
     StateRankingFunction ranking_function,
     std::vector<value_t> value_table)
     : ranking_function_(std::move(ranking_function))
-    , value_table_(std::move(value_table))
+    , value_table_(to_stored_lower_bounds(std::move(value_table)))
 {
 }
 
+ProbabilityAwarePatternDatabase::ProbabilityAwarePatternDatabase(
+    StateRankingFunction ranking_function,
+    std::shared_ptr<const MappedFile> mapped_file,
+    std::span<const stored_value_t> value_table)
+    : ranking_function_(std::move(ranking_function))
+    , mapped_file_(std::move(mapped_file))
+    , mapped_value_table_(value_table)
+{
+    assert(mapped_value_table_.size() == ranking_function_.num_states());
+}
+
 ProbabilityAwarePatternDatabase::ProbabilityAwarePatternDatabase(
     ProbabilisticTaskProxy task_proxy,
     std::shared_ptr<FDRSimpleCostFunction> task_cost_function,
@@ -62,11 +85,11 @@ ProbabilityAwarePatternDatabase::ProbabilityAwarePatternDatabase(
         ranking_function_,
         operator_pruning,
         timer.get_remaining_time());
-    compute_value_table(
+    value_table_ = compute_stored_value_table(
         mdp,
+        ranking_function_,
         ranking_function_.get_abstract_rank(initial_state),
         heuristic,
-        value_table_,
         timer.get_remaining_time());
 }
 
@@ -78,7 +101,12 @@ ProbabilityAwarePatternDatabase::ProbabilityAwarePatternDatabase(
     double max_time)
     : ProbabilityAwarePatternDatabase(std::move(ranking_function))
 {
-    compute_value_table(mdp, initial_state, heuristic, value_table_, max_time);
+    value_table_ = compute_stored_value_table(
+        mdp,
+        ranking_function_,
+        initial_state,
+        heuristic,
+        max_time);
 }
 
 ProbabilityAwarePatternDatabase::ProbabilityAwarePatternDatabase(
@@ -140,14 +168,14 @@ ProbabilityAwarePatternDatabase::ProbabilityAwarePatternDatabase(
         ranking_function_,
         operator_pruning,
         timer.get_remaining_time());
-    compute_value_table(
+    value_table_ = compute_stored_value_table(
         mdp,
+        ranking_function_,
         ranking_function_.get_abstract_rank(initial_state),
         IncrementalPPDBEvaluator(
             pdb.get_value_table(),
             ranking_function_,
             add_var),
-        value_table_,
         timer.get_remaining_time());
 }
 
@@ -160,14 +188,14 @@ ProbabilityAwarePatternDatabase::ProbabilityAwarePatternDatabase(
     double max_time)
     : ProbabilityAwarePatternDatabase(std::move(ranking_function))
 {
-    compute_value_table(
+    value_table_ = compute_stored_value_table(
         mdp,
+        ranking_function_,
         initial_state,
         IncrementalPPDBEvaluator(
             pdb.get_value_table(),
             ranking_function_,
             add_var),
-        value_table_,
         max_time);
 }
 
@@ -193,11 +221,11 @@ ProbabilityAwarePatternDatabase::ProbabilityAwarePatternDatabase(
         ranking_function_,
         operator_pruning,
         timer.get_remaining_time());
-    compute_value_table(
+    value_table_ = compute_stored_value_table(
         mdp,
+        ranking_function_,
         ranking_function_.get_abstract_rank(initial_state),
         MergeEvaluator(ranking_function_, left, right, term_cost),
-        value_table_,
         timer.get_remaining_time());
 }
 
@@ -210,15 +238,15 @@ ProbabilityAwarePatternDatabase::ProbabilityAwarePatternDatabase(
     double max_time)
     : ProbabilityAwarePatternDatabase(std::move(ranking_function))
 {
-    compute_value_table(
+    value_table_ = compute_stored_value_table(
         mdp,
+        ranking_function_,
         initial_state,
         MergeEvaluator(
             ranking_function_,
             left,
             right,
             mdp.get_non_goal_termination_cost()),
-        value_table_,
         max_time);
 }
 
@@ -233,9 +261,10 @@ ProbabilityAwarePatternDatabase::get_state_ranking_function() const
     return ranking_function_;
 }
 
-const std::vector<value_t>&
+std::span<const stored_value_t>
 ProbabilityAwarePatternDatabase::get_value_table() const
 {
+    if (mapped_file_) return mapped_value_table_;
     return value_table_;
 }
 
@@ -251,7 +280,7 @@ value_t ProbabilityAwarePatternDatabase::lookup_estimate(const State& s) const
 
 value_t ProbabilityAwarePatternDatabase::lookup_estimate(StateRank s) const
 {
-    return value_table_[s];
+    return get_value_table()[s];
 }
 
 StateRank
@@ -7,9 +7,11 @@
 
 namespace probfd::pdbs {
 
-void compute_saturated_costs(
+namespace {
+template <typename T>
+void compute_saturated_costs_impl(
     ProjectionStateSpace& state_space,
-    std::span<const value_t> value_table,
+    std::span<const T> value_table,
     std::span<value_t> saturated_costs)
 {
     std::fill(saturated_costs.begin(), saturated_costs.end(), -INFINITE_VALUE);
@@ -54,4 +56,24 @@ void compute_saturated_costs(
     }
 }
 
-} // namespace probfd::pdbs
\ No newline at end of file
+} // namespace
+
+void compute_saturated_costs(
+    ProjectionStateSpace& state_space,
+    std::span<const value_t> value_table,
+    std::span<value_t> saturated_costs)
+{
+    compute_saturated_costs_impl(state_space, value_table, saturated_costs);
+}
+
+#if defined(PROBFD_MIXED_PRECISION)
+void compute_saturated_costs(
+    ProjectionStateSpace& state_space,
+    std::span<const stored_value_t> value_table,
+    std::span<value_t> saturated_costs)
+{
+    compute_saturated_costs_impl(state_space, value_table, saturated_costs);
+}
+#endif
+
+} // namespace probfd::pdbs
@@ -2,6 +2,8 @@
 
 #include "probfd/pdbs/probability_aware_pattern_database.h"
 
+#include <algorithm>
+#include <cassert>
 #include <numeric>
 
 namespace probfd::pdbs {
@@ -26,6 +28,52 @@ value_t SubCollectionFinder::evaluate(
         estimates[i] = estimate;
     }
 
+    return evaluate_subcollections(subcollections, estimates);
+}
+
+void SubCollectionFinder::evaluate_batch(
+    const PPDBCollection& database,
+    const std::vector<PatternSubCollection>& subcollections,
+    std::span<const StateRank> ranks,
+    std::span<value_t> values,
+    value_t termination_cost)
+{
+    const size_t num_states = values.size();
+    const size_t num_pdbs = database.size();
+
+    assert(ranks.size() == num_pdbs * num_states);
+
+    if (database.empty()) {
+        std::ranges::fill(values, 0_vt);
+        return;
+    }
+
+    // Reused across calls, so that single evaluations do not allocate.
+    thread_local std::vector<value_t> estimates;
+    estimates.resize(num_pdbs);
+
+    for (size_t j = 0; j != num_states; ++j) {
+        values[j] = [&] {
+            for (size_t i = 0; i != num_pdbs; ++i) {
+                const value_t estimate =
+                    database[i]->lookup_estimate(ranks[i * num_states + j]);
+
+                if (estimate == termination_cost) {
+                    return estimate;
+                }
+
+                estimates[i] = estimate;
+            }
+
+            return evaluate_subcollections(subcollections, estimates);
+        }();
+    }
+}
+
+value_t SubCollectionFinder::evaluate_subcollections(
+    const std::vector<PatternSubCollection>& subcollections,
+    const std::vector<value_t>& estimates) const
+{
     // Get lowest additive subcollection value
     auto transformer = [&, this](const std::vector<int>& subcollection) {
         return this->evaluate_subcollection(estimates, subcollection);
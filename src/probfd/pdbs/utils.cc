@@ -1,5 +1,6 @@
 #include "probfd/pdbs/utils.h"
 
+#include "probfd/pdbs/pdb_cache.h"
 #include "probfd/pdbs/probability_aware_pattern_database.h"
 #include "probfd/pdbs/projection_operator.h"
 #include "probfd/pdbs/projection_state_space.h"
@@ -7,6 +8,7 @@
 #include "probfd/task_utils/task_properties.h"
 
 #include "probfd/utils/graph_visualization.h"
+#include "probfd/utils/thread_pool.h"
 
 #include "downward/utils/rng.h"
 
@@ -46,6 +48,42 @@ std::vector<int> get_goals_in_random_order(
     return goals;
 }
 
+PPDBCollection compute_pdbs(
+    const ProbabilisticTaskProxy& task_proxy,
+    const std::shared_ptr<FDRSimpleCostFunction>& task_cost_function,
+    const PatternCollection& patterns,
+    unsigned num_threads,
+    const PDBCache* cache,
+    bool operator_pruning)
+{
+    const State initial_state = task_proxy.get_initial_state();
+
+    const std::uint64_t cost_key =
+        cache ? cache->get_cost_key(*task_cost_function) : 0;
+
+    PPDBCollection pdbs(patterns.size());
+
+    parallel_for(num_threads, patterns.size(), [&](std::size_t i) {
+        if (cache) {
+            if (auto pdb = cache->load(patterns[i], cost_key)) {
+                pdbs[i] = std::move(pdb);
+                return;
+            }
+        }
+
+        pdbs[i] = std::make_shared<ProbabilityAwarePatternDatabase>(
+            task_proxy,
+            task_cost_function,
+            patterns[i],
+            initial_state,
+            operator_pruning);
+
+        if (cache) cache->store(*pdbs[i], cost_key);
+    });
+
+    return pdbs;
+}
+
 void dump_graphviz(
     ProbabilisticTaskProxy task_proxy,
     ProjectionStateSpace& mdp,
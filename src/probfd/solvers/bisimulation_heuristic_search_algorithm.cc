@@ -6,16 +6,11 @@
 
 #include "probfd/bisimulation/bisimilar_state_space.h"
 
-#include "probfd/tasks/determinization_task.h"
-
 #include "probfd/utils/not_implemented.h"
 
 #include "probfd/task_proxy.h"
 
-#include "downward/merge_and_shrink/factored_transition_system.h"
-#include "downward/merge_and_shrink/merge_and_shrink_representation.h"
-#include "downward/merge_and_shrink/transition_system.h"
-
+#include "downward/utils/logging.h"
 #include "downward/utils/timer.h"
 
 namespace probfd::solvers {
@@ -51,34 +46,21 @@ Interval BisimulationBasedHeuristicSearchAlgorithm::solve(
 
     std::cout << "Building bisimulation..." << std::endl;
 
-    ProbabilisticTaskProxy task_proxy(*task_);
-
-    std::shared_ptr determinization =
-        std::make_shared<tasks::DeterminizationTask>(task_);
-
-    TaskProxy det_task_proxy(*determinization);
-
-    auto [transition_system, state_mapping, distances] =
-        bisimulation::compute_bisimulation_on_determinization(det_task_proxy);
+    bisimulation::BisimilarStateSpace state_space(
+        task_,
+        task_cost_function_,
+        1,
+        utils::g_log);
 
     std::cout << "Done." << std::endl;
 
-    if (!transition_system->is_solvable(*distances)) {
+    const QState initial_state = state_space.get_initial_state();
+
+    if (state_space.is_dead_end(initial_state)) {
         std::cout << "Initial state recognized as unsolvable!" << std::endl;
         return Interval(1_vt, 1_vt);
     }
 
-    State initial = task_proxy.get_initial_state();
-    initial.unpack();
-    const auto initial_state =
-        bisimulation::QuotientState(state_mapping->get_value(initial));
-
-    bisimulation::BisimilarStateSpace state_space(
-        task_,
-        task_cost_function_,
-        det_task_proxy,
-        *transition_system);
-
     stats_.time = timer();
     stats_.states = state_space.num_bisimilar_states();
     stats_.transitions = state_space.num_transitions();
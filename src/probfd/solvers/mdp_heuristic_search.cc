@@ -20,6 +20,9 @@ MDPHeuristicSearchBase<Bisimulation, Fret>::MDPHeuristicSearchBase(
     utils::Verbosity verbosity,
     std::vector<std::shared_ptr<::Evaluator>> path_dependent_evaluators,
     bool cache,
+    int cache_memory_limit,
+    bool flat_successor_generator,
+    std::optional<std::string> state_storage_directory,
     const std::shared_ptr<TaskEvaluatorFactory>& eval,
     std::optional<value_t> report_epsilon,
     bool report_enabled,
@@ -30,6 +33,9 @@ MDPHeuristicSearchBase<Bisimulation, Fret>::MDPHeuristicSearchBase(
           verbosity,
           std::move(path_dependent_evaluators),
           cache,
+          cache_memory_limit,
+          flat_successor_generator,
+          std::move(state_storage_directory),
           eval,
           report_epsilon,
           report_enabled,
@@ -80,6 +86,9 @@ MDPHeuristicSearch<false, false>::MDPHeuristicSearch(
     utils::Verbosity verbosity,
     std::vector<std::shared_ptr<::Evaluator>> path_dependent_evaluators,
     bool cache,
+    int cache_memory_limit,
+    bool flat_successor_generator,
+    std::optional<std::string> state_storage_directory,
     const std::shared_ptr<TaskEvaluatorFactory>& eval,
     std::optional<value_t> report_epsilon,
     bool report_enabled,
@@ -92,6 +101,9 @@ MDPHeuristicSearch<false, false>::MDPHeuristicSearch(
           verbosity,
           std::move(path_dependent_evaluators),
           cache,
+          cache_memory_limit,
+          flat_successor_generator,
+          std::move(state_storage_directory),
           eval,
           report_epsilon,
           report_enabled,
@@ -108,6 +120,9 @@ MDPHeuristicSearch<false, true>::MDPHeuristicSearch(
     utils::Verbosity verbosity,
     std::vector<std::shared_ptr<::Evaluator>> path_dependent_evaluators,
     bool cache,
+    int cache_memory_limit,
+    bool flat_successor_generator,
+    std::optional<std::string> state_storage_directory,
     const std::shared_ptr<TaskEvaluatorFactory>& eval,
     std::optional<value_t> report_epsilon,
     bool report_enabled,
@@ -120,6 +135,9 @@ MDPHeuristicSearch<false, true>::MDPHeuristicSearch(
           verbosity,
           std::move(path_dependent_evaluators),
           cache,
+          cache_memory_limit,
+          flat_successor_generator,
+          std::move(state_storage_directory),
           eval,
           report_epsilon,
           report_enabled,
@@ -136,6 +154,9 @@ MDPHeuristicSearch<true, false>::MDPHeuristicSearch(
     utils::Verbosity verbosity,
     std::vector<std::shared_ptr<::Evaluator>> path_dependent_evaluators,
     bool cache,
+    int cache_memory_limit,
+    bool flat_successor_generator,
+    std::optional<std::string> state_storage_directory,
     const std::shared_ptr<TaskEvaluatorFactory>& eval,
     std::optional<value_t> report_epsilon,
     bool report_enabled,
@@ -148,6 +169,9 @@ MDPHeuristicSearch<true, false>::MDPHeuristicSearch(
           verbosity,
           std::move(path_dependent_evaluators),
           cache,
+          cache_memory_limit,
+          flat_successor_generator,
+          std::move(state_storage_directory),
           eval,
           report_epsilon,
           report_enabled,
@@ -164,6 +188,9 @@ MDPHeuristicSearch<true, true>::MDPHeuristicSearch(
     utils::Verbosity verbosity,
     std::vector<std::shared_ptr<::Evaluator>> path_dependent_evaluators,
     bool cache,
+    int cache_memory_limit,
+    bool flat_successor_generator,
+    std::optional<std::string> state_storage_directory,
     const std::shared_ptr<TaskEvaluatorFactory>& eval,
     std::optional<value_t> report_epsilon,
     bool report_enabled,
@@ -176,6 +203,9 @@ MDPHeuristicSearch<true, true>::MDPHeuristicSearch(
           verbosity,
           std::move(path_dependent_evaluators),
           cache,
+          cache_memory_limit,
+          flat_successor_generator,
+          std::move(state_storage_directory),
           eval,
           report_epsilon,
           report_enabled,
@@ -4,6 +4,8 @@
 
 #include "probfd/caching_task_state_space.h"
 
+#include "probfd/utils/mapped_memory_resource.h"
+
 #include "probfd/evaluator.h"
 #include "probfd/interval.h"
 #include "probfd/mdp_algorithm.h"
@@ -23,10 +25,24 @@
 
 namespace probfd::solvers {
 
+namespace {
+std::size_t get_cache_budget_in_bytes(int cache_memory_limit)
+{
+    if (cache_memory_limit == std::numeric_limits<int>::max()) {
+        return std::numeric_limits<std::size_t>::max();
+    }
+
+    return static_cast<std::size_t>(cache_memory_limit) << 20;
+}
+} // namespace
+
 MDPSolver::MDPSolver(
     utils::Verbosity verbosity,
     std::vector<std::shared_ptr<::Evaluator>> path_dependent_evaluators,
     bool cache,
+    int cache_memory_limit,
+    bool flat_successor_generator,
+    std::optional<std::string> state_storage_directory,
     std::shared_ptr<TaskEvaluatorFactory> heuristic_factory,
     std::optional<value_t> report_epsilon,
     bool report_enabled,
@@ -35,15 +51,24 @@ MDPSolver::MDPSolver(
     bool print_fact_names)
     : log_(utils::get_log_for_verbosity(verbosity))
     , task_(tasks::g_root_task)
+    , state_memory_(
+          state_storage_directory
+              ? std::make_unique<MappedMemoryResource>(*state_storage_directory)
+              : nullptr)
     , task_mdp_(
           cache ? new CachingTaskStateSpace(
                       task_,
                       log_,
-                      std::move(path_dependent_evaluators))
+                      std::move(path_dependent_evaluators),
+                      get_cache_budget_in_bytes(cache_memory_limit),
+                      flat_successor_generator,
+                      get_per_state_memory())
                 : new TaskStateSpace(
                       task_,
                       log_,
-                      std::move(path_dependent_evaluators)))
+                      std::move(path_dependent_evaluators),
+                      flat_successor_generator,
+                      get_per_state_memory()))
     , task_cost_function_(std::make_shared<TaskCostFunction>(task_))
     , heuristic_factory_(std::move(heuristic_factory))
     , progress_(report_epsilon, std::cout, report_enabled)
@@ -55,6 +80,12 @@ MDPSolver::MDPSolver(
 
 MDPSolver::~MDPSolver() = default;
 
+std::pmr::memory_resource* MDPSolver::get_per_state_memory() const
+{
+    return state_memory_ ? state_memory_.get()
+                         : std::pmr::get_default_resource();
+}
+
 bool MDPSolver::solve()
 {
     std::cout << "Running MDP algorithm " << get_algorithm_name();
@@ -139,6 +170,12 @@ bool MDPSolver::solve()
                   << task_mdp_->get_num_registered_states() << std::endl;
         task_mdp_->print_statistics();
 
+        if (state_memory_) {
+            std::cout << "  State storage file: "
+                      << state_memory_->get_file_size() << " bytes in "
+                      << state_memory_->get_directory() << std::endl;
+        }
+
         std::cout << std::endl;
         std::cout << "Algorithm " << get_algorithm_name()
                   << " statistics:" << std::endl;
@@ -10,6 +10,7 @@
 #include "downward/state_id.h"
 
 #include <iostream>
+#include <ranges>
 
 namespace probfd {
 
@@ -28,11 +29,14 @@ void TaskStateSpace::Statistics::print(utils::LogProxy log) const
 TaskStateSpace::TaskStateSpace(
     std::shared_ptr<ProbabilisticTask> task,
     utils::LogProxy log,
-    std::vector<std::shared_ptr<::Evaluator>> path_dependent_evaluators)
+    std::vector<std::shared_ptr<::Evaluator>> path_dependent_evaluators,
+    bool flat_successor_generator,
+    std::pmr::memory_resource* state_memory)
     : task_proxy_(*task)
     , log_(std::move(log))
-    , state_registry_(task_proxy_)
-    , gen_(task_proxy_)
+    , state_registry_(task_proxy_, state_memory)
+    , gen_(task_proxy_, flat_successor_generator)
+    , outcome_deltas_(task_proxy_, state_registry_.get_state_packer())
     , notify_(std::move(path_dependent_evaluators))
 {
 }
@@ -119,17 +123,34 @@ void TaskStateSpace::compute_successor_dist(
     const size_t num_outcomes = outcomes.size();
     successor_dist.reserve(num_outcomes);
 
-    for (const ProbabilisticOutcomeProxy outcome : outcomes) {
-        value_t probability = outcome.get_probability();
-        State succ =
-            state_registry_.get_successor_state(state, outcome.get_effects());
+    outcome_successors_.clear();
+    if (outcome_deltas_.has_deltas(op_id)) {
+        state_registry_.get_successor_states(
+            state,
+            outcome_deltas_.get_deltas(),
+            outcome_deltas_.get_outcome_offsets(op_id),
+            outcome_successors_);
+    } else {
+        state_registry_.get_successor_states(
+            state,
+            outcomes | std::views::transform(
+                           &ProbabilisticOutcomeProxy::get_effects),
+            outcome_successors_);
+    }
+
+    for (size_t i = 0; i != num_outcomes; ++i) {
+        const ProbabilisticOutcomeProxy outcome = outcomes[i];
+        const ::StateID succ_id = outcome_successors_[i];
 
-        for (const auto& h : notify_) {
-            OperatorID det_op_id(outcome.get_determinization_id());
-            h->notify_state_transition(state, det_op_id, succ);
+        if (!notify_.empty()) {
+            const State succ = state_registry_.lookup_state(succ_id);
+            for (const auto& h : notify_) {
+                OperatorID det_op_id(outcome.get_determinization_id());
+                h->notify_state_transition(state, det_op_id, succ);
+            }
         }
 
-        successor_dist.add_probability(succ.get_id(), probability);
+        successor_dist.add_probability(succ_id, outcome.get_probability());
     }
 
     ++statistics_.transition_computations;
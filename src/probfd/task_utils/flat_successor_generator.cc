@@ -0,0 +1,197 @@
+#include "probfd/task_utils/flat_successor_generator.h"
+
+#include "probfd/task_utils/probabilistic_successor_generator_internals.h"
+
+#include "downward/task_utils/task_properties.h"
+
+#include "downward/operator_id.h"
+#include "downward/state_id.h"
+#include "downward/task_proxy.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+
+namespace probfd::successor_generator {
+
+namespace {
+// Scratch space up to these sizes lives on the stack.
+constexpr size_t MAX_LOCAL_VARIABLES = 64;
+constexpr size_t MAX_LOCAL_PENDING = 256;
+} // namespace
+
+FlatSuccessorGenerator::FlatSuccessorGenerator(
+    const PlanningTaskProxy& task_proxy,
+    const ProbabilisticGeneratorBase& root)
+{
+    [[maybe_unused]] const int root_offset = root.compile(code_);
+    assert(root_offset == 0);
+    code_.shrink_to_fit();
+
+    VariablesProxy variables = task_proxy.get_variables();
+    max_pending_ = compute_max_pending(variables, 0);
+
+    const int_packer::IntPacker& state_packer =
+        task_properties::g_state_packers[task_proxy];
+    const int num_variables = variables.size();
+    bit_positions_.reserve(num_variables);
+    for (int var = 0; var != num_variables; ++var) {
+        bit_positions_.push_back(state_packer.get_bit_position(var));
+    }
+}
+
+size_t FlatSuccessorGenerator::compute_max_pending(
+    const VariablesProxy& variables,
+    int offset) const
+{
+    const int* node = code_.data() + offset;
+    size_t max_child = 0;
+
+    switch (node[0]) {
+    case FORK:
+        for (int i = 0; i != node[1]; ++i) {
+            max_child =
+                max(max_child, compute_max_pending(variables, node[2 + i]));
+        }
+        // A fork pushes at most all of its children at once.
+        return node[1] + max_child;
+    case SWITCH_VECTOR:
+        for (int i = 0; i != variables[node[1]].get_domain_size(); ++i) {
+            if (node[2 + i] != -1) {
+                max_child =
+                    max(max_child, compute_max_pending(variables, node[2 + i]));
+            }
+        }
+        return max_child;
+    case SWITCH_SORTED:
+        for (int i = 0; i != node[2]; ++i) {
+            max_child = max(
+                max_child,
+                compute_max_pending(variables, node[3 + node[2] + i]));
+        }
+        return max_child;
+    case SWITCH_SINGLE: return compute_max_pending(variables, node[3]);
+    default: return 0;
+    }
+}
+
+void FlatSuccessorGenerator::generate_applicable_ops(
+    const State& state,
+    vector<OperatorID>& applicable_ops) const
+{
+    if (state.get_id() == ::StateID::no_state) {
+        // Unregistered states have no packed buffer.
+        state.unpack();
+        const vector<int>& values = state.get_unpacked_values();
+        generate_applicable_ops(
+            [&values](int var) { return values[var]; },
+            applicable_ops);
+        return;
+    }
+
+    /*
+      Decode all values once. Most variables are tested by some node, and
+      reading a value from the packed buffer for every test is more
+      expensive than reading it from a decoded array.
+    */
+    const PackedStateBin* buffer = state.get_buffer();
+    const size_t num_variables = bit_positions_.size();
+    int local_values[MAX_LOCAL_VARIABLES];
+    thread_local vector<int> values;
+    int* data = local_values;
+    if (num_variables > MAX_LOCAL_VARIABLES) {
+        values.resize(num_variables);
+        data = values.data();
+    }
+    for (size_t var = 0; var != num_variables; ++var) {
+        const auto& [bin_index, shift, read_mask] = bit_positions_[var];
+        data[var] = (buffer[bin_index] & read_mask) >> shift;
+    }
+
+    generate_applicable_ops(
+        [data](int var) { return data[var]; },
+        applicable_ops);
+}
+
+size_t FlatSuccessorGenerator::get_code_size_in_bytes() const
+{
+    return code_.size() * sizeof(int) +
+           bit_positions_.size() * sizeof(int_packer::IntPacker::BitPosition);
+}
+
+template <typename ValueReader>
+void FlatSuccessorGenerator::generate_applicable_ops(
+    const ValueReader& get_value,
+    vector<OperatorID>& applicable_ops) const
+{
+    // Offsets of the fork children which are still to be visited.
+    int local_pending[MAX_LOCAL_PENDING];
+    thread_local vector<int> pending;
+    int* bottom = local_pending;
+    if (max_pending_ > MAX_LOCAL_PENDING) {
+        if (pending.size() < max_pending_) pending.resize(max_pending_);
+        bottom = pending.data();
+    }
+    int* top = bottom;
+
+    const int* const code = code_.data();
+    const int* node = code;
+
+    for (;;) {
+        int next = -1;
+
+        switch (node[0]) {
+        case FORK: {
+            /*
+              Visit the children in order, so push them in reverse. Most
+              children of forks are single switches whose test fails, so
+              they are tested here rather than pushed and popped again.
+            */
+            for (int i = node[1] - 1; i >= 0; --i) {
+                const int* child = code + node[2 + i];
+                if (child[0] != SWITCH_SINGLE) {
+                    *top++ = node[2 + i];
+                } else if (get_value(child[1]) == child[2]) {
+                    *top++ = child[3];
+                }
+            }
+            break;
+        }
+        case SWITCH_VECTOR: next = node[2 + get_value(node[1])]; break;
+        case SWITCH_SORTED: {
+            const int value = get_value(node[1]);
+            const int num_values = node[2];
+            const int* values = node + 3;
+            const int* it = lower_bound(values, values + num_values, value);
+            if (it != values + num_values && *it == value) {
+                next = values[num_values + (it - values)];
+            }
+            break;
+        }
+        case SWITCH_SINGLE:
+            if (get_value(node[1]) == node[2]) next = node[3];
+            break;
+        case LEAF: {
+            const int num_ops = node[1];
+            for (int i = 0; i != num_ops; ++i) {
+                applicable_ops.emplace_back(node[2 + i]);
+            }
+            break;
+        }
+        default: assert(false);
+        }
+
+        assert(top - bottom <= static_cast<ptrdiff_t>(max_pending_));
+
+        if (next != -1) {
+            node = code + next;
+        } else if (top != bottom) {
+            node = code + *--top;
+        } else {
+            return;
+        }
+    }
+}
+
+} // namespace probfd::successor_generator
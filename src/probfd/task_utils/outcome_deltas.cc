@@ -0,0 +1,90 @@
+#include "probfd/task_utils/outcome_deltas.h"
+
+#include "probfd/task_proxy.h"
+
+#include "downward/task_utils/task_properties.h"
+
+#include "downward/operator_id.h"
+
+#include <cassert>
+
+using namespace std;
+
+namespace probfd {
+
+OutcomeDeltas::OutcomeDeltas(
+    const ProbabilisticTaskProxy& task_proxy,
+    const int_packer::IntPacker& state_packer)
+{
+    const ProbabilisticOperatorsProxy operators = task_proxy.get_operators();
+    const bool has_axioms = ::task_properties::has_axioms(task_proxy);
+
+    first_outcome_.reserve(operators.size() + 1);
+    has_deltas_.reserve(operators.size());
+    outcome_offsets_.push_back(0);
+
+    vector<BinDelta> outcome_deltas;
+
+    for (const ProbabilisticOperatorProxy op : operators) {
+        first_outcome_.push_back(outcome_offsets_.size() - 1);
+
+        bool unconditional = !has_axioms;
+        for (const ProbabilisticOutcomeProxy outcome : op.get_outcomes()) {
+            for (const ProbabilisticEffectProxy effect :
+                 outcome.get_effects()) {
+                if (!effect.get_conditions().empty()) {
+                    unconditional = false;
+                    break;
+                }
+            }
+            if (!unconditional) break;
+        }
+
+        has_deltas_.push_back(unconditional);
+        if (!unconditional) continue;
+
+        ++num_operators_with_deltas_;
+
+        for (const ProbabilisticOutcomeProxy outcome : op.get_outcomes()) {
+            outcome_deltas.clear();
+            for (const ProbabilisticEffectProxy effect :
+                 outcome.get_effects()) {
+                const FactPair fact = effect.get_fact().get_pair();
+                state_packer.add_to_deltas(outcome_deltas, fact.var, fact.value);
+            }
+            deltas_.insert(
+                deltas_.end(),
+                outcome_deltas.begin(),
+                outcome_deltas.end());
+            outcome_offsets_.push_back(deltas_.size());
+        }
+    }
+
+    first_outcome_.push_back(outcome_offsets_.size() - 1);
+
+    first_outcome_.shrink_to_fit();
+    outcome_offsets_.shrink_to_fit();
+    deltas_.shrink_to_fit();
+}
+
+bool OutcomeDeltas::has_deltas(OperatorID op_id) const
+{
+    return has_deltas_[op_id.get_index()];
+}
+
+span<const int> OutcomeDeltas::get_outcome_offsets(OperatorID op_id) const
+{
+    assert(has_deltas(op_id));
+    const int first = first_outcome_[op_id.get_index()];
+    const int last = first_outcome_[op_id.get_index() + 1];
+    return span<const int>(outcome_offsets_).subspan(first, last - first + 1);
+}
+
+size_t OutcomeDeltas::get_size_in_bytes() const
+{
+    return first_outcome_.capacity() * sizeof(int) +
+           outcome_offsets_.capacity() * sizeof(int) +
+           deltas_.capacity() * sizeof(BinDelta) + has_deltas_.capacity() / 8;
+}
+
+} // namespace probfd
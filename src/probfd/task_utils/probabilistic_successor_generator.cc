@@ -1,8 +1,13 @@
 #include "probfd/task_utils/probabilistic_successor_generator.h"
 
+#include "probfd/task_utils/flat_successor_generator.h"
 #include "probfd/task_utils/probabilistic_successor_generator_factory.h"
 #include "probfd/task_utils/probabilistic_successor_generator_internals.h"
 
+#include "probfd/task_state_space.h"
+#include "probfd/transition.h"
+
+#include "downward/operator_id.h"
 #include "downward/task_proxy.h"
 
 using namespace std;
@@ -10,9 +15,13 @@ using namespace std;
 namespace probfd::successor_generator {
 
 ProbabilisticSuccessorGenerator::ProbabilisticSuccessorGenerator(
-    const PlanningTaskProxy& task_proxy)
+    const PlanningTaskProxy& task_proxy,
+    bool flat)
     : root_(ProbabilisticSuccessorGeneratorFactory(task_proxy).create())
 {
+    if (flat) {
+        flat_ = std::make_unique<FlatSuccessorGenerator>(task_proxy, *root_);
+    }
 }
 
 ProbabilisticSuccessorGenerator::~ProbabilisticSuccessorGenerator() = default;
@@ -21,6 +30,11 @@ void ProbabilisticSuccessorGenerator::generate_applicable_ops(
     const State& state,
     vector<OperatorID>& applicable_ops) const
 {
+    if (flat_) {
+        flat_->generate_applicable_ops(state, applicable_ops);
+        return;
+    }
+
     state.unpack();
     root_->generate_applicable_ops(state.get_unpacked_values(), applicable_ops);
 }
@@ -30,6 +44,21 @@ void ProbabilisticSuccessorGenerator::generate_transitions(
     std::vector<Transition<OperatorID>>& transitions,
     TaskStateSpace& task_state_space) const
 {
+    if (flat_) {
+        thread_local vector<OperatorID> applicable_ops;
+        applicable_ops.clear();
+        flat_->generate_applicable_ops(state, applicable_ops);
+        transitions.reserve(transitions.size() + applicable_ops.size());
+        for (OperatorID op_id : applicable_ops) {
+            auto& t = transitions.emplace_back(op_id);
+            task_state_space.compute_successor_dist(
+                state,
+                op_id,
+                t.successor_dist);
+        }
+        return;
+    }
+
     state.unpack();
     root_->generate_transitions(state, transitions, task_state_space);
 }
@@ -1,10 +1,13 @@
 #include "probfd/task_utils/probabilistic_successor_generator_internals.h"
 
+#include "probfd/task_utils/flat_successor_generator.h"
+
 #include "downward/task_proxy.h"
 
 #include "probfd/task_state_space.h"
 #include "probfd/transition.h"
 
+#include <algorithm>
 #include <cassert>
 #include <utility>
 
@@ -25,7 +28,8 @@ using namespace std;
   - Going further down this route, on the more extreme end of the
     spectrum, we could use a "byte-code" style representation, where
     the successor generator is just a long vector of ints combining
-    information about node type with node payload.
+    information about node type with node payload. (FlatSuccessorGenerator
+    implements a variant of this, compiled from the node tree.)
 
     For example, we could represent different node types as follows,
     where BINARY_FORK etc. are symbolic constants for tagging node
@@ -103,6 +107,17 @@ void ProbabilisticGeneratorForkBinary::generate_transitions(
     generator_2_->generate_transitions(state, transitions, task_state_space);
 }
 
+int ProbabilisticGeneratorForkBinary::compile(vector<int>& code) const
+{
+    const int offset = code.size();
+    code.insert(code.end(), {FORK, 2, -1, -1});
+    const int child_1 = generator_1_->compile(code);
+    code[offset + 2] = child_1;
+    const int child_2 = generator_2_->compile(code);
+    code[offset + 3] = child_2;
+    return offset;
+}
+
 ProbabilisticGeneratorForkMulti::ProbabilisticGeneratorForkMulti(
     vector<unique_ptr<ProbabilisticGeneratorBase>> children)
     : children_(std::move(children))
@@ -131,6 +146,19 @@ void ProbabilisticGeneratorForkMulti::generate_transitions(
         generator->generate_transitions(state, transitions, task_state_space);
 }
 
+int ProbabilisticGeneratorForkMulti::compile(vector<int>& code) const
+{
+    const int offset = code.size();
+    code.push_back(FORK);
+    code.push_back(children_.size());
+    code.resize(code.size() + children_.size(), -1);
+    for (size_t i = 0; i != children_.size(); ++i) {
+        const int child = children_[i]->compile(code);
+        code[offset + 2 + i] = child;
+    }
+    return offset;
+}
+
 ProbabilisticGeneratorSwitchVector::ProbabilisticGeneratorSwitchVector(
     int switch_var_id,
     vector<unique_ptr<ProbabilisticGeneratorBase>>&& generator_for_value)
@@ -167,6 +195,21 @@ void ProbabilisticGeneratorSwitchVector::generate_transitions(
     }
 }
 
+int ProbabilisticGeneratorSwitchVector::compile(vector<int>& code) const
+{
+    const int offset = code.size();
+    code.push_back(SWITCH_VECTOR);
+    code.push_back(switch_var_id_);
+    code.resize(code.size() + generator_for_value_.size(), -1);
+    for (size_t value = 0; value != generator_for_value_.size(); ++value) {
+        if (const auto& generator = generator_for_value_[value]) {
+            const int child = generator->compile(code);
+            code[offset + 2 + value] = child;
+        }
+    }
+    return offset;
+}
+
 ProbabilisticGeneratorSwitchHash::ProbabilisticGeneratorSwitchHash(
     int switch_var_id,
     unordered_map<int, unique_ptr<ProbabilisticGeneratorBase>>&&
@@ -206,6 +249,29 @@ void ProbabilisticGeneratorSwitchHash::generate_transitions(
     }
 }
 
+int ProbabilisticGeneratorSwitchHash::compile(vector<int>& code) const
+{
+    vector<int> values;
+    values.reserve(generator_for_value_.size());
+    for (const auto& [value, _] : generator_for_value_) {
+        values.push_back(value);
+    }
+    sort(values.begin(), values.end());
+
+    const int num_values = values.size();
+    const int offset = code.size();
+    code.push_back(SWITCH_SORTED);
+    code.push_back(switch_var_id_);
+    code.push_back(num_values);
+    code.insert(code.end(), values.begin(), values.end());
+    code.resize(code.size() + num_values, -1);
+    for (int i = 0; i != num_values; ++i) {
+        const int child = generator_for_value_.at(values[i])->compile(code);
+        code[offset + 3 + num_values + i] = child;
+    }
+    return offset;
+}
+
 ProbabilisticGeneratorSwitchSingle::ProbabilisticGeneratorSwitchSingle(
     int switch_var_id,
     int value,
@@ -238,6 +304,15 @@ void ProbabilisticGeneratorSwitchSingle::generate_transitions(
     }
 }
 
+int ProbabilisticGeneratorSwitchSingle::compile(vector<int>& code) const
+{
+    const int offset = code.size();
+    code.insert(code.end(), {SWITCH_SINGLE, switch_var_id_, value_, -1});
+    const int child = generator_for_value_->compile(code);
+    code[offset + 3] = child;
+    return offset;
+}
+
 ProbabilisticGeneratorLeafVector::ProbabilisticGeneratorLeafVector(
     vector<OperatorID>&& applicable_operators)
     : applicable_operators_(std::move(applicable_operators))
@@ -271,6 +346,17 @@ void ProbabilisticGeneratorLeafVector::generate_transitions(
     }
 }
 
+int ProbabilisticGeneratorLeafVector::compile(vector<int>& code) const
+{
+    const int offset = code.size();
+    code.push_back(LEAF);
+    code.push_back(applicable_operators_.size());
+    for (OperatorID id : applicable_operators_) {
+        code.push_back(id.get_index());
+    }
+    return offset;
+}
+
 ProbabilisticGeneratorLeafSingle::ProbabilisticGeneratorLeafSingle(
     OperatorID applicable_operator)
     : applicable_operator_(applicable_operator)
@@ -296,4 +382,11 @@ void ProbabilisticGeneratorLeafSingle::generate_transitions(
         t.successor_dist);
 }
 
+int ProbabilisticGeneratorLeafSingle::compile(vector<int>& code) const
+{
+    const int offset = code.size();
+    code.insert(code.end(), {LEAF, 1, applicable_operator_.get_index()});
+    return offset;
+}
+
 } // namespace probfd::successor_generator
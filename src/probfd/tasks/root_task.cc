@@ -1,6 +1,8 @@
 #include "probfd/tasks/root_task.h"
 #include "probfd/tasks/determinization_task.h"
 
+#include "probfd/utils/mapped_file.h"
+
 #include "probfd/probabilistic_task.h"
 #include "probfd/value_type.h"
 
@@ -13,8 +15,14 @@
 #include <algorithm>
 #include <cassert>
 #include <compare>
+#include <cstdint>
+#include <cstring>
 #include <memory>
+#include <ostream>
 #include <set>
+#include <span>
+#include <system_error>
+#include <type_traits>
 #include <vector>
 
 using namespace std;
@@ -28,6 +36,139 @@ namespace {
 
 const auto PRE_FILE_PROB_VERSION = "1";
 
+constexpr char BINARY_SAS_MAGIC[4] = {'P', 'S', 'A', 'S'};
+constexpr std::uint32_t BINARY_SAS_VERSION = 1;
+constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+struct BinarySASHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t byte_order_mark;
+    std::uint32_t value_size;
+};
+
+[[noreturn]]
+void binary_input_error(const string& reason)
+{
+    cerr << "Invalid binary task file: " << reason << endl;
+    utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+}
+
+// Fact arrays are copied as a whole.
+static_assert(sizeof(FactPair) == 2 * sizeof(std::int32_t));
+
+/*
+  Reads the binary SAS format from a memory buffer. All values are stored
+  unaligned in native byte order, counts and strings are prefixed with their
+  32-bit length. Every read is bounds-checked, so that a truncated or
+  corrupted file results in an input error instead of undefined behaviour.
+*/
+class BinaryTaskReader {
+    std::span<const std::byte> data;
+    std::size_t position = 0;
+
+public:
+    explicit BinaryTaskReader(std::span<const std::byte> data)
+        : data(data)
+    {
+    }
+
+    template <typename T>
+    void read_array(T* out, std::size_t count)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (count > (data.size() - position) / sizeof(T)) {
+            binary_input_error("unexpected end of file");
+        }
+        std::memcpy(out, data.data() + position, count * sizeof(T));
+        position += count * sizeof(T);
+    }
+
+    template <typename T>
+    T read()
+    {
+        T value;
+        read_array(&value, 1);
+        return value;
+    }
+
+    // Each element occupies at least min_element_size bytes, which bounds
+    // the count by the remaining file size before anything is allocated.
+    int read_count(std::size_t min_element_size)
+    {
+        const auto count = read<std::uint32_t>();
+        if (count > (data.size() - position) / min_element_size) {
+            binary_input_error("count exceeds file size");
+        }
+        return static_cast<int>(count);
+    }
+
+    string read_string()
+    {
+        const int length = read_count(1);
+        string result(
+            reinterpret_cast<const char*>(data.data() + position),
+            length);
+        position += length;
+        return result;
+    }
+
+    vector<FactPair> read_facts()
+    {
+        const int count = read_count(sizeof(FactPair));
+        vector<FactPair> facts(count, FactPair::no_fact);
+        read_array(facts.data(), count);
+        return facts;
+    }
+
+    bool at_end() const { return position == data.size(); }
+};
+
+class BinaryTaskWriter {
+    std::ostream& out;
+
+public:
+    explicit BinaryTaskWriter(std::ostream& out)
+        : out(out)
+    {
+    }
+
+    template <typename T>
+    void write_array(const T* data, std::size_t count)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        out.write(
+            reinterpret_cast<const char*>(data),
+            static_cast<std::streamsize>(count * sizeof(T)));
+    }
+
+    template <typename T>
+    void write(const T& value)
+    {
+        write_array(&value, 1);
+    }
+
+    void write_count(std::size_t count)
+    {
+        write(static_cast<std::uint32_t>(count));
+    }
+
+    void write_string(const string& str)
+    {
+        write_count(str.size());
+        write_array(str.data(), str.size());
+    }
+
+    template <typename R>
+    void write_facts(const R& facts)
+    {
+        write_count(std::ranges::size(facts));
+        for (const FactPair& fact : facts) {
+            write(fact);
+        }
+    }
+};
+
 enum Optimization : unsigned char {
     MINIMIZE_LENGTH = 0,
     MINIMIZE = 1,
@@ -48,6 +189,9 @@ struct ExplicitVariable {
     int axiom_default_value;
 
     explicit ExplicitVariable(std::istream& in);
+    explicit ExplicitVariable(BinaryTaskReader& in);
+
+    void write(BinaryTaskWriter& out) const;
 };
 
 struct ConditionalEffect {
@@ -55,6 +199,9 @@ struct ConditionalEffect {
     vector<FactPair> conditions;
 
     ConditionalEffect(int var, int value, vector<FactPair>&& conditions);
+    explicit ConditionalEffect(BinaryTaskReader& in);
+
+    void write(BinaryTaskWriter& out) const;
 
     friend bool
     operator<(const ConditionalEffect& left, const ConditionalEffect& right)
@@ -69,6 +216,9 @@ struct ProbabilisticOutcome {
     vector<ConditionalEffect> effects;
 
     explicit ProbabilisticOutcome(std::istream& in);
+    explicit ProbabilisticOutcome(BinaryTaskReader& in);
+
+    void write(BinaryTaskWriter& out) const;
 };
 
 struct ProbabilisticOperator {
@@ -82,6 +232,9 @@ struct ProbabilisticOperator {
         std::istream& in,
         Optimization optimization,
         int& total_num_outcomes);
+    ProbabilisticOperator(BinaryTaskReader& in, int& total_num_outcomes);
+
+    void write(BinaryTaskWriter& out) const;
 };
 
 struct ExplicitAxiom {
@@ -90,8 +243,11 @@ struct ExplicitAxiom {
     string name;
 
     explicit ExplicitAxiom(std::istream& in);
+    explicit ExplicitAxiom(BinaryTaskReader& in);
 
     void read_pre_post(std::istream& in);
+
+    void write(BinaryTaskWriter& out) const;
 };
 
 class RootTask : public ProbabilisticTask {
@@ -114,6 +270,9 @@ class RootTask : public ProbabilisticTask {
 
 public:
     explicit RootTask(std::istream& in);
+    explicit RootTask(std::span<const std::byte> binary_data);
+
+    void write_binary(std::ostream& out) const;
 
     int get_num_variables() const override;
     string get_variable_name(int var) const override;
@@ -412,6 +571,161 @@ void ExplicitAxiom::read_pre_post(std::istream& in)
     effects.emplace_back(var, value_post, std::move(conditions));
 }
 
+template <typename T>
+void check_sorted(const vector<T>& elements, const char* what)
+{
+    if (!std::is_sorted(elements.begin(), elements.end())) {
+        binary_input_error(string(what) + " are not sorted");
+    }
+}
+
+ExplicitVariable::ExplicitVariable(BinaryTaskReader& in)
+    : name(in.read_string())
+    , axiom_layer(in.read<std::int32_t>())
+    , axiom_default_value(in.read<std::int32_t>())
+{
+    domain_size = in.read_count(sizeof(std::uint32_t));
+    if (domain_size < 1) {
+        binary_input_error("empty domain of variable " + name);
+    }
+
+    if (axiom_default_value < 0 || axiom_default_value >= domain_size) {
+        binary_input_error("invalid initial value of variable " + name);
+    }
+
+    fact_names.reserve(domain_size);
+    for (int i = 0; i < domain_size; ++i) {
+        fact_names.push_back(in.read_string());
+    }
+}
+
+void ExplicitVariable::write(BinaryTaskWriter& out) const
+{
+    out.write_string(name);
+    out.write<std::int32_t>(axiom_layer);
+    out.write<std::int32_t>(axiom_default_value);
+    out.write_count(fact_names.size());
+    for (const string& fact_name : fact_names) {
+        out.write_string(fact_name);
+    }
+}
+
+ConditionalEffect::ConditionalEffect(BinaryTaskReader& in)
+    : fact(FactPair::no_fact)
+    , conditions(in.read_facts())
+{
+    fact.var = in.read<std::int32_t>();
+    fact.value = in.read<std::int32_t>();
+    check_sorted(conditions, "Effect conditions");
+}
+
+void ConditionalEffect::write(BinaryTaskWriter& out) const
+{
+    out.write_facts(conditions);
+    out.write<std::int32_t>(fact.var);
+    out.write<std::int32_t>(fact.value);
+}
+
+ProbabilisticOutcome::ProbabilisticOutcome(BinaryTaskReader& in)
+    : probability(in.read<value_t>())
+{
+    const int count = in.read_count(3 * sizeof(std::uint32_t));
+    effects.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        effects.emplace_back(in);
+    }
+    check_sorted(effects, "Outcome effects");
+}
+
+void ProbabilisticOutcome::write(BinaryTaskWriter& out) const
+{
+    out.write(probability);
+    out.write_count(effects.size());
+    for (const ConditionalEffect& effect : effects) {
+        effect.write(out);
+    }
+}
+
+ProbabilisticOperator::ProbabilisticOperator(
+    BinaryTaskReader& in,
+    int& total_num_outcomes)
+    : outcomes_start_index(total_num_outcomes)
+{
+    name = in.read_string();
+    preconditions = in.read_facts();
+    check_sorted(preconditions, "Preconditions");
+
+    const int num_outcomes = in.read_count(sizeof(value_t));
+    if (num_outcomes < 1) {
+        binary_input_error("operator " + name + " has no outcomes");
+    }
+
+    total_num_outcomes += num_outcomes;
+
+    outcomes.reserve(num_outcomes);
+    for (int i = 0; i < num_outcomes; ++i) {
+        outcomes.emplace_back(in);
+    }
+
+    // The cost is stored after the objective has been applied.
+    cost = in.read<value_t>();
+}
+
+void ProbabilisticOperator::write(BinaryTaskWriter& out) const
+{
+    out.write_string(name);
+    out.write_facts(preconditions);
+    out.write_count(outcomes.size());
+    for (const ProbabilisticOutcome& outcome : outcomes) {
+        outcome.write(out);
+    }
+    out.write(cost);
+}
+
+ExplicitAxiom::ExplicitAxiom(BinaryTaskReader& in)
+    : preconditions(in.read_facts())
+    , name("<axiom>")
+{
+    const int count = in.read_count(3 * sizeof(std::uint32_t));
+    effects.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        effects.emplace_back(in);
+    }
+}
+
+void ExplicitAxiom::write(BinaryTaskWriter& out) const
+{
+    out.write_facts(preconditions);
+    out.write_count(effects.size());
+    for (const ConditionalEffect& effect : effects) {
+        effect.write(out);
+    }
+}
+
+void read_and_verify_binary_header(BinaryTaskReader& in)
+{
+    const auto header = in.read<BinarySASHeader>();
+
+    if (std::memcmp(header.magic, BINARY_SAS_MAGIC, sizeof(header.magic)) !=
+        0) {
+        binary_input_error("bad magic number");
+    }
+
+    if (header.version != BINARY_SAS_VERSION) {
+        binary_input_error(
+            "expected version " + std::to_string(BINARY_SAS_VERSION) +
+            ", got " + std::to_string(header.version));
+    }
+
+    if (header.byte_order_mark != BYTE_ORDER_MARK) {
+        binary_input_error("byte order mismatch");
+    }
+
+    if (header.value_size != sizeof(value_t)) {
+        binary_input_error("value type mismatch");
+    }
+}
+
 void read_and_verify_version(std::istream& in)
 {
     std::string version;
@@ -600,6 +914,101 @@ RootTask::RootTask(std::istream& in)
     axiom_evaluator.evaluate(initial_state_values);
 }
 
+RootTask::RootTask(std::span<const std::byte> binary_data)
+{
+    BinaryTaskReader in(binary_data);
+    read_and_verify_binary_header(in);
+
+    termination_cost = in.read<value_t>();
+
+    const int num_variables = in.read_count(4 * sizeof(std::uint32_t));
+    variables.reserve(num_variables);
+    for (int i = 0; i < num_variables; ++i) {
+        variables.emplace_back(in);
+    }
+
+    mutexes.resize(num_variables);
+    for (int var = 0; var < num_variables; ++var) {
+        mutexes[var].reserve(variables[var].domain_size);
+        for (int value = 0; value < variables[var].domain_size; ++value) {
+            const vector<FactPair> facts = in.read_facts();
+            check_facts(facts, variables);
+            check_sorted(facts, "Mutexes");
+            mutexes[var].emplace_back(facts.begin(), facts.end());
+        }
+    }
+
+    // The initial state is not stored separately, it coincides with the
+    // default values of the variables before the axioms are evaluated.
+    initial_state_values.reserve(num_variables);
+    for (const ExplicitVariable& var : variables) {
+        initial_state_values.push_back(var.axiom_default_value);
+    }
+
+    goals = in.read_facts();
+    if (goals.empty()) {
+        binary_input_error("task has no goal condition");
+    }
+    check_facts(goals, variables);
+
+    const int num_operators = in.read_count(3 * sizeof(std::uint32_t));
+    operators.reserve(num_operators);
+    int total_num_outcomes = 0;
+    for (int i = 0; i < num_operators; ++i) {
+        check_facts(operators.emplace_back(in, total_num_outcomes), variables);
+    }
+
+    const int num_axioms = in.read_count(2 * sizeof(std::uint32_t));
+    axioms.reserve(num_axioms);
+    for (int i = 0; i < num_axioms; ++i) {
+        check_facts(axioms.emplace_back(in), variables);
+    }
+
+    if (!in.at_end()) {
+        binary_input_error("trailing data after the axioms");
+    }
+
+    AxiomEvaluator& axiom_evaluator =
+        g_axiom_evaluators[PlanningTaskProxy(*this)];
+    axiom_evaluator.evaluate(initial_state_values);
+}
+
+void RootTask::write_binary(std::ostream& out) const
+{
+    BinarySASHeader header{};
+    std::memcpy(header.magic, BINARY_SAS_MAGIC, sizeof(header.magic));
+    header.version = BINARY_SAS_VERSION;
+    header.byte_order_mark = BYTE_ORDER_MARK;
+    header.value_size = sizeof(value_t);
+
+    BinaryTaskWriter writer(out);
+    writer.write(header);
+    writer.write(termination_cost);
+
+    writer.write_count(variables.size());
+    for (const ExplicitVariable& var : variables) {
+        var.write(writer);
+    }
+
+    for (const auto& var_mutexes : mutexes) {
+        for (const set<FactPair>& fact_mutexes : var_mutexes) {
+            writer.write_facts(fact_mutexes);
+        }
+    }
+
+    writer.write_facts(goals);
+
+    writer.write_count(operators.size());
+    for (const ProbabilisticOperator& op : operators) {
+        op.write(writer);
+    }
+
+    writer.write_count(axioms.size());
+    for (const ExplicitAxiom& axiom : axioms) {
+        axiom.write(writer);
+    }
+}
+
 const ExplicitVariable& RootTask::get_variable(int var) const
 {
     assert(utils::in_bounds(var, variables));
@@ -857,6 +1266,23 @@ std::unique_ptr<ProbabilisticTask> read_sas_task(std::istream& in)
     return std::make_unique<RootTask>(in);
 }
 
+std::unique_ptr<ProbabilisticTask>
+read_binary_sas_task(const std::filesystem::path& path)
+{
+    try {
+        const MappedFile file(path);
+        return std::make_unique<RootTask>(file.get_data());
+    } catch (const std::system_error& e) {
+        cerr << "Failed to open binary task file: " << e.what() << endl;
+        utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+    }
+}
+
+void convert_sas_task_to_binary(std::istream& in, std::ostream& out)
+{
+    RootTask(in).write_binary(out);
+}
+
 std::shared_ptr<ProbabilisticTask> read_root_tasks(std::istream& in)
 {
     std::shared_ptr<ProbabilisticTask> input_task = read_sas_task(in);
@@ -864,6 +1290,14 @@ std::shared_ptr<ProbabilisticTask> read_root_tasks(std::istream& in)
     return input_task;
 }
 
+std::shared_ptr<ProbabilisticTask>
+read_binary_root_tasks(const std::filesystem::path& path)
+{
+    std::shared_ptr<ProbabilisticTask> input_task = read_binary_sas_task(path);
+    set_root_task(input_task);
+    return input_task;
+}
+
 void set_root_task(std::shared_ptr<ProbabilisticTask> task)
 {
     // FIXME crashes in tests since it persists in between tests.
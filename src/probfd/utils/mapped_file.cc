@@ -0,0 +1,95 @@
+#include "probfd/utils/mapped_file.h"
+
+#include <cerrno>
+#include <fstream>
+#include <system_error>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define PROBFD_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace probfd {
+
+#ifdef PROBFD_HAS_MMAP
+
+MappedFile::MappedFile(const std::filesystem::path& path)
+{
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        throw std::system_error(errno, std::generic_category(), path.string());
+    }
+
+    struct stat file_stat;
+    if (::fstat(fd, &file_stat) == -1) {
+        const int error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), path.string());
+    }
+
+    size_ = static_cast<std::size_t>(file_stat.st_size);
+
+    // Mapping zero bytes is an error.
+    if (size_ != 0) {
+        void* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            const int error = errno;
+            ::close(fd);
+            throw std::system_error(
+                error,
+                std::generic_category(),
+                path.string());
+        }
+        data_ = static_cast<const std::byte*>(data);
+    }
+
+    // The mapping stays valid after the descriptor is closed.
+    ::close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+    if (data_) {
+        ::munmap(const_cast<std::byte*>(data_), size_);
+    }
+}
+
+#else
+
+MappedFile::MappedFile(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::system_error(
+            std::make_error_code(std::errc::no_such_file_or_directory),
+            path.string());
+    }
+
+    buffer_.resize(std::filesystem::file_size(path));
+    file.read(
+        reinterpret_cast<char*>(buffer_.data()),
+        static_cast<std::streamsize>(buffer_.size()));
+
+    if (!file) {
+        throw std::system_error(
+            std::make_error_code(std::errc::io_error),
+            path.string());
+    }
+
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+}
+
+MappedFile::~MappedFile() = default;
+
+#endif
+
+std::span<const std::byte> MappedFile::get_data() const
+{
+    return {data_, size_};
+}
+
+} // namespace probfd
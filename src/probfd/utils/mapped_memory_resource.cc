@@ -0,0 +1,109 @@
+#include "probfd/utils/mapped_memory_resource.h"
+
+#include <cerrno>
+#include <memory>
+#include <string>
+#include <system_error>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define PROBFD_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace probfd {
+
+MappedMemoryResource::MappedMemoryResource(
+    std::filesystem::path directory,
+    std::size_t chunk_size)
+    : path_(std::move(directory))
+    , chunk_size_(chunk_size)
+{
+#ifdef PROBFD_HAS_MMAP
+    std::string name = (path_ / "probfd-XXXXXX").string();
+    fd_ = ::mkstemp(name.data());
+    if (fd_ == -1) {
+        throw std::system_error(errno, std::generic_category(), name);
+    }
+
+    // The mappings keep the file alive, nobody else needs its name.
+    ::unlink(name.c_str());
+#endif
+}
+
+MappedMemoryResource::~MappedMemoryResource()
+{
+#ifdef PROBFD_HAS_MMAP
+    for (const Chunk& chunk : chunks_) {
+        ::munmap(chunk.data, chunk.size);
+    }
+    if (fd_ != -1) ::close(fd_);
+#else
+    for (const Chunk& chunk : chunks_) {
+        std::pmr::get_default_resource()->deallocate(chunk.data, chunk.size);
+    }
+#endif
+}
+
+void* MappedMemoryResource::do_allocate(
+    std::size_t bytes,
+    std::size_t alignment)
+{
+    void* p = current_;
+    if (!std::align(alignment, bytes, p, space_left_)) {
+        // Chunks are page-aligned.
+        add_chunk(bytes);
+        p = current_;
+    }
+
+    current_ = static_cast<std::byte*>(p) + bytes;
+    space_left_ -= bytes;
+    allocated_bytes_ += bytes;
+    return p;
+}
+
+void MappedMemoryResource::do_deallocate(void*, std::size_t, std::size_t)
+{
+    // Memory is only released on destruction.
+}
+
+bool MappedMemoryResource::do_is_equal(
+    const std::pmr::memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+
+void MappedMemoryResource::add_chunk(std::size_t min_size)
+{
+    std::size_t size = chunk_size_;
+    while (size < min_size) size *= 2;
+
+#ifdef PROBFD_HAS_MMAP
+    // Mapped file offsets must be multiples of the page size.
+    const auto page_size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    size = (size + page_size - 1) / page_size * page_size;
+
+    const auto offset = static_cast<off_t>(file_size_);
+
+    if (::ftruncate(fd_, offset + static_cast<off_t>(size)) == -1) {
+        throw std::system_error(errno, std::generic_category(), path_.string());
+    }
+
+    void* data =
+        ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, offset);
+    if (data == MAP_FAILED) {
+        throw std::system_error(errno, std::generic_category(), path_.string());
+    }
+
+    file_size_ += size;
+#else
+    void* data = std::pmr::get_default_resource()->allocate(size);
+#endif
+
+    chunks_.push_back({static_cast<std::byte*>(data), size});
+    current_ = static_cast<std::byte*>(data);
+    space_left_ = size;
+}
+
+} // namespace probfd
@@ -0,0 +1,163 @@
+#include "probfd/utils/thread_pool.h"
+
+#include <cassert>
+
+namespace probfd {
+
+namespace {
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local unsigned current_worker = 0;
+} // namespace
+
+ThreadPool::ThreadPool(unsigned num_threads)
+{
+    assert(num_threads > 0);
+
+    queues_.reserve(num_threads);
+    for (unsigned i = 0; i != num_threads; ++i) {
+        queues_.emplace_back(std::make_unique<WorkerQueue>());
+    }
+
+    workers_.reserve(num_threads);
+    for (unsigned i = 0; i != num_threads; ++i) {
+        workers_.emplace_back([this, i] { run_worker(i); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock(idle_mutex_);
+        shutdown_ = true;
+    }
+
+    work_available_.notify_all();
+
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+unsigned ThreadPool::get_num_threads() const
+{
+    return static_cast<unsigned>(workers_.size());
+}
+
+void ThreadPool::submit(std::function<void()> task)
+{
+    ++pending_;
+
+    const unsigned index =
+        current_pool == this
+            ? current_worker
+            : static_cast<unsigned>(next_queue_++ % queues_.size());
+
+    {
+        WorkerQueue& queue = *queues_[index];
+        std::lock_guard lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+
+    {
+        std::lock_guard lock(idle_mutex_);
+        ++queued_;
+    }
+
+    work_available_.notify_one();
+}
+
+void ThreadPool::wait()
+{
+    std::unique_lock lock(idle_mutex_);
+    all_done_.wait(lock, [this] { return pending_ == 0; });
+
+    cancelled_ = false;
+
+    if (exception_) {
+        std::rethrow_exception(std::exchange(exception_, nullptr));
+    }
+}
+
+unsigned ThreadPool::get_worker_index() const
+{
+    return current_pool == this ? current_worker : get_num_threads();
+}
+
+void ThreadPool::run_worker(unsigned index)
+{
+    current_pool = this;
+    current_worker = index;
+
+    for (;;) {
+        std::function<void()> task;
+
+        if (try_pop(index, task)) {
+            if (!cancelled_) {
+                try {
+                    task();
+                } catch (...) {
+                    std::lock_guard lock(idle_mutex_);
+                    if (!exception_) exception_ = std::current_exception();
+                    cancelled_ = true;
+                }
+            }
+
+            finish_task();
+            continue;
+        }
+
+        std::unique_lock lock(idle_mutex_);
+        work_available_.wait(lock, [this] {
+            return shutdown_ || queued_ > 0;
+        });
+
+        if (shutdown_ && queued_ <= 0) return;
+    }
+}
+
+bool ThreadPool::try_pop(unsigned index, std::function<void()>& task)
+{
+    // Own queue first (LIFO), then steal from the others (FIFO).
+    {
+        WorkerQueue& queue = *queues_[index];
+        std::lock_guard lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+            --queued_;
+            return true;
+        }
+    }
+
+    const std::size_t num_queues = queues_.size();
+
+    for (std::size_t i = 1; i != num_queues; ++i) {
+        WorkerQueue& queue = *queues_[(index + i) % num_queues];
+        std::lock_guard lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            --queued_;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ThreadPool::finish_task()
+{
+    if (--pending_ == 0) {
+        std::lock_guard lock(idle_mutex_);
+        all_done_.notify_all();
+    }
+}
+
+unsigned resolve_num_threads(unsigned num_threads)
+{
+    if (num_threads != 0) return num_threads;
+    const unsigned hardware_threads = std::thread::hardware_concurrency();
+    return hardware_threads != 0 ? hardware_threads : 1;
+}
+
+} // namespace probfd
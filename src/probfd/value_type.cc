@@ -1,6 +1,8 @@
 #include "probfd/value_type.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <cstdlib>
 
 namespace probfd {
@@ -29,6 +31,50 @@ value_t abs(value_t val)
     return std::abs(val);
 }
 
+stored_value_t to_stored_lower_bound(value_t value)
+{
+    auto stored = static_cast<stored_value_t>(value);
+    if (stored > value) {
+        stored = std::nextafter(
+            stored,
+            -std::numeric_limits<stored_value_t>::infinity());
+    }
+    return stored;
+}
+
+stored_value_t to_stored_upper_bound(value_t value)
+{
+    auto stored = static_cast<stored_value_t>(value);
+    if (stored < value) {
+        stored = std::nextafter(
+            stored,
+            std::numeric_limits<stored_value_t>::infinity());
+    }
+    return stored;
+}
+
+std::vector<stored_value_t> to_stored_lower_bounds(std::vector<value_t> values)
+{
+#if defined(PROBFD_MIXED_PRECISION)
+    std::vector<stored_value_t> stored(values.size());
+    std::ranges::transform(values, stored.begin(), to_stored_lower_bound);
+    return stored;
+#else
+    return values;
+#endif
+}
+
+value_t get_stored_value_error(value_t value)
+{
+    if (!std::isfinite(value)) return 0_vt;
+    const auto stored = static_cast<stored_value_t>(std::abs(value));
+    if (!std::isfinite(stored)) return INFINITE_VALUE;
+    return static_cast<value_t>(std::nextafter(
+               stored,
+               std::numeric_limits<stored_value_t>::infinity())) -
+           static_cast<value_t>(stored);
+}
+
 bool is_approx_equal(value_t v1, value_t v2, value_t tolerance)
 {
     assert(tolerance >= 0.0_vt);
@@ -4,13 +4,25 @@
 
 #include "probfd/algorithms/depth_first_heuristic_search.h"
 #include "probfd/algorithms/fret.h"
+#include "probfd/algorithms/interval_iteration.h"
+#include "probfd/algorithms/lrtdp.h"
+#include "probfd/algorithms/parallel_lrtdp.h"
+#include "probfd/algorithms/scc_bellman_matrix.h"
+#include "probfd/algorithms/topological_value_iteration.h"
+
+#include "probfd/bisimulation/bisimilar_state_space.h"
 
 #include "probfd/policy_pickers/arbitrary_tiebreaker.h"
 
 #include "probfd/heuristics/constant_evaluator.h"
 
+#include "probfd/preprocessing/end_component_decomposition.h"
+
 #include "probfd/quotients/quotient_system.h"
 
+#include "probfd/successor_samplers/random_successor_sampler.h"
+
+#include "probfd/probabilistic_task.h"
 #include "probfd/task_cost_function.h"
 #include "probfd/task_proxy.h"
 #include "probfd/task_state_space.h"
@@ -19,11 +31,60 @@
 
 #include "tests/verification/policy_verification.h"
 
+#include "downward/task_utils/task_properties.h"
+
+#include <limits>
 #include <memory>
 
 using namespace probfd;
 using namespace tests;
 
+namespace {
+// Zero action costs, so that the reversible parts of the task form end
+// components.
+class MaxProbCostFunction : public SimpleCostFunction<State, OperatorID> {
+    std::shared_ptr<ProbabilisticTask> task_;
+
+public:
+    explicit MaxProbCostFunction(std::shared_ptr<ProbabilisticTask> task)
+        : task_(std::move(task))
+    {
+    }
+
+    bool is_goal(const State& state) const override
+    {
+        ProbabilisticTaskProxy proxy(*task_);
+        return ::task_properties::is_goal_state(proxy, state);
+    }
+
+    value_t get_non_goal_termination_cost() const override { return 1_vt; }
+
+    value_t get_action_cost(OperatorID) override { return 0_vt; }
+};
+
+// Action costs of 1000, so that the state values are in the thousands. Large,
+// but finite termination costs, so that the upper bounds are finite.
+class ScaledCostFunction : public SimpleCostFunction<State, OperatorID> {
+    std::shared_ptr<ProbabilisticTask> task_;
+
+public:
+    explicit ScaledCostFunction(std::shared_ptr<ProbabilisticTask> task)
+        : task_(std::move(task))
+    {
+    }
+
+    bool is_goal(const State& state) const override
+    {
+        ProbabilisticTaskProxy proxy(*task_);
+        return ::task_properties::is_goal_state(proxy, state);
+    }
+
+    value_t get_non_goal_termination_cost() const override { return 1e6_vt; }
+
+    value_t get_action_cost(OperatorID) override { return 1000_vt; }
+};
+} // namespace
+
 TEST(EngineTests, test_interval_set_min)
 {
     Interval interval(8.0_vt, 40.0_vt);
@@ -105,6 +166,34 @@ TEST(EngineTests, test_interval_update4)
     ASSERT_EQ(interval.upper, std::min(40.0_vt, 39.0_vt));
 }
 
+TEST(EngineTests, test_scc_bellman_matrix)
+{
+    // V(0) = min(10, 1 + 0.5 V(1)), V(1) = min(10, 2 + 0.5 V(0), 3 + V(0))
+    algorithms::SCCBellmanMatrix<value_t> matrix;
+
+    matrix.add_state(0_vt, 10_vt);
+    matrix.add_q_value(1_vt);
+    matrix.add_successor(1, 0.5_vt);
+
+    matrix.add_state(0_vt, 10_vt);
+    matrix.add_q_value(2_vt);
+    matrix.add_successor(0, 0.5_vt);
+    matrix.add_q_value(3_vt);
+    matrix.add_successor(0, 1_vt);
+
+    ASSERT_EQ(matrix.num_states(), 2u);
+
+    while (!matrix.sweep([](value_t& value, value_t new_value) {
+        return algorithms::update(value, new_value);
+    })) {
+    }
+
+    ASSERT_NEAR(matrix.get_value(0), 8_vt / 3_vt, 0.001);
+    ASSERT_NEAR(matrix.get_value(1), 10_vt / 3_vt, 0.001);
+    ASSERT_EQ(matrix.get_best_q_value(0), 0);
+    ASSERT_EQ(matrix.get_best_q_value(1), 0);
+}
+
 TEST(EngineTests, test_ilao_blocksworld_6_blocks)
 {
     using namespace algorithms::heuristic_depth_first_search;
@@ -210,4 +299,383 @@ TEST(EngineTests, test_fret_ilao_blocksworld_6_blocks)
         mdp,
         *policy,
         mdp.get_state_id(state_space.get_initial_state())));
-}
\ No newline at end of file
+}
+
+TEST(EngineTests, test_lrtdp_split_layout_blocksworld_6_blocks)
+{
+    using namespace algorithms::lrtdp;
+
+    std::shared_ptr<ProbabilisticTask> task(new BlocksworldTask(
+        6,
+        {{1, 0}, {2}, {5, 4, 3}},
+        {{1, 4}, {5, 3, 2, 0}}));
+
+    tasks::set_root_task(task);
+
+    ProgressReport report(0.0_vt, std::cout, false);
+    heuristics::BlindEvaluator<State> heuristic;
+    auto cost_function = std::make_shared<TaskCostFunction>(task);
+
+    TaskStateSpace state_space(task, utils::get_silent_log());
+    auto policy_chooser = std::make_shared<
+        policy_pickers::ArbitraryTiebreaker<State, OperatorID>>(true);
+    auto successor_sampler = std::make_shared<
+        successor_samplers::RandomSuccessorSampler<OperatorID>>(0);
+
+    LRTDP<State, OperatorID, false, algorithms::heuristic_search::SplitLayout>
+        lrtdp(
+            policy_chooser,
+            TrialTerminationCondition::TERMINAL,
+            successor_sampler);
+
+    CompositeMDP<State, OperatorID> mdp{state_space, *cost_function};
+
+    auto policy = lrtdp.compute_policy(
+        mdp,
+        heuristic,
+        state_space.get_initial_state(),
+        report,
+        std::numeric_limits<double>::infinity());
+
+    std::optional<PolicyDecision<OperatorID>> decision =
+        policy->get_decision(state_space.get_initial_state());
+
+    ASSERT_NE(policy, nullptr);
+    ASSERT_TRUE(decision.has_value());
+    EXPECT_NEAR(decision->q_value_interval.lower, 8.011, 0.01);
+    ASSERT_TRUE(verify_policy(
+        mdp,
+        *policy,
+        mdp.get_state_id(state_space.get_initial_state())));
+}
+
+TEST(EngineTests, test_parallel_tvi_blocksworld_6_blocks)
+{
+    using namespace algorithms::topological_vi;
+
+    std::shared_ptr<ProbabilisticTask> task(new BlocksworldTask(
+        6,
+        {{1, 0}, {2}, {5, 4, 3}},
+        {{1, 4}, {5, 3, 2, 0}}));
+
+    tasks::set_root_task(task);
+
+    heuristics::BlindEvaluator<State> heuristic;
+    auto cost_function = std::make_shared<TaskCostFunction>(task);
+
+    TaskStateSpace state_space(task, utils::get_silent_log());
+    CompositeMDP<State, OperatorID> mdp{state_space, *cost_function};
+
+    const probfd::StateID init_id =
+        mdp.get_state_id(state_space.get_initial_state());
+
+    storage::PerStateStorage<value_t> serial_values;
+    storage::PerStateStorage<value_t> parallel_values;
+
+    TopologicalValueIteration<State, OperatorID> serial_tvi(false);
+    TopologicalValueIteration<State, OperatorID> parallel_tvi(false, 4);
+
+    const Interval serial_result =
+        serial_tvi.solve(mdp, heuristic, init_id, serial_values);
+    const Interval parallel_result =
+        parallel_tvi.solve(mdp, heuristic, init_id, parallel_values);
+
+    EXPECT_NEAR(serial_result.lower, 8.011, 0.01);
+    ASSERT_EQ(serial_result.lower, parallel_result.lower);
+    ASSERT_EQ(serial_values.size(), parallel_values.size());
+
+    for (std::size_t i = 0; i != serial_values.size(); ++i) {
+        ASSERT_EQ(serial_values[i], parallel_values[i]);
+    }
+
+    const Statistics serial_stats = serial_tvi.get_statistics();
+    const Statistics parallel_stats = parallel_tvi.get_statistics();
+
+    ASSERT_EQ(serial_stats.sccs, parallel_stats.sccs);
+    ASSERT_EQ(serial_stats.bellman_backups, parallel_stats.bellman_backups);
+    ASSERT_EQ(parallel_stats.thread_statistics.size(), 4u);
+}
+
+TEST(EngineTests, test_bisimulation_blocksworld_6_blocks)
+{
+    using namespace algorithms::topological_vi;
+    using namespace bisimulation;
+
+    std::shared_ptr<ProbabilisticTask> task(new BlocksworldTask(
+        6,
+        {{1, 0}, {2}, {5, 4, 3}},
+        {{1, 4}, {5, 3, 2, 0}}));
+
+    tasks::set_root_task(task);
+
+    auto cost_function = std::make_shared<MaxProbCostFunction>(task);
+
+    TaskStateSpace state_space(task, utils::get_silent_log());
+    CompositeMDP<State, OperatorID> mdp{state_space, *cost_function};
+
+    const probfd::StateID init_id =
+        mdp.get_state_id(state_space.get_initial_state());
+
+    heuristics::BlindEvaluator<State> heuristic;
+    storage::PerStateStorage<value_t> values;
+
+    TopologicalValueIteration<State, OperatorID> tvi(false);
+    const Interval result = tvi.solve(mdp, heuristic, init_id, values);
+
+    BisimilarStateSpace serial(task, cost_function, 1, utils::get_silent_log());
+    BisimilarStateSpace parallel(
+        task,
+        cost_function,
+        4,
+        utils::get_silent_log());
+
+    ASSERT_EQ(serial.num_bisimilar_states(), parallel.num_bisimilar_states());
+    ASSERT_EQ(serial.num_transitions(), parallel.num_transitions());
+    ASSERT_LE(
+        serial.num_bisimilar_states(),
+        state_space.get_num_registered_states());
+
+    const QuotientState quotient_init = serial.get_initial_state();
+    ASSERT_FALSE(serial.is_dead_end(quotient_init));
+
+    heuristics::BlindEvaluator<QuotientState> quotient_heuristic;
+    storage::PerStateStorage<value_t> quotient_values;
+
+    TopologicalValueIteration<QuotientState, QuotientAction> quotient_tvi(
+        false);
+    const Interval quotient_result = quotient_tvi.solve(
+        serial,
+        quotient_heuristic,
+        serial.get_state_id(quotient_init),
+        quotient_values);
+
+    EXPECT_NEAR(result.lower, quotient_result.lower, 0.001);
+}
+
+TEST(EngineTests, test_tvi_scc_update_orders_blocksworld_6_blocks)
+{
+    using namespace algorithms::topological_vi;
+
+    std::shared_ptr<ProbabilisticTask> task(new BlocksworldTask(
+        6,
+        {{1, 0}, {2}, {5, 4, 3}},
+        {{1, 4}, {5, 3, 2, 0}}));
+
+    tasks::set_root_task(task);
+
+    heuristics::BlindEvaluator<State> heuristic;
+    auto cost_function = std::make_shared<TaskCostFunction>(task);
+
+    TaskStateSpace state_space(task, utils::get_silent_log());
+    CompositeMDP<State, OperatorID> mdp{state_space, *cost_function};
+
+    const probfd::StateID init_id =
+        mdp.get_state_id(state_space.get_initial_state());
+
+    storage::PerStateStorage<value_t> round_robin_values;
+    TopologicalValueIteration<State, OperatorID> round_robin_tvi(false);
+    round_robin_tvi.solve(mdp, heuristic, init_id, round_robin_values);
+
+    const Statistics round_robin_stats = round_robin_tvi.get_statistics();
+    ASSERT_GT(round_robin_stats.sccs, round_robin_stats.singleton_sccs);
+    ASSERT_EQ(round_robin_stats.saved_backups, 0u);
+
+    for (const SCCUpdateOrder order :
+         {SCCUpdateOrder::BACKWARD_GAUSS_SEIDEL,
+          SCCUpdateOrder::PRIORITIZED_SWEEPING}) {
+        for (const unsigned num_threads : {1u, 4u}) {
+            storage::PerStateStorage<value_t> values;
+            TopologicalValueIteration<State, OperatorID> tvi(
+                false,
+                num_threads,
+                order);
+
+            const Interval result =
+                tvi.solve(mdp, heuristic, init_id, values);
+
+            EXPECT_NEAR(result.lower, 8.011, 0.01);
+            ASSERT_EQ(round_robin_values.size(), values.size());
+
+            for (std::size_t i = 0; i != values.size(); ++i) {
+                if (round_robin_values[i] == INFINITE_VALUE) {
+                    ASSERT_EQ(values[i], INFINITE_VALUE);
+                } else {
+                    ASSERT_NEAR(round_robin_values[i], values[i], 0.001);
+                }
+            }
+
+            const Statistics stats = tvi.get_statistics();
+            ASSERT_EQ(stats.sccs, round_robin_stats.sccs);
+            ASSERT_GT(stats.saved_backups, 0u);
+        }
+    }
+}
+
+TEST(EngineTests, test_parallel_interval_iteration_blocksworld_6_blocks)
+{
+    using namespace algorithms::interval_iteration;
+    using namespace preprocessing;
+
+    std::shared_ptr<ProbabilisticTask> task(new BlocksworldTask(
+        6,
+        {{1, 0}, {2}, {5, 4, 3}},
+        {{1, 4}, {5, 3, 2, 0}}));
+
+    tasks::set_root_task(task);
+
+    heuristics::BlindEvaluator<State> heuristic;
+    MaxProbCostFunction cost_function(task);
+
+    TaskStateSpace state_space(task, utils::get_silent_log());
+    CompositeMDP<State, OperatorID> mdp{state_space, cost_function};
+
+    const State initial_state = state_space.get_initial_state();
+
+    EndComponentDecomposition<State, OperatorID> serial_ecd(false);
+    EndComponentDecomposition<State, OperatorID> parallel_ecd(false, 4);
+
+    auto serial_sys =
+        serial_ecd.build_quotient_system(mdp, nullptr, initial_state);
+    auto parallel_sys =
+        parallel_ecd.build_quotient_system(mdp, nullptr, initial_state);
+
+    const ECDStatistics serial_stats = serial_ecd.get_statistics();
+    const ECDStatistics parallel_stats = parallel_ecd.get_statistics();
+
+    ASSERT_GT(serial_stats.recursions, 0u);
+    ASSERT_EQ(serial_stats.sccsk, parallel_stats.sccsk);
+    ASSERT_EQ(serial_stats.ec1, parallel_stats.ec1);
+    ASSERT_EQ(serial_stats.eck, parallel_stats.eck);
+    ASSERT_EQ(serial_stats.ec_transitions, parallel_stats.ec_transitions);
+    ASSERT_EQ(serial_stats.recursions, parallel_stats.recursions);
+    ASSERT_EQ(parallel_stats.thread_statistics.size(), 4u);
+
+    // The end components and their representatives do not depend on the
+    // thread schedule.
+    for (std::size_t i = 0; i != state_space.get_num_registered_states();
+         ++i) {
+        ASSERT_EQ(
+            serial_sys->translate_state_id(probfd::StateID(i)),
+            parallel_sys->translate_state_id(probfd::StateID(i)));
+    }
+
+    IntervalIteration<State, OperatorID> serial_ii(false, false);
+    IntervalIteration<State, OperatorID> parallel_ii(
+        false,
+        false,
+        std::pmr::get_default_resource(),
+        4);
+
+    ProgressReport report(0.0_vt, std::cout, false);
+
+    const Interval serial_result = serial_ii.solve(
+        mdp,
+        heuristic,
+        initial_state,
+        report,
+        std::numeric_limits<double>::infinity());
+    const Interval parallel_result = parallel_ii.solve(
+        mdp,
+        heuristic,
+        initial_state,
+        report,
+        std::numeric_limits<double>::infinity());
+
+    ASSERT_TRUE(serial_result.bounds_approximately_equal());
+    ASSERT_TRUE(parallel_result.bounds_approximately_equal());
+    ASSERT_NEAR(serial_result.lower, parallel_result.lower, g_epsilon);
+    ASSERT_NEAR(serial_result.upper, parallel_result.upper, g_epsilon);
+}
+
+// Blocksworld with six blocks. The expected cost of an optimal policy for the
+// initial state is about 8.011.
+class Blocksworld6Tests : public ::testing::Test {
+protected:
+    static std::shared_ptr<ProbabilisticTask> create_root_task()
+    {
+        std::shared_ptr<ProbabilisticTask> task(new BlocksworldTask(
+            6,
+            {{1, 0}, {2}, {5, 4, 3}},
+            {{1, 4}, {5, 3, 2, 0}}));
+        tasks::set_root_task(task);
+        return task;
+    }
+
+    std::shared_ptr<ProbabilisticTask> task = create_root_task();
+
+    ProgressReport report{0.0_vt, std::cout, false};
+    heuristics::BlindEvaluator<State> heuristic;
+
+    TaskStateSpace state_space{task, utils::get_silent_log()};
+
+    std::shared_ptr<TaskCostFunction> cost_function =
+        std::make_shared<TaskCostFunction>(task);
+    CompositeMDP<State, OperatorID> mdp{state_space, *cost_function};
+
+    void check_optimal_policy(Policy<State, OperatorID>* policy)
+    {
+        ASSERT_NE(policy, nullptr);
+
+        std::optional<PolicyDecision<OperatorID>> decision =
+            policy->get_decision(state_space.get_initial_state());
+
+        ASSERT_TRUE(decision.has_value());
+        EXPECT_NEAR(decision->q_value_interval.lower, 8.011, 0.01);
+        ASSERT_TRUE(verify_policy(
+            mdp,
+            *policy,
+            mdp.get_state_id(state_space.get_initial_state())));
+    }
+};
+
+TEST_F(Blocksworld6Tests, test_parallel_lrtdp)
+{
+    using namespace algorithms::parallel_lrtdp;
+
+    ParallelLRTDP<State, OperatorID, false> lrtdp(
+        TrialTerminationCondition::TERMINAL,
+        4,
+        0);
+
+    auto policy = lrtdp.compute_policy(
+        mdp,
+        heuristic,
+        state_space.get_initial_state(),
+        report,
+        std::numeric_limits<double>::infinity());
+
+    check_optimal_policy(policy.get());
+    ASSERT_EQ(lrtdp.get_statistics().thread_statistics.size(), 4u);
+}
+
+// With mixed precision, the stored bounds of values in the thousands cannot
+// get closer than g_epsilon, but LRTDP must still label the states as solved.
+TEST_F(Blocksworld6Tests, test_interval_lrtdp_large_values)
+{
+    using namespace algorithms::lrtdp;
+
+    auto scaled_cost_function = std::make_shared<ScaledCostFunction>(task);
+    CompositeMDP<State, OperatorID> scaled_mdp{
+        state_space,
+        *scaled_cost_function};
+
+    auto policy_chooser = std::make_shared<
+        policy_pickers::ArbitraryTiebreaker<State, OperatorID>>(true);
+    auto successor_sampler = std::make_shared<
+        successor_samplers::RandomSuccessorSampler<OperatorID>>(0);
+
+    LRTDP<State, OperatorID, true> lrtdp(
+        policy_chooser,
+        TrialTerminationCondition::TERMINAL,
+        successor_sampler);
+
+    const Interval result = lrtdp.solve(
+        scaled_mdp,
+        heuristic,
+        state_space.get_initial_state(),
+        report,
+        std::numeric_limits<double>::infinity());
+
+    EXPECT_NEAR(result.lower, 8011, 10);
+    EXPECT_NEAR(result.upper, result.lower, 0.01);
+}
@@ -42,4 +42,21 @@ TEST(FPTests, test_user_defined_literal_double)
 TEST(FPTests, test_user_defined_literal_long)
 {
     ASSERT_EQ(double_to_value(static_cast<double>(42)), 42_vt);
-}
\ No newline at end of file
+}
+
+TEST(FPTests, test_stored_bounds_enclose_value)
+{
+    const value_t value = 1_vt / 3_vt;
+    ASSERT_LE(to_stored_lower_bound(value), value);
+    ASSERT_GE(to_stored_upper_bound(value), value);
+    ASSERT_LE(
+        to_stored_upper_bound(value) - to_stored_lower_bound(value),
+        get_stored_value_error(value));
+}
+
+TEST(FPTests, test_stored_bounds_keep_infinity)
+{
+    ASSERT_EQ(to_stored_lower_bound(INFINITE_VALUE), INFINITE_VALUE);
+    ASSERT_EQ(to_stored_upper_bound(INFINITE_VALUE), INFINITE_VALUE);
+    ASSERT_EQ(get_stored_value_error(INFINITE_VALUE), 0_vt);
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include "downward/algorithms/compact_int_hash_set.h"
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+using namespace compact_int_hash_set;
+
+namespace {
+// Looks up the hash of a key in a table, to place keys in chosen buckets.
+struct TableHasher {
+    std::vector<HashType> hashes;
+
+    HashType operator()(KeyType key) const { return hashes[key]; }
+};
+
+struct MultiplicativeHasher {
+    HashType operator()(KeyType key) const
+    {
+        return static_cast<HashType>(key) * 2654435761U;
+    }
+};
+
+using TableHashSet = CompactIntHashSet<TableHasher, std::equal_to<KeyType>>;
+
+// The first hash of the ideal bucket with the given index, for a set with 406
+// buckets. A set with 256 to 355 keys and a good hash function has 406
+// buckets.
+HashType get_bucket_hash(std::uint64_t bucket)
+{
+    return static_cast<HashType>(((bucket << 32) + 405) / 406);
+}
+
+std::size_t get_size_with_good_hash(int num_keys)
+{
+    CompactIntHashSet<MultiplicativeHasher, std::equal_to<KeyType>> set(
+        MultiplicativeHasher{},
+        std::equal_to<KeyType>());
+
+    for (KeyType key = 0; key != num_keys; ++key) {
+        set.insert(key);
+    }
+
+    return set.get_size_in_bytes();
+}
+
+void insert_all(TableHashSet& set, int num_keys)
+{
+    for (KeyType key = 0; key != num_keys; ++key) {
+        ASSERT_EQ(set.insert(key), std::make_pair(key, true));
+    }
+}
+
+void check_contains_all(TableHashSet& set, int num_keys)
+{
+    ASSERT_EQ(set.size(), num_keys);
+    for (KeyType key = 0; key != num_keys; ++key) {
+        ASSERT_EQ(set.insert(key), std::make_pair(key, false));
+    }
+    ASSERT_EQ(set.size(), num_keys);
+}
+} // namespace
+
+TEST(HashSetTests, test_compact_robin_hood_displacement)
+{
+    // 200 keys in bucket 50, then 100 keys in bucket 0. Without displacement,
+    // the last keys of bucket 0 would be placed behind the keys of bucket 50,
+    // almost 300 buckets from their ideal bucket, and the set would grow.
+    TableHasher hasher;
+    hasher.hashes.assign(200, get_bucket_hash(50));
+    hasher.hashes.resize(300, get_bucket_hash(0));
+
+    TableHashSet set(hasher, std::equal_to<KeyType>());
+    insert_all(set, 300);
+    check_contains_all(set, 300);
+
+    ASSERT_EQ(set.get_size_in_bytes(), get_size_with_good_hash(300));
+}
+
+TEST(HashSetTests, test_compact_growth_on_max_distance)
+{
+    // 300 keys in the first 30 of 406 buckets, so some key is more than 254
+    // buckets from its ideal bucket, although the load factor is below 7/8.
+    TableHasher hasher;
+    for (HashType key = 0; key != 300; ++key) {
+        hasher.hashes.push_back(key << 20);
+    }
+
+    TableHashSet set(hasher, std::equal_to<KeyType>());
+    insert_all(set, 300);
+    check_contains_all(set, 300);
+
+    ASSERT_GT(set.get_size_in_bytes(), get_size_with_good_hash(300));
+}
+
+TEST(HashSetTests, test_compact_growth_during_rehash)
+{
+    // Two groups of keys, which are in adjacent buckets in a set with 406
+    // buckets, but in the same bucket in a set with 609 buckets. The 256th
+    // key makes the first set grow, and reinserting the keys into the second
+    // set makes it grow again before the rehash is completed.
+    TableHasher hasher;
+    for (int key = 0; key != 256; ++key) {
+        hasher.hashes.push_back(key % 2 == 0 ? 10000000 : 11000000);
+    }
+
+    TableHashSet set(hasher, std::equal_to<KeyType>());
+    insert_all(set, 256);
+    check_contains_all(set, 256);
+
+    ASSERT_GT(set.get_size_in_bytes(), get_size_with_good_hash(256));
+}
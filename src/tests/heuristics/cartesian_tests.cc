@@ -2,18 +2,54 @@
 
 #include "probfd/tasks/root_task.h"
 
+#include "probfd/algorithms/topological_value_iteration.h"
+#include "probfd/algorithms/trap_aware_dfhs.h"
+
+#include "probfd/heuristics/constant_evaluator.h"
+
+#include "probfd/policy_pickers/arbitrary_tiebreaker.h"
+
+#include "probfd/quotients/quotient_system.h"
+
+#include "probfd/storage/per_state_storage.h"
+
+#include "probfd/task_utils/task_properties.h"
+
+#include "probfd/mdp.h"
+#include "probfd/policy.h"
 #include "probfd/probabilistic_task.h"
+#include "probfd/progress_report.h"
+#include "probfd/task_cost_function.h"
 #include "probfd/task_proxy.h"
+#include "probfd/task_state_space.h"
 
+#include "probfd/cartesian_abstractions/abstract_state.h"
+#include "probfd/cartesian_abstractions/adjacency_lists.h"
 #include "probfd/cartesian_abstractions/cartesian_abstraction.h"
+#include "probfd/cartesian_abstractions/cartesian_heuristic_function.h"
+#include "probfd/cartesian_abstractions/cost_saturation.h"
+#include "probfd/cartesian_abstractions/evaluators.h"
+#include "probfd/cartesian_abstractions/flat_refinement_hierarchy.h"
+#include "probfd/cartesian_abstractions/ilao_policy_generator.h"
+#include "probfd/cartesian_abstractions/policy_based_flaw_generator.h"
+#include "probfd/cartesian_abstractions/probabilistic_transition.h"
 #include "probfd/cartesian_abstractions/probabilistic_transition_system.h"
+#include "probfd/cartesian_abstractions/split_selector.h"
+#include "probfd/cartesian_abstractions/subtask_generators.h"
 #include "probfd/cartesian_abstractions/types.h"
 
+#include "tests/tasks/blocksworld.h"
+
 #include "downward/cartesian_abstractions/refinement_hierarchy.h"
 
+#include "downward/utils/countdown_timer.h"
 #include "downward/utils/logging.h"
+#include "downward/utils/rng.h"
 
+#include <algorithm>
 #include <fstream>
+#include <limits>
+#include <ranges>
 
 using namespace probfd;
 using namespace probfd::cartesian_abstractions;
@@ -23,6 +59,63 @@ static size_t get_num_transitions(const ProbabilisticTransitionSystem& ts)
     return ts.get_num_loops() + ts.get_num_non_loops();
 }
 
+// The abstract states reachable from the initial state with a policy.
+static std::vector<int>
+get_policy_states(CartesianAbstraction& abstraction, const Solution& policy)
+{
+    std::vector<int> states = {abstraction.get_initial_state().get_id()};
+    std::vector<bool> reached(abstraction.get_num_states(), false);
+    reached[states.front()] = true;
+
+    for (size_t i = 0; i != states.size(); ++i) {
+        const auto decision = policy.get_decision(states[i]);
+        if (!decision) continue;
+        for (const int target : decision->action->target_ids) {
+            if (reached[target]) continue;
+            reached[target] = true;
+            states.push_back(target);
+        }
+    }
+
+    return states;
+}
+
+// Sums the values of the heuristic functions for every registered state.
+static std::vector<value_t> get_additive_values(
+    TaskStateSpace& state_space,
+    const std::vector<CartesianHeuristicFunction>& functions)
+{
+    std::vector<value_t> values;
+    for (size_t i = 0; i != state_space.get_num_registered_states(); ++i) {
+        const State state = state_space.get_state(probfd::StateID(i));
+        value_t sum = 0_vt;
+        for (const CartesianHeuristicFunction& function : functions) {
+            const value_t value = function.get_value(state);
+            if (value == INFINITE_VALUE) {
+                sum = INFINITE_VALUE;
+                break;
+            }
+            sum += value;
+        }
+        values.push_back(sum);
+    }
+    return values;
+}
+
+static void check_adjacency(const ProbabilisticTransitionSystem& ts)
+{
+    for (int v = 0; v != ts.get_num_states(); ++v) {
+        for (const int transition_id : ts.get_outgoing_transitions(v)) {
+            ASSERT_EQ(ts.get_transition(transition_id).source_id, v);
+        }
+
+        for (const int transition_id : ts.get_incoming_transitions(v)) {
+            const auto& targets = ts.get_transition(transition_id).target_ids;
+            ASSERT_TRUE(std::ranges::contains(targets, v));
+        }
+    }
+}
+
 TEST(CartesianTests, test_probabilistic_transition_system)
 {
     std::fstream file("resources/gripper_example.sas");
@@ -51,6 +144,8 @@ TEST(CartesianTests, test_probabilistic_transition_system)
     abs.refine(refinement_hierarchy, abs.get_abstract_state(0), 1, {2});
     ASSERT_EQ(abs.get_num_states(), 5);
     ASSERT_EQ(get_num_transitions(abs.get_transition_system()), 10);
+
+    check_adjacency(abs.get_transition_system());
 }
 
 TEST(CartesianTests, test_probabilistic_transition_system2)
@@ -74,4 +169,269 @@ TEST(CartesianTests, test_probabilistic_transition_system2)
     abs.refine(refinement_hierarchy, abs.get_abstract_state(1), 2, {1, 2, 3});
     ASSERT_EQ(abs.get_num_states(), 3);
     ASSERT_EQ(get_num_transitions(abs.get_transition_system()), 34);
-}
\ No newline at end of file
+
+    check_adjacency(abs.get_transition_system());
+}
+
+TEST(CartesianTests, test_adjacency_lists)
+{
+    AdjacencyLists lists;
+    lists.add_list();
+    lists.add_list();
+
+    // Interleaved growth relocates the blocks repeatedly.
+    for (int i = 0; i != 1000; ++i) {
+        lists.push_back(0, i);
+        lists.push_back(1, -i);
+    }
+
+    lists.clear(0);
+    lists.push_back(0, 42);
+
+    ASSERT_EQ(lists.size(), 2U);
+    ASSERT_TRUE(std::ranges::equal(lists[0], std::views::single(42)));
+    ASSERT_EQ(lists[1].size(), 1000U);
+
+    for (int i = 0; i != 1000; ++i) {
+        ASSERT_EQ(lists[1][i], -i);
+    }
+
+    ASSERT_GT(lists.get_num_compactions(), 0U);
+}
+
+TEST(CartesianTests, test_flat_refinement_hierarchy)
+{
+    std::shared_ptr<tests::BlocksworldTask> task(
+        new tests::BlocksworldTask(2, {{1, 0}}, {{0, 1}}));
+    const ProbabilisticTaskProxy task_proxy(*task);
+
+    RefinementHierarchy refinement_hierarchy(task);
+    CartesianAbstraction abs(task_proxy, {}, utils::g_log);
+
+    // Splits four different variables, whose domains span 64 states.
+    abs.refine(
+        refinement_hierarchy,
+        abs.get_abstract_state(0),
+        task->get_location_var(0),
+        {2});
+    abs.refine(
+        refinement_hierarchy,
+        abs.get_abstract_state(0),
+        task->get_hand_var(),
+        {1});
+    abs.refine(
+        refinement_hierarchy,
+        abs.get_abstract_state(2),
+        task->get_location_var(1),
+        {0});
+    abs.refine(
+        refinement_hierarchy,
+        abs.get_abstract_state(0),
+        task->get_clear_var(1),
+        {1});
+
+    const FlatRefinementHierarchy table(refinement_hierarchy);
+    const FlatRefinementHierarchy tree(refinement_hierarchy, false);
+
+    ASSERT_TRUE(table.uses_lookup_table());
+    ASSERT_FALSE(tree.uses_lookup_table());
+
+    // Enumerate all states of the task, including unreachable ones.
+    const int num_variables = task->get_num_variables();
+    std::vector<State> states;
+    std::vector<int> values(num_variables, 0);
+    for (;;) {
+        states.push_back(task_proxy.create_state(std::vector<int>(values)));
+
+        int var = 0;
+        while (var != num_variables &&
+               ++values[var] == task->get_variable_domain_size(var)) {
+            values[var++] = 0;
+        }
+
+        if (var == num_variables) break;
+    }
+
+    std::vector<int> table_ids(states.size());
+    std::vector<int> tree_ids(states.size());
+    table.get_abstract_state_ids(states, table_ids);
+    tree.get_abstract_state_ids(states, tree_ids);
+
+    for (size_t i = 0; i != states.size(); ++i) {
+        const int id = refinement_hierarchy.get_abstract_state_id(states[i]);
+        ASSERT_EQ(table.get_abstract_state_id(states[i]), id);
+        ASSERT_EQ(tree.get_abstract_state_id(states[i]), id);
+        ASSERT_EQ(table_ids[i], id);
+        ASSERT_EQ(tree_ids[i], id);
+    }
+}
+
+TEST(CartesianTests, test_ilao_policy_generator_keeps_solved_states)
+{
+    using namespace algorithms::trap_aware_dfhs;
+
+    std::shared_ptr<ProbabilisticTask> task(
+        new tests::BlocksworldTask(3, {{1, 0}, {2}}, {{1}, {2, 0}}));
+    const ProbabilisticTaskProxy task_proxy(*task);
+
+    RefinementHierarchy refinement_hierarchy(task);
+    CartesianAbstraction abstraction(
+        task_proxy,
+        probfd::task_properties::get_operator_costs(task_proxy),
+        utils::get_silent_log());
+    CartesianHeuristic heuristic;
+    ILAOPolicyGenerator policy_generator;
+    utils::CountdownTimer timer(std::numeric_limits<double>::infinity());
+
+    ProgressReport report(0.0_vt);
+    report.disable();
+
+    heuristics::BlindEvaluator<int> blind_heuristic;
+
+    for (int i = 0; i != 40; ++i) {
+        const int init_id = abstraction.get_initial_state().get_id();
+
+        auto policy = policy_generator.find_solution(
+            abstraction,
+            &abstraction.get_initial_state(),
+            heuristic,
+            timer);
+        ASSERT_NE(policy, nullptr);
+
+        // Solve the refined abstraction from scratch.
+        auto picker = std::make_shared<policy_pickers::ArbitraryTiebreaker<
+            quotients::QuotientState<int, const ProbabilisticTransition*>,
+            quotients::QuotientAction<const ProbabilisticTransition*>>>(true);
+        TADepthFirstHeuristicSearch<int, const ProbabilisticTransition*, false>
+            solver(
+                picker,
+                false,
+                BacktrackingUpdateType::SINGLE,
+                true,
+                false,
+                false,
+                true,
+                true);
+        auto expected_policy = solver.compute_policy(
+            abstraction,
+            blind_heuristic,
+            init_id,
+            report,
+            std::numeric_limits<double>::infinity());
+        ASSERT_NE(expected_policy, nullptr);
+
+        ASSERT_NEAR(
+            heuristic.get_h_value(init_id),
+            solver.lookup_bounds(probfd::StateID(init_id)).lower,
+            0.001);
+
+        // Every state reached by the policy has its optimal value, and the
+        // policy chooses an optimal action for it.
+        const std::vector<int> states =
+            get_policy_states(abstraction, *policy);
+        for (const int state : states) {
+            if (abstraction.is_goal(state)) continue;
+
+            const auto decision = policy->get_decision(state);
+            ASSERT_TRUE(decision.has_value());
+
+            const probfd::StateID state_id(state);
+            if (!solver.was_visited(state_id) || !solver.is_solved(state_id)) {
+                continue;
+            }
+
+            const value_t value = solver.lookup_bounds(state_id).lower;
+            ASSERT_NEAR(heuristic.get_h_value(state), value, 0.001);
+            ASSERT_NEAR(decision->q_value_interval.lower, value, 0.001);
+        }
+
+        // Split the first state reached by the policy which can be split.
+        auto splittable = std::ranges::find_if(states, [&](int state) {
+            const AbstractState& abstract_state =
+                abstraction.get_abstract_state(state);
+            for (const VariableProxy var : task_proxy.get_variables()) {
+                if (abstract_state.count(var.get_id()) > 1) return true;
+            }
+            return false;
+        });
+
+        if (splittable == states.end()) break;
+
+        const AbstractState& abstract_state =
+            abstraction.get_abstract_state(*splittable);
+        for (const VariableProxy var : task_proxy.get_variables()) {
+            const int var_id = var.get_id();
+            if (abstract_state.count(var_id) == 1) continue;
+
+            int value = 0;
+            while (!abstract_state.contains(var_id, value)) ++value;
+
+            abstraction.refine(
+                refinement_hierarchy,
+                abstract_state,
+                var_id,
+                {value});
+            heuristic.on_split(*splittable);
+            policy_generator.notify_split(*splittable);
+            break;
+        }
+    }
+}
+
+TEST(CartesianTests, test_parallel_cost_saturation)
+{
+    using namespace algorithms::topological_vi;
+
+    std::shared_ptr<ProbabilisticTask> task(new tests::BlocksworldTask(
+        4,
+        {{1, 0}, {2, 3}},
+        {{0, 1, 2, 3}}));
+
+    // Compute the optimal values of all reachable states.
+    TaskStateSpace state_space(task, utils::get_silent_log());
+    TaskCostFunction cost_function(task);
+    CompositeMDP<State, OperatorID> mdp{state_space, cost_function};
+    heuristics::BlindEvaluator<State> blind_heuristic;
+    storage::PerStateStorage<value_t> optimal_values;
+
+    TopologicalValueIteration<State, OperatorID> tvi(false);
+    tvi.solve(
+        mdp,
+        blind_heuristic,
+        mdp.get_state_id(state_space.get_initial_state()),
+        optimal_values);
+
+    auto generate_heuristic_functions = [&](unsigned num_threads) {
+        CostSaturation cost_saturation(
+            {std::make_shared<TaskDuplicator>(4)},
+            std::make_shared<ILAOFlawGeneratorFactory>(
+                std::numeric_limits<int>::max()),
+            std::make_shared<SplitSelectorRandomFactory>(
+                std::make_shared<utils::RandomNumberGenerator>(42)),
+            40,
+            std::numeric_limits<int>::max(),
+            std::numeric_limits<double>::infinity(),
+            false,
+            num_threads,
+            utils::get_silent_log());
+        return cost_saturation.generate_heuristic_functions(task);
+    };
+
+    const std::vector<value_t> serial_values = get_additive_values(
+        state_space,
+        generate_heuristic_functions(1));
+    const std::vector<value_t> parallel_values = get_additive_values(
+        state_space,
+        generate_heuristic_functions(4));
+
+    for (size_t i = 0; i != serial_values.size(); ++i) {
+        const value_t optimal_value = optimal_values[probfd::StateID(i)];
+        ASSERT_LE(serial_values[i], optimal_value + 0.001);
+        ASSERT_LE(parallel_values[i], optimal_value + 0.001);
+    }
+
+    // The random splits do not depend on the thread schedule.
+    ASSERT_EQ(
+        get_additive_values(state_space, generate_heuristic_functions(4)),
+        parallel_values);
+}
@@ -1,10 +1,20 @@
 #include <gtest/gtest.h>
 
+#include "probfd/pdbs/multi_pattern_ranking.h"
+#include "probfd/pdbs/pdb_cache.h"
+#include "probfd/pdbs/probability_aware_pattern_database.h"
 #include "probfd/pdbs/state_ranking_function.h"
+#include "probfd/pdbs/utils.h"
 
+#include "probfd/utils/guards.h"
+
+#include "probfd/task_cost_function.h"
 #include "probfd/task_proxy.h"
 #include "tests/tasks/blocksworld.h"
 
+#include <algorithm>
+#include <filesystem>
+
 using namespace probfd;
 using namespace probfd::pdbs;
 
@@ -106,4 +116,186 @@ TEST(PDBTests, test_ranking_function_all_variables)
          task.get_fact_block_on_table(2),
          task.get_fact_is_hand_empty(true)});
     ASSERT_EQ(ranking_function.get_abstract_rank(example_state), 1751);
-}
\ No newline at end of file
+}
+
+TEST(PDBTests, test_multi_pattern_ranking)
+{
+    BlocksworldTask task(3, {{1, 0}, {2}}, {{1}, {2, 0}});
+
+    ProbabilisticTaskProxy task_proxy(task);
+    VariablesProxy variables = task_proxy.get_variables();
+    const int num_variables = static_cast<int>(variables.size());
+
+    // Patterns of different sizes, filling more than one block.
+    std::vector<StateRankingFunction> ranking_functions;
+    Pattern all_variables;
+    for (int i = 0; i != num_variables; ++i) {
+        ranking_functions.emplace_back(variables, Pattern{i});
+        for (int j = i + 1; j != num_variables; ++j) {
+            ranking_functions.emplace_back(variables, Pattern{i, j});
+        }
+        all_variables.push_back(i);
+    }
+    ranking_functions.emplace_back(variables, all_variables);
+
+    std::vector<const StateRankingFunction*> ranking_function_ptrs;
+    for (const StateRankingFunction& ranking_function : ranking_functions) {
+        ranking_function_ptrs.push_back(&ranking_function);
+    }
+
+    std::vector<State> states;
+    states.push_back(task.get_state(
+        {task.get_fact_is_block_clear(0, true),
+         task.get_fact_is_block_clear(1, true),
+         task.get_fact_is_block_clear(2, true),
+         task.get_fact_block_on_table(0),
+         task.get_fact_block_on_table(1),
+         task.get_fact_block_on_table(2),
+         task.get_fact_is_hand_empty(true)}));
+    states.push_back(task.get_state(
+        {task.get_fact_is_block_clear(0, false),
+         task.get_fact_is_block_clear(1, true),
+         task.get_fact_is_block_clear(2, false),
+         task.get_fact_block_on_block(1, 0),
+         task.get_fact_block_on_table(0),
+         task.get_fact_block_in_hand(2),
+         task.get_fact_is_hand_empty(false)}));
+
+    for (const bool allow_simd : {false, true}) {
+        const MultiPatternRanking ranking(ranking_function_ptrs, allow_simd);
+        ASSERT_EQ(ranking.num_patterns(), ranking_functions.size());
+
+        std::vector<StateRank> ranks(ranking.num_patterns() * states.size());
+        ranking.compute_ranks(states, ranks);
+
+        for (size_t i = 0; i != ranking_functions.size(); ++i) {
+            for (size_t j = 0; j != states.size(); ++j) {
+                ASSERT_EQ(
+                    ranks[i * states.size() + j],
+                    ranking_functions[i].get_abstract_rank(states[j]));
+            }
+        }
+    }
+}
+
+TEST(PDBTests, test_parallel_pdb_construction)
+{
+    std::shared_ptr<ProbabilisticTask> task(new BlocksworldTask(
+        4,
+        {{1, 0}, {2, 3}},
+        {{0, 1, 2, 3}}));
+    ProbabilisticTaskProxy task_proxy(*task);
+    auto cost_function = std::make_shared<TaskCostFunction>(task);
+
+    std::vector<bool> is_goal_var(task_proxy.get_variables().size(), false);
+    for (const FactProxy goal : task_proxy.get_goals()) {
+        is_goal_var[goal.get_variable().get_id()] = true;
+    }
+
+    // All patterns of size two that contain a goal variable.
+    PatternCollection patterns;
+    const int num_variables = static_cast<int>(is_goal_var.size());
+    for (int i = 0; i != num_variables; ++i) {
+        for (int j = i + 1; j != num_variables; ++j) {
+            if (is_goal_var[i] || is_goal_var[j]) patterns.push_back({i, j});
+        }
+    }
+
+    const PPDBCollection serial_pdbs =
+        compute_pdbs(task_proxy, cost_function, patterns, 1);
+    const PPDBCollection parallel_pdbs =
+        compute_pdbs(task_proxy, cost_function, patterns, 4);
+
+    ASSERT_EQ(serial_pdbs.size(), patterns.size());
+    ASSERT_EQ(parallel_pdbs.size(), patterns.size());
+
+    for (size_t i = 0; i != patterns.size(); ++i) {
+        ASSERT_EQ(parallel_pdbs[i]->get_pattern(), patterns[i]);
+        ASSERT_TRUE(std::ranges::equal(
+            serial_pdbs[i]->get_value_table(),
+            parallel_pdbs[i]->get_value_table()));
+    }
+}
+
+TEST(PDBTests, test_pdb_cache_round_trip)
+{
+    std::shared_ptr<ProbabilisticTask> task(
+        new BlocksworldTask(3, {{1, 0}, {2}}, {{1}, {2, 0}}));
+    ProbabilisticTaskProxy task_proxy(*task);
+    auto cost_function = std::make_shared<TaskCostFunction>(task);
+
+    const PatternCollection patterns = {{0, 3}, {1, 4, 5}};
+
+    const std::filesystem::path directory =
+        std::filesystem::temp_directory_path() / "probfd_pdb_cache_test";
+    std::filesystem::remove_all(directory);
+
+    const PDBCache cache(directory, task_proxy, utils::get_silent_log());
+    const std::uint64_t cost_key = cache.get_cost_key(*cost_function);
+
+    ASSERT_EQ(cache.load(patterns[0], cost_key), nullptr);
+
+    const PPDBCollection computed_pdbs =
+        compute_pdbs(task_proxy, cost_function, patterns, 1, &cache);
+
+    for (size_t i = 0; i != patterns.size(); ++i) {
+        const auto loaded_pdb = cache.load(patterns[i], cost_key);
+        ASSERT_NE(loaded_pdb, nullptr);
+        ASSERT_EQ(loaded_pdb->get_pattern(), patterns[i]);
+        ASSERT_TRUE(std::ranges::equal(
+            loaded_pdb->get_value_table(),
+            computed_pdbs[i]->get_value_table()));
+    }
+
+    // A different cost function must not hit the cache.
+    ASSERT_EQ(cache.load(patterns[0], cost_key + 1), nullptr);
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST(PDBTests, test_pdb_cache_rejects_foreign_files)
+{
+    std::shared_ptr<ProbabilisticTask> task(
+        new BlocksworldTask(3, {{1, 0}, {2}}, {{1}, {2, 0}}));
+    ProbabilisticTaskProxy task_proxy(*task);
+    auto cost_function = std::make_shared<TaskCostFunction>(task);
+
+    const PatternCollection patterns = {{0, 3}};
+
+    const std::filesystem::path directory =
+        std::filesystem::temp_directory_path() / "probfd_pdb_cache_test_2";
+    std::filesystem::remove_all(directory);
+
+    const PDBCache cache(directory, task_proxy, utils::get_silent_log());
+    const std::uint64_t cost_key = cache.get_cost_key(*cost_function);
+    compute_pdbs(task_proxy, cost_function, patterns, 1, &cache);
+
+    const std::filesystem::path file =
+        std::filesystem::directory_iterator(directory)->path();
+
+    const value_t old_epsilon = g_epsilon;
+    scope_exit restore_epsilon([&] { g_epsilon = old_epsilon; });
+    g_epsilon = old_epsilon / 2;
+
+    // A different epsilon must not hit the cache.
+    const PDBCache other_cache(directory, task_proxy, utils::get_silent_log());
+    ASSERT_EQ(other_cache.load(patterns[0], cost_key), nullptr);
+
+    compute_pdbs(task_proxy, cost_function, patterns, 1, &other_cache);
+    ASSERT_NE(other_cache.load(patterns[0], cost_key), nullptr);
+
+    // Simulate a file name collision with the file of the first cache. The
+    // fingerprint in the header must reject it.
+    for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        if (entry.path() != file) {
+            std::filesystem::copy_file(
+                file,
+                entry.path(),
+                std::filesystem::copy_options::overwrite_existing);
+        }
+    }
+
+    ASSERT_EQ(other_cache.load(patterns[0], cost_key), nullptr);
+
+    std::filesystem::remove_all(directory);
+}
@@ -2,10 +2,156 @@
 
 #include "probfd/tasks/root_task.h"
 
+#include "probfd/storage/per_state_storage.h"
+
+#include "probfd/task_utils/outcome_deltas.h"
+#include "probfd/task_utils/probabilistic_successor_generator.h"
+
+#include "probfd/utils/mapped_memory_resource.h"
+
+#include "probfd/concurrent_task_state_space.h"
+#include "probfd/distribution.h"
 #include "probfd/probabilistic_task.h"
+#include "probfd/task_state_space.h"
+
+#include "downward/utils/logging.h"
+
+#include "downward/state_registry.h"
+
+#include "tests/tasks/blocksworld.h"
 
+#include <deque>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <ranges>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// A small task in the text SAS format, with a mutex group, a probabilistic
+// operator and a conditional effect.
+const char* const EXAMPLE_SAS_TASK = R"(begin_version
+1
+end_version
+begin_metric
+1
+1
+1
+end_metric
+2
+begin_variable
+var0
+-1
+3
+Atom at(a)
+Atom at(b)
+Atom at(c)
+end_variable
+begin_variable
+var1
+-1
+2
+Atom holding()
+NegatedAtom holding()
+end_variable
+1
+begin_mutex_group
+2
+0 0
+1 0
+end_mutex_group
+begin_state
+0
+1
+end_state
+begin_goal
+1
+0 2
+end_goal
+2
+begin_operator
+move-a-b
+1
+0 0
+2
+3/4
+1
+0 0 1
+1/4
+0
+1
+end_operator
+begin_operator
+move-b-c
+1
+0 1
+1
+1
+2
+0 0 2
+1 1 1 1 0
+2
+end_operator
+0
+)";
+
+// Creates blocksworld with six blocks and makes it the root task.
+std::shared_ptr<probfd::ProbabilisticTask> create_blocksworld_6_task()
+{
+    std::shared_ptr<probfd::ProbabilisticTask> task(new tests::BlocksworldTask(
+        6,
+        {{1, 0}, {2}, {5, 4, 3}},
+        {{1, 4}, {5, 3, 2, 0}}));
+
+    probfd::tasks::set_root_task(task);
+
+    return task;
+}
+
+// Explores the reachable state space depth-first, returning the IDs of the
+// reached states in order of their first visit.
+template <typename StateSpace>
+std::vector<probfd::StateID> explore(StateSpace& state_space)
+{
+    std::vector<probfd::StateID> reached;
+    std::set<probfd::StateID> seen;
+    std::vector<probfd::StateID> stack;
+
+    const probfd::StateID init_id =
+        state_space.get_state_id(state_space.get_initial_state());
+    seen.insert(init_id);
+    stack.push_back(init_id);
+
+    std::vector<OperatorID> aops;
+    std::vector<probfd::Distribution<probfd::StateID>> successors;
+
+    while (!stack.empty()) {
+        const probfd::StateID state_id = stack.back();
+        stack.pop_back();
+        reached.push_back(state_id);
+
+        aops.clear();
+        successors.clear();
+        state_space.generate_all_transitions(
+            state_space.get_state(state_id),
+            aops,
+            successors);
+
+        for (const auto& dist : successors) {
+            for (const auto& [succ_id, _] : dist) {
+                if (seen.insert(succ_id).second) stack.push_back(succ_id);
+            }
+        }
+    }
+
+    return reached;
+}
+
+} // namespace
 
 TEST(TaskTests, test_read_sas_task)
 {
@@ -19,4 +165,334 @@ TEST(TaskTests, test_read_sas_task)
         task->get_initial_state_values(),
         std::vector({1, 0, 0, 0, 1, 6, 6, 5, 1, 6, 0}));
     ASSERT_EQ(task->get_num_goals(), 7);
-}
\ No newline at end of file
+}
+
+TEST(TaskTests, test_binary_sas_task_round_trip)
+{
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "probfd_example.psas";
+
+    {
+        std::istringstream in(EXAMPLE_SAS_TASK);
+        std::ofstream out(path, std::ios::binary);
+        probfd::tasks::convert_sas_task_to_binary(in, out);
+    }
+
+    std::istringstream in(EXAMPLE_SAS_TASK);
+    auto expected = probfd::tasks::read_sas_task(in);
+    auto task = probfd::tasks::read_binary_sas_task(path);
+    std::filesystem::remove(path);
+
+    ASSERT_EQ(expected->get_num_variables(), 2);
+    ASSERT_EQ(expected->get_num_operators(), 2);
+
+    ASSERT_EQ(task->get_num_variables(), expected->get_num_variables());
+    ASSERT_EQ(task->get_num_operators(), expected->get_num_operators());
+    ASSERT_EQ(
+        task->get_initial_state_values(),
+        expected->get_initial_state_values());
+    ASSERT_EQ(
+        task->get_non_goal_termination_cost(),
+        expected->get_non_goal_termination_cost());
+    ASSERT_TRUE(task->are_facts_mutex({0, 0}, {1, 0}));
+    ASSERT_FALSE(task->are_facts_mutex({0, 1}, {1, 0}));
+
+    for (int i = 0; i != task->get_num_goals(); ++i) {
+        ASSERT_EQ(task->get_goal_fact(i), expected->get_goal_fact(i));
+    }
+
+    for (int op = 0; op != task->get_num_operators(); ++op) {
+        ASSERT_EQ(task->get_operator_name(op), expected->get_operator_name(op));
+        ASSERT_EQ(task->get_operator_cost(op), expected->get_operator_cost(op));
+        ASSERT_EQ(
+            task->get_num_operator_outcomes(op),
+            expected->get_num_operator_outcomes(op));
+
+        for (int i = 0; i != task->get_num_operator_outcomes(op); ++i) {
+            ASSERT_EQ(
+                task->get_operator_outcome_probability(op, i),
+                expected->get_operator_outcome_probability(op, i));
+            ASSERT_EQ(
+                task->get_num_operator_outcome_effects(op, i),
+                expected->get_num_operator_outcome_effects(op, i));
+
+            for (int j = 0; j != task->get_num_operator_outcome_effects(op, i);
+                 ++j) {
+                ASSERT_EQ(
+                    task->get_operator_outcome_effect(op, i, j),
+                    expected->get_operator_outcome_effect(op, i, j));
+                ASSERT_EQ(
+                    task->get_num_operator_outcome_effect_conditions(op, i, j),
+                    expected->get_num_operator_outcome_effect_conditions(
+                        op,
+                        i,
+                        j));
+            }
+        }
+    }
+}
+
+TEST(TaskTests, test_concurrent_state_registry_stress)
+{
+    using namespace probfd;
+
+    const std::shared_ptr<ProbabilisticTask> task = create_blocksworld_6_task();
+
+    TaskStateSpace sequential_space(task, utils::get_silent_log());
+    const size_t num_states = explore(sequential_space).size();
+
+    constexpr int NUM_THREADS = 8;
+
+    ConcurrentTaskStateSpace state_space(task, utils::get_silent_log());
+
+    // Every thread explores the whole state space, so most registrations
+    // race with lookups or registrations of the same state by other threads.
+    std::vector<std::vector<probfd::StateID>> reached(NUM_THREADS);
+    std::vector<std::thread> threads;
+    for (int i = 0; i != NUM_THREADS; ++i) {
+        threads.emplace_back([&, i] { reached[i] = explore(state_space); });
+    }
+    for (std::thread& thread : threads) thread.join();
+
+    ASSERT_EQ(state_space.get_num_registered_states(), num_states);
+
+    // IDs are dense and every thread reached every state under the same ID.
+    const std::set<probfd::StateID> expected_ids(
+        reached[0].begin(),
+        reached[0].end());
+    ASSERT_EQ(expected_ids.size(), num_states);
+    ASSERT_EQ(*expected_ids.rbegin(), num_states - 1);
+    for (const auto& ids : reached) {
+        ASSERT_EQ(
+            std::set<probfd::StateID>(ids.begin(), ids.end()),
+            expected_ids);
+    }
+
+    // No state was registered twice.
+    std::set<std::vector<int>> distinct_states;
+    for (const probfd::StateID id : expected_ids) {
+        State state = state_space.get_state(id);
+        state.unpack();
+        ASSERT_EQ(state_space.get_state_id(state), id);
+        distinct_states.insert(state.get_unpacked_values());
+    }
+    ASSERT_EQ(distinct_states.size(), num_states);
+}
+
+TEST(TaskTests, test_flat_successor_generator_blocksworld_6_blocks)
+{
+    using namespace probfd;
+    using successor_generator::ProbabilisticSuccessorGenerator;
+
+    const std::shared_ptr<ProbabilisticTask> task = create_blocksworld_6_task();
+
+    ProbabilisticTaskProxy task_proxy(*task);
+    ProbabilisticSuccessorGenerator tree(task_proxy);
+    ProbabilisticSuccessorGenerator flat(task_proxy, true);
+
+    TaskStateSpace state_space(task, utils::get_silent_log());
+
+    std::vector<OperatorID> tree_ops;
+    std::vector<OperatorID> flat_ops;
+
+    for (const probfd::StateID id : explore(state_space)) {
+        const State state = state_space.get_state(id);
+        tree_ops.clear();
+        flat_ops.clear();
+        tree.generate_applicable_ops(state, tree_ops);
+        flat.generate_applicable_ops(state, flat_ops);
+        ASSERT_EQ(tree_ops, flat_ops);
+
+        // Unregistered states are read from their unpacked values.
+        state.unpack();
+        const State unregistered = task_proxy.create_state(
+            std::vector<int>(state.get_unpacked_values()));
+        flat_ops.clear();
+        flat.generate_applicable_ops(unregistered, flat_ops);
+        ASSERT_EQ(tree_ops, flat_ops);
+    }
+}
+
+TEST(TaskTests, test_outcome_deltas_blocksworld_6_blocks)
+{
+    using namespace probfd;
+    using successor_generator::ProbabilisticSuccessorGenerator;
+
+    const std::shared_ptr<ProbabilisticTask> task = create_blocksworld_6_task();
+
+    ProbabilisticTaskProxy task_proxy(*task);
+    ProbabilisticSuccessorGenerator generator(task_proxy);
+    StateRegistry registry(task_proxy);
+    OutcomeDeltas deltas(task_proxy, registry.get_state_packer());
+
+    // Blocksworld has no conditional effects.
+    ASSERT_EQ(
+        deltas.get_num_operators_with_deltas(),
+        static_cast<int>(task_proxy.get_operators().size()));
+
+    std::deque<::StateID> queue;
+    std::vector<OperatorID> aops;
+    std::vector<::StateID> successors;
+
+    queue.push_back(registry.get_initial_state().get_id());
+
+    while (!queue.empty()) {
+        const State state = registry.lookup_state(queue.front());
+        queue.pop_front();
+
+        aops.clear();
+        generator.generate_applicable_ops(state, aops);
+
+        for (const OperatorID op_id : aops) {
+            const size_t num_states = registry.size();
+
+            successors.clear();
+            registry.get_successor_states(
+                state,
+                deltas.get_deltas(),
+                deltas.get_outcome_offsets(op_id),
+                successors);
+
+            const auto outcomes =
+                task_proxy.get_operators()[op_id].get_outcomes();
+            ASSERT_EQ(successors.size(), outcomes.size());
+
+            // Applying the effects one by one must find the same states.
+            const size_t num_registered = registry.size();
+            for (size_t i = 0; i != outcomes.size(); ++i) {
+                const State succ = registry.get_successor_state(
+                    state,
+                    outcomes[i].get_effects());
+                ASSERT_EQ(succ.get_id(), successors[i]);
+            }
+            ASSERT_EQ(registry.size(), num_registered);
+
+            for (const ::StateID succ_id : successors) {
+                if (static_cast<size_t>(succ_id.get_value()) >= num_states) {
+                    queue.push_back(succ_id);
+                }
+            }
+        }
+    }
+}
+
+TEST(TaskTests, test_batched_successor_registration_blocksworld_4_blocks)
+{
+    using namespace probfd;
+    using successor_generator::ProbabilisticSuccessorGenerator;
+
+    std::shared_ptr<ProbabilisticTask> task(
+        new tests::BlocksworldTask(4, {{1, 0}, {3, 2}}, {{0, 1, 2, 3}}));
+
+    tasks::set_root_task(task);
+
+    ProbabilisticTaskProxy task_proxy(*task);
+    ProbabilisticSuccessorGenerator generator(task_proxy);
+
+    // Registers the successors of all outcomes at once.
+    StateRegistry batched(task_proxy);
+
+    // Registers the successor of one outcome at a time.
+    StateRegistry reference(task_proxy);
+
+    ASSERT_EQ(
+        batched.get_initial_state().get_id(),
+        reference.get_initial_state().get_id());
+
+    std::deque<::StateID> queue;
+    std::vector<OperatorID> aops;
+    std::vector<::StateID> successors;
+
+    queue.push_back(batched.get_initial_state().get_id());
+
+    while (!queue.empty()) {
+        const State state = batched.lookup_state(queue.front());
+        const State reference_state = reference.lookup_state(queue.front());
+        queue.pop_front();
+
+        aops.clear();
+        generator.generate_applicable_ops(state, aops);
+
+        for (const OperatorID op_id : aops) {
+            const size_t num_states = batched.size();
+            const auto outcomes =
+                task_proxy.get_operators()[op_id].get_outcomes();
+
+            successors.clear();
+            batched.get_successor_states(
+                state,
+                outcomes | std::views::transform(
+                               &ProbabilisticOutcomeProxy::get_effects),
+                successors);
+            ASSERT_EQ(successors.size(), outcomes.size());
+
+            // New states are registered in the order of the outcomes, so
+            // both registries assign the same IDs.
+            for (size_t i = 0; i != outcomes.size(); ++i) {
+                const State succ = reference.get_successor_state(
+                    reference_state,
+                    outcomes[i].get_effects());
+                ASSERT_EQ(succ.get_id(), successors[i]);
+            }
+            ASSERT_EQ(reference.size(), batched.size());
+
+            for (const ::StateID succ_id : successors) {
+                if (static_cast<size_t>(succ_id.get_value()) >= num_states) {
+                    queue.push_back(succ_id);
+                }
+            }
+        }
+    }
+
+    ASSERT_GT(batched.size(), 1u);
+
+    for (int i = 0; i != static_cast<int>(batched.size()); ++i) {
+        const State state = batched.lookup_state(::StateID(i));
+        const State reference_state = reference.lookup_state(::StateID(i));
+        state.unpack();
+        reference_state.unpack();
+        ASSERT_EQ(
+            state.get_unpacked_values(),
+            reference_state.get_unpacked_values());
+    }
+}
+
+TEST(TaskTests, test_mapped_state_storage_blocksworld_6_blocks)
+{
+    using namespace probfd;
+
+    const std::shared_ptr<ProbabilisticTask> task = create_blocksworld_6_task();
+
+    // Small chunks, so that the arena spans many mappings.
+    MappedMemoryResource state_memory(
+        std::filesystem::temp_directory_path(),
+        4096);
+
+    TaskStateSpace in_memory(task, utils::get_silent_log());
+    TaskStateSpace mapped(
+        task,
+        utils::get_silent_log(),
+        {},
+        false,
+        &state_memory);
+
+    const std::vector<probfd::StateID> expected = explore(in_memory);
+    ASSERT_EQ(explore(mapped), expected);
+    ASSERT_GT(state_memory.get_file_size(), std::size_t(4096));
+
+    storage::PolymorphicPerStateStorage<int> values(-1, &state_memory);
+    for (const probfd::StateID id : expected) {
+        const State state = mapped.get_state(id);
+        const State expected_state = in_memory.get_state(id);
+        state.unpack();
+        expected_state.unpack();
+        ASSERT_EQ(
+            state.get_unpacked_values(),
+            expected_state.get_unpacked_values());
+        values[id] = id;
+    }
+
+    for (const probfd::StateID id : expected) {
+        ASSERT_EQ(values[id], static_cast<int>(id));
+    }
+}